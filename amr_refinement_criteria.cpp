@@ -23,6 +23,7 @@
 #include <cstdlib>
 #include <cmath>
 
+#include "common.h"
 #include "parameters.h"
 #include "amr_refinement_criteria.h"
 #include "velocity_blocks.h"
@@ -37,6 +38,8 @@ namespace amr_ref_criteria {
    Base::~Base() { }
    
    Base* relDiffMaker() {return new RelativeDifference;}
+   SpatialBase* rhomGradientMaker() {return new RhomGradient;}
+   SpatialBase* perbGradientMaker() {return new PerBGradient;}
    
    void Base::evaluate(const Realf* velBlost,Realf* result,const uint popID) {
       for (uint i=0; i<WID3; ++i) result[i] = 0.0;
@@ -116,8 +119,63 @@ namespace amr_ref_criteria {
       return true;
    }
 
+   SpatialBase::SpatialBase() { }
+   
+   SpatialBase::~SpatialBase() { }
+
+   RhomGradient::RhomGradient() { }
+   
+   RhomGradient::~RhomGradient() { }
+
+   Real RhomGradient::evaluate(const Real* cellParams,const std::vector<const Real*>& nbrParams) {
+      const Real rhom = cellParams[CellParams::RHOM];
+      Real maxvalue = 0.0;
+      for (size_t n=0; n<nbrParams.size(); ++n) {
+         const Real rhom_nbr = nbrParams[n][CellParams::RHOM];
+         const Real norm = max(fabs(rhom),fabs(rhom_nbr));
+         if (norm <= 0.0) continue;
+         maxvalue = max(maxvalue,fabs(rhom_nbr-rhom) / norm);
+      }
+      return maxvalue;
+   }
+
+   bool RhomGradient::initialize(const std::string& configRegion) {
+      return true;
+   }
+
+   PerBGradient::PerBGradient() { }
+   
+   PerBGradient::~PerBGradient() { }
+
+   Real PerBGradient::evaluate(const Real* cellParams,const std::vector<const Real*>& nbrParams) {
+      Real B[3];
+      for (int i=0; i<3; ++i) B[i] = cellParams[CellParams::PERBXVOL+i] + cellParams[CellParams::BGBXVOL+i];
+      const Real B2 = B[0]*B[0] + B[1]*B[1] + B[2]*B[2];
+      
+      Real maxvalue = 0.0;
+      for (size_t n=0; n<nbrParams.size(); ++n) {
+         Real dB2 = 0.0;
+         Real B2_nbr = 0.0;
+         for (int i=0; i<3; ++i) {
+            const Real B_nbr = nbrParams[n][CellParams::PERBXVOL+i] + nbrParams[n][CellParams::BGBXVOL+i];
+            dB2    += (B_nbr-B[i])*(B_nbr-B[i]);
+            B2_nbr += B_nbr*B_nbr;
+         }
+         const Real norm2 = max(B2,B2_nbr);
+         if (norm2 <= 0.0) continue;
+         maxvalue = max(maxvalue,sqrt(dB2/norm2));
+      }
+      return maxvalue;
+   }
+
+   bool PerBGradient::initialize(const std::string& configRegion) {
+      return true;
+   }
+
    void addRefinementCriteria() {
       getObjectWrapper().amrVelRefCriteria.add("relative_difference",relDiffMaker);
+      getObjectWrapper().amrSpatialRefCriteria.add("rhom_gradient",rhomGradientMaker);
+      getObjectWrapper().amrSpatialRefCriteria.add("perb_gradient",perbGradientMaker);
    }
 }
 
@@ -24,6 +24,7 @@
 #define AMR_REFINEMENT_CRITERIA_H
 
 #include <iostream>
+#include <vector>
 #include "definitions.h"
 
 namespace amr_ref_criteria {
@@ -41,6 +42,18 @@ namespace amr_ref_criteria {
 
    };
 
+   /** Base class for spatial cell refinement criteria. The criterion is evaluated
+    * from the cell parameters (CellParams) of a cell and its face neighbors, 
+    * a large value means that the cell should be refined.*/
+   class SpatialBase {
+    public:
+      SpatialBase();
+      virtual ~SpatialBase();
+      
+      virtual Real evaluate(const Real* cellParams,const std::vector<const Real*>& nbrParams) = 0;
+      virtual bool initialize(const std::string& configRegion) = 0;
+   };
+
    void addRefinementCriteria();
 
    class RelativeDifference: public Base {
@@ -58,6 +71,27 @@ namespace amr_ref_criteria {
       Realf evaluate(const Realf& f_lef,const Realf& f_cen,const Realf& f_rgt);
    };
 
+   /** Maximum relative jump of the mass density to the face neighbors.*/
+   class RhomGradient: public SpatialBase {
+    public:
+      RhomGradient();
+      ~RhomGradient();
+      
+      Real evaluate(const Real* cellParams,const std::vector<const Real*>& nbrParams);
+      bool initialize(const std::string& configRegion);
+   };
+
+   /** Maximum jump of the (perturbed + background) volume-averaged magnetic field 
+    * to the face neighbors, normalized by the larger of the two field magnitudes.*/
+   class PerBGradient: public SpatialBase {
+    public:
+      PerBGradient();
+      ~PerBGradient();
+      
+      Real evaluate(const Real* cellParams,const std::vector<const Real*>& nbrParams);
+      bool initialize(const std::string& configRegion);
+   };
+
 } // namespace amr_ref_criteria
 
 #endif
@@ -0,0 +1,248 @@
+/*
+ * This file is part of Vlasiator.
+ * Copyright 2010-2016 Finnish Meteorological Institute
+ *
+ * For details of usage, see the COPYING file and read the "Rules of the Road"
+ * at http://www.physics.helsinki.fi/vlasiator/
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <sys/mman.h>
+
+#include "block_pool.h"
+
+using namespace std;
+
+namespace blockpool {
+
+   // Four size classes per power of two from MIN_CLASS_BYTES to MAX_CLASS_BYTES
+   static const int N_CLASSES = 49;
+   // Bytes each thread keeps cached per size class before returning half to the shared list
+   static const size_t THREAD_CACHE_BYTES = 1024*1024;
+   // Bytes of freed large mappings kept for reuse
+   static const size_t LARGE_CACHE_BYTES = 64*1024*1024;
+
+   struct FreeObject {
+      FreeObject* next;
+   };
+
+   struct ThreadCache {
+      FreeObject* head[N_CLASSES];
+      uint32_t count[N_CLASSES];
+   };
+
+   // Shared free list and current slab of a size class, one cache line each
+   struct alignas(64) CentralList {
+      mutex lock;
+      FreeObject* head;
+      char* slabCursor;
+      char* slabEnd;
+   };
+
+   struct LargeMapping {
+      void* ptr;
+      size_t bytes;
+   };
+
+   static thread_local ThreadCache threadCache;
+   static CentralList central[N_CLASSES];
+   static mutex largeLock;
+   static vector<LargeMapping> largeCache;
+
+   static atomic<bool> hugeTLB(false);
+   static atomic<bool> hugeTLBFailed(false);
+   static atomic<uint64_t> slabBytes(0);
+   static atomic<uint64_t> largeBytes(0);
+   static atomic<uint64_t> largeCachedBytes(0);
+   static atomic<uint64_t> mapCalls(0);
+   static atomic<uint64_t> centralRefills(0);
+
+   static inline int sizeClass(const size_t bytes) {
+      if (bytes <= MIN_CLASS_BYTES) return 0;
+      // 2^b < bytes <= 2^(b+1), split in quarters of 2^b
+      const int b = 63 - __builtin_clzll(bytes-1);
+      const size_t quarter = (size_t)1 << (b-2);
+      const int sub = ((bytes - ((size_t)1 << b)) + quarter - 1) / quarter;
+      return 4*(b-8) + sub;
+   }
+
+   static inline size_t classBytes(const int cls) {
+      if (cls == 0) return MIN_CLASS_BYTES;
+      const int b = (cls-1)/4 + 8;
+      const int sub = (cls-1)%4 + 1;
+      return ((size_t)1 << b) + sub*((size_t)1 << (b-2));
+   }
+
+   static inline uint32_t cacheLimit(const int cls) {
+      const size_t limit = THREAD_CACHE_BYTES / classBytes(cls);
+      return limit < 2 ? 2 : limit;
+   }
+
+   /*! Map bytes (a multiple of SLAB_BYTES) aligned to SLAB_BYTES, backed by huge pages if possible.*/
+   static void* mapHuge(const size_t bytes) {
+      ++mapCalls;
+      #ifdef MAP_HUGETLB
+      if (hugeTLB) {
+         void* p = mmap(NULL,bytes,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB,-1,0);
+         if (p != MAP_FAILED) return p;
+         hugeTLBFailed = true;
+      }
+      #endif
+
+      // Over-allocate by one slab and trim to get the alignment transparent huge pages need
+      char* p = (char*)mmap(NULL,bytes+SLAB_BYTES,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS,-1,0);
+      if (p == MAP_FAILED) return NULL;
+      char* aligned = (char*)(((uintptr_t)p + SLAB_BYTES - 1) & ~(uintptr_t)(SLAB_BYTES-1));
+      if (aligned > p) munmap(p,aligned-p);
+      const size_t tail = (p + bytes + SLAB_BYTES) - (aligned + bytes);
+      if (tail > 0) munmap(aligned+bytes,tail);
+      #ifdef MADV_HUGEPAGE
+      madvise(aligned,bytes,MADV_HUGEPAGE);
+      #endif
+      return aligned;
+   }
+
+   static void* allocateLarge(const size_t bytes) {
+      const size_t mapped = (bytes + SLAB_BYTES - 1) / SLAB_BYTES * SLAB_BYTES;
+      {
+         lock_guard<mutex> guard(largeLock);
+         for (size_t i=0; i<largeCache.size(); ++i) {
+            if (largeCache[i].bytes != mapped) continue;
+            void* p = largeCache[i].ptr;
+            largeCache.erase(largeCache.begin()+i);
+            largeCachedBytes -= mapped;
+            return p;
+         }
+      }
+      void* p = mapHuge(mapped);
+      if (p != NULL) largeBytes += mapped;
+      return p;
+   }
+
+   static void deallocateLarge(void* ptr,const size_t bytes) {
+      const size_t mapped = (bytes + SLAB_BYTES - 1) / SLAB_BYTES * SLAB_BYTES;
+      if (mapped <= LARGE_CACHE_BYTES) {
+         lock_guard<mutex> guard(largeLock);
+         largeCache.push_back({ptr,mapped});
+         largeCachedBytes += mapped;
+         // Evict the oldest mappings beyond the cache size
+         while (largeCachedBytes > LARGE_CACHE_BYTES) {
+            munmap(largeCache.front().ptr,largeCache.front().bytes);
+            largeBytes -= largeCache.front().bytes;
+            largeCachedBytes -= largeCache.front().bytes;
+            largeCache.erase(largeCache.begin());
+         }
+         return;
+      }
+      munmap(ptr,mapped);
+      largeBytes -= mapped;
+   }
+
+   /*! Move up to half a cache worth of objects of class cls from the shared list, or
+    * from the current slab of the class, into the cache of this thread.*/
+   static void refill(const int cls) {
+      ThreadCache& cache = threadCache;
+      CentralList& list = central[cls];
+      const size_t size = classBytes(cls);
+      const uint32_t batch = (cacheLimit(cls)+1) / 2;
+      ++centralRefills;
+
+      lock_guard<mutex> guard(list.lock);
+      uint32_t moved = 0;
+      while (moved < batch && list.head != NULL) {
+         FreeObject* obj = list.head;
+         list.head = obj->next;
+         obj->next = cache.head[cls];
+         cache.head[cls] = obj;
+         ++moved;
+      }
+      while (moved < batch) {
+         if (list.slabCursor == NULL || list.slabCursor + size > list.slabEnd) {
+            char* slab = (char*)mapHuge(SLAB_BYTES);
+            if (slab == NULL) break;
+            slabBytes += SLAB_BYTES;
+            list.slabCursor = slab;
+            list.slabEnd = slab + SLAB_BYTES;
+         }
+         FreeObject* obj = (FreeObject*)list.slabCursor;
+         list.slabCursor += size;
+         obj->next = cache.head[cls];
+         cache.head[cls] = obj;
+         ++moved;
+      }
+      cache.count[cls] += moved;
+   }
+
+   void* allocate(const size_t bytes) {
+      if (bytes > MAX_CLASS_BYTES) return allocateLarge(bytes);
+
+      const int cls = sizeClass(bytes);
+      ThreadCache& cache = threadCache;
+      if (cache.head[cls] == NULL) {
+         refill(cls);
+         if (cache.head[cls] == NULL) return NULL;
+      }
+      FreeObject* obj = cache.head[cls];
+      cache.head[cls] = obj->next;
+      --cache.count[cls];
+      return obj;
+   }
+
+   void deallocate(void* ptr,const size_t bytes) {
+      if (bytes > MAX_CLASS_BYTES) {
+         deallocateLarge(ptr,bytes);
+         return;
+      }
+
+      const int cls = sizeClass(bytes);
+      ThreadCache& cache = threadCache;
+      FreeObject* obj = (FreeObject*)ptr;
+      obj->next = cache.head[cls];
+      cache.head[cls] = obj;
+      if (++cache.count[cls] <= cacheLimit(cls)) return;
+
+      // Cache is full, return half of it to the shared list
+      CentralList& list = central[cls];
+      const uint32_t batch = cache.count[cls] / 2;
+      lock_guard<mutex> guard(list.lock);
+      for (uint32_t i=0; i<batch; ++i) {
+         FreeObject* moved = cache.head[cls];
+         cache.head[cls] = moved->next;
+         moved->next = list.head;
+         list.head = moved;
+      }
+      cache.count[cls] -= batch;
+   }
+
+   void setHugeTLB(const bool useHugeTLB) {
+      hugeTLB = useHugeTLB;
+   }
+
+   Statistics getStatistics() {
+      Statistics stats;
+      stats.slabBytes = slabBytes;
+      stats.largeBytes = largeBytes;
+      stats.largeCachedBytes = largeCachedBytes;
+      stats.mapCalls = mapCalls.exchange(0);
+      stats.centralRefills = centralRefills.exchange(0);
+      stats.hugeTLB = hugeTLB;
+      stats.hugeTLBFailed = hugeTLBFailed;
+      return stats;
+   }
+}
@@ -0,0 +1,144 @@
+/*
+ * This file is part of Vlasiator.
+ * Copyright 2010-2016 Finnish Meteorological Institute
+ *
+ * For details of usage, see the COPYING file and read the "Rules of the Road"
+ * at http://www.physics.helsinki.fi/vlasiator/
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef BLOCK_POOL_H
+#define BLOCK_POOL_H
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <stdint.h>
+
+/*! Pool allocator for velocity block storage, enabled with -DUSE_BLOCK_POOL.
+ *
+ * Requests up to MAX_CLASS_BYTES are rounded up to one of four size classes per
+ * power of two (at most 25 % waste) and carved from 2 MiB slabs. Each thread keeps
+ * a small free list per size class, so the resizes of block containers in block
+ * adjustment, ghost cell updates and load balancing mostly neither lock nor call
+ * the system allocator. Larger requests are mapped directly in multiples of 2 MiB
+ * and a few recently freed mappings are kept for reuse.
+ *
+ * All mappings are 2 MiB aligned and marked for transparent huge pages, or use
+ * MAP_HUGETLB after setHugeTLB(true) when the node has huge pages reserved. Slab
+ * memory is reused by the pool but not returned to the system.
+ */
+namespace blockpool {
+   const size_t SLAB_BYTES = 2*1024*1024;      /*!< Size and alignment of all mappings.*/
+   const size_t MIN_CLASS_BYTES = 256;         /*!< Smallest size class, all classes are multiples of 64 bytes.*/
+   const size_t MAX_CLASS_BYTES = 1024*1024;   /*!< Larger requests are mapped directly.*/
+
+   struct Statistics {
+      uint64_t slabBytes;        /*!< Bytes mapped as slabs for the size classes.*/
+      uint64_t largeBytes;       /*!< Bytes mapped for large requests, in use or cached.*/
+      uint64_t largeCachedBytes; /*!< Of which freed and kept for reuse.*/
+      uint64_t mapCalls;         /*!< Number of mmap calls since the previous call to getStatistics.*/
+      uint64_t centralRefills;   /*!< Thread cache refills from the shared lists since the previous call.*/
+      bool hugeTLB;              /*!< True if mappings use MAP_HUGETLB.*/
+      bool hugeTLBFailed;        /*!< True if a MAP_HUGETLB mapping failed and the pool fell back to THP.*/
+   };
+
+   /*! Return at least bytes of memory, aligned to 64 bytes and to the largest power of
+    * two dividing the size class. Returns NULL if the memory could not be mapped.*/
+   void* allocate(const size_t bytes);
+
+   /*! Return memory obtained from allocate. bytes has to be the same as in the allocate call.*/
+   void deallocate(void* ptr,const size_t bytes);
+
+   /*! Use MAP_HUGETLB for mappings made after this call, falls back to transparent huge pages if it fails.*/
+   void setHugeTLB(const bool useHugeTLB);
+
+   /*! Return the pool statistics and reset the counters of events.*/
+   Statistics getStatistics();
+}
+
+/*! std::vector allocator drawing from blockpool, same interface and alignment
+ * guarantee as aligned_allocator. The request is padded to at least four times
+ * Alignment, which puts it in a size class whose objects are Alignment aligned.
+ */
+template <typename T, std::size_t Alignment>
+class pool_allocator
+{
+public:
+   typedef T * pointer;
+   typedef const T * const_pointer;
+   typedef T& reference;
+   typedef const T& const_reference;
+   typedef T value_type;
+   typedef std::size_t size_type;
+   typedef ptrdiff_t difference_type;
+
+   T * address(T& r) const {return &r;}
+   const T * address(const T& s) const {return &s;}
+
+   std::size_t max_size() const {
+      return (static_cast<std::size_t>(0) - static_cast<std::size_t>(1)) / sizeof(T);
+   }
+
+   template <typename U>
+   struct rebind
+   {
+      typedef pool_allocator<U, Alignment> other;
+   };
+
+   bool operator!=(const pool_allocator& other) const {return !(*this == other);}
+   bool operator==(const pool_allocator& other) const {return true;}
+
+   void construct(T * const p, const T& t) const {
+      void * const pv = static_cast<void *>(p);
+      new (pv) T(t);
+   }
+   void destroy(T * const p) const {p->~T();}
+
+   pool_allocator() { }
+   pool_allocator(const pool_allocator&) { }
+   template <typename U> pool_allocator(const pool_allocator<U, Alignment>&) { }
+   ~pool_allocator() { }
+
+   T * allocate(const std::size_t n) const {
+      if (n == 0) return NULL;
+      if (n > max_size()) {
+         throw std::length_error("pool_allocator<T>::allocate() - Integer overflow.");
+      }
+      void * const pv = blockpool::allocate(paddedBytes(n));
+      if (pv == NULL) throw std::bad_alloc();
+      return static_cast<T *>(pv);
+   }
+
+   void deallocate(T * const p, const std::size_t n) const {
+      if (p == NULL) return;
+      blockpool::deallocate(p,paddedBytes(n));
+   }
+
+   template <typename U>
+   T * allocate(const std::size_t n, const U * /* const hint */) const {
+      return allocate(n);
+   }
+
+private:
+   static std::size_t paddedBytes(const std::size_t n) {
+      const std::size_t bytes = n*sizeof(T);
+      return bytes < 4*Alignment ? 4*Alignment : bytes;
+   }
+
+   pool_allocator& operator=(const pool_allocator&);
+};
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * This file is part of Vlasiator.
+ * Copyright 2010-2016 Finnish Meteorological Institute
+ *
+ * For details of usage, see the COPYING file and read the "Rules of the Road"
+ * at http://www.physics.helsinki.fi/vlasiator/
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <phiprof.hpp>
+
+#include "cell_affinity.h"
+#include "logger.h"
+#include "object_wrapper.h"
+
+using namespace std;
+using namespace spatial_cell;
+
+extern Logger logFile;
+
+namespace cellaffinity {
+   namespace detail {
+      std::atomic<uint64_t> processedCells(0);
+      std::atomic<uint64_t> stolenCells(0);
+   }
+
+   void assignHomeThreads(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid) {
+      if (Parameters::threadAffinity == false) return;
+      phiprof::start("Assign home threads");
+
+      const vector<CellID>& cells = getLocalCells();
+      const uint nPops = getObjectWrapper().particleSpecies.size();
+      const int nThreads = omp_get_max_threads();
+
+      // Weight of a cell is its number of blocks, plus one so that empty cells are spread too
+      vector<uint64_t> weights(cells.size());
+      uint64_t totalWeight = 0;
+      for (size_t c=0; c<cells.size(); ++c) {
+         weights[c] = 1;
+         for (uint popID=0; popID<nPops; ++popID) weights[c] += mpiGrid[cells[c]]->get_number_of_velocity_blocks(popID);
+         totalWeight += weights[c];
+      }
+
+      // Contiguous chunks of the local cell list, spatially compact if loadBalance.cellOrder is a curve
+      vector<uint64_t> threadWeights(nThreads,0);
+      uint64_t cumulative = 0;
+      for (size_t c=0; c<cells.size(); ++c) {
+         const uint home = min<uint64_t>((cumulative + weights[c]/2) * nThreads / max<uint64_t>(totalWeight,1),nThreads-1);
+         mpiGrid[cells[c]]->homeThread = home;
+         threadWeights[home] += weights[c];
+         cumulative += weights[c];
+      }
+
+      // Copy the block data on the home thread so that its pages are first touched there
+      #pragma omp parallel
+      {
+         const uint thread = omp_get_thread_num();
+         for (size_t c=0; c<cells.size(); ++c) {
+            SpatialCell* cell = mpiGrid[cells[c]];
+            if (cell->homeThread != thread) continue;
+            for (uint popID=0; popID<nPops; ++popID) {
+               vmesh::VelocityBlockContainer<vmesh::LocalID>& blockContainer = cell->get_velocity_blocks(popID);
+               if (blockContainer.size() == 0) continue;
+               vmesh::VelocityBlockContainer<vmesh::LocalID> homeCopy(blockContainer);
+               blockContainer.swap(homeCopy);
+            }
+         }
+      }
+
+      const uint64_t maxWeight = *max_element(threadWeights.begin(),threadWeights.end());
+      const uint64_t processed = detail::processedCells.exchange(0);
+      const uint64_t stolen = detail::stolenCells.exchange(0);
+      logFile << "(AFFINITY): Block imbalance between home threads (max/average) ";
+      logFile << (totalWeight > 0 ? (double)maxWeight*nThreads/totalWeight : 1.0);
+      if (processed > 0) {
+         logFile << ", " << 100.0*stolen/processed << "% of cell updates were stolen since the previous assignment";
+      }
+      logFile << endl << writeVerbose;
+
+      phiprof::stop("Assign home threads");
+   }
+}
@@ -0,0 +1,121 @@
+/*
+ * This file is part of Vlasiator.
+ * Copyright 2010-2016 Finnish Meteorological Institute
+ *
+ * For details of usage, see the COPYING file and read the "Rules of the Road"
+ * at http://www.physics.helsinki.fi/vlasiator/
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef CELL_AFFINITY_H
+#define CELL_AFFINITY_H
+
+#include <atomic>
+#include <vector>
+#include <omp.h>
+#include <dccrg.hpp>
+#include <dccrg_cartesian_geometry.hpp>
+
+#include "definitions.h"
+#include "memoryallocation.h"
+#include "parameters.h"
+#include "spatial_cell.hpp"
+
+/*! Thread affinity of spatial cells (loadBalance.threadAffinity).
+ *
+ * Every local cell is given a home OpenMP thread so that the threads own contiguous
+ * chunks of the local cell list with about equal numbers of velocity blocks. After each
+ * repartition the block data of each cell is copied on its home thread, so that with
+ * pinned threads the pages are first touched, and thus placed, on the NUMA domain of
+ * that thread. The heavy per-cell loops go through forEachCell, which runs every cell on
+ * its home thread and lets threads that run out of own cells steal from the others,
+ * starting from the neighbouring thread numbers which usually share the NUMA domain.
+ * Block data that grows later (block adjustment) is then also mostly allocated by the
+ * home thread.
+ */
+namespace cellaffinity {
+   namespace detail {
+      extern std::atomic<uint64_t> processedCells; /*!< Cells processed by forEachCell since the last report.*/
+      extern std::atomic<uint64_t> stolenCells;    /*!< Of which processed by another thread than their home thread.*/
+
+      // One cache line per counter, so that threads taking cells from different queues do not share lines
+      struct alignas(64) QueueCounter {
+         std::atomic<size_t> next;
+      };
+   }
+
+   /*! Assign home threads to the local cells and copy their block data on the home thread.
+    * Logs the block balance between threads and the fraction of stolen cell updates since
+    * the previous call. Does nothing unless loadBalance.threadAffinity is set.
+    * \param mpiGrid Spatial grid
+    */
+   void assignHomeThreads(dccrg::Dccrg<spatial_cell::SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid);
+
+   /*! OpenMP schedule of forEachCell when loadBalance.threadAffinity is not set.*/
+   enum Schedule {
+      STATIC,  /*!< Static schedule, for loops with about equal work per cell.*/
+      DYNAMIC  /*!< Dynamic schedule with one cell per chunk, for loops with uneven work per cell.*/
+   };
+
+   /*! Call fn(c) for every index c of cells, in parallel. With loadBalance.threadAffinity
+    * every cell is run on its home thread unless its home thread is still busy when another
+    * thread runs out of work, otherwise this is a parallel loop with the given schedule.
+    * Has to be called outside of parallel regions.
+    * \param mpiGrid Spatial grid
+    * \param cells Local cells to process
+    * \param schedule Schedule of the loop without thread affinity
+    * \param fn Function called with the index of the cell in cells
+    */
+   template<typename F> void forEachCell(dccrg::Dccrg<spatial_cell::SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+                                         const std::vector<CellID>& cells,const Schedule schedule,F fn) {
+      const int nThreads = omp_get_max_threads();
+      if (Parameters::threadAffinity == false || nThreads == 1) {
+         if (schedule == DYNAMIC) {
+            #pragma omp parallel for schedule(dynamic,1)
+            for (size_t c=0; c<cells.size(); ++c) fn(c);
+         } else {
+            #pragma omp parallel for
+            for (size_t c=0; c<cells.size(); ++c) fn(c);
+         }
+         return;
+      }
+
+      std::vector<std::vector<size_t> > queues(nThreads);
+      for (size_t c=0; c<cells.size(); ++c) {
+         const uint home = mpiGrid[cells[c]]->homeThread;
+         queues[home < (uint)nThreads ? home : nThreads-1].push_back(c);
+      }
+      std::vector<detail::QueueCounter,aligned_allocator<detail::QueueCounter,64> > counters(nThreads);
+      for (int t=0; t<nThreads; ++t) counters[t].next = 0;
+
+      uint64_t stolen = 0;
+      #pragma omp parallel reduction(+:stolen)
+      {
+         const int thread = omp_get_thread_num();
+         for (int offset=0; offset<nThreads; ++offset) {
+            const int owner = (thread + offset) % nThreads;
+            const std::vector<size_t>& queue = queues[owner];
+            for (size_t i = counters[owner].next++; i < queue.size(); i = counters[owner].next++) {
+               fn(queue[i]);
+               if (offset > 0) ++stolen;
+            }
+         }
+      }
+      detail::processedCells += cells.size();
+      detail::stolenCells += stolen;
+   }
+}
+
+#endif
@@ -0,0 +1,153 @@
+/*
+ * This file is part of Vlasiator.
+ * Copyright 2010-2016 Finnish Meteorological Institute
+ *
+ * For details of usage, see the COPYING file and read the "Rules of the Road"
+ * at http://www.physics.helsinki.fi/vlasiator/
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <unordered_map>
+#include <phiprof.hpp>
+
+#include "cell_order.h"
+#include "common.h"
+#include "logger.h"
+#include "parameters.h"
+
+using namespace std;
+using namespace spatial_cell;
+
+extern Logger logFile;
+
+namespace cellorder {
+
+   /*! Spread the lowest 21 bits of x to every third bit.*/
+   static inline uint64_t spreadBits(uint64_t x) {
+      x &= 0x1fffff;
+      x = (x | x << 32) & 0x1f00000000ffffULL;
+      x = (x | x << 16) & 0x1f0000ff0000ffULL;
+      x = (x | x << 8)  & 0x100f00f00f00f00fULL;
+      x = (x | x << 4)  & 0x10c30c30c30c30c3ULL;
+      x = (x | x << 2)  & 0x1249249249249249ULL;
+      return x;
+   }
+
+   static inline uint64_t mortonKey(const uint64_t i,const uint64_t j,const uint64_t k) {
+      return spreadBits(i) | spreadBits(j) << 1 | spreadBits(k) << 2;
+   }
+
+   /*! Hilbert key of (i,j,k) with bits bits per coordinate, using Skilling's transpose
+    * algorithm (AIP Conf. Proc. 707, 381 (2004)) followed by bit interleaving.*/
+   static inline uint64_t hilbertKey(const uint64_t i,const uint64_t j,const uint64_t k,const int bits) {
+      uint64_t x[3] = {i,j,k};
+      const uint64_t top = (uint64_t)1 << (bits-1);
+
+      // Inverse undo of the excess work
+      for (uint64_t q=top; q>1; q>>=1) {
+         const uint64_t p = q-1;
+         for (int d=0; d<3; ++d) {
+            if (x[d] & q) {
+               x[0] ^= p;
+            } else {
+               const uint64_t t = (x[0] ^ x[d]) & p;
+               x[0] ^= t;
+               x[d] ^= t;
+            }
+         }
+      }
+
+      // Gray encode
+      x[1] ^= x[0];
+      x[2] ^= x[1];
+      uint64_t t = 0;
+      for (uint64_t q=top; q>1; q>>=1) {
+         if (x[2] & q) t ^= q-1;
+      }
+      for (int d=0; d<3; ++d) x[d] ^= t;
+
+      // x[0] holds the most significant bit of each triplet
+      return spreadBits(x[2]) | spreadBits(x[1]) << 1 | spreadBits(x[0]) << 2;
+   }
+
+   void sortCells(const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+                  std::vector<CellID>& cells) {
+      if (Parameters::cellOrder == cellorder::DCCRG) {
+         sort(cells.begin(),cells.end());
+         return;
+      }
+
+      // Indices are in units of the finest refinement level, so refined and
+      // unrefined cells share one curve
+      const int maxRefLvl = mpiGrid.mapping.get_maximum_refinement_level();
+      const uint64_t extent = max(max((uint64_t)Parameters::xcells_ini,(uint64_t)Parameters::ycells_ini),(uint64_t)Parameters::zcells_ini) << maxRefLvl;
+      int bits = 1;
+      while (((uint64_t)1 << bits) < extent) ++bits;
+      if (bits > 21) {
+         cerr << "(CELLORDER) ERROR: grid of " << extent << " finest cells per dimension does not fit in a 63-bit curve key" << endl;
+         abort();
+      }
+
+      vector<pair<uint64_t,CellID> > keys(cells.size());
+      #pragma omp parallel for
+      for (size_t c=0; c<cells.size(); ++c) {
+         const dccrg::Types<3>::indices_t indices = mpiGrid.mapping.get_indices(cells[c]);
+         if (Parameters::cellOrder == cellorder::MORTON) {
+            keys[c].first = mortonKey(indices[0],indices[1],indices[2]);
+         } else {
+            keys[c].first = hilbertKey(indices[0],indices[1],indices[2],bits);
+         }
+         keys[c].second = cells[c];
+      }
+      sort(keys.begin(),keys.end());
+      for (size_t c=0; c<cells.size(); ++c) cells[c] = keys[c].second;
+   }
+
+   /*! Mean distance in cells between a cell and its local nearest neighbours.*/
+   static double meanNeighborDistance(const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+                                      const vector<CellID>& cells) {
+      unordered_map<CellID,size_t> position;
+      position.reserve(cells.size());
+      for (size_t c=0; c<cells.size(); ++c) position[cells[c]] = c;
+
+      double distance = 0.0;
+      uint64_t pairs = 0;
+      for (size_t c=0; c<cells.size(); ++c) {
+         const auto* neighbors = mpiGrid.get_neighbors_of(cells[c],NEAREST_NEIGHBORHOOD_ID);
+         if (neighbors == NULL) continue;
+         for (const auto& nbrPair : *neighbors) {
+            const auto it = position.find(nbrPair.first);
+            if (it == position.end() || it->second == c) continue;
+            distance += it->second > c ? it->second - c : c - it->second;
+            ++pairs;
+         }
+      }
+      return pairs > 0 ? distance/pairs : 0.0;
+   }
+
+   void reportLocality(const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid) {
+      if (Parameters::cellOrder == cellorder::DCCRG) return;
+      phiprof::start("Cell order locality");
+      const vector<CellID>& cells = getLocalCells();
+      vector<CellID> idOrder(cells);
+      sort(idOrder.begin(),idOrder.end());
+      logFile << "(CELLORDER): Mean list distance of local nearest neighbours " << meanNeighborDistance(mpiGrid,cells);
+      logFile << " (" << meanNeighborDistance(mpiGrid,idOrder) << " in cell ID order)" << endl << writeVerbose;
+      phiprof::stop("Cell order locality");
+   }
+}
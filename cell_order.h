@@ -0,0 +1,56 @@
+/*
+ * This file is part of Vlasiator.
+ * Copyright 2010-2016 Finnish Meteorological Institute
+ *
+ * For details of usage, see the COPYING file and read the "Rules of the Road"
+ * at http://www.physics.helsinki.fi/vlasiator/
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef CELL_ORDER_H
+#define CELL_ORDER_H
+
+#include <vector>
+#include <dccrg.hpp>
+#include <dccrg_cartesian_geometry.hpp>
+
+#include "definitions.h"
+#include "spatial_cell.hpp"
+
+/*! Space-filling curve order of the local cell list (loadBalance.cellOrder).
+ *
+ * dccrg returns the local cells in cell ID order, which walks x-rows, so the y and z
+ * neighbours of a cell are a whole row or plane away in the list. Ordering the list
+ * along a Morton or Hilbert curve keeps spatial neighbours close in the list, and thus
+ * in the per-block cell loops of the translation, in the static chunks of the cell
+ * loops and in the home thread segments of cell_affinity.h.
+ */
+namespace cellorder {
+
+   /*! Sort cells along the curve selected by loadBalance.cellOrder, or by cell ID for dccrg order.
+    * \param mpiGrid Spatial grid
+    * \param cells Cells to sort, local or remote
+    */
+   void sortCells(const dccrg::Dccrg<spatial_cell::SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+                  std::vector<CellID>& cells);
+
+   /*! Log the mean distance in the local cell list between a cell and its local nearest
+    * neighbours, for the current order and for cell ID order. Does nothing in dccrg order.
+    * \param mpiGrid Spatial grid
+    */
+   void reportLocality(const dccrg::Dccrg<spatial_cell::SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid);
+}
+
+#endif
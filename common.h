@@ -386,10 +386,20 @@ RK_ORDER2_STEP1,   /*!< Two-step second order method, first step */
 RK_ORDER2_STEP2    /*!< Two-step second order method, second step */
 };
 
-const int WID = 4;         /*!< Number of cells per coordinate in a velocity block. Only a value of 4 supported by vectorized Leveque solver */
+#ifndef VELOCITY_BLOCK_WIDTH
+#define VELOCITY_BLOCK_WIDTH 4
+#endif
+const int WID = VELOCITY_BLOCK_WIDTH; /*!< Number of cells per coordinate in a velocity block, set at build time with BLOCK_WIDTH in the Makefile. */
 const int WID2 = WID*WID;  /*!< Number of cells per 2D slab in a velocity block. */
 const int WID3 = WID2*WID; /*!< Number of cells in a velocity block. */
 
+/*! Type of the cell indices within a velocity block stored in the transposition tables of the solvers. */
+#if VELOCITY_BLOCK_WIDTH <= 6
+typedef unsigned char BlockCellIndex;
+#else
+typedef uint16_t BlockCellIndex;
+#endif
+
 /*!
 Get the cellindex in the velocity space block
 */
@@ -0,0 +1,116 @@
+/*
+ * This file is part of Vlasiator.
+ * Copyright 2010-2016 Finnish Meteorological Institute
+ *
+ * For details of usage, see the COPYING file and read the "Rules of the Road"
+ * at http://www.physics.helsinki.fi/vlasiator/
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "control_channel.h"
+
+using namespace std;
+
+namespace controlchannel {
+   namespace detail {
+      std::atomic<bool> pending(false);
+   }
+
+   static int socketFd = -1;
+   static string socketPath;
+   static thread* listener = NULL;
+   static atomic<bool> running(false);
+   static mutex queueLock;
+   static vector<string> queue;
+
+   /*! Listener thread, the poll timeout only bounds the time close() waits for it.*/
+   static void listen() {
+      char buffer[1024];
+      while (running) {
+         struct pollfd pfd;
+         pfd.fd = socketFd;
+         pfd.events = POLLIN;
+         if (poll(&pfd,1,500) <= 0) continue;
+         const ssize_t length = recv(socketFd,buffer,sizeof(buffer)-1,0);
+         if (length <= 0) continue;
+         buffer[length] = '\0';
+
+         istringstream lines(buffer);
+         string line;
+         lock_guard<mutex> guard(queueLock);
+         while (getline(lines,line)) {
+            const size_t first = line.find_first_not_of(" \t\r");
+            if (first == string::npos) continue;
+            const size_t last = line.find_last_not_of(" \t\r");
+            queue.push_back(line.substr(first,last-first+1));
+            detail::pending.store(true,memory_order_release);
+         }
+      }
+   }
+
+   bool open(const std::string& path) {
+      struct sockaddr_un address;
+      if (path.size() >= sizeof(address.sun_path)) return false;
+      memset(&address,0,sizeof(address));
+      address.sun_family = AF_UNIX;
+      strncpy(address.sun_path,path.c_str(),sizeof(address.sun_path)-1);
+
+      socketFd = socket(AF_UNIX,SOCK_DGRAM,0);
+      if (socketFd < 0) return false;
+      unlink(path.c_str());
+      if (bind(socketFd,(struct sockaddr*)&address,sizeof(address)) != 0) {
+         ::close(socketFd);
+         socketFd = -1;
+         return false;
+      }
+      socketPath = path;
+      running = true;
+      listener = new thread(listen);
+      return true;
+   }
+
+   void close() {
+      if (socketFd < 0) return;
+      running = false;
+      listener->join();
+      delete listener;
+      listener = NULL;
+      ::close(socketFd);
+      socketFd = -1;
+      unlink(socketPath.c_str());
+   }
+
+   bool isOpen() {
+      return socketFd >= 0;
+   }
+
+   std::vector<std::string> receive() {
+      vector<string> commands;
+      lock_guard<mutex> guard(queueLock);
+      commands.swap(queue);
+      detail::pending.store(false,memory_order_release);
+      return commands;
+   }
+}
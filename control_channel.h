@@ -0,0 +1,62 @@
+/*
+ * This file is part of Vlasiator.
+ * Copyright 2010-2016 Finnish Meteorological Institute
+ *
+ * For details of usage, see the COPYING file and read the "Rules of the Road"
+ * at http://www.physics.helsinki.fi/vlasiator/
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef CONTROL_CHANNEL_H
+#define CONTROL_CHANNEL_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+/*! Runtime control channel of the master process (io.control_socket).
+ *
+ * A helper thread waits on a Unix domain datagram socket and queues the received
+ * commands, one per line, e.g.
+ *    echo SAVE | socat - UNIX-SENDTO:vlasiator.ctl
+ * The time loop only reads an atomic flag to see whether anything has arrived, so
+ * unlike polling for command files it does no system calls on steps without commands.
+ */
+namespace controlchannel {
+   namespace detail {
+      extern std::atomic<bool> pending; /*!< True if commands are waiting in the queue.*/
+   }
+
+   /*! Bind the socket and start the listener thread. Only called on the master process.
+    * \param path File system path of the socket, an existing socket file is replaced.
+    * \return If true, the channel is open.*/
+   bool open(const std::string& path);
+
+   /*! Stop the listener thread and remove the socket file.*/
+   void close();
+
+   /*! Return true if the channel is open.*/
+   bool isOpen();
+
+   /*! Return true if commands have been received since the last call to receive.*/
+   inline bool pending() {
+      return detail::pending.load(std::memory_order_acquire);
+   }
+
+   /*! Return the received commands in arrival order and empty the queue.*/
+   std::vector<std::string> receive();
+}
+
+#endif
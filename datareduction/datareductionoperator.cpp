@@ -1571,4 +1571,163 @@ namespace DRO {
       return true;
    }
 
+   /*! \brief Velocity space slices
+    * Bins the distribution function of every cellStride'th cell (by cell ID, like
+    * systemWriteDistributionWriteStride) onto a resolution x resolution grid spanning
+    * [-halfWidth,halfWidth] around the population bulk velocity. The plane is spanned by
+    * (b, v_perp1) in the B frame, where v_perp1 is along the perpendicular bulk velocity, or by
+    * two simulation axes. With thickness 0 the whole distribution is projected onto the plane
+    * (column phase-space density, s^2/m^5), otherwise only the slab |v_normal| < thickness/2 is
+    * kept and the result is the mean phase-space density of the slab (s^3/m^6).
+    * Parameters that can be set in cfg file under [{species}_vslice]:
+    *    - cellStride [default: 0, disabled],
+    *    - resolution [bins per dimension, default: 64],
+    *    - halfWidth [m/s, default: 2e6],
+    *    - thickness [m/s, default: 0],
+    *    - frame [B, xy, xz or yz, default: B].
+    * Written arrays (all with attributes mesh and name):
+    *    - VELOCITYSLICECELLS, the cell IDs,
+    *    - VELOCITYSLICEBASIS, the 3 unit vectors of the plane axes and normal,
+    *    - VELOCITYSLICE, resolution*resolution floats per cell, first axis running fastest.
+    */
+   VariableVelocitySlice::VariableVelocitySlice(cuint _popID): DataReductionOperatorHandlesWriting(),popID(_popID) {
+      const species::Species& species = getObjectWrapper().particleSpecies[popID];
+      popName = species.name;
+      cellStride = species.vsliceCellStride;
+      resolution = species.vsliceResolution;
+      halfWidth = species.vsliceHalfWidth;
+      thickness = species.vsliceThickness;
+      frame = species.vsliceFrame;
+   }
+   VariableVelocitySlice::~VariableVelocitySlice() { }
+   
+   std::string VariableVelocitySlice::getName() const {return popName + "/VelocitySlice";}
+   
+   bool VariableVelocitySlice::getDataVectorInfo(std::string& dataType,unsigned int& dataSize,unsigned int& vectorSize) const {
+      return true;
+   }
+   
+   bool VariableVelocitySlice::setSpatialCell(const SpatialCell* cell) {return true;}
+
+   /*! Unit vectors of the two slice axes and the plane normal, basis[0..2], basis[3..5] and basis[6..8].*/
+   void VariableVelocitySlice::getBasis(const SpatialCell* cell,Real* basis) const {
+      for (int i=0; i<9; ++i) basis[i] = 0.0;
+      if (frame == "xy") { basis[0] = 1.0; basis[4] = 1.0; basis[8] = 1.0; return; }
+      if (frame == "xz") { basis[0] = 1.0; basis[5] = 1.0; basis[7] = 1.0; return; }
+      if (frame == "yz") { basis[1] = 1.0; basis[5] = 1.0; basis[6] = 1.0; return; }
+
+      Real b[3];
+      b[0] = cell->parameters[CellParams::PERBXVOL] + cell->parameters[CellParams::BGBXVOL];
+      b[1] = cell->parameters[CellParams::PERBYVOL] + cell->parameters[CellParams::BGBYVOL];
+      b[2] = cell->parameters[CellParams::PERBZVOL] + cell->parameters[CellParams::BGBZVOL];
+      Real norm = sqrt(b[0]*b[0] + b[1]*b[1] + b[2]*b[2]);
+      if (norm == 0.0) {
+         // No field, fall back to the xy plane
+         basis[0] = 1.0; basis[4] = 1.0; basis[8] = 1.0;
+         return;
+      }
+      for (int i=0; i<3; ++i) b[i] /= norm;
+
+      // v_perp1 is along the bulk velocity component perpendicular to B, or along the
+      // simulation axis least aligned with B if the bulk flow is (nearly) field-aligned
+      const Real* V = cell->get_population(popID).V;
+      Real vpar = V[0]*b[0] + V[1]*b[1] + V[2]*b[2];
+      Real p[3];
+      for (int i=0; i<3; ++i) p[i] = V[i] - vpar*b[i];
+      norm = sqrt(p[0]*p[0] + p[1]*p[1] + p[2]*p[2]);
+      if (norm <= 1.0e-3*sqrt(V[0]*V[0] + V[1]*V[1] + V[2]*V[2]) || norm == 0.0) {
+         int axis = 0;
+         if (fabs(b[1]) < fabs(b[axis])) axis = 1;
+         if (fabs(b[2]) < fabs(b[axis])) axis = 2;
+         for (int i=0; i<3; ++i) p[i] = -b[axis]*b[i];
+         p[axis] += 1.0;
+         norm = sqrt(p[0]*p[0] + p[1]*p[1] + p[2]*p[2]);
+      }
+      for (int i=0; i<3; ++i) p[i] /= norm;
+
+      for (int i=0; i<3; ++i) {
+         basis[i] = b[i];
+         basis[3+i] = p[i];
+      }
+      basis[6] = b[1]*p[2] - b[2]*p[1];
+      basis[7] = b[2]*p[0] - b[0]*p[2];
+      basis[8] = b[0]*p[1] - b[1]*p[0];
+   }
+
+   /*! Deposits the phase-space density of each velocity cell into the slice bin containing its centre.*/
+   void VariableVelocitySlice::binDistribution(const SpatialCell* cell,const Real* basis,float* slice) const {
+      const Real HALF = 0.5;
+      const Real dBin = 2.0*halfWidth/resolution;
+      const Real halfThickness = HALF*thickness;
+      const Real* V = cell->get_population(popID).V;
+      const Real* parameters = cell->get_block_parameters(popID);
+      const Realf* block_data = cell->get_data(popID);
+
+      std::vector<Real> sums(resolution*resolution,0.0);
+      for (vmesh::LocalID n=0; n<cell->get_number_of_velocity_blocks(popID); n++) {
+         const Real* blockParams = parameters + n*BlockParams::N_VELOCITY_BLOCK_PARAMS;
+         const Real DV3 = blockParams[BlockParams::DVX]*blockParams[BlockParams::DVY]*blockParams[BlockParams::DVZ];
+         for (uint k = 0; k < WID; ++k) for (uint j = 0; j < WID; ++j) for (uint i = 0; i < WID; ++i) {
+            const Real f = block_data[n*SIZE_VELBLOCK + cellIndex(i,j,k)];
+            if (f == 0.0) continue;
+            const Real VX = blockParams[BlockParams::VXCRD] + (i + HALF)*blockParams[BlockParams::DVX] - V[0];
+            const Real VY = blockParams[BlockParams::VYCRD] + (j + HALF)*blockParams[BlockParams::DVY] - V[1];
+            const Real VZ = blockParams[BlockParams::VZCRD] + (k + HALF)*blockParams[BlockParams::DVZ] - V[2];
+            if (thickness > 0.0 && fabs(VX*basis[6] + VY*basis[7] + VZ*basis[8]) >= halfThickness) continue;
+
+            const Real v1 = VX*basis[0] + VY*basis[1] + VZ*basis[2] + halfWidth;
+            const Real v2 = VX*basis[3] + VY*basis[4] + VZ*basis[5] + halfWidth;
+            if (v1 < 0.0 || v2 < 0.0) continue;
+            const int i1 = static_cast<int>(v1/dBin);
+            const int i2 = static_cast<int>(v2/dBin);
+            if (i1 >= resolution || i2 >= resolution) continue;
+            sums[i2*resolution + i1] += f*DV3;
+         }
+      }
+
+      const Real norm = (thickness > 0.0) ? 1.0/(dBin*dBin*thickness) : 1.0/(dBin*dBin);
+      for (int b=0; b<resolution*resolution; ++b) slice[b] = sums[b]*norm;
+   }
+
+   bool VariableVelocitySlice::writeData(const dccrg::Dccrg<spatial_cell::SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+                                         const std::vector<CellID>& cells,const std::string& meshName,
+                                         vlsv::Writer& vlsvWriter) {
+      if (cellStride <= 0) return true;
+
+      std::vector<uint64_t> sliceCells;
+      std::vector<const SpatialCell*> sliceCellPointers;
+      for (size_t c=0; c<cells.size(); ++c) {
+         if (cells[c] % cellStride != 0) continue;
+         const SpatialCell* cell = mpiGrid[cells[c]];
+         if (cell->sysBoundaryFlag == sysboundarytype::DO_NOT_COMPUTE) continue;
+         sliceCells.push_back(cells[c]);
+         sliceCellPointers.push_back(cell);
+      }
+
+      // Cells are independent, so the slices are binned in parallel into their own slots
+      const size_t sliceSize = resolution*resolution;
+      std::vector<Real> basis(9*sliceCells.size());
+      std::vector<float> slices(sliceSize*sliceCells.size());
+      #pragma omp parallel for schedule(dynamic,1)
+      for (size_t c=0; c<sliceCellPointers.size(); ++c) {
+         getBasis(sliceCellPointers[c],basis.data() + 9*c);
+         binDistribution(sliceCellPointers[c],basis.data() + 9*c,slices.data() + sliceSize*c);
+      }
+
+      map<string,string> attribs;
+      attribs["mesh"] = meshName;
+      attribs["name"] = getName();
+      attribs["frame"] = frame;
+      attribs["resolution"] = std::to_string(resolution);
+      attribs["halfwidth"] = std::to_string(halfWidth);
+      attribs["thickness"] = std::to_string(thickness);
+
+      bool success = true;
+      if (vlsvWriter.writeArray("VELOCITYSLICECELLS",attribs,sliceCells.size(),1,sliceCells.data()) == false) success = false;
+      if (vlsvWriter.writeArray("VELOCITYSLICEBASIS",attribs,sliceCells.size(),9,basis.data()) == false) success = false;
+      if (vlsvWriter.writeArray("VELOCITYSLICE",attribs,sliceCells.size(),sliceSize,slices.data()) == false) success = false;
+      if (success == false) cerr << "ERROR failed to write velocity slices of " << popName << endl;
+      return success;
+   }
+
 } // namespace DRO
@@ -547,6 +547,32 @@ namespace DRO {
       Real lossConeAngle;
       std::vector<Real> channels, dataDiffFlux;
    };
+
+   // 2D velocity space slices of selected cells, written as fixed-size arrays
+   class VariableVelocitySlice: public DataReductionOperatorHandlesWriting {
+   public:
+      VariableVelocitySlice(cuint popID);
+      virtual ~VariableVelocitySlice();
+      
+      virtual bool getDataVectorInfo(std::string& dataType,unsigned int& dataSize,unsigned int& vectorSize) const;
+      virtual std::string getName() const;
+      virtual bool setSpatialCell(const SpatialCell* cell);
+      virtual bool writeData(const dccrg::Dccrg<spatial_cell::SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+                             const std::vector<CellID>& cells,const std::string& meshName,
+                             vlsv::Writer& vlsvWriter);
+      
+   protected:
+      void getBasis(const SpatialCell* cell,Real* basis) const;
+      void binDistribution(const SpatialCell* cell,const Real* basis,float* slice) const;
+      
+      uint popID;
+      std::string popName;
+      int cellStride;
+      int resolution;
+      Real halfWidth;
+      Real thickness;
+      std::string frame;
+   };
 } // namespace DRO
 
 #endif
@@ -67,6 +67,15 @@ namespace geometry {
    };
 }
 
+/** Order of the local cell list, see cell_order.h.*/
+namespace cellorder {
+   enum Curve {
+      DCCRG,           /**< Cell ID order as returned by dccrg (default).*/
+      MORTON,          /**< Morton (Z-order) curve.*/
+      HILBERT          /**< Hilbert curve.*/
+   };
+}
+
 namespace vmesh {
    #ifndef AMR
    typedef uint32_t GlobalID;              /**< Datatype used for velocity block global IDs.*/
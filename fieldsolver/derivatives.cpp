@@ -26,21 +26,20 @@
 #include "derivatives.hpp"
 #include "fs_limiters.h"
 
-/*! \brief Low-level spatial derivatives calculation.
+/*! \brief Low-level spatial derivatives calculation of a cell whose derivatives are all computed.
  * 
- * For the cell with ID cellID calculate the spatial derivatives or apply the derivative boundary conditions defined in project.h. Uses RHO, V[XYZ] and B[XYZ] in the first-order time accuracy method and in the second step of the second-order method, and RHO_DT2, V[XYZ]1 and B[XYZ]1 in the first step of the second-order method.
+ * Used for the interior (NOT_SYSBOUNDARY) cells and for the first layer of system boundary cells,
+ * does not look at the boundary flags. Uses RHO, V[XYZ] and B[XYZ] in the first-order time accuracy method and in the second step of the second-order method, and RHO_DT2, V[XYZ]1 and B[XYZ]1 in the first step of the second-order method.
  * \param i,j,k fsGrid cell coordinates for the current cell
  * \param perBGrid fsGrid holding the perturbed B quantities
  * \param momentsGrid fsGrid holding the moment quantities
  * \param dPerBGrid fsGrid holding the derivatives of perturbed B
  * \param dMomentsGrid fsGrid holding the derviatives of moments
- * \param technicalGrid fsGrid holding technical information (such as boundary types)
- * \param sysBoundaries System boundary conditions existing
- * \param RKCase Element in the enum defining the Runge-Kutta method steps
+ * \param secondDerivatives If false, the second and mixed derivatives of B are set to zero.
  * 
- * \sa calculateDerivativesSimple calculateBVOLDerivativesSimple calculateBVOLDerivatives
+ * \sa calculateDerivatives calculateDerivativesSimple
  */
-void calculateDerivatives(
+static inline void calculateComputedDerivatives(
    cint i,
    cint j,
    cint k,
@@ -48,218 +47,189 @@ void calculateDerivatives(
    FsGrid< std::array<Real, fsgrids::moments::N_MOMENTS>, 2> & momentsGrid,
    FsGrid< std::array<Real, fsgrids::dperb::N_DPERB>, 2> & dPerBGrid,
    FsGrid< std::array<Real, fsgrids::dmoments::N_DMOMENTS>, 2> & dMomentsGrid,
-   FsGrid< fsgrids::technical, 2> & technicalGrid,
-   SysBoundary& sysBoundaries,
-   cint& RKCase
+   const bool secondDerivatives
 ) {
-   std::array<Real, fsgrids::dperb::N_DPERB> * dPerB = dPerBGrid.get(i,j,k);
-   std::array<Real, fsgrids::dmoments::N_DMOMENTS> * dMoments = dMomentsGrid.get(i,j,k);
+   FsCell<fsgrids::dperb::N_DPERB> dPerB = fsCell(dPerBGrid,i,j,k);
+   FsCell<fsgrids::dmoments::N_DMOMENTS> dMoments = fsCell(dMomentsGrid,i,j,k);
 
-   // Get boundary flag for the cell:
-   cuint sysBoundaryFlag  = technicalGrid.get(i,j,k)->sysBoundaryFlag;
-   cuint sysBoundaryLayer = technicalGrid.get(i,j,k)->sysBoundaryLayer;
-   
-   std::array<Real, fsgrids::moments::N_MOMENTS> * leftMoments = NULL;
-   std::array<Real, fsgrids::bfield::N_BFIELD> * leftPerB = NULL;
-   std::array<Real, fsgrids::moments::N_MOMENTS> * centMoments = momentsGrid.get(i,j,k);
-   std::array<Real, fsgrids::bfield::N_BFIELD> * centPerB = perBGrid.get(i,j,k);
+   FsCell<fsgrids::moments::N_MOMENTS> leftMoments;
+   FsCell<fsgrids::bfield::N_BFIELD> leftPerB;
+   FsCell<fsgrids::moments::N_MOMENTS> centMoments = fsCell(momentsGrid,i,j,k);
+   FsCell<fsgrids::bfield::N_BFIELD> centPerB = fsCell(perBGrid,i,j,k);
    #ifdef DEBUG_SOLVERS
-   if (centMoments->at(fsgrids::moments::RHOM) <= 0) {
+   if (centMoments.at(fsgrids::moments::RHOM) <= 0) {
       std::cerr << __FILE__ << ":" << __LINE__
-         << (centMoments->at(fsgrids::moments::RHOM) < 0 ? " Negative" : " Zero") << " density in spatial cell at (" << i << " " << j << " " << k << ")"
+         << (centMoments.at(fsgrids::moments::RHOM) < 0 ? " Negative" : " Zero") << " density in spatial cell at (" << i << " " << j << " " << k << ")"
          << std::endl;
       abort();
    }
    #endif
-   std::array<Real, fsgrids::moments::N_MOMENTS> * rghtMoments = NULL;
-   std::array<Real, fsgrids::bfield::N_BFIELD>  * rghtPerB = NULL;
-   std::array<Real, fsgrids::bfield::N_BFIELD>  * botLeft = NULL;
-   std::array<Real, fsgrids::bfield::N_BFIELD>  * botRght = NULL;
-   std::array<Real, fsgrids::bfield::N_BFIELD>  * topLeft = NULL;
-   std::array<Real, fsgrids::bfield::N_BFIELD>  * topRght = NULL;
+   FsCell<fsgrids::moments::N_MOMENTS> rghtMoments;
+   FsCell<fsgrids::bfield::N_BFIELD>  rghtPerB;
+   FsCell<fsgrids::bfield::N_BFIELD>  botLeft;
+   FsCell<fsgrids::bfield::N_BFIELD>  botRght;
+   FsCell<fsgrids::bfield::N_BFIELD>  topLeft;
+   FsCell<fsgrids::bfield::N_BFIELD>  topRght;
    
    // Calculate x-derivatives (is not TVD for AMR mesh):
-   if ((sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY) || (sysBoundaryLayer == 1)) {
-      
-      leftPerB = perBGrid.get(i-1,j,k);
-      rghtPerB = perBGrid.get(i+1,j,k);
-      leftMoments = momentsGrid.get(i-1,j,k);
-      rghtMoments = momentsGrid.get(i+1,j,k);
-      #ifdef DEBUG_SOLVERS
-      if (leftMoments->at(fsgrids::moments::RHOM) <= 0) {
-         std::cerr << __FILE__ << ":" << __LINE__
-            << (leftMoments->at(fsgrids::moments::RHOM) < 0 ? " Negative" : " Zero") << " density in spatial cell " //<< leftNbrID
-            << std::endl;
-         abort();
-      }
-      if (rghtMoments->at(fsgrids::moments::RHOM) <= 0) {
-         std::cerr << __FILE__ << ":" << __LINE__
-            << (rghtMoments->at(fsgrids::moments::RHOM) < 0 ? " Negative" : " Zero") << " density in spatial cell " //<< rightNbrID
-            << std::endl;
-         abort();
-      }
-      #endif
-      
-      dMoments->at(fsgrids::dmoments::drhomdx) = limiter(leftMoments->at(fsgrids::moments::RHOM),centMoments->at(fsgrids::moments::RHOM),rghtMoments->at(fsgrids::moments::RHOM));
-      dMoments->at(fsgrids::dmoments::drhoqdx) = limiter(leftMoments->at(fsgrids::moments::RHOQ),centMoments->at(fsgrids::moments::RHOQ),rghtMoments->at(fsgrids::moments::RHOQ));
-      dMoments->at(fsgrids::dmoments::dp11dx) = limiter(leftMoments->at(fsgrids::moments::P_11),centMoments->at(fsgrids::moments::P_11),rghtMoments->at(fsgrids::moments::P_11));
-      dMoments->at(fsgrids::dmoments::dp22dx) = limiter(leftMoments->at(fsgrids::moments::P_22),centMoments->at(fsgrids::moments::P_22),rghtMoments->at(fsgrids::moments::P_22));
-      dMoments->at(fsgrids::dmoments::dp33dx) = limiter(leftMoments->at(fsgrids::moments::P_33),centMoments->at(fsgrids::moments::P_33),rghtMoments->at(fsgrids::moments::P_33));
+   leftPerB = fsCell(perBGrid,i-1,j,k);
+   rghtPerB = fsCell(perBGrid,i+1,j,k);
+   leftMoments = fsCell(momentsGrid,i-1,j,k);
+   rghtMoments = fsCell(momentsGrid,i+1,j,k);
+   #ifdef DEBUG_SOLVERS
+   if (leftMoments.at(fsgrids::moments::RHOM) <= 0) {
+      std::cerr << __FILE__ << ":" << __LINE__
+         << (leftMoments.at(fsgrids::moments::RHOM) < 0 ? " Negative" : " Zero") << " density in spatial cell " //<< leftNbrID
+         << std::endl;
+      abort();
+   }
+   if (rghtMoments.at(fsgrids::moments::RHOM) <= 0) {
+      std::cerr << __FILE__ << ":" << __LINE__
+         << (rghtMoments.at(fsgrids::moments::RHOM) < 0 ? " Negative" : " Zero") << " density in spatial cell " //<< rightNbrID
+         << std::endl;
+      abort();
+   }
+   #endif
+   
+   dMoments.at(fsgrids::dmoments::drhomdx) = limiter(leftMoments.at(fsgrids::moments::RHOM),centMoments.at(fsgrids::moments::RHOM),rghtMoments.at(fsgrids::moments::RHOM));
+   dMoments.at(fsgrids::dmoments::drhoqdx) = limiter(leftMoments.at(fsgrids::moments::RHOQ),centMoments.at(fsgrids::moments::RHOQ),rghtMoments.at(fsgrids::moments::RHOQ));
+   dMoments.at(fsgrids::dmoments::dp11dx) = limiter(leftMoments.at(fsgrids::moments::P_11),centMoments.at(fsgrids::moments::P_11),rghtMoments.at(fsgrids::moments::P_11));
+   dMoments.at(fsgrids::dmoments::dp22dx) = limiter(leftMoments.at(fsgrids::moments::P_22),centMoments.at(fsgrids::moments::P_22),rghtMoments.at(fsgrids::moments::P_22));
+   dMoments.at(fsgrids::dmoments::dp33dx) = limiter(leftMoments.at(fsgrids::moments::P_33),centMoments.at(fsgrids::moments::P_33),rghtMoments.at(fsgrids::moments::P_33));
 
-      dMoments->at(fsgrids::dmoments::dVxdx)  = limiter(leftMoments->at(fsgrids::moments::VX), centMoments->at(fsgrids::moments::VX), rghtMoments->at(fsgrids::moments::VX));
-      dMoments->at(fsgrids::dmoments::dVydx)  = limiter(leftMoments->at(fsgrids::moments::VY), centMoments->at(fsgrids::moments::VY), rghtMoments->at(fsgrids::moments::VY));
-      dMoments->at(fsgrids::dmoments::dVzdx)  = limiter(leftMoments->at(fsgrids::moments::VZ), centMoments->at(fsgrids::moments::VZ), rghtMoments->at(fsgrids::moments::VZ));
-      dPerB->at(fsgrids::dperb::dPERBydx)  = limiter(leftPerB->at(fsgrids::bfield::PERBY),centPerB->at(fsgrids::bfield::PERBY),rghtPerB->at(fsgrids::bfield::PERBY));
-      dPerB->at(fsgrids::dperb::dPERBzdx)  = limiter(leftPerB->at(fsgrids::bfield::PERBZ),centPerB->at(fsgrids::bfield::PERBZ),rghtPerB->at(fsgrids::bfield::PERBZ));
-      if (Parameters::ohmHallTerm < 2 || sysBoundaryLayer == 1) {
-        dPerB->at(fsgrids::dperb::dPERBydxx) = 0.0;
-        dPerB->at(fsgrids::dperb::dPERBzdxx) = 0.0;
-      } else {
-        dPerB->at(fsgrids::dperb::dPERBydxx) = leftPerB->at(fsgrids::bfield::PERBY) + rghtPerB->at(fsgrids::bfield::PERBY) - 2.0*centPerB->at(fsgrids::bfield::PERBY);
-        dPerB->at(fsgrids::dperb::dPERBzdxx) = leftPerB->at(fsgrids::bfield::PERBZ) + rghtPerB->at(fsgrids::bfield::PERBZ) - 2.0*centPerB->at(fsgrids::bfield::PERBZ);
-      }
+   dMoments.at(fsgrids::dmoments::dVxdx)  = limiter(leftMoments.at(fsgrids::moments::VX), centMoments.at(fsgrids::moments::VX), rghtMoments.at(fsgrids::moments::VX));
+   dMoments.at(fsgrids::dmoments::dVydx)  = limiter(leftMoments.at(fsgrids::moments::VY), centMoments.at(fsgrids::moments::VY), rghtMoments.at(fsgrids::moments::VY));
+   dMoments.at(fsgrids::dmoments::dVzdx)  = limiter(leftMoments.at(fsgrids::moments::VZ), centMoments.at(fsgrids::moments::VZ), rghtMoments.at(fsgrids::moments::VZ));
+   dPerB.at(fsgrids::dperb::dPERBydx)  = limiter(leftPerB.at(fsgrids::bfield::PERBY),centPerB.at(fsgrids::bfield::PERBY),rghtPerB.at(fsgrids::bfield::PERBY));
+   dPerB.at(fsgrids::dperb::dPERBzdx)  = limiter(leftPerB.at(fsgrids::bfield::PERBZ),centPerB.at(fsgrids::bfield::PERBZ),rghtPerB.at(fsgrids::bfield::PERBZ));
+   if (secondDerivatives) {
+      dPerB.at(fsgrids::dperb::dPERBydxx) = leftPerB.at(fsgrids::bfield::PERBY) + rghtPerB.at(fsgrids::bfield::PERBY) - 2.0*centPerB.at(fsgrids::bfield::PERBY);
+      dPerB.at(fsgrids::dperb::dPERBzdxx) = leftPerB.at(fsgrids::bfield::PERBZ) + rghtPerB.at(fsgrids::bfield::PERBZ) - 2.0*centPerB.at(fsgrids::bfield::PERBZ);
    } else {
-      // Boundary conditions handle derivatives.
-      if (sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY) {
-         SBC::SysBoundaryCondition::setCellDerivativesToZero(dPerBGrid, dMomentsGrid, i, j, k, 0);
-      } else {
-         sysBoundaries.getSysBoundary(sysBoundaryFlag)->fieldSolverBoundaryCondDerivatives(dPerBGrid, dMomentsGrid, i, j, k, RKCase, 0);
-      }
+      dPerB.at(fsgrids::dperb::dPERBydxx) = 0.0;
+      dPerB.at(fsgrids::dperb::dPERBzdxx) = 0.0;
    }
 
    // Calculate y-derivatives (is not TVD for AMR mesh):
-   if ((sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY) || (sysBoundaryLayer == 1)) {
-      
-      leftPerB = perBGrid.get(i,j-1,k);
-      rghtPerB = perBGrid.get(i,j+1,k);
-      leftMoments = momentsGrid.get(i,j-1,k);
-      rghtMoments = momentsGrid.get(i,j+1,k);
-      
-       dMoments->at(fsgrids::dmoments::drhomdy) = limiter(leftMoments->at(fsgrids::moments::RHOM),centMoments->at(fsgrids::moments::RHOM),rghtMoments->at(fsgrids::moments::RHOM));
-       dMoments->at(fsgrids::dmoments::drhoqdy) = limiter(leftMoments->at(fsgrids::moments::RHOQ),centMoments->at(fsgrids::moments::RHOQ),rghtMoments->at(fsgrids::moments::RHOQ));
-       dMoments->at(fsgrids::dmoments::dp11dy) = limiter(leftMoments->at(fsgrids::moments::P_11),centMoments->at(fsgrids::moments::P_11),rghtMoments->at(fsgrids::moments::P_11));
-       dMoments->at(fsgrids::dmoments::dp22dy) = limiter(leftMoments->at(fsgrids::moments::P_22),centMoments->at(fsgrids::moments::P_22),rghtMoments->at(fsgrids::moments::P_22));
-       dMoments->at(fsgrids::dmoments::dp33dy) = limiter(leftMoments->at(fsgrids::moments::P_33),centMoments->at(fsgrids::moments::P_33),rghtMoments->at(fsgrids::moments::P_33));
-       dMoments->at(fsgrids::dmoments::dVxdy)  = limiter(leftMoments->at(fsgrids::moments::VX), centMoments->at(fsgrids::moments::VX), rghtMoments->at(fsgrids::moments::VX));
-       dMoments->at(fsgrids::dmoments::dVydy)  = limiter(leftMoments->at(fsgrids::moments::VY), centMoments->at(fsgrids::moments::VY), rghtMoments->at(fsgrids::moments::VY));
-       dMoments->at(fsgrids::dmoments::dVzdy)  = limiter(leftMoments->at(fsgrids::moments::VZ), centMoments->at(fsgrids::moments::VZ), rghtMoments->at(fsgrids::moments::VZ));
+   leftPerB = fsCell(perBGrid,i,j-1,k);
+   rghtPerB = fsCell(perBGrid,i,j+1,k);
+   leftMoments = fsCell(momentsGrid,i,j-1,k);
+   rghtMoments = fsCell(momentsGrid,i,j+1,k);
+   
+   dMoments.at(fsgrids::dmoments::drhomdy) = limiter(leftMoments.at(fsgrids::moments::RHOM),centMoments.at(fsgrids::moments::RHOM),rghtMoments.at(fsgrids::moments::RHOM));
+   dMoments.at(fsgrids::dmoments::drhoqdy) = limiter(leftMoments.at(fsgrids::moments::RHOQ),centMoments.at(fsgrids::moments::RHOQ),rghtMoments.at(fsgrids::moments::RHOQ));
+   dMoments.at(fsgrids::dmoments::dp11dy) = limiter(leftMoments.at(fsgrids::moments::P_11),centMoments.at(fsgrids::moments::P_11),rghtMoments.at(fsgrids::moments::P_11));
+   dMoments.at(fsgrids::dmoments::dp22dy) = limiter(leftMoments.at(fsgrids::moments::P_22),centMoments.at(fsgrids::moments::P_22),rghtMoments.at(fsgrids::moments::P_22));
+   dMoments.at(fsgrids::dmoments::dp33dy) = limiter(leftMoments.at(fsgrids::moments::P_33),centMoments.at(fsgrids::moments::P_33),rghtMoments.at(fsgrids::moments::P_33));
+   dMoments.at(fsgrids::dmoments::dVxdy)  = limiter(leftMoments.at(fsgrids::moments::VX), centMoments.at(fsgrids::moments::VX), rghtMoments.at(fsgrids::moments::VX));
+   dMoments.at(fsgrids::dmoments::dVydy)  = limiter(leftMoments.at(fsgrids::moments::VY), centMoments.at(fsgrids::moments::VY), rghtMoments.at(fsgrids::moments::VY));
+   dMoments.at(fsgrids::dmoments::dVzdy)  = limiter(leftMoments.at(fsgrids::moments::VZ), centMoments.at(fsgrids::moments::VZ), rghtMoments.at(fsgrids::moments::VZ));
 
-      dPerB->at(fsgrids::dperb::dPERBxdy)  = limiter(leftPerB->at(fsgrids::bfield::PERBX),centPerB->at(fsgrids::bfield::PERBX),rghtPerB->at(fsgrids::bfield::PERBX));
-      dPerB->at(fsgrids::dperb::dPERBzdy)  = limiter(leftPerB->at(fsgrids::bfield::PERBZ),centPerB->at(fsgrids::bfield::PERBZ),rghtPerB->at(fsgrids::bfield::PERBZ));
+   dPerB.at(fsgrids::dperb::dPERBxdy)  = limiter(leftPerB.at(fsgrids::bfield::PERBX),centPerB.at(fsgrids::bfield::PERBX),rghtPerB.at(fsgrids::bfield::PERBX));
+   dPerB.at(fsgrids::dperb::dPERBzdy)  = limiter(leftPerB.at(fsgrids::bfield::PERBZ),centPerB.at(fsgrids::bfield::PERBZ),rghtPerB.at(fsgrids::bfield::PERBZ));
 
-      if (Parameters::ohmHallTerm < 2 || sysBoundaryLayer == 1) {
-         dPerB->at(fsgrids::dperb::dPERBxdyy) = 0.0;
-         dPerB->at(fsgrids::dperb::dPERBzdyy) = 0.0;
-      } else {
-         dPerB->at(fsgrids::dperb::dPERBxdyy) = leftPerB->at(fsgrids::bfield::PERBX) + rghtPerB->at(fsgrids::bfield::PERBX) - 2.0*centPerB->at(fsgrids::bfield::PERBX);
-         dPerB->at(fsgrids::dperb::dPERBzdyy) = leftPerB->at(fsgrids::bfield::PERBZ) + rghtPerB->at(fsgrids::bfield::PERBZ) - 2.0*centPerB->at(fsgrids::bfield::PERBZ);
-      }
-      
+   if (secondDerivatives) {
+      dPerB.at(fsgrids::dperb::dPERBxdyy) = leftPerB.at(fsgrids::bfield::PERBX) + rghtPerB.at(fsgrids::bfield::PERBX) - 2.0*centPerB.at(fsgrids::bfield::PERBX);
+      dPerB.at(fsgrids::dperb::dPERBzdyy) = leftPerB.at(fsgrids::bfield::PERBZ) + rghtPerB.at(fsgrids::bfield::PERBZ) - 2.0*centPerB.at(fsgrids::bfield::PERBZ);
    } else {
-      // Boundary conditions handle derivatives.
-      if (sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY) {
-         SBC::SysBoundaryCondition::setCellDerivativesToZero(dPerBGrid, dMomentsGrid, i, j, k, 1);
-      } else {
-         sysBoundaries.getSysBoundary(sysBoundaryFlag)->fieldSolverBoundaryCondDerivatives(dPerBGrid, dMomentsGrid, i, j, k, RKCase, 1);
-      }
+      dPerB.at(fsgrids::dperb::dPERBxdyy) = 0.0;
+      dPerB.at(fsgrids::dperb::dPERBzdyy) = 0.0;
    }
    
    // Calculate z-derivatives (is not TVD for AMR mesh):
-   if ((sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY) || (sysBoundaryLayer == 1)) {
-      
-      leftPerB = perBGrid.get(i,j,k-1);
-      rghtPerB = perBGrid.get(i,j,k+1);
-      leftMoments = momentsGrid.get(i,j,k-1);
-      rghtMoments = momentsGrid.get(i,j,k+1);
-      
-      dMoments->at(fsgrids::dmoments::drhomdz) = limiter(leftMoments->at(fsgrids::moments::RHOM),centMoments->at(fsgrids::moments::RHOM),rghtMoments->at(fsgrids::moments::RHOM));
-      dMoments->at(fsgrids::dmoments::drhoqdz) = limiter(leftMoments->at(fsgrids::moments::RHOQ),centMoments->at(fsgrids::moments::RHOQ),rghtMoments->at(fsgrids::moments::RHOQ));
-      dMoments->at(fsgrids::dmoments::dp11dz) = limiter(leftMoments->at(fsgrids::moments::P_11),centMoments->at(fsgrids::moments::P_11),rghtMoments->at(fsgrids::moments::P_11));
-      dMoments->at(fsgrids::dmoments::dp22dz) = limiter(leftMoments->at(fsgrids::moments::P_22),centMoments->at(fsgrids::moments::P_22),rghtMoments->at(fsgrids::moments::P_22));
-      dMoments->at(fsgrids::dmoments::dp33dz) = limiter(leftMoments->at(fsgrids::moments::P_33),centMoments->at(fsgrids::moments::P_33),rghtMoments->at(fsgrids::moments::P_33));
-      dMoments->at(fsgrids::dmoments::dVxdz)  = limiter(leftMoments->at(fsgrids::moments::VX), centMoments->at(fsgrids::moments::VX), rghtMoments->at(fsgrids::moments::VX));
-      dMoments->at(fsgrids::dmoments::dVydz)  = limiter(leftMoments->at(fsgrids::moments::VY), centMoments->at(fsgrids::moments::VY), rghtMoments->at(fsgrids::moments::VY));
-      dMoments->at(fsgrids::dmoments::dVzdz)  = limiter(leftMoments->at(fsgrids::moments::VZ), centMoments->at(fsgrids::moments::VZ), rghtMoments->at(fsgrids::moments::VZ));
-      
-      dPerB->at(fsgrids::dperb::dPERBxdz)  = limiter(leftPerB->at(fsgrids::bfield::PERBX),centPerB->at(fsgrids::bfield::PERBX),rghtPerB->at(fsgrids::bfield::PERBX));
-      dPerB->at(fsgrids::dperb::dPERBydz)  = limiter(leftPerB->at(fsgrids::bfield::PERBY),centPerB->at(fsgrids::bfield::PERBY),rghtPerB->at(fsgrids::bfield::PERBY));
-      if (Parameters::ohmHallTerm < 2 || sysBoundaryLayer == 1) {
-        dPerB->at(fsgrids::dperb::dPERBxdzz) = 0.0;
-        dPerB->at(fsgrids::dperb::dPERBydzz) = 0.0;
-      } else {
-        dPerB->at(fsgrids::dperb::dPERBxdzz) = leftPerB->at(fsgrids::bfield::PERBX) + rghtPerB->at(fsgrids::bfield::PERBX) - 2.0*centPerB->at(fsgrids::bfield::PERBX);
-        dPerB->at(fsgrids::dperb::dPERBydzz) = leftPerB->at(fsgrids::bfield::PERBY) + rghtPerB->at(fsgrids::bfield::PERBY) - 2.0*centPerB->at(fsgrids::bfield::PERBY);
-      }
-      
+   leftPerB = fsCell(perBGrid,i,j,k-1);
+   rghtPerB = fsCell(perBGrid,i,j,k+1);
+   leftMoments = fsCell(momentsGrid,i,j,k-1);
+   rghtMoments = fsCell(momentsGrid,i,j,k+1);
+   
+   dMoments.at(fsgrids::dmoments::drhomdz) = limiter(leftMoments.at(fsgrids::moments::RHOM),centMoments.at(fsgrids::moments::RHOM),rghtMoments.at(fsgrids::moments::RHOM));
+   dMoments.at(fsgrids::dmoments::drhoqdz) = limiter(leftMoments.at(fsgrids::moments::RHOQ),centMoments.at(fsgrids::moments::RHOQ),rghtMoments.at(fsgrids::moments::RHOQ));
+   dMoments.at(fsgrids::dmoments::dp11dz) = limiter(leftMoments.at(fsgrids::moments::P_11),centMoments.at(fsgrids::moments::P_11),rghtMoments.at(fsgrids::moments::P_11));
+   dMoments.at(fsgrids::dmoments::dp22dz) = limiter(leftMoments.at(fsgrids::moments::P_22),centMoments.at(fsgrids::moments::P_22),rghtMoments.at(fsgrids::moments::P_22));
+   dMoments.at(fsgrids::dmoments::dp33dz) = limiter(leftMoments.at(fsgrids::moments::P_33),centMoments.at(fsgrids::moments::P_33),rghtMoments.at(fsgrids::moments::P_33));
+   dMoments.at(fsgrids::dmoments::dVxdz)  = limiter(leftMoments.at(fsgrids::moments::VX), centMoments.at(fsgrids::moments::VX), rghtMoments.at(fsgrids::moments::VX));
+   dMoments.at(fsgrids::dmoments::dVydz)  = limiter(leftMoments.at(fsgrids::moments::VY), centMoments.at(fsgrids::moments::VY), rghtMoments.at(fsgrids::moments::VY));
+   dMoments.at(fsgrids::dmoments::dVzdz)  = limiter(leftMoments.at(fsgrids::moments::VZ), centMoments.at(fsgrids::moments::VZ), rghtMoments.at(fsgrids::moments::VZ));
+   
+   dPerB.at(fsgrids::dperb::dPERBxdz)  = limiter(leftPerB.at(fsgrids::bfield::PERBX),centPerB.at(fsgrids::bfield::PERBX),rghtPerB.at(fsgrids::bfield::PERBX));
+   dPerB.at(fsgrids::dperb::dPERBydz)  = limiter(leftPerB.at(fsgrids::bfield::PERBY),centPerB.at(fsgrids::bfield::PERBY),rghtPerB.at(fsgrids::bfield::PERBY));
+   if (secondDerivatives) {
+      dPerB.at(fsgrids::dperb::dPERBxdzz) = leftPerB.at(fsgrids::bfield::PERBX) + rghtPerB.at(fsgrids::bfield::PERBX) - 2.0*centPerB.at(fsgrids::bfield::PERBX);
+      dPerB.at(fsgrids::dperb::dPERBydzz) = leftPerB.at(fsgrids::bfield::PERBY) + rghtPerB.at(fsgrids::bfield::PERBY) - 2.0*centPerB.at(fsgrids::bfield::PERBY);
    } else {
-      // Boundary conditions handle derivatives.
-      if (sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY) {
-         SBC::SysBoundaryCondition::setCellDerivativesToZero(dPerBGrid, dMomentsGrid, i, j, k, 2);
-      } else {
-         sysBoundaries.getSysBoundary(sysBoundaryFlag)->fieldSolverBoundaryCondDerivatives(dPerBGrid, dMomentsGrid, i, j, k, RKCase, 2);
-      }
+      dPerB.at(fsgrids::dperb::dPERBxdzz) = 0.0;
+      dPerB.at(fsgrids::dperb::dPERBydzz) = 0.0;
    }
    
-   if (Parameters::ohmHallTerm < 2 || sysBoundaryLayer == 1) {
-      dPerB->at(fsgrids::dperb::dPERBxdyz) = 0.0;
-      dPerB->at(fsgrids::dperb::dPERBydxz) = 0.0;
-      dPerB->at(fsgrids::dperb::dPERBzdxy) = 0.0;
-   } else {
+   if (secondDerivatives) {
       // Calculate xy mixed derivatives:
-      if ((sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY) || (sysBoundaryLayer == 1)) {
-         
-         botLeft = perBGrid.get(i-1,j-1,k);
-         botRght = perBGrid.get(i+1,j-1,k);
-         topLeft = perBGrid.get(i-1,j+1,k);
-         topRght = perBGrid.get(i+1,j+1,k);
-         
-         dPerB->at(fsgrids::dperb::dPERBzdxy) = FOURTH * (botLeft->at(fsgrids::bfield::PERBZ) + topRght->at(fsgrids::bfield::PERBZ) - botRght->at(fsgrids::bfield::PERBZ) - topLeft->at(fsgrids::bfield::PERBZ));
-         
-      } else {
-         // Boundary conditions handle derivatives.
-         if (sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY) {
-            SBC::SysBoundaryCondition::setCellDerivativesToZero(dPerBGrid, dMomentsGrid, i, j, k, 3);
-         } else {
-            sysBoundaries.getSysBoundary(sysBoundaryFlag)->fieldSolverBoundaryCondDerivatives(dPerBGrid, dMomentsGrid, i, j, k, RKCase, 3);
-         }
-      }
+      botLeft = fsCell(perBGrid,i-1,j-1,k);
+      botRght = fsCell(perBGrid,i+1,j-1,k);
+      topLeft = fsCell(perBGrid,i-1,j+1,k);
+      topRght = fsCell(perBGrid,i+1,j+1,k);
+      
+      dPerB.at(fsgrids::dperb::dPERBzdxy) = FOURTH * (botLeft.at(fsgrids::bfield::PERBZ) + topRght.at(fsgrids::bfield::PERBZ) - botRght.at(fsgrids::bfield::PERBZ) - topLeft.at(fsgrids::bfield::PERBZ));
       
       // Calculate xz mixed derivatives:
-      if ((sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY) || (sysBoundaryLayer == 1)) {
-         
-         botLeft = perBGrid.get(i-1,j,k-1);
-         botRght = perBGrid.get(i+1,j,k-1);
-         topLeft = perBGrid.get(i-1,j,k+1);
-         topRght = perBGrid.get(i+1,j,k+1);
-         
-         dPerB->at(fsgrids::dperb::dPERBydxz) = FOURTH * (botLeft->at(fsgrids::bfield::PERBY) + topRght->at(fsgrids::bfield::PERBY) - botRght->at(fsgrids::bfield::PERBY) - topLeft->at(fsgrids::bfield::PERBY));
-         
-      } else {
-         // Boundary conditions handle derivatives.
-         if (sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY) {
-            SBC::SysBoundaryCondition::setCellDerivativesToZero(dPerBGrid, dMomentsGrid, i, j, k, 4);
-         } else {
-            sysBoundaries.getSysBoundary(sysBoundaryFlag)->fieldSolverBoundaryCondDerivatives(dPerBGrid, dMomentsGrid, i, j, k, RKCase, 4);
-         }
-      }
+      botLeft = fsCell(perBGrid,i-1,j,k-1);
+      botRght = fsCell(perBGrid,i+1,j,k-1);
+      topLeft = fsCell(perBGrid,i-1,j,k+1);
+      topRght = fsCell(perBGrid,i+1,j,k+1);
+      
+      dPerB.at(fsgrids::dperb::dPERBydxz) = FOURTH * (botLeft.at(fsgrids::bfield::PERBY) + topRght.at(fsgrids::bfield::PERBY) - botRght.at(fsgrids::bfield::PERBY) - topLeft.at(fsgrids::bfield::PERBY));
       
       // Calculate yz mixed derivatives:
-      if ((sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY) || (sysBoundaryLayer == 1)) {
-         
-         botLeft = perBGrid.get(i,j-1,k-1);
-         botRght = perBGrid.get(i,j+1,k-1);
-         topLeft = perBGrid.get(i,j-1,k+1);
-         topRght = perBGrid.get(i,j+1,k+1);
-         
-         dPerB->at(fsgrids::dperb::dPERBxdyz) = FOURTH * (botLeft->at(fsgrids::bfield::PERBX) + topRght->at(fsgrids::bfield::PERBX) - botRght->at(fsgrids::bfield::PERBX) - topLeft->at(fsgrids::bfield::PERBX));
-         
-      } else {
-         // Boundary conditions handle derivatives.
-         if (sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY) {
-            SBC::SysBoundaryCondition::setCellDerivativesToZero(dPerBGrid, dMomentsGrid, i, j, k, 5);
-         } else {
-            sysBoundaries.getSysBoundary(sysBoundaryFlag)->fieldSolverBoundaryCondDerivatives(dPerBGrid, dMomentsGrid, i, j, k, RKCase, 5);
-         }
+      botLeft = fsCell(perBGrid,i,j-1,k-1);
+      botRght = fsCell(perBGrid,i,j+1,k-1);
+      topLeft = fsCell(perBGrid,i,j-1,k+1);
+      topRght = fsCell(perBGrid,i,j+1,k+1);
+      
+      dPerB.at(fsgrids::dperb::dPERBxdyz) = FOURTH * (botLeft.at(fsgrids::bfield::PERBX) + topRght.at(fsgrids::bfield::PERBX) - botRght.at(fsgrids::bfield::PERBX) - topLeft.at(fsgrids::bfield::PERBX));
+   } else {
+      dPerB.at(fsgrids::dperb::dPERBxdyz) = 0.0;
+      dPerB.at(fsgrids::dperb::dPERBydxz) = 0.0;
+      dPerB.at(fsgrids::dperb::dPERBzdxy) = 0.0;
+   }
+}
+
+/*! \brief Low-level spatial derivatives calculation of a system boundary cell.
+ * 
+ * The derivatives of the first boundary layer are computed like in the interior, without second
+ * derivatives. The other layers get the derivative boundary conditions of their system boundary.
+ * \param cell System boundary cell from getFsCellLists
+ * \param perBGrid fsGrid holding the perturbed B quantities
+ * \param momentsGrid fsGrid holding the moment quantities
+ * \param dPerBGrid fsGrid holding the derivatives of perturbed B
+ * \param dMomentsGrid fsGrid holding the derviatives of moments
+ * \param RKCase Element in the enum defining the Runge-Kutta method steps
+ * 
+ * \sa calculateComputedDerivatives calculateDerivativesSimple
+ */
+static void calculateDerivatives(
+   const FsBoundaryCell& cell,
+   FsGrid< std::array<Real, fsgrids::bfield::N_BFIELD>, 2> & perBGrid,
+   FsGrid< std::array<Real, fsgrids::moments::N_MOMENTS>, 2> & momentsGrid,
+   FsGrid< std::array<Real, fsgrids::dperb::N_DPERB>, 2> & dPerBGrid,
+   FsGrid< std::array<Real, fsgrids::dmoments::N_DMOMENTS>, 2> & dMomentsGrid,
+   cint& RKCase
+) {
+   if (cell.sysBoundaryLayer == 1) {
+      calculateComputedDerivatives(cell.i,cell.j,cell.k, perBGrid, momentsGrid, dPerBGrid, dMomentsGrid, false);
+      return;
+   }
+
+   // Boundary conditions handle derivatives.
+   for (uint component=0; component<3; component++) {
+      cell.sysBoundary->fieldSolverBoundaryCondDerivatives(dPerBGrid, dMomentsGrid, cell.i, cell.j, cell.k, RKCase, component);
+   }
+   if (Parameters::ohmHallTerm < 2) {
+      FsCell<fsgrids::dperb::N_DPERB> dPerB = fsCell(dPerBGrid,cell.i,cell.j,cell.k);
+      dPerB.at(fsgrids::dperb::dPERBxdyz) = 0.0;
+      dPerB.at(fsgrids::dperb::dPERBydxz) = 0.0;
+      dPerB.at(fsgrids::dperb::dPERBzdxy) = 0.0;
+   } else {
+      for (uint component=3; component<6; component++) {
+         cell.sysBoundary->fieldSolverBoundaryCondDerivatives(dPerBGrid, dMomentsGrid, cell.i, cell.j, cell.k, RKCase, component);
       }
    }
 }
@@ -305,6 +275,7 @@ void calculateDerivativesSimple(
    
    timer=phiprof::initializeTimer("MPI","MPI");
    phiprof::start(timer);
+   telemetry::start(telemetry::MPI_WAIT);
    
    switch (RKCase) {
     case RK_ORDER1:
@@ -340,24 +311,36 @@ void calculateDerivativesSimple(
       abort();
    }
    
+   telemetry::stop(telemetry::MPI_WAIT);
    phiprof::stop(timer);
 
    timer=phiprof::initializeTimer("Compute cells");
    phiprof::start(timer);
 
-   // Calculate derivatives
-   #pragma omp parallel for collapse(3)
-   for (int k=0; k<gridDims[2]; k++) {
-      for (int j=0; j<gridDims[1]; j++) {
-         for (int i=0; i<gridDims[0]; i++) {
-            if (technicalGrid.get(i,j,k)->sysBoundaryFlag == sysboundarytype::DO_NOT_COMPUTE) continue;
-            if (RKCase == RK_ORDER1 || RKCase == RK_ORDER2_STEP2) {
-               calculateDerivatives(i,j,k, perBGrid, momentsGrid, dPerBGrid, dMomentsGrid, technicalGrid, sysBoundaries, RKCase);
-            } else {
-               calculateDerivatives(i,j,k, perBDt2Grid, momentsDt2Grid, dPerBGrid, dMomentsGrid, technicalGrid, sysBoundaries, RKCase);
-            }
+   FsGrid< std::array<Real, fsgrids::bfield::N_BFIELD>, 2> & curPerBGrid =
+      (RKCase == RK_ORDER1 || RKCase == RK_ORDER2_STEP2) ? perBGrid : perBDt2Grid;
+   FsGrid< std::array<Real, fsgrids::moments::N_MOMENTS>, 2> & curMomentsGrid =
+      (RKCase == RK_ORDER1 || RKCase == RK_ORDER2_STEP2) ? momentsGrid : momentsDt2Grid;
+   
+   const FsCellLists& cellLists = getFsCellLists(technicalGrid, sysBoundaries);
+   const vector<FsCellRun>& interiorRuns = cellLists.interiorRuns;
+   const vector<FsBoundaryCell>& boundaryCells = cellLists.boundaryCells;
+   const bool secondDerivatives = (Parameters::ohmHallTerm >= 2);
+   
+   // Calculate derivatives, DO_NOT_COMPUTE cells are not in either list
+   #pragma omp parallel
+   {
+      #pragma omp for schedule(dynamic,4) nowait
+      for (size_t r=0; r<interiorRuns.size(); r++) {
+         const FsCellRun& run = interiorRuns[r];
+         for (int i=run.iBegin; i<run.iEnd; i++) {
+            calculateComputedDerivatives(i,run.j,run.k, curPerBGrid, curMomentsGrid, dPerBGrid, dMomentsGrid, secondDerivatives);
          }
       }
+      #pragma omp for schedule(dynamic,16)
+      for (size_t c=0; c<boundaryCells.size(); c++) {
+         calculateDerivatives(boundaryCells[c], curPerBGrid, curMomentsGrid, dPerBGrid, dMomentsGrid, RKCase);
+      }
    }
 
    phiprof::stop(timer,N_cells,"Spatial Cells");
@@ -385,18 +368,18 @@ void calculateBVOLDerivatives(
    cint k,
    SysBoundary& sysBoundaries
 ) {
-   std::array<Real, fsgrids::volfields::N_VOL> * array = volGrid.get(i,j,k);
+   FsCell<fsgrids::volfields::N_VOL> array = fsCell(volGrid,i,j,k);
    
-   std::array<Real, fsgrids::volfields::N_VOL> * left = NULL;
-   std::array<Real, fsgrids::volfields::N_VOL> * rght = NULL;
+   FsCell<fsgrids::volfields::N_VOL> left;
+   FsCell<fsgrids::volfields::N_VOL> rght;
    
    // Calculate x-derivatives (is not TVD for AMR mesh):
    if (technicalGrid.get(i,j,k)->sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY) {
-      left = volGrid.get(i-1,j,k);
-      rght = volGrid.get(i+1,j,k);
+      left = fsCell(volGrid,i-1,j,k);
+      rght = fsCell(volGrid,i+1,j,k);
       
-      array->at(fsgrids::volfields::dPERBYVOLdx) = limiter(left->at(fsgrids::volfields::PERBYVOL),array->at(fsgrids::volfields::PERBYVOL),rght->at(fsgrids::volfields::PERBYVOL));
-      array->at(fsgrids::volfields::dPERBZVOLdx) = limiter(left->at(fsgrids::volfields::PERBZVOL),array->at(fsgrids::volfields::PERBZVOL),rght->at(fsgrids::volfields::PERBZVOL));
+      array.at(fsgrids::volfields::dPERBYVOLdx) = limiter(left.at(fsgrids::volfields::PERBYVOL),array.at(fsgrids::volfields::PERBYVOL),rght.at(fsgrids::volfields::PERBYVOL));
+      array.at(fsgrids::volfields::dPERBZVOLdx) = limiter(left.at(fsgrids::volfields::PERBZVOL),array.at(fsgrids::volfields::PERBZVOL),rght.at(fsgrids::volfields::PERBZVOL));
    } else {
       if (technicalGrid.get(i,j,k)->sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY) {
          SBC::SysBoundaryCondition::setCellBVOLDerivativesToZero(volGrid, i, j, k, 0);
@@ -407,11 +390,11 @@ void calculateBVOLDerivatives(
    
    // Calculate y-derivatives (is not TVD for AMR mesh):
    if (technicalGrid.get(i,j,k)->sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY) {
-      left = volGrid.get(i,j-1,k);
-      rght = volGrid.get(i,j+1,k);
+      left = fsCell(volGrid,i,j-1,k);
+      rght = fsCell(volGrid,i,j+1,k);
       
-      array->at(fsgrids::volfields::dPERBXVOLdy) = limiter(left->at(fsgrids::volfields::PERBXVOL),array->at(fsgrids::volfields::PERBXVOL),rght->at(fsgrids::volfields::PERBXVOL));
-      array->at(fsgrids::volfields::dPERBZVOLdy) = limiter(left->at(fsgrids::volfields::PERBZVOL),array->at(fsgrids::volfields::PERBZVOL),rght->at(fsgrids::volfields::PERBZVOL));
+      array.at(fsgrids::volfields::dPERBXVOLdy) = limiter(left.at(fsgrids::volfields::PERBXVOL),array.at(fsgrids::volfields::PERBXVOL),rght.at(fsgrids::volfields::PERBXVOL));
+      array.at(fsgrids::volfields::dPERBZVOLdy) = limiter(left.at(fsgrids::volfields::PERBZVOL),array.at(fsgrids::volfields::PERBZVOL),rght.at(fsgrids::volfields::PERBZVOL));
    } else {
       if (technicalGrid.get(i,j,k)->sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY) {
          SBC::SysBoundaryCondition::setCellBVOLDerivativesToZero(volGrid, i, j, k, 1);
@@ -422,11 +405,11 @@ void calculateBVOLDerivatives(
    
    // Calculate z-derivatives (is not TVD for AMR mesh):
    if (technicalGrid.get(i,j,k)->sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY) {
-      left = volGrid.get(i,j,k-1);
-      rght = volGrid.get(i,j,k+1);
+      left = fsCell(volGrid,i,j,k-1);
+      rght = fsCell(volGrid,i,j,k+1);
       
-      array->at(fsgrids::volfields::dPERBXVOLdz) = limiter(left->at(fsgrids::volfields::PERBXVOL),array->at(fsgrids::volfields::PERBXVOL),rght->at(fsgrids::volfields::PERBXVOL));
-      array->at(fsgrids::volfields::dPERBYVOLdz) = limiter(left->at(fsgrids::volfields::PERBYVOL),array->at(fsgrids::volfields::PERBYVOL),rght->at(fsgrids::volfields::PERBYVOL));
+      array.at(fsgrids::volfields::dPERBXVOLdz) = limiter(left.at(fsgrids::volfields::PERBXVOL),array.at(fsgrids::volfields::PERBXVOL),rght.at(fsgrids::volfields::PERBXVOL));
+      array.at(fsgrids::volfields::dPERBYVOLdz) = limiter(left.at(fsgrids::volfields::PERBYVOL),array.at(fsgrids::volfields::PERBYVOL),rght.at(fsgrids::volfields::PERBYVOL));
    } else {
       if (technicalGrid.get(i,j,k)->sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY) {
          SBC::SysBoundaryCondition::setCellBVOLDerivativesToZero(volGrid, i, j, k, 2);
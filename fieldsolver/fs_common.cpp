@@ -40,6 +40,62 @@ Real divideIfNonZero(
    }
 }
 
+static FsCellLists fsCellLists;
+static bool fsCellListsValid = false;
+
+void invalidateFsCellLists() {
+   fsCellListsValid = false;
+}
+
+const FsCellLists& getFsCellLists(
+   FsGrid< fsgrids::technical, 2> & technicalGrid,
+   SysBoundary& sysBoundaries
+) {
+   if (fsCellListsValid) return fsCellLists;
+
+   const int* gridDims = &technicalGrid.getLocalSize()[0];
+   fsCellLists.interiorRuns.clear();
+   fsCellLists.boundaryCells.clear();
+   fsCellLists.nInteriorCells = 0;
+
+   for (int k=0; k<gridDims[2]; k++) {
+      for (int j=0; j<gridDims[1]; j++) {
+         for (int i=0; i<gridDims[0]; i++) {
+            fsgrids::technical* cell = technicalGrid.get(i,j,k);
+            // The rank of a cell does not change during the run, so it is set here once
+            cell->fsGridRank = technicalGrid.getRank();
+
+            if (cell->sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY) {
+               // Extend the current run or start a new one
+               if (i > 0 && fsCellLists.interiorRuns.size() > 0 && fsCellLists.interiorRuns.back().iEnd == i &&
+                   fsCellLists.interiorRuns.back().j == j && fsCellLists.interiorRuns.back().k == k) {
+                  fsCellLists.interiorRuns.back().iEnd = i+1;
+               } else {
+                  FsCellRun run;
+                  run.iBegin = i;
+                  run.iEnd = i+1;
+                  run.j = j;
+                  run.k = k;
+                  fsCellLists.interiorRuns.push_back(run);
+               }
+               ++fsCellLists.nInteriorCells;
+            } else if (cell->sysBoundaryFlag != sysboundarytype::DO_NOT_COMPUTE) {
+               FsBoundaryCell boundaryCell;
+               boundaryCell.i = i;
+               boundaryCell.j = j;
+               boundaryCell.k = k;
+               boundaryCell.sysBoundaryLayer = cell->sysBoundaryLayer;
+               boundaryCell.sysBoundary = sysBoundaries.getSysBoundary(cell->sysBoundaryFlag);
+               fsCellLists.boundaryCells.push_back(boundaryCell);
+            }
+         }
+      }
+   }
+
+   fsCellListsValid = true;
+   return fsCellLists;
+}
+
 /*! \brief Low-level helper function.
  * 
  * Computes the reconstruction coefficients used for field component reconstruction.
@@ -60,23 +116,23 @@ void reconstructionCoefficients(
    cint k,
    creal& reconstructionOrder
 ) {
-   std::array<Real, fsgrids::bfield::N_BFIELD> * cep_i1j1k1 = NULL;
-   std::array<Real, fsgrids::dperb::N_DPERB> * der_i1j1k1 = dPerBGrid.get(i,j,k);
-   std::array<Real, fsgrids::bfield::N_BFIELD> * dummyCellParams = NULL;
-   std::array<Real, fsgrids::bfield::N_BFIELD> * cep_i2j1k1 = NULL;
-   std::array<Real, fsgrids::bfield::N_BFIELD> * cep_i1j2k1 = NULL;
-   std::array<Real, fsgrids::bfield::N_BFIELD> * cep_i1j1k2 = NULL;
+   FsCell<fsgrids::bfield::N_BFIELD> cep_i1j1k1;
+   FsCell<fsgrids::dperb::N_DPERB> der_i1j1k1 = fsCell(dPerBGrid,i,j,k);
+   FsCell<fsgrids::bfield::N_BFIELD> dummyCellParams;
+   FsCell<fsgrids::bfield::N_BFIELD> cep_i2j1k1;
+   FsCell<fsgrids::bfield::N_BFIELD> cep_i1j2k1;
+   FsCell<fsgrids::bfield::N_BFIELD> cep_i1j1k2;
    
    FsGrid< std::array<Real, fsgrids::bfield::N_BFIELD>, 2> * params = & perBGrid;
    
-   cep_i1j1k1 = params->get(i,j,k);
+   cep_i1j1k1 = fsCell(*params,i,j,k);
    dummyCellParams = cep_i1j1k1;
    cep_i2j1k1 = dummyCellParams;
    cep_i1j2k1 = dummyCellParams;
    cep_i1j1k2 = dummyCellParams;
-   if (params->get(i+1,j,k) != NULL) cep_i2j1k1 = params->get(i+1,j,k);
-   if (params->get(i,j+1,k) != NULL) cep_i1j2k1 = params->get(i,j+1,k);
-   if (params->get(i,j,k+1) != NULL) cep_i1j1k2 = params->get(i,j,k+1);
+   if (fsCell(*params,i+1,j,k).exists()) cep_i2j1k1 = fsCell(*params,i+1,j,k);
+   if (fsCell(*params,i,j+1,k).exists()) cep_i1j2k1 = fsCell(*params,i,j+1,k);
+   if (fsCell(*params,i,j,k+1).exists()) cep_i1j1k2 = fsCell(*params,i,j,k+1);
    
    #ifndef FS_1ST_ORDER_SPACE
 
@@ -88,12 +144,12 @@ void reconstructionCoefficients(
    
    // Fetch neighbour cell derivatives, or in case the neighbour does not 
    // exist, use dummyDerivatives array:
-   std::array<Real, fsgrids::dperb::N_DPERB> * der_i2j1k1 = &dummyDerivatives;
-   std::array<Real, fsgrids::dperb::N_DPERB> * der_i1j2k1 = &dummyDerivatives;
-   std::array<Real, fsgrids::dperb::N_DPERB> * der_i1j1k2 = &dummyDerivatives;
-   if (dPerBGrid.get(i+1,j,k) != NULL) der_i2j1k1 = dPerBGrid.get(i+1,j,k);
-   if (dPerBGrid.get(i,j+1,k) != NULL) der_i1j2k1 = dPerBGrid.get(i,j+1,k);
-   if (dPerBGrid.get(i,j,k+1) != NULL) der_i1j1k2 = dPerBGrid.get(i,j,k+1);
+   FsCell<fsgrids::dperb::N_DPERB> der_i2j1k1 = &dummyDerivatives;
+   FsCell<fsgrids::dperb::N_DPERB> der_i1j2k1 = &dummyDerivatives;
+   FsCell<fsgrids::dperb::N_DPERB> der_i1j1k2 = &dummyDerivatives;
+   if (fsCell(dPerBGrid,i+1,j,k).exists()) der_i2j1k1 = fsCell(dPerBGrid,i+1,j,k);
+   if (fsCell(dPerBGrid,i,j+1,k).exists()) der_i1j2k1 = fsCell(dPerBGrid,i,j+1,k);
+   if (fsCell(dPerBGrid,i,j,k+1).exists()) der_i1j1k2 = fsCell(dPerBGrid,i,j,k+1);
    
    // Calculate 3rd order reconstruction coefficients:
    if (reconstructionOrder == 2) {
@@ -125,26 +181,26 @@ void reconstructionCoefficients(
       perturbedResult[Rec::c_yzz] = 0.0;
       perturbedResult[Rec::c_zzz] = 0.0;
    } else if (reconstructionOrder == 3) {
-      perturbedResult[Rec::a_yy] = HALF * (der_i2j1k1->at(fsgrids::dperb::dPERBxdyy) + der_i1j1k1->at(fsgrids::dperb::dPERBxdyy));
-      perturbedResult[Rec::a_zz] = HALF * (der_i2j1k1->at(fsgrids::dperb::dPERBxdzz) + der_i1j1k1->at(fsgrids::dperb::dPERBxdzz));
-      perturbedResult[Rec::a_yz] = HALF * (der_i2j1k1->at(fsgrids::dperb::dPERBxdyz) + der_i1j1k1->at(fsgrids::dperb::dPERBxdyz));
-      perturbedResult[Rec::a_xyy] = (der_i2j1k1->at(fsgrids::dperb::dPERBxdyy) - der_i1j1k1->at(fsgrids::dperb::dPERBxdyy));
-      perturbedResult[Rec::a_xyz] = (der_i2j1k1->at(fsgrids::dperb::dPERBxdyz) - der_i1j1k1->at(fsgrids::dperb::dPERBxdyz));
-      perturbedResult[Rec::a_xzz] = (der_i2j1k1->at(fsgrids::dperb::dPERBxdzz) - der_i1j1k1->at(fsgrids::dperb::dPERBxdzz));
+      perturbedResult[Rec::a_yy] = HALF * (der_i2j1k1.at(fsgrids::dperb::dPERBxdyy) + der_i1j1k1.at(fsgrids::dperb::dPERBxdyy));
+      perturbedResult[Rec::a_zz] = HALF * (der_i2j1k1.at(fsgrids::dperb::dPERBxdzz) + der_i1j1k1.at(fsgrids::dperb::dPERBxdzz));
+      perturbedResult[Rec::a_yz] = HALF * (der_i2j1k1.at(fsgrids::dperb::dPERBxdyz) + der_i1j1k1.at(fsgrids::dperb::dPERBxdyz));
+      perturbedResult[Rec::a_xyy] = (der_i2j1k1.at(fsgrids::dperb::dPERBxdyy) - der_i1j1k1.at(fsgrids::dperb::dPERBxdyy));
+      perturbedResult[Rec::a_xyz] = (der_i2j1k1.at(fsgrids::dperb::dPERBxdyz) - der_i1j1k1.at(fsgrids::dperb::dPERBxdyz));
+      perturbedResult[Rec::a_xzz] = (der_i2j1k1.at(fsgrids::dperb::dPERBxdzz) - der_i1j1k1.at(fsgrids::dperb::dPERBxdzz));
       
-      perturbedResult[Rec::b_xx] = HALF * (der_i1j2k1->at(fsgrids::dperb::dPERBydxx) + der_i1j1k1->at(fsgrids::dperb::dPERBydxx));
-      perturbedResult[Rec::b_xz] = HALF * (der_i1j2k1->at(fsgrids::dperb::dPERBydxz) + der_i1j1k1->at(fsgrids::dperb::dPERBydxz));
-      perturbedResult[Rec::b_zz] = HALF * (der_i1j2k1->at(fsgrids::dperb::dPERBydzz) + der_i1j1k1->at(fsgrids::dperb::dPERBydzz));
-      perturbedResult[Rec::b_xxy] = (der_i1j2k1->at(fsgrids::dperb::dPERBydxx) - der_i1j1k1->at(fsgrids::dperb::dPERBydxx));
-      perturbedResult[Rec::b_xyz] = (der_i1j2k1->at(fsgrids::dperb::dPERBydxz) - der_i1j1k1->at(fsgrids::dperb::dPERBydxz));
-      perturbedResult[Rec::b_yzz] = (der_i1j2k1->at(fsgrids::dperb::dPERBydzz) - der_i1j1k1->at(fsgrids::dperb::dPERBydzz));
+      perturbedResult[Rec::b_xx] = HALF * (der_i1j2k1.at(fsgrids::dperb::dPERBydxx) + der_i1j1k1.at(fsgrids::dperb::dPERBydxx));
+      perturbedResult[Rec::b_xz] = HALF * (der_i1j2k1.at(fsgrids::dperb::dPERBydxz) + der_i1j1k1.at(fsgrids::dperb::dPERBydxz));
+      perturbedResult[Rec::b_zz] = HALF * (der_i1j2k1.at(fsgrids::dperb::dPERBydzz) + der_i1j1k1.at(fsgrids::dperb::dPERBydzz));
+      perturbedResult[Rec::b_xxy] = (der_i1j2k1.at(fsgrids::dperb::dPERBydxx) - der_i1j1k1.at(fsgrids::dperb::dPERBydxx));
+      perturbedResult[Rec::b_xyz] = (der_i1j2k1.at(fsgrids::dperb::dPERBydxz) - der_i1j1k1.at(fsgrids::dperb::dPERBydxz));
+      perturbedResult[Rec::b_yzz] = (der_i1j2k1.at(fsgrids::dperb::dPERBydzz) - der_i1j1k1.at(fsgrids::dperb::dPERBydzz));
       
-      perturbedResult[Rec::c_xx] = HALF * (der_i1j1k2->at(fsgrids::dperb::dPERBzdxx) + der_i1j1k1->at(fsgrids::dperb::dPERBzdxx));
-      perturbedResult[Rec::c_xy] = HALF * (der_i1j1k2->at(fsgrids::dperb::dPERBzdxy) + der_i1j1k1->at(fsgrids::dperb::dPERBzdxy));
-      perturbedResult[Rec::c_yy] = HALF * (der_i1j1k2->at(fsgrids::dperb::dPERBzdyy) + der_i1j1k1->at(fsgrids::dperb::dPERBzdyy));
-      perturbedResult[Rec::c_xxz] = (der_i1j1k2->at(fsgrids::dperb::dPERBzdxx) - der_i1j1k1->at(fsgrids::dperb::dPERBzdxx));
-      perturbedResult[Rec::c_xyz] = (der_i1j1k2->at(fsgrids::dperb::dPERBzdxy) - der_i1j1k1->at(fsgrids::dperb::dPERBzdxy));
-      perturbedResult[Rec::c_yyz] = (der_i1j1k2->at(fsgrids::dperb::dPERBzdyy) - der_i1j1k1->at(fsgrids::dperb::dPERBzdyy));
+      perturbedResult[Rec::c_xx] = HALF * (der_i1j1k2.at(fsgrids::dperb::dPERBzdxx) + der_i1j1k1.at(fsgrids::dperb::dPERBzdxx));
+      perturbedResult[Rec::c_xy] = HALF * (der_i1j1k2.at(fsgrids::dperb::dPERBzdxy) + der_i1j1k1.at(fsgrids::dperb::dPERBzdxy));
+      perturbedResult[Rec::c_yy] = HALF * (der_i1j1k2.at(fsgrids::dperb::dPERBzdyy) + der_i1j1k1.at(fsgrids::dperb::dPERBzdyy));
+      perturbedResult[Rec::c_xxz] = (der_i1j1k2.at(fsgrids::dperb::dPERBzdxx) - der_i1j1k1.at(fsgrids::dperb::dPERBzdxx));
+      perturbedResult[Rec::c_xyz] = (der_i1j1k2.at(fsgrids::dperb::dPERBzdxy) - der_i1j1k1.at(fsgrids::dperb::dPERBzdxy));
+      perturbedResult[Rec::c_yyz] = (der_i1j1k2.at(fsgrids::dperb::dPERBzdyy) - der_i1j1k1.at(fsgrids::dperb::dPERBzdyy));
       
       perturbedResult[Rec::a_xxx] = -THIRD*(perturbedResult[Rec::b_xxy] + perturbedResult[Rec::c_xxz]);
       perturbedResult[Rec::a_xxy] = -FOURTH*perturbedResult[Rec::c_xyz];
@@ -163,28 +219,28 @@ void reconstructionCoefficients(
    }
    
    // Calculate 2nd order reconstruction coefficients:
-   perturbedResult[Rec::a_xy] = der_i2j1k1->at(fsgrids::dperb::dPERBxdy) - der_i1j1k1->at(fsgrids::dperb::dPERBxdy);
-   perturbedResult[Rec::a_xz] = der_i2j1k1->at(fsgrids::dperb::dPERBxdz) - der_i1j1k1->at(fsgrids::dperb::dPERBxdz);
-   perturbedResult[Rec::a_y ] = HALF*(der_i2j1k1->at(fsgrids::dperb::dPERBxdy) + der_i1j1k1->at(fsgrids::dperb::dPERBxdy)) - SIXTH*perturbedResult[Rec::a_xxy];
-   perturbedResult[Rec::a_z ] = HALF*(der_i2j1k1->at(fsgrids::dperb::dPERBxdz) + der_i1j1k1->at(fsgrids::dperb::dPERBxdz)) - SIXTH*perturbedResult[Rec::a_xxz];
+   perturbedResult[Rec::a_xy] = der_i2j1k1.at(fsgrids::dperb::dPERBxdy) - der_i1j1k1.at(fsgrids::dperb::dPERBxdy);
+   perturbedResult[Rec::a_xz] = der_i2j1k1.at(fsgrids::dperb::dPERBxdz) - der_i1j1k1.at(fsgrids::dperb::dPERBxdz);
+   perturbedResult[Rec::a_y ] = HALF*(der_i2j1k1.at(fsgrids::dperb::dPERBxdy) + der_i1j1k1.at(fsgrids::dperb::dPERBxdy)) - SIXTH*perturbedResult[Rec::a_xxy];
+   perturbedResult[Rec::a_z ] = HALF*(der_i2j1k1.at(fsgrids::dperb::dPERBxdz) + der_i1j1k1.at(fsgrids::dperb::dPERBxdz)) - SIXTH*perturbedResult[Rec::a_xxz];
    
-   perturbedResult[Rec::b_xy] = der_i1j2k1->at(fsgrids::dperb::dPERBydx) - der_i1j1k1->at(fsgrids::dperb::dPERBydx);
-   perturbedResult[Rec::b_yz] = der_i1j2k1->at(fsgrids::dperb::dPERBydz) - der_i1j1k1->at(fsgrids::dperb::dPERBydz);
-   perturbedResult[Rec::b_x ] = HALF*(der_i1j2k1->at(fsgrids::dperb::dPERBydx) + der_i1j1k1->at(fsgrids::dperb::dPERBydx)) - SIXTH*perturbedResult[Rec::b_xyy];
-   perturbedResult[Rec::b_z ] = HALF*(der_i1j2k1->at(fsgrids::dperb::dPERBydz) + der_i1j1k1->at(fsgrids::dperb::dPERBydz)) - SIXTH*perturbedResult[Rec::b_yyz];
+   perturbedResult[Rec::b_xy] = der_i1j2k1.at(fsgrids::dperb::dPERBydx) - der_i1j1k1.at(fsgrids::dperb::dPERBydx);
+   perturbedResult[Rec::b_yz] = der_i1j2k1.at(fsgrids::dperb::dPERBydz) - der_i1j1k1.at(fsgrids::dperb::dPERBydz);
+   perturbedResult[Rec::b_x ] = HALF*(der_i1j2k1.at(fsgrids::dperb::dPERBydx) + der_i1j1k1.at(fsgrids::dperb::dPERBydx)) - SIXTH*perturbedResult[Rec::b_xyy];
+   perturbedResult[Rec::b_z ] = HALF*(der_i1j2k1.at(fsgrids::dperb::dPERBydz) + der_i1j1k1.at(fsgrids::dperb::dPERBydz)) - SIXTH*perturbedResult[Rec::b_yyz];
    
-   perturbedResult[Rec::c_xz] = der_i1j1k2->at(fsgrids::dperb::dPERBzdx) - der_i1j1k1->at(fsgrids::dperb::dPERBzdx);
-   perturbedResult[Rec::c_yz] = der_i1j1k2->at(fsgrids::dperb::dPERBzdy) - der_i1j1k1->at(fsgrids::dperb::dPERBzdy);
-   perturbedResult[Rec::c_x ] = HALF*(der_i1j1k2->at(fsgrids::dperb::dPERBzdx) + der_i1j1k1->at(fsgrids::dperb::dPERBzdx)) - SIXTH*perturbedResult[Rec::c_xzz];
-   perturbedResult[Rec::c_y ] = HALF*(der_i1j1k2->at(fsgrids::dperb::dPERBzdy) + der_i1j1k1->at(fsgrids::dperb::dPERBzdy)) - SIXTH*perturbedResult[Rec::c_yzz];
+   perturbedResult[Rec::c_xz] = der_i1j1k2.at(fsgrids::dperb::dPERBzdx) - der_i1j1k1.at(fsgrids::dperb::dPERBzdx);
+   perturbedResult[Rec::c_yz] = der_i1j1k2.at(fsgrids::dperb::dPERBzdy) - der_i1j1k1.at(fsgrids::dperb::dPERBzdy);
+   perturbedResult[Rec::c_x ] = HALF*(der_i1j1k2.at(fsgrids::dperb::dPERBzdx) + der_i1j1k1.at(fsgrids::dperb::dPERBzdx)) - SIXTH*perturbedResult[Rec::c_xzz];
+   perturbedResult[Rec::c_y ] = HALF*(der_i1j1k2.at(fsgrids::dperb::dPERBzdy) + der_i1j1k1.at(fsgrids::dperb::dPERBzdy)) - SIXTH*perturbedResult[Rec::c_yzz];
    
    perturbedResult[Rec::a_xx] = -HALF*(perturbedResult[Rec::b_xy] + perturbedResult[Rec::c_xz]);
    perturbedResult[Rec::b_yy] = -HALF*(perturbedResult[Rec::a_xy] + perturbedResult[Rec::c_yz]);
    perturbedResult[Rec::c_zz] = -HALF*(perturbedResult[Rec::a_xz] + perturbedResult[Rec::b_yz]);
          
-   perturbedResult[Rec::a_x ] = cep_i2j1k1->at(fsgrids::bfield::PERBX) - cep_i1j1k1->at(fsgrids::bfield::PERBX) - TENTH*perturbedResult[Rec::a_xxx];
-   perturbedResult[Rec::b_y ] = cep_i1j2k1->at(fsgrids::bfield::PERBY) - cep_i1j1k1->at(fsgrids::bfield::PERBY) - TENTH*perturbedResult[Rec::b_yyy];
-   perturbedResult[Rec::c_z ] = cep_i1j1k2->at(fsgrids::bfield::PERBZ) - cep_i1j1k1->at(fsgrids::bfield::PERBZ) - TENTH*perturbedResult[Rec::c_zzz];
+   perturbedResult[Rec::a_x ] = cep_i2j1k1.at(fsgrids::bfield::PERBX) - cep_i1j1k1.at(fsgrids::bfield::PERBX) - TENTH*perturbedResult[Rec::a_xxx];
+   perturbedResult[Rec::b_y ] = cep_i1j2k1.at(fsgrids::bfield::PERBY) - cep_i1j1k1.at(fsgrids::bfield::PERBY) - TENTH*perturbedResult[Rec::b_yyy];
+   perturbedResult[Rec::c_z ] = cep_i1j1k2.at(fsgrids::bfield::PERBZ) - cep_i1j1k1.at(fsgrids::bfield::PERBZ) - TENTH*perturbedResult[Rec::c_zzz];
 
    #else
    for (int i=0; i<Rec::N_REC_COEFFICIENTS; ++i) {
@@ -193,8 +249,8 @@ void reconstructionCoefficients(
    #endif
 
    // Calculate 1st order reconstruction coefficients:
-   perturbedResult[Rec::a_0 ] = HALF*(cep_i2j1k1->at(fsgrids::bfield::PERBX) + cep_i1j1k1->at(fsgrids::bfield::PERBX)) - SIXTH*perturbedResult[Rec::a_xx];
-   perturbedResult[Rec::b_0 ] = HALF*(cep_i1j2k1->at(fsgrids::bfield::PERBY) + cep_i1j1k1->at(fsgrids::bfield::PERBY)) - SIXTH*perturbedResult[Rec::b_yy];
-   perturbedResult[Rec::c_0 ] = HALF*(cep_i1j1k2->at(fsgrids::bfield::PERBZ) + cep_i1j1k1->at(fsgrids::bfield::PERBZ)) - SIXTH*perturbedResult[Rec::c_zz];
+   perturbedResult[Rec::a_0 ] = HALF*(cep_i2j1k1.at(fsgrids::bfield::PERBX) + cep_i1j1k1.at(fsgrids::bfield::PERBX)) - SIXTH*perturbedResult[Rec::a_xx];
+   perturbedResult[Rec::b_0 ] = HALF*(cep_i1j2k1.at(fsgrids::bfield::PERBY) + cep_i1j1k1.at(fsgrids::bfield::PERBY)) - SIXTH*perturbedResult[Rec::b_yy];
+   perturbedResult[Rec::c_0 ] = HALF*(cep_i1j1k2.at(fsgrids::bfield::PERBZ) + cep_i1j1k1.at(fsgrids::bfield::PERBZ)) - SIXTH*perturbedResult[Rec::c_zz];
 }
 
@@ -40,6 +40,7 @@
 #include "../projects/project.h"
 #include "../sysboundary/sysboundary.h"
 #include "../sysboundary/sysboundarycondition.h"
+#include "../telemetry.h"
 
 // Constants: not needed as such, but if field solver is implemented on GPUs 
 // these force CPU to use float accuracy, which in turn helps to compare 
@@ -61,6 +62,37 @@ static creal EPS = 1.0e-30;
 
 using namespace std;
 
+/*! Handle to the field components of one cell of a field solver grid.
+ *
+ * The field solver reads and writes field components only through fsCell and FsCell::at.
+ * FsGrid currently stores all components of a cell contiguously (array of structures), so the
+ * handle is a pointer to the cell. Once FsGrid can store each component as a separate array,
+ * this class and fsCell are the only code that has to change (see mini-apps/fsgrid_layout).
+ */
+template<size_t N> class FsCell {
+ public:
+   FsCell(std::array<Real,N>* cell=NULL): cell(cell) { }
+
+   /*! Field component c of the cell.*/
+   inline Real& at(const int c) const {return cell->at(c);}
+
+   /*! Returns true if the cell is in the local domain or its ghost layers.*/
+   inline bool exists() const {return cell != NULL;}
+
+ private:
+   std::array<Real,N>* cell;
+};
+
+/*! Handle to cell (i,j,k) of a field solver grid, see FsCell.*/
+template<size_t N, int stencil> inline FsCell<N> fsCell(FsGrid< std::array<Real,N>, stencil> & grid,cint i,cint j,cint k) {
+   return FsCell<N>(grid.get(i,j,k));
+}
+
+/*! Handle to the cell of a field solver grid with the given local ID, see FsCell.*/
+template<size_t N, int stencil> inline FsCell<N> fsCell(FsGrid< std::array<Real,N>, stencil> & grid,const int64_t localID) {
+   return FsCell<N>(grid.get(localID));
+}
+
 bool initializeFieldPropagator(
    FsGrid< std::array<Real, fsgrids::bfield::N_BFIELD>, 2> & perBGrid,
    FsGrid< std::array<Real, fsgrids::bfield::N_BFIELD>, 2> & perBDt2Grid,
@@ -124,4 +156,46 @@ void reconstructionCoefficients(
    creal& reconstructionOrder
 );
 
+/*! Run of consecutive interior (NOT_SYSBOUNDARY) cells along i in the local field solver grid.*/
+struct FsCellRun {
+   int iBegin; /*!< First i index of the run.*/
+   int iEnd;   /*!< One past the last i index of the run.*/
+   int j;
+   int k;
+};
+
+/*! Local system boundary cell of the field solver grid with its boundary condition.*/
+struct FsBoundaryCell {
+   int i;
+   int j;
+   int k;
+   uint sysBoundaryLayer;
+   SBC::SysBoundaryCondition* sysBoundary;
+};
+
+/*! Local cells of the field solver grid classified by their system boundary type, so that the
+ * field solver kernels do not branch on the boundary flags or look up boundary conditions per cell.
+ * DO_NOT_COMPUTE cells are in neither list.
+ */
+struct FsCellLists {
+   std::vector<FsCellRun> interiorRuns;       /*!< Interior cells, as runs along i.*/
+   std::vector<FsBoundaryCell> boundaryCells; /*!< System boundary cells.*/
+   size_t nInteriorCells;                     /*!< Number of cells in interiorRuns.*/
+};
+
+/*! Get the classified local cells of the field solver grid. The lists are built on the first
+ * call after invalidateFsCellLists. Not thread-safe, has to be called outside parallel regions.
+ * \param technicalGrid fsGrid holding technical information (such as boundary types)
+ * \param sysBoundaries System boundary conditions existing
+ */
+const FsCellLists& getFsCellLists(
+   FsGrid< fsgrids::technical, 2> & technicalGrid,
+   SysBoundary& sysBoundaries
+);
+
+/*! Mark the classified cell lists out of date. Has to be called whenever the system boundary
+ * flags or layers of the technical grid change.
+ */
+void invalidateFsCellLists();
+
 #endif
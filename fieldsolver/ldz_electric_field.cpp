@@ -118,22 +118,22 @@ void calculateWaveSpeedYZ(
    Real& ret_vS,
    Real& ret_vW
 ) {
-   std::array<Real, fsgrids::bfield::N_BFIELD> * perb = perBGrid.get(i,j,k);
-   std::array<Real, fsgrids::bfield::N_BFIELD> * nbr_perb = perBGrid.get(nbi,nbj,nbk);
-   std::array<Real, fsgrids::moments::N_MOMENTS> * moments = momentsGrid.get(i,j,k);
-   std::array<Real, fsgrids::dmoments::N_DMOMENTS> * dmoments = dMomentsGrid.get(i,j,k);
-   std::array<Real, fsgrids::dperb::N_DPERB> * dperb = dPerBGrid.get(i,j,k);
-   std::array<Real, fsgrids::dperb::N_DPERB> * nbr_dperb = dPerBGrid.get(nbi,nbj,nbk);
-   std::array<Real, fsgrids::bgbfield::N_BGB> * bgb = BgBGrid.get(i,j,k);
-   std::array<Real, fsgrids::bgbfield::N_BGB> *  nbr_bgb = BgBGrid.get(nbi,nbj,nbk);
+   FsCell<fsgrids::bfield::N_BFIELD> perb = fsCell(perBGrid,i,j,k);
+   FsCell<fsgrids::bfield::N_BFIELD> nbr_perb = fsCell(perBGrid,nbi,nbj,nbk);
+   FsCell<fsgrids::moments::N_MOMENTS> moments = fsCell(momentsGrid,i,j,k);
+   FsCell<fsgrids::dmoments::N_DMOMENTS> dmoments = fsCell(dMomentsGrid,i,j,k);
+   FsCell<fsgrids::dperb::N_DPERB> dperb = fsCell(dPerBGrid,i,j,k);
+   FsCell<fsgrids::dperb::N_DPERB> nbr_dperb = fsCell(dPerBGrid,nbi,nbj,nbk);
+   FsCell<fsgrids::bgbfield::N_BGB> bgb = fsCell(BgBGrid,i,j,k);
+   FsCell<fsgrids::bgbfield::N_BGB> nbr_bgb = fsCell(BgBGrid,nbi,nbj,nbk);
    
    Real A_0, A_X, rhom, p11, p22, p33;
-   A_0  = HALF*(nbr_perb->at(fsgrids::bfield::PERBX) + nbr_bgb->at(fsgrids::bgbfield::BGBX) + perb->at(fsgrids::bfield::PERBX) + bgb->at(fsgrids::bgbfield::BGBX));
-   A_X  = (nbr_perb->at(fsgrids::bfield::PERBX) + nbr_bgb->at(fsgrids::bgbfield::BGBX)) - (perb->at(fsgrids::bfield::PERBX) + bgb->at(fsgrids::bgbfield::BGBX));
-   rhom = moments->at(fsgrids::moments::RHOM) + ydir*HALF*dmoments->at(fsgrids::dmoments::drhomdy) + zdir*HALF*dmoments->at(fsgrids::dmoments::drhomdz);
-   p11 = moments->at(fsgrids::moments::P_11) + ydir*HALF*dmoments->at(fsgrids::dmoments::dp11dy) + zdir*HALF*dmoments->at(fsgrids::dmoments::dp11dz);
-   p22 = moments->at(fsgrids::moments::P_22) + ydir*HALF*dmoments->at(fsgrids::dmoments::dp22dy) + zdir*HALF*dmoments->at(fsgrids::dmoments::dp22dz);
-   p33 = moments->at(fsgrids::moments::P_33) + ydir*HALF*dmoments->at(fsgrids::dmoments::dp33dy) + zdir*HALF*dmoments->at(fsgrids::dmoments::dp33dz);
+   A_0  = HALF*(nbr_perb.at(fsgrids::bfield::PERBX) + nbr_bgb.at(fsgrids::bgbfield::BGBX) + perb.at(fsgrids::bfield::PERBX) + bgb.at(fsgrids::bgbfield::BGBX));
+   A_X  = (nbr_perb.at(fsgrids::bfield::PERBX) + nbr_bgb.at(fsgrids::bgbfield::BGBX)) - (perb.at(fsgrids::bfield::PERBX) + bgb.at(fsgrids::bgbfield::BGBX));
+   rhom = moments.at(fsgrids::moments::RHOM) + ydir*HALF*dmoments.at(fsgrids::dmoments::drhomdy) + zdir*HALF*dmoments.at(fsgrids::dmoments::drhomdz);
+   p11 = moments.at(fsgrids::moments::P_11) + ydir*HALF*dmoments.at(fsgrids::dmoments::dp11dy) + zdir*HALF*dmoments.at(fsgrids::dmoments::dp11dz);
+   p22 = moments.at(fsgrids::moments::P_22) + ydir*HALF*dmoments.at(fsgrids::dmoments::dp22dy) + zdir*HALF*dmoments.at(fsgrids::dmoments::dp22dz);
+   p33 = moments.at(fsgrids::moments::P_33) + ydir*HALF*dmoments.at(fsgrids::dmoments::dp33dy) + zdir*HALF*dmoments.at(fsgrids::dmoments::dp33dz);
    
    if (rhom < minRhom) {
       rhom = minRhom;
@@ -141,10 +141,10 @@ void calculateWaveSpeedYZ(
       rhom = maxRhom;
    }
    
-   const Real A_Y  = nbr_dperb->at(fsgrids::dperb::dPERBxdy) + nbr_bgb->at(fsgrids::bgbfield::dBGBxdy) + dperb->at(fsgrids::dperb::dPERBxdy) + bgb->at(fsgrids::bgbfield::dBGBxdy);
-   const Real A_XY = nbr_dperb->at(fsgrids::dperb::dPERBxdy) + nbr_bgb->at(fsgrids::bgbfield::dBGBxdy) - (dperb->at(fsgrids::dperb::dPERBxdy) + bgb->at(fsgrids::bgbfield::dBGBxdy));
-   const Real A_Z  = nbr_dperb->at(fsgrids::dperb::dPERBxdz) + nbr_bgb->at(fsgrids::bgbfield::dBGBxdz) + dperb->at(fsgrids::dperb::dPERBxdz) + bgb->at(fsgrids::bgbfield::dBGBxdz);
-   const Real A_XZ = nbr_dperb->at(fsgrids::dperb::dPERBxdz) + nbr_bgb->at(fsgrids::bgbfield::dBGBxdz) - (dperb->at(fsgrids::dperb::dPERBxdz) + bgb->at(fsgrids::bgbfield::dBGBxdz));
+   const Real A_Y  = nbr_dperb.at(fsgrids::dperb::dPERBxdy) + nbr_bgb.at(fsgrids::bgbfield::dBGBxdy) + dperb.at(fsgrids::dperb::dPERBxdy) + bgb.at(fsgrids::bgbfield::dBGBxdy);
+   const Real A_XY = nbr_dperb.at(fsgrids::dperb::dPERBxdy) + nbr_bgb.at(fsgrids::bgbfield::dBGBxdy) - (dperb.at(fsgrids::dperb::dPERBxdy) + bgb.at(fsgrids::bgbfield::dBGBxdy));
+   const Real A_Z  = nbr_dperb.at(fsgrids::dperb::dPERBxdz) + nbr_bgb.at(fsgrids::bgbfield::dBGBxdz) + dperb.at(fsgrids::dperb::dPERBxdz) + bgb.at(fsgrids::bgbfield::dBGBxdz);
+   const Real A_XZ = nbr_dperb.at(fsgrids::dperb::dPERBxdz) + nbr_bgb.at(fsgrids::bgbfield::dBGBxdz) - (dperb.at(fsgrids::dperb::dPERBxdz) + bgb.at(fsgrids::bgbfield::dBGBxdz));
 
    const Real Bx2  = (A_0 + ydir*HALF*A_Y + zdir*HALF*A_Z)*(A_0 + ydir*HALF*A_Y + zdir*HALF*A_Z)
      + TWELWTH*(A_X + ydir*HALF*A_XY + zdir*HALF*A_XZ)*(A_X + ydir*HALF*A_XY + zdir*HALF*A_XZ); // OK
@@ -232,22 +232,22 @@ void calculateWaveSpeedXZ(
    Real& ret_vS,
    Real& ret_vW
 ) {
-   std::array<Real, fsgrids::bfield::N_BFIELD> * perb = perBGrid.get(i,j,k);
-   std::array<Real, fsgrids::bfield::N_BFIELD> * nbr_perb = perBGrid.get(nbi,nbj,nbk);
-   std::array<Real, fsgrids::moments::N_MOMENTS> * moments = momentsGrid.get(i,j,k);
-   std::array<Real, fsgrids::dmoments::N_DMOMENTS> * dmoments = dMomentsGrid.get(i,j,k);
-   std::array<Real, fsgrids::dperb::N_DPERB> * dperb = dPerBGrid.get(i,j,k);
-   std::array<Real, fsgrids::dperb::N_DPERB> * nbr_dperb = dPerBGrid.get(nbi,nbj,nbk);
-   std::array<Real, fsgrids::bgbfield::N_BGB> * bgb = BgBGrid.get(i,j,k);
-   std::array<Real, fsgrids::bgbfield::N_BGB> *  nbr_bgb = BgBGrid.get(nbi,nbj,nbk);
+   FsCell<fsgrids::bfield::N_BFIELD> perb = fsCell(perBGrid,i,j,k);
+   FsCell<fsgrids::bfield::N_BFIELD> nbr_perb = fsCell(perBGrid,nbi,nbj,nbk);
+   FsCell<fsgrids::moments::N_MOMENTS> moments = fsCell(momentsGrid,i,j,k);
+   FsCell<fsgrids::dmoments::N_DMOMENTS> dmoments = fsCell(dMomentsGrid,i,j,k);
+   FsCell<fsgrids::dperb::N_DPERB> dperb = fsCell(dPerBGrid,i,j,k);
+   FsCell<fsgrids::dperb::N_DPERB> nbr_dperb = fsCell(dPerBGrid,nbi,nbj,nbk);
+   FsCell<fsgrids::bgbfield::N_BGB> bgb = fsCell(BgBGrid,i,j,k);
+   FsCell<fsgrids::bgbfield::N_BGB> nbr_bgb = fsCell(BgBGrid,nbi,nbj,nbk);
    
    Real B_0, B_Y, rhom, p11, p22, p33;
-   B_0  = HALF*(nbr_perb->at(fsgrids::bfield::PERBY) + nbr_bgb->at(fsgrids::bgbfield::BGBY) + perb->at(fsgrids::bfield::PERBY) + bgb->at(fsgrids::bgbfield::BGBY));
-   B_Y  = (nbr_perb->at(fsgrids::bfield::PERBY) + nbr_bgb->at(fsgrids::bgbfield::BGBY)) - (perb->at(fsgrids::bfield::PERBY) + bgb->at(fsgrids::bgbfield::BGBY));
-   rhom = moments->at(fsgrids::moments::RHOM) + xdir*HALF*dmoments->at(fsgrids::dmoments::drhomdx) + zdir*HALF*dmoments->at(fsgrids::dmoments::drhomdz);
-   p11 = moments->at(fsgrids::moments::P_11) + xdir*HALF*dmoments->at(fsgrids::dmoments::dp11dx) + zdir*HALF*dmoments->at(fsgrids::dmoments::dp11dz);
-   p22 = moments->at(fsgrids::moments::P_22) + xdir*HALF*dmoments->at(fsgrids::dmoments::dp22dx) + zdir*HALF*dmoments->at(fsgrids::dmoments::dp22dz);
-   p33 = moments->at(fsgrids::moments::P_33) + xdir*HALF*dmoments->at(fsgrids::dmoments::dp33dx) + zdir*HALF*dmoments->at(fsgrids::dmoments::dp33dz);
+   B_0  = HALF*(nbr_perb.at(fsgrids::bfield::PERBY) + nbr_bgb.at(fsgrids::bgbfield::BGBY) + perb.at(fsgrids::bfield::PERBY) + bgb.at(fsgrids::bgbfield::BGBY));
+   B_Y  = (nbr_perb.at(fsgrids::bfield::PERBY) + nbr_bgb.at(fsgrids::bgbfield::BGBY)) - (perb.at(fsgrids::bfield::PERBY) + bgb.at(fsgrids::bgbfield::BGBY));
+   rhom = moments.at(fsgrids::moments::RHOM) + xdir*HALF*dmoments.at(fsgrids::dmoments::drhomdx) + zdir*HALF*dmoments.at(fsgrids::dmoments::drhomdz);
+   p11 = moments.at(fsgrids::moments::P_11) + xdir*HALF*dmoments.at(fsgrids::dmoments::dp11dx) + zdir*HALF*dmoments.at(fsgrids::dmoments::dp11dz);
+   p22 = moments.at(fsgrids::moments::P_22) + xdir*HALF*dmoments.at(fsgrids::dmoments::dp22dx) + zdir*HALF*dmoments.at(fsgrids::dmoments::dp22dz);
+   p33 = moments.at(fsgrids::moments::P_33) + xdir*HALF*dmoments.at(fsgrids::dmoments::dp33dx) + zdir*HALF*dmoments.at(fsgrids::dmoments::dp33dz);
    
    if (rhom < minRhom) {
       rhom = minRhom;
@@ -255,10 +255,10 @@ void calculateWaveSpeedXZ(
       rhom = maxRhom;
    }
    
-   const Real B_X  = nbr_dperb->at(fsgrids::dperb::dPERBydx) + nbr_bgb->at(fsgrids::bgbfield::dBGBydx) + dperb->at(fsgrids::dperb::dPERBydx) + bgb->at(fsgrids::bgbfield::dBGBydx);
-   const Real B_XY = nbr_dperb->at(fsgrids::dperb::dPERBydx) + nbr_bgb->at(fsgrids::bgbfield::dBGBydx) - (dperb->at(fsgrids::dperb::dPERBydx) + bgb->at(fsgrids::bgbfield::dBGBydx));
-   const Real B_Z  = nbr_dperb->at(fsgrids::dperb::dPERBydz) + nbr_bgb->at(fsgrids::bgbfield::dBGBydz) + dperb->at(fsgrids::dperb::dPERBydz) + bgb->at(fsgrids::bgbfield::dBGBydz);
-   const Real B_YZ = nbr_dperb->at(fsgrids::dperb::dPERBydz) + nbr_bgb->at(fsgrids::bgbfield::dBGBydz) - (dperb->at(fsgrids::dperb::dPERBydz) + bgb->at(fsgrids::bgbfield::dBGBydz));
+   const Real B_X  = nbr_dperb.at(fsgrids::dperb::dPERBydx) + nbr_bgb.at(fsgrids::bgbfield::dBGBydx) + dperb.at(fsgrids::dperb::dPERBydx) + bgb.at(fsgrids::bgbfield::dBGBydx);
+   const Real B_XY = nbr_dperb.at(fsgrids::dperb::dPERBydx) + nbr_bgb.at(fsgrids::bgbfield::dBGBydx) - (dperb.at(fsgrids::dperb::dPERBydx) + bgb.at(fsgrids::bgbfield::dBGBydx));
+   const Real B_Z  = nbr_dperb.at(fsgrids::dperb::dPERBydz) + nbr_bgb.at(fsgrids::bgbfield::dBGBydz) + dperb.at(fsgrids::dperb::dPERBydz) + bgb.at(fsgrids::bgbfield::dBGBydz);
+   const Real B_YZ = nbr_dperb.at(fsgrids::dperb::dPERBydz) + nbr_bgb.at(fsgrids::bgbfield::dBGBydz) - (dperb.at(fsgrids::dperb::dPERBydz) + bgb.at(fsgrids::bgbfield::dBGBydz));
       
    const Real By2  = (B_0 + xdir*HALF*B_X + zdir*HALF*B_Z)*(B_0 + xdir*HALF*B_X + zdir*HALF*B_Z)
      + TWELWTH*(B_Y + xdir*HALF*B_XY + zdir*HALF*B_YZ)*(B_Y + xdir*HALF*B_XY + zdir*HALF*B_YZ); // OK
@@ -346,22 +346,22 @@ void calculateWaveSpeedXY(
    Real& ret_vS,
    Real& ret_vW
 ) {
-   std::array<Real, fsgrids::bfield::N_BFIELD> * perb = perBGrid.get(i,j,k);
-   std::array<Real, fsgrids::bfield::N_BFIELD> * nbr_perb = perBGrid.get(nbi,nbj,nbk);
-   std::array<Real, fsgrids::moments::N_MOMENTS> * moments = momentsGrid.get(i,j,k);
-   std::array<Real, fsgrids::dmoments::N_DMOMENTS> * dmoments = dMomentsGrid.get(i,j,k);
-   std::array<Real, fsgrids::dperb::N_DPERB> * dperb = dPerBGrid.get(i,j,k);
-   std::array<Real, fsgrids::dperb::N_DPERB> * nbr_dperb = dPerBGrid.get(nbi,nbj,nbk);
-   std::array<Real, fsgrids::bgbfield::N_BGB> * bgb = BgBGrid.get(i,j,k);
-   std::array<Real, fsgrids::bgbfield::N_BGB> *  nbr_bgb = BgBGrid.get(nbi,nbj,nbk);
+   FsCell<fsgrids::bfield::N_BFIELD> perb = fsCell(perBGrid,i,j,k);
+   FsCell<fsgrids::bfield::N_BFIELD> nbr_perb = fsCell(perBGrid,nbi,nbj,nbk);
+   FsCell<fsgrids::moments::N_MOMENTS> moments = fsCell(momentsGrid,i,j,k);
+   FsCell<fsgrids::dmoments::N_DMOMENTS> dmoments = fsCell(dMomentsGrid,i,j,k);
+   FsCell<fsgrids::dperb::N_DPERB> dperb = fsCell(dPerBGrid,i,j,k);
+   FsCell<fsgrids::dperb::N_DPERB> nbr_dperb = fsCell(dPerBGrid,nbi,nbj,nbk);
+   FsCell<fsgrids::bgbfield::N_BGB> bgb = fsCell(BgBGrid,i,j,k);
+   FsCell<fsgrids::bgbfield::N_BGB> nbr_bgb = fsCell(BgBGrid,nbi,nbj,nbk);
    
    Real C_0, C_Z, rhom, p11, p22, p33;
-   C_0  = HALF*(nbr_perb->at(fsgrids::bfield::PERBZ) + nbr_bgb->at(fsgrids::bgbfield::BGBZ) + perb->at(fsgrids::bfield::PERBZ) + bgb->at(fsgrids::bgbfield::BGBZ));
-   C_Z  = (nbr_perb->at(fsgrids::bfield::PERBZ) + nbr_bgb->at(fsgrids::bgbfield::BGBZ)) - (perb->at(fsgrids::bfield::PERBZ) + bgb->at(fsgrids::bgbfield::BGBZ));
-   rhom = moments->at(fsgrids::moments::RHOM) + xdir*HALF*dmoments->at(fsgrids::dmoments::drhomdx) + ydir*HALF*dmoments->at(fsgrids::dmoments::drhomdy);
-   p11 = moments->at(fsgrids::moments::P_11) + xdir*HALF*dmoments->at(fsgrids::dmoments::dp11dx) + ydir*HALF*dmoments->at(fsgrids::dmoments::dp11dy);
-   p22 = moments->at(fsgrids::moments::P_22) + xdir*HALF*dmoments->at(fsgrids::dmoments::dp22dx) + ydir*HALF*dmoments->at(fsgrids::dmoments::dp22dy);
-   p33 = moments->at(fsgrids::moments::P_33) + xdir*HALF*dmoments->at(fsgrids::dmoments::dp33dx) + ydir*HALF*dmoments->at(fsgrids::dmoments::dp33dy);
+   C_0  = HALF*(nbr_perb.at(fsgrids::bfield::PERBZ) + nbr_bgb.at(fsgrids::bgbfield::BGBZ) + perb.at(fsgrids::bfield::PERBZ) + bgb.at(fsgrids::bgbfield::BGBZ));
+   C_Z  = (nbr_perb.at(fsgrids::bfield::PERBZ) + nbr_bgb.at(fsgrids::bgbfield::BGBZ)) - (perb.at(fsgrids::bfield::PERBZ) + bgb.at(fsgrids::bgbfield::BGBZ));
+   rhom = moments.at(fsgrids::moments::RHOM) + xdir*HALF*dmoments.at(fsgrids::dmoments::drhomdx) + ydir*HALF*dmoments.at(fsgrids::dmoments::drhomdy);
+   p11 = moments.at(fsgrids::moments::P_11) + xdir*HALF*dmoments.at(fsgrids::dmoments::dp11dx) + ydir*HALF*dmoments.at(fsgrids::dmoments::dp11dy);
+   p22 = moments.at(fsgrids::moments::P_22) + xdir*HALF*dmoments.at(fsgrids::dmoments::dp22dx) + ydir*HALF*dmoments.at(fsgrids::dmoments::dp22dy);
+   p33 = moments.at(fsgrids::moments::P_33) + xdir*HALF*dmoments.at(fsgrids::dmoments::dp33dx) + ydir*HALF*dmoments.at(fsgrids::dmoments::dp33dy);
    
    if (rhom < minRhom) {
       rhom = minRhom;
@@ -369,10 +369,10 @@ void calculateWaveSpeedXY(
       rhom = maxRhom;
    }
    
-   const Real C_X  = nbr_dperb->at(fsgrids::dperb::dPERBzdx) + nbr_bgb->at(fsgrids::bgbfield::dBGBzdx) + dperb->at(fsgrids::dperb::dPERBzdx) + bgb->at(fsgrids::bgbfield::dBGBzdx);
-   const Real C_XZ = nbr_dperb->at(fsgrids::dperb::dPERBzdx) + nbr_bgb->at(fsgrids::bgbfield::dBGBzdx) - (dperb->at(fsgrids::dperb::dPERBzdx) + bgb->at(fsgrids::bgbfield::dBGBzdx));
-   const Real C_Y  = nbr_dperb->at(fsgrids::dperb::dPERBzdy) + nbr_bgb->at(fsgrids::bgbfield::dBGBzdy) + dperb->at(fsgrids::dperb::dPERBzdy) + bgb->at(fsgrids::bgbfield::dBGBzdy);
-   const Real C_YZ = nbr_dperb->at(fsgrids::dperb::dPERBzdy) + nbr_bgb->at(fsgrids::bgbfield::dBGBzdy) - (dperb->at(fsgrids::dperb::dPERBzdy) + bgb->at(fsgrids::bgbfield::dBGBzdy));
+   const Real C_X  = nbr_dperb.at(fsgrids::dperb::dPERBzdx) + nbr_bgb.at(fsgrids::bgbfield::dBGBzdx) + dperb.at(fsgrids::dperb::dPERBzdx) + bgb.at(fsgrids::bgbfield::dBGBzdx);
+   const Real C_XZ = nbr_dperb.at(fsgrids::dperb::dPERBzdx) + nbr_bgb.at(fsgrids::bgbfield::dBGBzdx) - (dperb.at(fsgrids::dperb::dPERBzdx) + bgb.at(fsgrids::bgbfield::dBGBzdx));
+   const Real C_Y  = nbr_dperb.at(fsgrids::dperb::dPERBzdy) + nbr_bgb.at(fsgrids::bgbfield::dBGBzdy) + dperb.at(fsgrids::dperb::dPERBzdy) + bgb.at(fsgrids::bgbfield::dBGBzdy);
+   const Real C_YZ = nbr_dperb.at(fsgrids::dperb::dPERBzdy) + nbr_bgb.at(fsgrids::bgbfield::dBGBzdy) - (dperb.at(fsgrids::dperb::dPERBzdy) + bgb.at(fsgrids::bgbfield::dBGBzdy));
    
    const Real Bz2  = (C_0 + xdir*HALF*C_X + ydir*HALF*C_Y)*(C_0 + xdir*HALF*C_X + ydir*HALF*C_Y)
      + TWELWTH*(C_Z + xdir*HALF*C_XZ + ydir*HALF*C_YZ)*(C_Z + xdir*HALF*C_XZ + ydir*HALF*C_YZ);
@@ -461,72 +461,72 @@ void calculateEdgeElectricFieldX(
    Real c_y, c_z;                   // Wave speeds to yz-directions
 
    // Get values at all four neighbours, result is written to SW.
-   std::array<Real, fsgrids::bfield::N_BFIELD> * perb_SW = perBGrid.get(i  ,j  ,k  );
-   std::array<Real, fsgrids::bfield::N_BFIELD> * perb_SE = perBGrid.get(i  ,j-1,k  );
-   std::array<Real, fsgrids::bfield::N_BFIELD> * perb_NE = perBGrid.get(i  ,j-1,k-1);
-   std::array<Real, fsgrids::bfield::N_BFIELD> * perb_NW = perBGrid.get(i  ,j  ,k-1);
-   std::array<Real, fsgrids::bgbfield::N_BGB> * bgb_SW = BgBGrid.get(i,j  ,k  );
-   std::array<Real, fsgrids::bgbfield::N_BGB> * bgb_SE = BgBGrid.get(i,j-1,k  );
-   std::array<Real, fsgrids::bgbfield::N_BGB> * bgb_NE = BgBGrid.get(i,j-1,k-1);
-   std::array<Real, fsgrids::bgbfield::N_BGB> * bgb_NW = BgBGrid.get(i,j  ,k-1);
-   std::array<Real, fsgrids::moments::N_MOMENTS> * moments_SW = momentsGrid.get(i  ,j  ,k  );
-   std::array<Real, fsgrids::moments::N_MOMENTS> * moments_SE = momentsGrid.get(i  ,j-1,k  );
-   std::array<Real, fsgrids::moments::N_MOMENTS> * moments_NE = momentsGrid.get(i  ,j-1,k-1);
-   std::array<Real, fsgrids::moments::N_MOMENTS> * moments_NW = momentsGrid.get(i  ,j  ,k-1);
-   std::array<Real, fsgrids::dmoments::N_DMOMENTS> * dmoments_SW = dMomentsGrid.get(i  ,j  ,k  );
-   std::array<Real, fsgrids::dmoments::N_DMOMENTS> * dmoments_SE = dMomentsGrid.get(i  ,j-1,k  );
-   std::array<Real, fsgrids::dmoments::N_DMOMENTS> * dmoments_NE = dMomentsGrid.get(i  ,j-1,k-1);
-   std::array<Real, fsgrids::dmoments::N_DMOMENTS> * dmoments_NW = dMomentsGrid.get(i  ,j  ,k-1);
-   std::array<Real, fsgrids::dperb::N_DPERB> * dperb_SW = dPerBGrid.get(i  ,j  ,k  );
-   std::array<Real, fsgrids::dperb::N_DPERB> * dperb_SE = dPerBGrid.get(i  ,j-1,k  );
-   std::array<Real, fsgrids::dperb::N_DPERB> * dperb_NE = dPerBGrid.get(i  ,j-1,k-1);
-   std::array<Real, fsgrids::dperb::N_DPERB> * dperb_NW = dPerBGrid.get(i  ,j  ,k-1);
-   
-   std::array<Real, fsgrids::efield::N_EFIELD> * efield_SW = EGrid.get(i,j,k);
+   FsCell<fsgrids::bfield::N_BFIELD> perb_SW = fsCell(perBGrid,i  ,j  ,k  );
+   FsCell<fsgrids::bfield::N_BFIELD> perb_SE = fsCell(perBGrid,i  ,j-1,k  );
+   FsCell<fsgrids::bfield::N_BFIELD> perb_NE = fsCell(perBGrid,i  ,j-1,k-1);
+   FsCell<fsgrids::bfield::N_BFIELD> perb_NW = fsCell(perBGrid,i  ,j  ,k-1);
+   FsCell<fsgrids::bgbfield::N_BGB> bgb_SW = fsCell(BgBGrid,i,j  ,k  );
+   FsCell<fsgrids::bgbfield::N_BGB> bgb_SE = fsCell(BgBGrid,i,j-1,k  );
+   FsCell<fsgrids::bgbfield::N_BGB> bgb_NE = fsCell(BgBGrid,i,j-1,k-1);
+   FsCell<fsgrids::bgbfield::N_BGB> bgb_NW = fsCell(BgBGrid,i,j  ,k-1);
+   FsCell<fsgrids::moments::N_MOMENTS> moments_SW = fsCell(momentsGrid,i  ,j  ,k  );
+   FsCell<fsgrids::moments::N_MOMENTS> moments_SE = fsCell(momentsGrid,i  ,j-1,k  );
+   FsCell<fsgrids::moments::N_MOMENTS> moments_NE = fsCell(momentsGrid,i  ,j-1,k-1);
+   FsCell<fsgrids::moments::N_MOMENTS> moments_NW = fsCell(momentsGrid,i  ,j  ,k-1);
+   FsCell<fsgrids::dmoments::N_DMOMENTS> dmoments_SW = fsCell(dMomentsGrid,i  ,j  ,k  );
+   FsCell<fsgrids::dmoments::N_DMOMENTS> dmoments_SE = fsCell(dMomentsGrid,i  ,j-1,k  );
+   FsCell<fsgrids::dmoments::N_DMOMENTS> dmoments_NE = fsCell(dMomentsGrid,i  ,j-1,k-1);
+   FsCell<fsgrids::dmoments::N_DMOMENTS> dmoments_NW = fsCell(dMomentsGrid,i  ,j  ,k-1);
+   FsCell<fsgrids::dperb::N_DPERB> dperb_SW = fsCell(dPerBGrid,i  ,j  ,k  );
+   FsCell<fsgrids::dperb::N_DPERB> dperb_SE = fsCell(dPerBGrid,i  ,j-1,k  );
+   FsCell<fsgrids::dperb::N_DPERB> dperb_NE = fsCell(dPerBGrid,i  ,j-1,k-1);
+   FsCell<fsgrids::dperb::N_DPERB> dperb_NW = fsCell(dPerBGrid,i  ,j  ,k-1);
+   
+   FsCell<fsgrids::efield::N_EFIELD> efield_SW = fsCell(EGrid,i,j,k);
    
    Real By_S, Bz_W, Bz_E, By_N, perBy_S, perBz_W, perBz_E, perBy_N;
    Real minRhom = std::numeric_limits<Real>::max();
    Real maxRhom = std::numeric_limits<Real>::min();
 
-   By_S = perb_SW->at(fsgrids::bfield::PERBY)+bgb_SW->at(fsgrids::bgbfield::BGBY);
-   Bz_W = perb_SW->at(fsgrids::bfield::PERBZ)+bgb_SW->at(fsgrids::bgbfield::BGBZ);
-   Bz_E = perb_SE->at(fsgrids::bfield::PERBZ)+bgb_SE->at(fsgrids::bgbfield::BGBZ);
-   By_N = perb_NW->at(fsgrids::bfield::PERBY)+bgb_NW->at(fsgrids::bgbfield::BGBY);
-   perBy_S = perb_SW->at(fsgrids::bfield::PERBY);
-   perBz_W = perb_SW->at(fsgrids::bfield::PERBZ);
-   perBz_E = perb_SE->at(fsgrids::bfield::PERBZ);
-   perBy_N = perb_NW->at(fsgrids::bfield::PERBY);
-   Vy0  = moments_SW->at(fsgrids::moments::VY);
-   Vz0  = moments_SW->at(fsgrids::moments::VZ);
+   By_S = perb_SW.at(fsgrids::bfield::PERBY)+bgb_SW.at(fsgrids::bgbfield::BGBY);
+   Bz_W = perb_SW.at(fsgrids::bfield::PERBZ)+bgb_SW.at(fsgrids::bgbfield::BGBZ);
+   Bz_E = perb_SE.at(fsgrids::bfield::PERBZ)+bgb_SE.at(fsgrids::bgbfield::BGBZ);
+   By_N = perb_NW.at(fsgrids::bfield::PERBY)+bgb_NW.at(fsgrids::bgbfield::BGBY);
+   perBy_S = perb_SW.at(fsgrids::bfield::PERBY);
+   perBz_W = perb_SW.at(fsgrids::bfield::PERBZ);
+   perBz_E = perb_SE.at(fsgrids::bfield::PERBZ);
+   perBy_N = perb_NW.at(fsgrids::bfield::PERBY);
+   Vy0  = moments_SW.at(fsgrids::moments::VY);
+   Vz0  = moments_SW.at(fsgrids::moments::VZ);
    minRhom = min(minRhom,
-       min(moments_SW->at(fsgrids::moments::RHOM),
-         min(moments_SE->at(fsgrids::moments::RHOM),
-           min(moments_NW->at(fsgrids::moments::RHOM),
-             moments_NE->at(fsgrids::moments::RHOM))
+       min(moments_SW.at(fsgrids::moments::RHOM),
+         min(moments_SE.at(fsgrids::moments::RHOM),
+           min(moments_NW.at(fsgrids::moments::RHOM),
+             moments_NE.at(fsgrids::moments::RHOM))
            )
          )
        );
    maxRhom = max(maxRhom,
-       max(moments_SW->at(fsgrids::moments::RHOM),
-         max(moments_SE->at(fsgrids::moments::RHOM),
-           max(moments_NW->at(fsgrids::moments::RHOM),
-             moments_NE->at(fsgrids::moments::RHOM))
+       max(moments_SW.at(fsgrids::moments::RHOM),
+         max(moments_SE.at(fsgrids::moments::RHOM),
+           max(moments_NW.at(fsgrids::moments::RHOM),
+             moments_NE.at(fsgrids::moments::RHOM))
            )
          )
        );
    
-   creal dBydx_S = dperb_SW->at(fsgrids::dperb::dPERBydx) + bgb_SW->at(fsgrids::bgbfield::dBGBydx);
-   creal dBydz_S = dperb_SW->at(fsgrids::dperb::dPERBydz) + bgb_SW->at(fsgrids::bgbfield::dBGBydz);
-   creal dBzdx_W = dperb_SW->at(fsgrids::dperb::dPERBzdx) + bgb_SW->at(fsgrids::bgbfield::dBGBzdx);
-   creal dBzdy_W = dperb_SW->at(fsgrids::dperb::dPERBzdy) + bgb_SW->at(fsgrids::bgbfield::dBGBzdy);
-   creal dBzdx_E = dperb_SE->at(fsgrids::dperb::dPERBzdx) + bgb_SE->at(fsgrids::bgbfield::dBGBzdx);
-   creal dBzdy_E = dperb_SE->at(fsgrids::dperb::dPERBzdy) + bgb_SE->at(fsgrids::bgbfield::dBGBzdy);
-   creal dBydx_N = dperb_NW->at(fsgrids::dperb::dPERBydx) + bgb_NW->at(fsgrids::bgbfield::dBGBydx);
-   creal dBydz_N = dperb_NW->at(fsgrids::dperb::dPERBydz) + bgb_NW->at(fsgrids::bgbfield::dBGBydz);
-   creal dperBydz_S = dperb_SW->at(fsgrids::dperb::dPERBydz);
-   creal dperBydz_N = dperb_NW->at(fsgrids::dperb::dPERBydz);
-   creal dperBzdy_W = dperb_SW->at(fsgrids::dperb::dPERBzdy);
-   creal dperBzdy_E = dperb_SE->at(fsgrids::dperb::dPERBzdy);
+   creal dBydx_S = dperb_SW.at(fsgrids::dperb::dPERBydx) + bgb_SW.at(fsgrids::bgbfield::dBGBydx);
+   creal dBydz_S = dperb_SW.at(fsgrids::dperb::dPERBydz) + bgb_SW.at(fsgrids::bgbfield::dBGBydz);
+   creal dBzdx_W = dperb_SW.at(fsgrids::dperb::dPERBzdx) + bgb_SW.at(fsgrids::bgbfield::dBGBzdx);
+   creal dBzdy_W = dperb_SW.at(fsgrids::dperb::dPERBzdy) + bgb_SW.at(fsgrids::bgbfield::dBGBzdy);
+   creal dBzdx_E = dperb_SE.at(fsgrids::dperb::dPERBzdx) + bgb_SE.at(fsgrids::bgbfield::dBGBzdx);
+   creal dBzdy_E = dperb_SE.at(fsgrids::dperb::dPERBzdy) + bgb_SE.at(fsgrids::bgbfield::dBGBzdy);
+   creal dBydx_N = dperb_NW.at(fsgrids::dperb::dPERBydx) + bgb_NW.at(fsgrids::bgbfield::dBGBydx);
+   creal dBydz_N = dperb_NW.at(fsgrids::dperb::dPERBydz) + bgb_NW.at(fsgrids::bgbfield::dBGBydz);
+   creal dperBydz_S = dperb_SW.at(fsgrids::dperb::dPERBydz);
+   creal dperBydz_N = dperb_NW.at(fsgrids::dperb::dPERBydz);
+   creal dperBzdy_W = dperb_SW.at(fsgrids::dperb::dPERBzdy);
+   creal dperBzdy_E = dperb_SE.at(fsgrids::dperb::dPERBzdy);
 
    // Ex and characteristic speeds on this cell:
    // 1st order terms:
@@ -535,32 +535,32 @@ void calculateEdgeElectricFieldX(
    // Resistive term
    if (Parameters::resistivity > 0) {
      Ex_SW += Parameters::resistivity *
-       sqrt((bgb_SW->at(fsgrids::bgbfield::BGBX)+perb_SW->at(fsgrids::bfield::PERBX))*
-            (bgb_SW->at(fsgrids::bgbfield::BGBX)+perb_SW->at(fsgrids::bfield::PERBX)) +
-            (bgb_SW->at(fsgrids::bgbfield::BGBY)+perb_SW->at(fsgrids::bfield::PERBY))*
-            (bgb_SW->at(fsgrids::bgbfield::BGBY)+perb_SW->at(fsgrids::bfield::PERBY)) +
-            (bgb_SW->at(fsgrids::bgbfield::BGBZ)+perb_SW->at(fsgrids::bfield::PERBZ))*
-            (bgb_SW->at(fsgrids::bgbfield::BGBZ)+perb_SW->at(fsgrids::bfield::PERBZ))
+       sqrt((bgb_SW.at(fsgrids::bgbfield::BGBX)+perb_SW.at(fsgrids::bfield::PERBX))*
+            (bgb_SW.at(fsgrids::bgbfield::BGBX)+perb_SW.at(fsgrids::bfield::PERBX)) +
+            (bgb_SW.at(fsgrids::bgbfield::BGBY)+perb_SW.at(fsgrids::bfield::PERBY))*
+            (bgb_SW.at(fsgrids::bgbfield::BGBY)+perb_SW.at(fsgrids::bfield::PERBY)) +
+            (bgb_SW.at(fsgrids::bgbfield::BGBZ)+perb_SW.at(fsgrids::bfield::PERBZ))*
+            (bgb_SW.at(fsgrids::bgbfield::BGBZ)+perb_SW.at(fsgrids::bfield::PERBZ))
            ) /
-       moments_SW->at(fsgrids::moments::RHOQ) /
+       moments_SW.at(fsgrids::moments::RHOQ) /
        physicalconstants::MU_0 *
-       (dperb_SW->at(fsgrids::dperb::dPERBzdy)/technicalGrid.DY - dperb_SW->at(fsgrids::dperb::dPERBydz)/technicalGrid.DZ);
+       (dperb_SW.at(fsgrids::dperb::dPERBzdy)/technicalGrid.DY - dperb_SW.at(fsgrids::dperb::dPERBydz)/technicalGrid.DZ);
    }
    
    // Hall term
    if(Parameters::ohmHallTerm > 0) {
-      Ex_SW += EHallGrid.get(i,j,k)->at(fsgrids::ehall::EXHALL_000_100);
+      Ex_SW += fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EXHALL_000_100);
    }
    
    // Electron pressure gradient term
    if(Parameters::ohmGradPeTerm > 0) {
-      Ex_SW += EGradPeGrid.get(i,j,k)->at(fsgrids::egradpe::EXGRADPE);
+      Ex_SW += fsCell(EGradPeGrid,i,j,k).at(fsgrids::egradpe::EXGRADPE);
    }
 
    #ifndef FS_1ST_ORDER_SPACE
       // 2nd order terms:
-      Ex_SW += +HALF*((By_S - HALF*dBydz_S)*(-dmoments_SW->at(fsgrids::dmoments::dVzdy) - dmoments_SW->at(fsgrids::dmoments::dVzdz)) - dBydz_S*Vz0 + SIXTH*dBydx_S*dmoments_SW->at(fsgrids::dmoments::dVzdx));
-      Ex_SW += -HALF*((Bz_W - HALF*dBzdy_W)*(-dmoments_SW->at(fsgrids::dmoments::dVydy) - dmoments_SW->at(fsgrids::dmoments::dVydz)) - dBzdy_W*Vy0 + SIXTH*dBzdx_W*dmoments_SW->at(fsgrids::dmoments::dVydx));
+      Ex_SW += +HALF*((By_S - HALF*dBydz_S)*(-dmoments_SW.at(fsgrids::dmoments::dVzdy) - dmoments_SW.at(fsgrids::dmoments::dVzdz)) - dBydz_S*Vz0 + SIXTH*dBydx_S*dmoments_SW.at(fsgrids::dmoments::dVzdx));
+      Ex_SW += -HALF*((Bz_W - HALF*dBzdy_W)*(-dmoments_SW.at(fsgrids::dmoments::dVydy) - dmoments_SW.at(fsgrids::dmoments::dVydz)) - dBzdy_W*Vy0 + SIXTH*dBzdx_W*dmoments_SW.at(fsgrids::dmoments::dVydx));
    #endif
    calculateWaveSpeedYZ(
       perBGrid,
@@ -581,8 +581,8 @@ void calculateEdgeElectricFieldX(
    maxV = max(maxV, calculateCflSpeed(Vy0, Vz0, vA, vS, vW));
 
    // Ex and characteristic speeds on j-1 neighbour:
-   Vy0  = moments_SE->at(fsgrids::moments::VY);
-   Vz0  = moments_SE->at(fsgrids::moments::VZ);
+   Vy0  = moments_SE.at(fsgrids::moments::VY);
+   Vz0  = moments_SE.at(fsgrids::moments::VZ);
    
    // 1st order terms:
    Real Ex_SE = By_S*Vz0 - Bz_E*Vy0;
@@ -590,32 +590,32 @@ void calculateEdgeElectricFieldX(
    // Resistive term
    if (Parameters::resistivity > 0) {
      Ex_SE += Parameters::resistivity *
-       sqrt((bgb_SE->at(fsgrids::bgbfield::BGBX)+perb_SE->at(fsgrids::bfield::PERBX))*
-            (bgb_SE->at(fsgrids::bgbfield::BGBX)+perb_SE->at(fsgrids::bfield::PERBX)) +
-            (bgb_SE->at(fsgrids::bgbfield::BGBY)+perb_SE->at(fsgrids::bfield::PERBY))*
-            (bgb_SE->at(fsgrids::bgbfield::BGBY)+perb_SE->at(fsgrids::bfield::PERBY)) +
-            (bgb_SE->at(fsgrids::bgbfield::BGBZ)+perb_SE->at(fsgrids::bfield::PERBZ))*
-            (bgb_SE->at(fsgrids::bgbfield::BGBZ)+perb_SE->at(fsgrids::bfield::PERBZ))
+       sqrt((bgb_SE.at(fsgrids::bgbfield::BGBX)+perb_SE.at(fsgrids::bfield::PERBX))*
+            (bgb_SE.at(fsgrids::bgbfield::BGBX)+perb_SE.at(fsgrids::bfield::PERBX)) +
+            (bgb_SE.at(fsgrids::bgbfield::BGBY)+perb_SE.at(fsgrids::bfield::PERBY))*
+            (bgb_SE.at(fsgrids::bgbfield::BGBY)+perb_SE.at(fsgrids::bfield::PERBY)) +
+            (bgb_SE.at(fsgrids::bgbfield::BGBZ)+perb_SE.at(fsgrids::bfield::PERBZ))*
+            (bgb_SE.at(fsgrids::bgbfield::BGBZ)+perb_SE.at(fsgrids::bfield::PERBZ))
            ) /
-       moments_SE->at(fsgrids::moments::RHOQ) /
+       moments_SE.at(fsgrids::moments::RHOQ) /
        physicalconstants::MU_0 *
-       (dperb_SE->at(fsgrids::dperb::dPERBzdy)/technicalGrid.DY - dperb_SE->at(fsgrids::dperb::dPERBydz)/technicalGrid.DZ);
+       (dperb_SE.at(fsgrids::dperb::dPERBzdy)/technicalGrid.DY - dperb_SE.at(fsgrids::dperb::dPERBydz)/technicalGrid.DZ);
    }
 
    // Hall term
    if(Parameters::ohmHallTerm > 0) {
-      Ex_SE += EHallGrid.get(i,j-1,k)->at(fsgrids::ehall::EXHALL_010_110);
+      Ex_SE += fsCell(EHallGrid,i,j-1,k).at(fsgrids::ehall::EXHALL_010_110);
    }
    
    // Electron pressure gradient term
    if(Parameters::ohmGradPeTerm > 0) {
-      Ex_SE += EGradPeGrid.get(i,j-1,k)->at(fsgrids::egradpe::EXGRADPE);
+      Ex_SE += fsCell(EGradPeGrid,i,j-1,k).at(fsgrids::egradpe::EXGRADPE);
    }
    
    #ifndef FS_1ST_ORDER_SPACE
       // 2nd order terms:
-      Ex_SE += +HALF*((By_S - HALF*dBydz_S)*(+dmoments_SE->at(fsgrids::dmoments::dVzdy) - dmoments_SE->at(fsgrids::dmoments::dVzdz)) - dBydz_S*Vz0 + SIXTH*dBydx_S*dmoments_SE->at(fsgrids::dmoments::dVzdx));
-      Ex_SE += -HALF*((Bz_E + HALF*dBzdy_E)*(+dmoments_SE->at(fsgrids::dmoments::dVydy) - dmoments_SE->at(fsgrids::dmoments::dVydz)) + dBzdy_E*Vy0 + SIXTH*dBzdx_E*dmoments_SE->at(fsgrids::dmoments::dVydx));
+      Ex_SE += +HALF*((By_S - HALF*dBydz_S)*(+dmoments_SE.at(fsgrids::dmoments::dVzdy) - dmoments_SE.at(fsgrids::dmoments::dVzdz)) - dBydz_S*Vz0 + SIXTH*dBydx_S*dmoments_SE.at(fsgrids::dmoments::dVzdx));
+      Ex_SE += -HALF*((Bz_E + HALF*dBzdy_E)*(+dmoments_SE.at(fsgrids::dmoments::dVydy) - dmoments_SE.at(fsgrids::dmoments::dVydz)) + dBzdy_E*Vy0 + SIXTH*dBzdx_E*dmoments_SE.at(fsgrids::dmoments::dVydx));
    #endif
    
    calculateWaveSpeedYZ(
@@ -637,8 +637,8 @@ void calculateEdgeElectricFieldX(
    maxV = max(maxV, calculateCflSpeed(Vy0, Vz0, vA, vS, vW));
 
    // Ex and characteristic speeds on k-1 neighbour:
-   Vy0  = moments_NW->at(fsgrids::moments::VY);
-   Vz0  = moments_NW->at(fsgrids::moments::VZ);
+   Vy0  = moments_NW.at(fsgrids::moments::VY);
+   Vz0  = moments_NW.at(fsgrids::moments::VZ);
    
    // 1st order terms:
    Real Ex_NW    = By_N*Vz0 - Bz_W*Vy0;
@@ -646,32 +646,32 @@ void calculateEdgeElectricFieldX(
    // Resistive term
    if (Parameters::resistivity > 0) {
      Ex_NW += Parameters::resistivity *
-       sqrt((bgb_NW->at(fsgrids::bgbfield::BGBX)+perb_NW->at(fsgrids::bfield::PERBX))*
-            (bgb_NW->at(fsgrids::bgbfield::BGBX)+perb_NW->at(fsgrids::bfield::PERBX)) +
-            (bgb_NW->at(fsgrids::bgbfield::BGBY)+perb_NW->at(fsgrids::bfield::PERBY))*
-            (bgb_NW->at(fsgrids::bgbfield::BGBY)+perb_NW->at(fsgrids::bfield::PERBY)) +
-            (bgb_NW->at(fsgrids::bgbfield::BGBZ)+perb_NW->at(fsgrids::bfield::PERBZ))*
-            (bgb_NW->at(fsgrids::bgbfield::BGBZ)+perb_NW->at(fsgrids::bfield::PERBZ))
+       sqrt((bgb_NW.at(fsgrids::bgbfield::BGBX)+perb_NW.at(fsgrids::bfield::PERBX))*
+            (bgb_NW.at(fsgrids::bgbfield::BGBX)+perb_NW.at(fsgrids::bfield::PERBX)) +
+            (bgb_NW.at(fsgrids::bgbfield::BGBY)+perb_NW.at(fsgrids::bfield::PERBY))*
+            (bgb_NW.at(fsgrids::bgbfield::BGBY)+perb_NW.at(fsgrids::bfield::PERBY)) +
+            (bgb_NW.at(fsgrids::bgbfield::BGBZ)+perb_NW.at(fsgrids::bfield::PERBZ))*
+            (bgb_NW.at(fsgrids::bgbfield::BGBZ)+perb_NW.at(fsgrids::bfield::PERBZ))
            ) /
-       moments_NW->at(fsgrids::moments::RHOQ) /
+       moments_NW.at(fsgrids::moments::RHOQ) /
        physicalconstants::MU_0 *
-       (dperb_NW->at(fsgrids::dperb::dPERBzdy)/technicalGrid.DY - dperb_NW->at(fsgrids::dperb::dPERBydz)/technicalGrid.DZ);
+       (dperb_NW.at(fsgrids::dperb::dPERBzdy)/technicalGrid.DY - dperb_NW.at(fsgrids::dperb::dPERBydz)/technicalGrid.DZ);
    }
    
    // Hall term
    if(Parameters::ohmHallTerm > 0) {
-      Ex_NW += EHallGrid.get(i,j,k-1)->at(fsgrids::ehall::EXHALL_001_101);
+      Ex_NW += fsCell(EHallGrid,i,j,k-1).at(fsgrids::ehall::EXHALL_001_101);
    }
    
    // Electron pressure gradient term
    if(Parameters::ohmGradPeTerm > 0) {
-      Ex_NW += EGradPeGrid.get(i,j,k-1)->at(fsgrids::egradpe::EXGRADPE);
+      Ex_NW += fsCell(EGradPeGrid,i,j,k-1).at(fsgrids::egradpe::EXGRADPE);
    }
    
    #ifndef FS_1ST_ORDER_SPACE
       // 2nd order terms:
-      Ex_NW += +HALF*((By_N + HALF*dBydz_N)*(-dmoments_NW->at(fsgrids::dmoments::dVzdy) + dmoments_NW->at(fsgrids::dmoments::dVzdz)) + dBydz_N*Vz0 + SIXTH*dBydx_N*dmoments_NW->at(fsgrids::dmoments::dVzdx));
-      Ex_NW += -HALF*((Bz_W - HALF*dBzdy_W)*(-dmoments_NW->at(fsgrids::dmoments::dVydy) + dmoments_NW->at(fsgrids::dmoments::dVydz)) - dBzdy_W*Vy0 + SIXTH*dBzdx_W*dmoments_NW->at(fsgrids::dmoments::dVydx));
+      Ex_NW += +HALF*((By_N + HALF*dBydz_N)*(-dmoments_NW.at(fsgrids::dmoments::dVzdy) + dmoments_NW.at(fsgrids::dmoments::dVzdz)) + dBydz_N*Vz0 + SIXTH*dBydx_N*dmoments_NW.at(fsgrids::dmoments::dVzdx));
+      Ex_NW += -HALF*((Bz_W - HALF*dBzdy_W)*(-dmoments_NW.at(fsgrids::dmoments::dVydy) + dmoments_NW.at(fsgrids::dmoments::dVydz)) - dBzdy_W*Vy0 + SIXTH*dBzdx_W*dmoments_NW.at(fsgrids::dmoments::dVydx));
    #endif
    
    calculateWaveSpeedYZ(
@@ -693,8 +693,8 @@ void calculateEdgeElectricFieldX(
    maxV = max(maxV, calculateCflSpeed(Vy0, Vz0, vA, vS, vW));
 
    // Ex and characteristic speeds on j-1,k-1 neighbour:
-   Vy0 = moments_NE->at(fsgrids::moments::VY);
-   Vz0 = moments_NE->at(fsgrids::moments::VZ);
+   Vy0 = moments_NE.at(fsgrids::moments::VY);
+   Vz0 = moments_NE.at(fsgrids::moments::VZ);
    
    // 1st order terms:
    Real Ex_NE    = By_N*Vz0 - Bz_E*Vy0;
@@ -702,32 +702,32 @@ void calculateEdgeElectricFieldX(
    // Resistive term
    if (Parameters::resistivity > 0) {
       Ex_NE += Parameters::resistivity *
-               sqrt((bgb_NE->at(fsgrids::bgbfield::BGBX)+perb_NE->at(fsgrids::bfield::PERBX))*
-                    (bgb_NE->at(fsgrids::bgbfield::BGBX)+perb_NE->at(fsgrids::bfield::PERBX)) +
-                    (bgb_NE->at(fsgrids::bgbfield::BGBY)+perb_NE->at(fsgrids::bfield::PERBY))*
-                    (bgb_NE->at(fsgrids::bgbfield::BGBY)+perb_NE->at(fsgrids::bfield::PERBY)) +
-                    (bgb_NE->at(fsgrids::bgbfield::BGBZ)+perb_NE->at(fsgrids::bfield::PERBZ))*
-                    (bgb_NE->at(fsgrids::bgbfield::BGBZ)+perb_NE->at(fsgrids::bfield::PERBZ))
+               sqrt((bgb_NE.at(fsgrids::bgbfield::BGBX)+perb_NE.at(fsgrids::bfield::PERBX))*
+                    (bgb_NE.at(fsgrids::bgbfield::BGBX)+perb_NE.at(fsgrids::bfield::PERBX)) +
+                    (bgb_NE.at(fsgrids::bgbfield::BGBY)+perb_NE.at(fsgrids::bfield::PERBY))*
+                    (bgb_NE.at(fsgrids::bgbfield::BGBY)+perb_NE.at(fsgrids::bfield::PERBY)) +
+                    (bgb_NE.at(fsgrids::bgbfield::BGBZ)+perb_NE.at(fsgrids::bfield::PERBZ))*
+                    (bgb_NE.at(fsgrids::bgbfield::BGBZ)+perb_NE.at(fsgrids::bfield::PERBZ))
                    ) /
-               moments_NE->at(fsgrids::moments::RHOQ) /
+               moments_NE.at(fsgrids::moments::RHOQ) /
                physicalconstants::MU_0 *
-               (dperb_NE->at(fsgrids::dperb::dPERBzdy)/technicalGrid.DY - dperb_NE->at(fsgrids::dperb::dPERBydz)/technicalGrid.DZ);
+               (dperb_NE.at(fsgrids::dperb::dPERBzdy)/technicalGrid.DY - dperb_NE.at(fsgrids::dperb::dPERBydz)/technicalGrid.DZ);
    }
 
    // Hall term
    if(Parameters::ohmHallTerm > 0) {
-      Ex_NE += EHallGrid.get(i,j-1,k-1)->at(fsgrids::ehall::EXHALL_011_111);
+      Ex_NE += fsCell(EHallGrid,i,j-1,k-1).at(fsgrids::ehall::EXHALL_011_111);
    }
    
    // Electron pressure gradient term
    if(Parameters::ohmGradPeTerm > 0) {
-      Ex_NE += EGradPeGrid.get(i,j-1,k-1)->at(fsgrids::egradpe::EXGRADPE);
+      Ex_NE += fsCell(EGradPeGrid,i,j-1,k-1).at(fsgrids::egradpe::EXGRADPE);
    }
    
    #ifndef FS_1ST_ORDER_SPACE
       // 2nd order terms:
-      Ex_NE += +HALF*((By_N + HALF*dBydz_N)*(+dmoments_NE->at(fsgrids::dmoments::dVzdy) + dmoments_NE->at(fsgrids::dmoments::dVzdz)) + dBydz_N*Vz0 + SIXTH*dBydx_N*dmoments_NE->at(fsgrids::dmoments::dVzdx));
-      Ex_NE += -HALF*((Bz_E + HALF*dBzdy_E)*(+dmoments_NE->at(fsgrids::dmoments::dVydy) + dmoments_NE->at(fsgrids::dmoments::dVydz)) + dBzdy_E*Vy0 + SIXTH*dBzdx_E*dmoments_NE->at(fsgrids::dmoments::dVydx));
+      Ex_NE += +HALF*((By_N + HALF*dBydz_N)*(+dmoments_NE.at(fsgrids::dmoments::dVzdy) + dmoments_NE.at(fsgrids::dmoments::dVzdz)) + dBydz_N*Vz0 + SIXTH*dBydx_N*dmoments_NE.at(fsgrids::dmoments::dVzdx));
+      Ex_NE += -HALF*((Bz_E + HALF*dBzdy_E)*(+dmoments_NE.at(fsgrids::dmoments::dVydy) + dmoments_NE.at(fsgrids::dmoments::dVydz)) + dBzdy_E*Vy0 + SIXTH*dBzdx_E*dmoments_NE.at(fsgrids::dmoments::dVydx));
    #endif
    
    calculateWaveSpeedYZ(
@@ -748,17 +748,17 @@ void calculateEdgeElectricFieldX(
    az_pos   = max(az_pos,+Vz0 + c_z);
    maxV = max(maxV, calculateCflSpeed(Vy0, Vz0, vA, vS, vW));
    // Calculate properly upwinded edge-averaged Ex:
-   efield_SW->at(fsgrids::efield::EX)  = ay_pos*az_pos*Ex_NE + ay_pos*az_neg*Ex_SE + ay_neg*az_pos*Ex_NW + ay_neg*az_neg*Ex_SW;
-   efield_SW->at(fsgrids::efield::EX) /= ((ay_pos+ay_neg)*(az_pos+az_neg)+EPS);
+   efield_SW.at(fsgrids::efield::EX)  = ay_pos*az_pos*Ex_NE + ay_pos*az_neg*Ex_SE + ay_neg*az_pos*Ex_NW + ay_neg*az_neg*Ex_SW;
+   efield_SW.at(fsgrids::efield::EX) /= ((ay_pos+ay_neg)*(az_pos+az_neg)+EPS);
    if (Parameters::fieldSolverDiffusiveEterms) {
 #ifdef FS_1ST_ORDER_SPACE
       // 1st order diffusive terms:
-      efield_SW->at(fsgrids::efield::EX) -= az_pos*az_neg/(az_pos+az_neg+EPS)*(perBy_S-perBy_N);
-      efield_SW->at(fsgrids::efield::EX) += ay_pos*ay_neg/(ay_pos+ay_neg+EPS)*(perBz_W-perBz_E);
+      efield_SW.at(fsgrids::efield::EX) -= az_pos*az_neg/(az_pos+az_neg+EPS)*(perBy_S-perBy_N);
+      efield_SW.at(fsgrids::efield::EX) += ay_pos*ay_neg/(ay_pos+ay_neg+EPS)*(perBz_W-perBz_E);
 #else
       // 2nd     order diffusive terms
-      efield_SW->at(fsgrids::efield::EX) -= az_pos*az_neg/(az_pos+az_neg+EPS)*((perBy_S-HALF*dperBydz_S) - (perBy_N+HALF*dperBydz_N));
-      efield_SW->at(fsgrids::efield::EX) += ay_pos*ay_neg/(ay_pos+ay_neg+EPS)*((perBz_W-HALF*dperBzdy_W) - (perBz_E+HALF*dperBzdy_E));
+      efield_SW.at(fsgrids::efield::EX) -= az_pos*az_neg/(az_pos+az_neg+EPS)*((perBy_S-HALF*dperBydz_S) - (perBy_N+HALF*dperBydz_N));
+      efield_SW.at(fsgrids::efield::EX) += ay_pos*ay_neg/(ay_pos+ay_neg+EPS)*((perBz_W-HALF*dperBzdy_W) - (perBz_E+HALF*dperBzdy_E));
 #endif
    }
    
@@ -818,72 +818,72 @@ void calculateEdgeElectricFieldY(
    Real maxV = 0.0;                 // Max velocity for CFL purposes
    Real c_x,c_z;                    // Wave speeds to xz-directions
    
-   std::array<Real, fsgrids::bfield::N_BFIELD> * perb_SW = perBGrid.get(i  ,j  ,k  );
-   std::array<Real, fsgrids::bfield::N_BFIELD> * perb_SE = perBGrid.get(i  ,j  ,k-1);
-   std::array<Real, fsgrids::bfield::N_BFIELD> * perb_NW = perBGrid.get(i-1,j  ,k  );
-   std::array<Real, fsgrids::bfield::N_BFIELD> * perb_NE = perBGrid.get(i-1,j  ,k-1);
-   std::array<Real, fsgrids::bgbfield::N_BGB> * bgb_SW = BgBGrid.get(i  ,j  ,k  );
-   std::array<Real, fsgrids::bgbfield::N_BGB> * bgb_SE = BgBGrid.get(i  ,j  ,k-1);
-   std::array<Real, fsgrids::bgbfield::N_BGB> * bgb_NW = BgBGrid.get(i-1,j  ,k  );
-   std::array<Real, fsgrids::bgbfield::N_BGB> * bgb_NE = BgBGrid.get(i-1,j  ,k-1);
-   std::array<Real, fsgrids::moments::N_MOMENTS> * moments_SW = momentsGrid.get(i  ,j  ,k  );
-   std::array<Real, fsgrids::moments::N_MOMENTS> * moments_SE = momentsGrid.get(i  ,j  ,k-1);
-   std::array<Real, fsgrids::moments::N_MOMENTS> * moments_NW = momentsGrid.get(i-1,j  ,k  );
-   std::array<Real, fsgrids::moments::N_MOMENTS> * moments_NE = momentsGrid.get(i-1,j  ,k-1);
-   std::array<Real, fsgrids::dmoments::N_DMOMENTS> * dmoments_SW = dMomentsGrid.get(i  ,j  ,k  );
-   std::array<Real, fsgrids::dmoments::N_DMOMENTS> * dmoments_SE = dMomentsGrid.get(i  ,j  ,k-1);
-   std::array<Real, fsgrids::dmoments::N_DMOMENTS> * dmoments_NW = dMomentsGrid.get(i-1,j  ,k  );
-   std::array<Real, fsgrids::dmoments::N_DMOMENTS> * dmoments_NE = dMomentsGrid.get(i-1,j  ,k-1);
-   std::array<Real, fsgrids::dperb::N_DPERB> * dperb_SW = dPerBGrid.get(i  ,j  ,k  );
-   std::array<Real, fsgrids::dperb::N_DPERB> * dperb_SE = dPerBGrid.get(i  ,j  ,k-1);
-   std::array<Real, fsgrids::dperb::N_DPERB> * dperb_NW = dPerBGrid.get(i-1,j  ,k  );
-   std::array<Real, fsgrids::dperb::N_DPERB> * dperb_NE = dPerBGrid.get(i-1,j  ,k-1);
-   
-   std::array<Real, fsgrids::efield::N_EFIELD> * efield_SW = EGrid.get(i,j,k);
+   FsCell<fsgrids::bfield::N_BFIELD> perb_SW = fsCell(perBGrid,i  ,j  ,k  );
+   FsCell<fsgrids::bfield::N_BFIELD> perb_SE = fsCell(perBGrid,i  ,j  ,k-1);
+   FsCell<fsgrids::bfield::N_BFIELD> perb_NW = fsCell(perBGrid,i-1,j  ,k  );
+   FsCell<fsgrids::bfield::N_BFIELD> perb_NE = fsCell(perBGrid,i-1,j  ,k-1);
+   FsCell<fsgrids::bgbfield::N_BGB> bgb_SW = fsCell(BgBGrid,i  ,j  ,k  );
+   FsCell<fsgrids::bgbfield::N_BGB> bgb_SE = fsCell(BgBGrid,i  ,j  ,k-1);
+   FsCell<fsgrids::bgbfield::N_BGB> bgb_NW = fsCell(BgBGrid,i-1,j  ,k  );
+   FsCell<fsgrids::bgbfield::N_BGB> bgb_NE = fsCell(BgBGrid,i-1,j  ,k-1);
+   FsCell<fsgrids::moments::N_MOMENTS> moments_SW = fsCell(momentsGrid,i  ,j  ,k  );
+   FsCell<fsgrids::moments::N_MOMENTS> moments_SE = fsCell(momentsGrid,i  ,j  ,k-1);
+   FsCell<fsgrids::moments::N_MOMENTS> moments_NW = fsCell(momentsGrid,i-1,j  ,k  );
+   FsCell<fsgrids::moments::N_MOMENTS> moments_NE = fsCell(momentsGrid,i-1,j  ,k-1);
+   FsCell<fsgrids::dmoments::N_DMOMENTS> dmoments_SW = fsCell(dMomentsGrid,i  ,j  ,k  );
+   FsCell<fsgrids::dmoments::N_DMOMENTS> dmoments_SE = fsCell(dMomentsGrid,i  ,j  ,k-1);
+   FsCell<fsgrids::dmoments::N_DMOMENTS> dmoments_NW = fsCell(dMomentsGrid,i-1,j  ,k  );
+   FsCell<fsgrids::dmoments::N_DMOMENTS> dmoments_NE = fsCell(dMomentsGrid,i-1,j  ,k-1);
+   FsCell<fsgrids::dperb::N_DPERB> dperb_SW = fsCell(dPerBGrid,i  ,j  ,k  );
+   FsCell<fsgrids::dperb::N_DPERB> dperb_SE = fsCell(dPerBGrid,i  ,j  ,k-1);
+   FsCell<fsgrids::dperb::N_DPERB> dperb_NW = fsCell(dPerBGrid,i-1,j  ,k  );
+   FsCell<fsgrids::dperb::N_DPERB> dperb_NE = fsCell(dPerBGrid,i-1,j  ,k-1);
+   
+   FsCell<fsgrids::efield::N_EFIELD> efield_SW = fsCell(EGrid,i,j,k);
    
    // Fetch required plasma parameters:
    Real Bz_S, Bx_W, Bx_E, Bz_N, perBz_S, perBx_W, perBx_E, perBz_N;
    Real minRhom = std::numeric_limits<Real>::max();
    Real maxRhom = std::numeric_limits<Real>::min();
-   Bz_S = perb_SW->at(fsgrids::bfield::PERBZ)+bgb_SW->at(fsgrids::bgbfield::BGBZ);
-   Bx_W = perb_SW->at(fsgrids::bfield::PERBX)+bgb_SW->at(fsgrids::bgbfield::BGBX);
-   Bx_E = perb_SE->at(fsgrids::bfield::PERBX)+bgb_SE->at(fsgrids::bgbfield::BGBX);
-   Bz_N = perb_NW->at(fsgrids::bfield::PERBZ)+bgb_NW->at(fsgrids::bgbfield::BGBZ);
-   perBz_S = perb_SW->at(fsgrids::bfield::PERBZ);
-   perBx_W = perb_SW->at(fsgrids::bfield::PERBX);
-   perBx_E = perb_SE->at(fsgrids::bfield::PERBX);
-   perBz_N = perb_NW->at(fsgrids::bfield::PERBZ);
-   Vx0  = moments_SW->at(fsgrids::moments::VX);
-   Vz0  = moments_SW->at(fsgrids::moments::VZ);
+   Bz_S = perb_SW.at(fsgrids::bfield::PERBZ)+bgb_SW.at(fsgrids::bgbfield::BGBZ);
+   Bx_W = perb_SW.at(fsgrids::bfield::PERBX)+bgb_SW.at(fsgrids::bgbfield::BGBX);
+   Bx_E = perb_SE.at(fsgrids::bfield::PERBX)+bgb_SE.at(fsgrids::bgbfield::BGBX);
+   Bz_N = perb_NW.at(fsgrids::bfield::PERBZ)+bgb_NW.at(fsgrids::bgbfield::BGBZ);
+   perBz_S = perb_SW.at(fsgrids::bfield::PERBZ);
+   perBx_W = perb_SW.at(fsgrids::bfield::PERBX);
+   perBx_E = perb_SE.at(fsgrids::bfield::PERBX);
+   perBz_N = perb_NW.at(fsgrids::bfield::PERBZ);
+   Vx0  = moments_SW.at(fsgrids::moments::VX);
+   Vz0  = moments_SW.at(fsgrids::moments::VZ);
    minRhom = min(minRhom,
-       min(moments_SW->at(fsgrids::moments::RHOM),
-         min(moments_SE->at(fsgrids::moments::RHOM),
-           min(moments_NW->at(fsgrids::moments::RHOM),
-             moments_NE->at(fsgrids::moments::RHOM))
+       min(moments_SW.at(fsgrids::moments::RHOM),
+         min(moments_SE.at(fsgrids::moments::RHOM),
+           min(moments_NW.at(fsgrids::moments::RHOM),
+             moments_NE.at(fsgrids::moments::RHOM))
            )
          )
        );
    maxRhom = max(maxRhom,
-       max(moments_SW->at(fsgrids::moments::RHOM),
-         max(moments_SE->at(fsgrids::moments::RHOM),
-           max(moments_NW->at(fsgrids::moments::RHOM),
-             moments_NE->at(fsgrids::moments::RHOM))
+       max(moments_SW.at(fsgrids::moments::RHOM),
+         max(moments_SE.at(fsgrids::moments::RHOM),
+           max(moments_NW.at(fsgrids::moments::RHOM),
+             moments_NE.at(fsgrids::moments::RHOM))
            )
          )
        );
    
-   creal dBxdy_W = dperb_SW->at(fsgrids::dperb::dPERBxdy) + bgb_SW->at(fsgrids::bgbfield::dBGBxdy);
-   creal dBxdz_W = dperb_SW->at(fsgrids::dperb::dPERBxdz) + bgb_SW->at(fsgrids::bgbfield::dBGBxdz);
-   creal dBzdx_S = dperb_SW->at(fsgrids::dperb::dPERBzdx) + bgb_SW->at(fsgrids::bgbfield::dBGBzdx);
-   creal dBzdy_S = dperb_SW->at(fsgrids::dperb::dPERBzdy) + bgb_SW->at(fsgrids::bgbfield::dBGBzdy);
-   creal dBxdy_E = dperb_SE->at(fsgrids::dperb::dPERBxdy) + bgb_SE->at(fsgrids::bgbfield::dBGBxdy);
-   creal dBxdz_E = dperb_SE->at(fsgrids::dperb::dPERBxdz) + bgb_SE->at(fsgrids::bgbfield::dBGBxdz);
-   creal dBzdx_N = dperb_NW->at(fsgrids::dperb::dPERBzdx) + bgb_NW->at(fsgrids::bgbfield::dBGBzdx);
-   creal dBzdy_N = dperb_NW->at(fsgrids::dperb::dPERBzdy) + bgb_NW->at(fsgrids::bgbfield::dBGBzdy);
-   creal dperBzdx_S = dperb_SW->at(fsgrids::dperb::dPERBzdx);
-   creal dperBzdx_N = dperb_NW->at(fsgrids::dperb::dPERBzdx);
-   creal dperBxdz_W = dperb_SW->at(fsgrids::dperb::dPERBxdz);
-   creal dperBxdz_E = dperb_SE->at(fsgrids::dperb::dPERBxdz);
+   creal dBxdy_W = dperb_SW.at(fsgrids::dperb::dPERBxdy) + bgb_SW.at(fsgrids::bgbfield::dBGBxdy);
+   creal dBxdz_W = dperb_SW.at(fsgrids::dperb::dPERBxdz) + bgb_SW.at(fsgrids::bgbfield::dBGBxdz);
+   creal dBzdx_S = dperb_SW.at(fsgrids::dperb::dPERBzdx) + bgb_SW.at(fsgrids::bgbfield::dBGBzdx);
+   creal dBzdy_S = dperb_SW.at(fsgrids::dperb::dPERBzdy) + bgb_SW.at(fsgrids::bgbfield::dBGBzdy);
+   creal dBxdy_E = dperb_SE.at(fsgrids::dperb::dPERBxdy) + bgb_SE.at(fsgrids::bgbfield::dBGBxdy);
+   creal dBxdz_E = dperb_SE.at(fsgrids::dperb::dPERBxdz) + bgb_SE.at(fsgrids::bgbfield::dBGBxdz);
+   creal dBzdx_N = dperb_NW.at(fsgrids::dperb::dPERBzdx) + bgb_NW.at(fsgrids::bgbfield::dBGBzdx);
+   creal dBzdy_N = dperb_NW.at(fsgrids::dperb::dPERBzdy) + bgb_NW.at(fsgrids::bgbfield::dBGBzdy);
+   creal dperBzdx_S = dperb_SW.at(fsgrids::dperb::dPERBzdx);
+   creal dperBzdx_N = dperb_NW.at(fsgrids::dperb::dPERBzdx);
+   creal dperBxdz_W = dperb_SW.at(fsgrids::dperb::dPERBxdz);
+   creal dperBxdz_E = dperb_SE.at(fsgrids::dperb::dPERBxdz);
    
    // Ey and characteristic speeds on this cell:
    // 1st order terms:
@@ -892,32 +892,32 @@ void calculateEdgeElectricFieldY(
    // Resistive term
    if (Parameters::resistivity > 0) {
       Ey_SW += Parameters::resistivity *
-        sqrt((bgb_SW->at(fsgrids::bgbfield::BGBX)+perb_SW->at(fsgrids::bfield::PERBX))*
-             (bgb_SW->at(fsgrids::bgbfield::BGBX)+perb_SW->at(fsgrids::bfield::PERBX)) +
-             (bgb_SW->at(fsgrids::bgbfield::BGBY)+perb_SW->at(fsgrids::bfield::PERBY))*
-             (bgb_SW->at(fsgrids::bgbfield::BGBY)+perb_SW->at(fsgrids::bfield::PERBY)) +
-             (bgb_SW->at(fsgrids::bgbfield::BGBZ)+perb_SW->at(fsgrids::bfield::PERBZ))*
-             (bgb_SW->at(fsgrids::bgbfield::BGBZ)+perb_SW->at(fsgrids::bfield::PERBZ))
+        sqrt((bgb_SW.at(fsgrids::bgbfield::BGBX)+perb_SW.at(fsgrids::bfield::PERBX))*
+             (bgb_SW.at(fsgrids::bgbfield::BGBX)+perb_SW.at(fsgrids::bfield::PERBX)) +
+             (bgb_SW.at(fsgrids::bgbfield::BGBY)+perb_SW.at(fsgrids::bfield::PERBY))*
+             (bgb_SW.at(fsgrids::bgbfield::BGBY)+perb_SW.at(fsgrids::bfield::PERBY)) +
+             (bgb_SW.at(fsgrids::bgbfield::BGBZ)+perb_SW.at(fsgrids::bfield::PERBZ))*
+             (bgb_SW.at(fsgrids::bgbfield::BGBZ)+perb_SW.at(fsgrids::bfield::PERBZ))
             ) /
-        moments_SW->at(fsgrids::moments::RHOQ) /
+        moments_SW.at(fsgrids::moments::RHOQ) /
         physicalconstants::MU_0 *
-        (dperb_SW->at(fsgrids::dperb::dPERBxdz)/technicalGrid.DZ - dperb_SW->at(fsgrids::dperb::dPERBzdx)/technicalGrid.DX);
+        (dperb_SW.at(fsgrids::dperb::dPERBxdz)/technicalGrid.DZ - dperb_SW.at(fsgrids::dperb::dPERBzdx)/technicalGrid.DX);
    }
 
    // Hall term
    if (Parameters::ohmHallTerm > 0) {
-      Ey_SW += EHallGrid.get(i,j,k)->at(fsgrids::ehall::EYHALL_000_010);
+      Ey_SW += fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EYHALL_000_010);
    }
    
    // Electron pressure gradient term
    if(Parameters::ohmGradPeTerm > 0) {
-      Ey_SW += EGradPeGrid.get(i,j,k)->at(fsgrids::egradpe::EYGRADPE);
+      Ey_SW += fsCell(EGradPeGrid,i,j,k).at(fsgrids::egradpe::EYGRADPE);
    }
    
    #ifndef FS_1ST_ORDER_SPACE
       // 2nd order terms
-      Ey_SW += +HALF*((Bz_S - HALF*dBzdx_S)*(-dmoments_SW->at(fsgrids::dmoments::dVxdx) - dmoments_SW->at(fsgrids::dmoments::dVxdz)) - dBzdx_S*Vx0 + SIXTH*dBzdy_S*dmoments_SW->at(fsgrids::dmoments::dVxdy));
-      Ey_SW += -HALF*((Bx_W - HALF*dBxdz_W)*(-dmoments_SW->at(fsgrids::dmoments::dVzdx) - dmoments_SW->at(fsgrids::dmoments::dVzdz)) - dBxdz_W*Vz0 + SIXTH*dBxdy_W*dmoments_SW->at(fsgrids::dmoments::dVzdy));
+      Ey_SW += +HALF*((Bz_S - HALF*dBzdx_S)*(-dmoments_SW.at(fsgrids::dmoments::dVxdx) - dmoments_SW.at(fsgrids::dmoments::dVxdz)) - dBzdx_S*Vx0 + SIXTH*dBzdy_S*dmoments_SW.at(fsgrids::dmoments::dVxdy));
+      Ey_SW += -HALF*((Bx_W - HALF*dBxdz_W)*(-dmoments_SW.at(fsgrids::dmoments::dVzdx) - dmoments_SW.at(fsgrids::dmoments::dVzdz)) - dBxdz_W*Vz0 + SIXTH*dBxdy_W*dmoments_SW.at(fsgrids::dmoments::dVzdy));
    #endif
    
    calculateWaveSpeedXZ(
@@ -939,8 +939,8 @@ void calculateEdgeElectricFieldY(
    maxV = max(maxV, calculateCflSpeed(Vz0, Vx0, vA, vS, vW));
 
    // Ey and characteristic speeds on k-1 neighbour:
-   Vx0  = moments_SE->at(fsgrids::moments::VX);
-   Vz0  = moments_SE->at(fsgrids::moments::VZ);
+   Vx0  = moments_SE.at(fsgrids::moments::VX);
+   Vz0  = moments_SE.at(fsgrids::moments::VZ);
 
    // 1st order terms:
    Real Ey_SE    = Bz_S*Vx0 - Bx_E*Vz0;
@@ -948,32 +948,32 @@ void calculateEdgeElectricFieldY(
    // Resistive term
    if (Parameters::resistivity > 0) {
       Ey_SE += Parameters::resistivity *
-        sqrt((bgb_SE->at(fsgrids::bgbfield::BGBX)+perb_SE->at(fsgrids::bfield::PERBX))*
-             (bgb_SE->at(fsgrids::bgbfield::BGBX)+perb_SE->at(fsgrids::bfield::PERBX)) +
-             (bgb_SE->at(fsgrids::bgbfield::BGBY)+perb_SE->at(fsgrids::bfield::PERBY))*
-             (bgb_SE->at(fsgrids::bgbfield::BGBY)+perb_SE->at(fsgrids::bfield::PERBY)) +
-             (bgb_SE->at(fsgrids::bgbfield::BGBZ)+perb_SE->at(fsgrids::bfield::PERBZ))*
-             (bgb_SE->at(fsgrids::bgbfield::BGBZ)+perb_SE->at(fsgrids::bfield::PERBZ))
+        sqrt((bgb_SE.at(fsgrids::bgbfield::BGBX)+perb_SE.at(fsgrids::bfield::PERBX))*
+             (bgb_SE.at(fsgrids::bgbfield::BGBX)+perb_SE.at(fsgrids::bfield::PERBX)) +
+             (bgb_SE.at(fsgrids::bgbfield::BGBY)+perb_SE.at(fsgrids::bfield::PERBY))*
+             (bgb_SE.at(fsgrids::bgbfield::BGBY)+perb_SE.at(fsgrids::bfield::PERBY)) +
+             (bgb_SE.at(fsgrids::bgbfield::BGBZ)+perb_SE.at(fsgrids::bfield::PERBZ))*
+             (bgb_SE.at(fsgrids::bgbfield::BGBZ)+perb_SE.at(fsgrids::bfield::PERBZ))
             ) /
-        moments_SE->at(fsgrids::moments::RHOQ) /
+        moments_SE.at(fsgrids::moments::RHOQ) /
         physicalconstants::MU_0 *
-        (dperb_SE->at(fsgrids::dperb::dPERBxdz)/technicalGrid.DZ - dperb_SE->at(fsgrids::dperb::dPERBzdx)/technicalGrid.DX);
+        (dperb_SE.at(fsgrids::dperb::dPERBxdz)/technicalGrid.DZ - dperb_SE.at(fsgrids::dperb::dPERBzdx)/technicalGrid.DX);
    }
 
    // Hall term
    if (Parameters::ohmHallTerm > 0) {
-      Ey_SE += EHallGrid.get(i,j,k-1)->at(fsgrids::ehall::EYHALL_001_011);
+      Ey_SE += fsCell(EHallGrid,i,j,k-1).at(fsgrids::ehall::EYHALL_001_011);
    }
    
    // Electron pressure gradient term
    if(Parameters::ohmGradPeTerm > 0) {
-      Ey_SE += EGradPeGrid.get(i,j,k-1)->at(fsgrids::egradpe::EYGRADPE);
+      Ey_SE += fsCell(EGradPeGrid,i,j,k-1).at(fsgrids::egradpe::EYGRADPE);
    }
    
    #ifndef FS_1ST_ORDER_SPACE
       // 2nd order terms:
-      Ey_SE += +HALF*((Bz_S - HALF*dBzdx_S)*(-dmoments_SE->at(fsgrids::dmoments::dVxdx) + dmoments_SE->at(fsgrids::dmoments::dVxdz)) - dBzdx_S*Vx0 + SIXTH*dBzdy_S*dmoments_SE->at(fsgrids::dmoments::dVxdy));
-      Ey_SE += -HALF*((Bx_E + HALF*dBxdz_E)*(-dmoments_SE->at(fsgrids::dmoments::dVzdx) + dmoments_SE->at(fsgrids::dmoments::dVzdz)) + dBxdz_E*Vz0 + SIXTH*dBxdy_E*dmoments_SE->at(fsgrids::dmoments::dVzdy));
+      Ey_SE += +HALF*((Bz_S - HALF*dBzdx_S)*(-dmoments_SE.at(fsgrids::dmoments::dVxdx) + dmoments_SE.at(fsgrids::dmoments::dVxdz)) - dBzdx_S*Vx0 + SIXTH*dBzdy_S*dmoments_SE.at(fsgrids::dmoments::dVxdy));
+      Ey_SE += -HALF*((Bx_E + HALF*dBxdz_E)*(-dmoments_SE.at(fsgrids::dmoments::dVzdx) + dmoments_SE.at(fsgrids::dmoments::dVzdz)) + dBxdz_E*Vz0 + SIXTH*dBxdy_E*dmoments_SE.at(fsgrids::dmoments::dVzdy));
    #endif
    
    calculateWaveSpeedXZ(
@@ -995,8 +995,8 @@ void calculateEdgeElectricFieldY(
    maxV = max(maxV, calculateCflSpeed(Vz0, Vx0, vA, vS, vW));
    
    // Ey and characteristic speeds on i-1 neighbour:
-   Vz0  = moments_NW->at(fsgrids::moments::VZ);
-   Vx0  = moments_NW->at(fsgrids::moments::VX);
+   Vz0  = moments_NW.at(fsgrids::moments::VZ);
+   Vx0  = moments_NW.at(fsgrids::moments::VX);
    
    // 1st order terms:
    Real Ey_NW    = Bz_N*Vx0 - Bx_W*Vz0;
@@ -1004,32 +1004,32 @@ void calculateEdgeElectricFieldY(
    // Resistive term
    if (Parameters::resistivity > 0) {
       Ey_NW += Parameters::resistivity *
-        sqrt((bgb_NW->at(fsgrids::bgbfield::BGBX)+perb_NW->at(fsgrids::bfield::PERBX))*
-             (bgb_NW->at(fsgrids::bgbfield::BGBX)+perb_NW->at(fsgrids::bfield::PERBX)) +
-             (bgb_NW->at(fsgrids::bgbfield::BGBY)+perb_NW->at(fsgrids::bfield::PERBY))*
-             (bgb_NW->at(fsgrids::bgbfield::BGBY)+perb_NW->at(fsgrids::bfield::PERBY)) +
-             (bgb_NW->at(fsgrids::bgbfield::BGBZ)+perb_NW->at(fsgrids::bfield::PERBZ))*
-             (bgb_NW->at(fsgrids::bgbfield::BGBZ)+perb_NW->at(fsgrids::bfield::PERBZ))
+        sqrt((bgb_NW.at(fsgrids::bgbfield::BGBX)+perb_NW.at(fsgrids::bfield::PERBX))*
+             (bgb_NW.at(fsgrids::bgbfield::BGBX)+perb_NW.at(fsgrids::bfield::PERBX)) +
+             (bgb_NW.at(fsgrids::bgbfield::BGBY)+perb_NW.at(fsgrids::bfield::PERBY))*
+             (bgb_NW.at(fsgrids::bgbfield::BGBY)+perb_NW.at(fsgrids::bfield::PERBY)) +
+             (bgb_NW.at(fsgrids::bgbfield::BGBZ)+perb_NW.at(fsgrids::bfield::PERBZ))*
+             (bgb_NW.at(fsgrids::bgbfield::BGBZ)+perb_NW.at(fsgrids::bfield::PERBZ))
             ) /
-        moments_NW->at(fsgrids::moments::RHOQ) /
+        moments_NW.at(fsgrids::moments::RHOQ) /
         physicalconstants::MU_0 *
-        (dperb_NW->at(fsgrids::dperb::dPERBxdz)/technicalGrid.DZ - dperb_NW->at(fsgrids::dperb::dPERBzdx)/technicalGrid.DX);
+        (dperb_NW.at(fsgrids::dperb::dPERBxdz)/technicalGrid.DZ - dperb_NW.at(fsgrids::dperb::dPERBzdx)/technicalGrid.DX);
    }
 
    // Hall term
    if(Parameters::ohmHallTerm > 0) {
-      Ey_NW += EHallGrid.get(i-1,j,k)->at(fsgrids::ehall::EYHALL_100_110);
+      Ey_NW += fsCell(EHallGrid,i-1,j,k).at(fsgrids::ehall::EYHALL_100_110);
    }
    
    // Electron pressure gradient term
    if(Parameters::ohmGradPeTerm > 0) {
-      Ey_NW += EGradPeGrid.get(i-1,j,k)->at(fsgrids::egradpe::EYGRADPE);
+      Ey_NW += fsCell(EGradPeGrid,i-1,j,k).at(fsgrids::egradpe::EYGRADPE);
    }
    
    #ifndef FS_1ST_ORDER_SPACE
       // 2nd order terms:
-      Ey_NW += +HALF*((Bz_N + HALF*dBzdx_N)*(+dmoments_NW->at(fsgrids::dmoments::dVxdx) - dmoments_NW->at(fsgrids::dmoments::dVxdz)) + dBzdx_N*Vx0 + SIXTH*dBzdy_N*dmoments_NW->at(fsgrids::dmoments::dVxdy));
-      Ey_NW += -HALF*((Bx_W - HALF*dBxdz_W)*(+dmoments_NW->at(fsgrids::dmoments::dVzdx) - dmoments_NW->at(fsgrids::dmoments::dVzdz)) - dBxdz_W*Vz0 + SIXTH*dBxdy_W*dmoments_NW->at(fsgrids::dmoments::dVzdy));
+      Ey_NW += +HALF*((Bz_N + HALF*dBzdx_N)*(+dmoments_NW.at(fsgrids::dmoments::dVxdx) - dmoments_NW.at(fsgrids::dmoments::dVxdz)) + dBzdx_N*Vx0 + SIXTH*dBzdy_N*dmoments_NW.at(fsgrids::dmoments::dVxdy));
+      Ey_NW += -HALF*((Bx_W - HALF*dBxdz_W)*(+dmoments_NW.at(fsgrids::dmoments::dVzdx) - dmoments_NW.at(fsgrids::dmoments::dVzdz)) - dBxdz_W*Vz0 + SIXTH*dBxdy_W*dmoments_NW.at(fsgrids::dmoments::dVzdy));
    #endif
    
    calculateWaveSpeedXZ(
@@ -1051,8 +1051,8 @@ void calculateEdgeElectricFieldY(
    maxV = max(maxV, calculateCflSpeed(Vz0, Vx0, vA, vS, vW));
 
    // Ey and characteristic speeds on i-1,k-1 neighbour:
-   Vz0 = moments_NE->at(fsgrids::moments::VZ);
-   Vx0 = moments_NE->at(fsgrids::moments::VX);
+   Vz0 = moments_NE.at(fsgrids::moments::VZ);
+   Vx0 = moments_NE.at(fsgrids::moments::VX);
    
    // 1st order terms:
    Real Ey_NE    = Bz_N*Vx0 - Bx_E*Vz0;
@@ -1060,32 +1060,32 @@ void calculateEdgeElectricFieldY(
    // Resistive term
    if (Parameters::resistivity > 0) {
       Ey_NE += Parameters::resistivity *
-        sqrt((bgb_NE->at(fsgrids::bgbfield::BGBX)+perb_NE->at(fsgrids::bfield::PERBX))*
-             (bgb_NE->at(fsgrids::bgbfield::BGBX)+perb_NE->at(fsgrids::bfield::PERBX)) +
-             (bgb_NE->at(fsgrids::bgbfield::BGBY)+perb_NE->at(fsgrids::bfield::PERBY))*
-             (bgb_NE->at(fsgrids::bgbfield::BGBY)+perb_NE->at(fsgrids::bfield::PERBY)) +
-             (bgb_NE->at(fsgrids::bgbfield::BGBZ)+perb_NE->at(fsgrids::bfield::PERBZ))*
-             (bgb_NE->at(fsgrids::bgbfield::BGBZ)+perb_NE->at(fsgrids::bfield::PERBZ))
+        sqrt((bgb_NE.at(fsgrids::bgbfield::BGBX)+perb_NE.at(fsgrids::bfield::PERBX))*
+             (bgb_NE.at(fsgrids::bgbfield::BGBX)+perb_NE.at(fsgrids::bfield::PERBX)) +
+             (bgb_NE.at(fsgrids::bgbfield::BGBY)+perb_NE.at(fsgrids::bfield::PERBY))*
+             (bgb_NE.at(fsgrids::bgbfield::BGBY)+perb_NE.at(fsgrids::bfield::PERBY)) +
+             (bgb_NE.at(fsgrids::bgbfield::BGBZ)+perb_NE.at(fsgrids::bfield::PERBZ))*
+             (bgb_NE.at(fsgrids::bgbfield::BGBZ)+perb_NE.at(fsgrids::bfield::PERBZ))
             ) /
-        moments_NE->at(fsgrids::moments::RHOQ) /
+        moments_NE.at(fsgrids::moments::RHOQ) /
         physicalconstants::MU_0 *
-        (dperb_NE->at(fsgrids::dperb::dPERBxdz)/technicalGrid.DZ - dperb_NE->at(fsgrids::dperb::dPERBzdx)/technicalGrid.DX);
+        (dperb_NE.at(fsgrids::dperb::dPERBxdz)/technicalGrid.DZ - dperb_NE.at(fsgrids::dperb::dPERBzdx)/technicalGrid.DX);
    }
 
    // Hall term
    if(Parameters::ohmHallTerm > 0) {
-      Ey_NE += EHallGrid.get(i-1,j,k-1)->at(fsgrids::ehall::EYHALL_101_111);
+      Ey_NE += fsCell(EHallGrid,i-1,j,k-1).at(fsgrids::ehall::EYHALL_101_111);
    }
    
    // Electron pressure gradient term
    if(Parameters::ohmGradPeTerm > 0) {
-      Ey_NE += EGradPeGrid.get(i-1,j,k-1)->at(fsgrids::egradpe::EYGRADPE);
+      Ey_NE += fsCell(EGradPeGrid,i-1,j,k-1).at(fsgrids::egradpe::EYGRADPE);
    }
    
    #ifndef FS_1ST_ORDER_SPACE
       // 2nd order terms:
-      Ey_NE += +HALF*((Bz_N + HALF*dBzdx_N)*(+dmoments_NE->at(fsgrids::dmoments::dVxdx) + dmoments_NE->at(fsgrids::dmoments::dVxdz)) + dBzdx_N*Vx0 + SIXTH*dBzdy_N*dmoments_NE->at(fsgrids::dmoments::dVxdy));
-      Ey_NE += -HALF*((Bx_E + HALF*dBxdz_E)*(+dmoments_NE->at(fsgrids::dmoments::dVzdx) + dmoments_NE->at(fsgrids::dmoments::dVzdz)) + dBxdz_E*Vz0 + SIXTH*dBxdy_E*dmoments_NE->at(fsgrids::dmoments::dVzdy));
+      Ey_NE += +HALF*((Bz_N + HALF*dBzdx_N)*(+dmoments_NE.at(fsgrids::dmoments::dVxdx) + dmoments_NE.at(fsgrids::dmoments::dVxdz)) + dBzdx_N*Vx0 + SIXTH*dBzdy_N*dmoments_NE.at(fsgrids::dmoments::dVxdy));
+      Ey_NE += -HALF*((Bx_E + HALF*dBxdz_E)*(+dmoments_NE.at(fsgrids::dmoments::dVzdx) + dmoments_NE.at(fsgrids::dmoments::dVzdz)) + dBxdz_E*Vz0 + SIXTH*dBxdy_E*dmoments_NE.at(fsgrids::dmoments::dVzdy));
    #endif
    
    calculateWaveSpeedXZ(
@@ -1106,16 +1106,16 @@ void calculateEdgeElectricFieldY(
    ax_pos   = max(ax_pos,+Vx0 + c_x);
    maxV = max(maxV, calculateCflSpeed(Vz0, Vx0, vA, vS, vW));
    // Calculate properly upwinded edge-averaged Ey:
-   efield_SW->at(fsgrids::efield::EY)  = az_pos*ax_pos*Ey_NE + az_pos*ax_neg*Ey_SE + az_neg*ax_pos*Ey_NW + az_neg*ax_neg*Ey_SW;
-   efield_SW->at(fsgrids::efield::EY) /= ((az_pos+az_neg)*(ax_pos+ax_neg)+EPS);
+   efield_SW.at(fsgrids::efield::EY)  = az_pos*ax_pos*Ey_NE + az_pos*ax_neg*Ey_SE + az_neg*ax_pos*Ey_NW + az_neg*ax_neg*Ey_SW;
+   efield_SW.at(fsgrids::efield::EY) /= ((az_pos+az_neg)*(ax_pos+ax_neg)+EPS);
 
    if (Parameters::fieldSolverDiffusiveEterms) {
 #ifdef FS_1ST_ORDER_SPACE
-      efield_SW->at(fsgrids::efield::EY) -= ax_pos*ax_neg/(ax_pos+ax_neg+EPS)*(perBz_S-perBz_N);
-      efield_SW->at(fsgrids::efield::EY) += az_pos*az_neg/(az_pos+az_neg+EPS)*(perBx_W-perBx_E);
+      efield_SW.at(fsgrids::efield::EY) -= ax_pos*ax_neg/(ax_pos+ax_neg+EPS)*(perBz_S-perBz_N);
+      efield_SW.at(fsgrids::efield::EY) += az_pos*az_neg/(az_pos+az_neg+EPS)*(perBx_W-perBx_E);
 #else
-      efield_SW->at(fsgrids::efield::EY) -= ax_pos*ax_neg/(ax_pos+ax_neg+EPS)*((perBz_S-HALF*dperBzdx_S) - (perBz_N+HALF*dperBzdx_N));
-      efield_SW->at(fsgrids::efield::EY) += az_pos*az_neg/(az_pos+az_neg+EPS)*((perBx_W-HALF*dperBxdz_W) - (perBx_E+HALF*dperBxdz_E));
+      efield_SW.at(fsgrids::efield::EY) -= ax_pos*ax_neg/(ax_pos+ax_neg+EPS)*((perBz_S-HALF*dperBzdx_S) - (perBz_N+HALF*dperBzdx_N));
+      efield_SW.at(fsgrids::efield::EY) += az_pos*az_neg/(az_pos+az_neg+EPS)*((perBx_W-HALF*dperBxdz_W) - (perBx_E+HALF*dperBxdz_E));
 #endif
    }
    
@@ -1176,73 +1176,73 @@ void calculateEdgeElectricFieldZ(
    Real c_x,c_y;                    // Characteristic speeds to xy-directions
    
    // Get read-only pointers to NE,NW,SE,SW states (SW is rw, result is written there):
-   std::array<Real, fsgrids::bfield::N_BFIELD> * perb_SW = perBGrid.get(i  ,j  ,k  );
-   std::array<Real, fsgrids::bfield::N_BFIELD> * perb_SE = perBGrid.get(i-1,j  ,k  );
-   std::array<Real, fsgrids::bfield::N_BFIELD> * perb_NE = perBGrid.get(i-1,j-1,k  );
-   std::array<Real, fsgrids::bfield::N_BFIELD> * perb_NW = perBGrid.get(i  ,j-1,k  );
-   std::array<Real, fsgrids::bgbfield::N_BGB> * bgb_SW = BgBGrid.get(i  ,j  ,k  );
-   std::array<Real, fsgrids::bgbfield::N_BGB> * bgb_SE = BgBGrid.get(i-1,j  ,k  );
-   std::array<Real, fsgrids::bgbfield::N_BGB> * bgb_NE = BgBGrid.get(i-1,j-1,k  );
-   std::array<Real, fsgrids::bgbfield::N_BGB> * bgb_NW = BgBGrid.get(i  ,j-1,k  );
-   std::array<Real, fsgrids::moments::N_MOMENTS> * moments_SW = momentsGrid.get(i  ,j  ,k  );
-   std::array<Real, fsgrids::moments::N_MOMENTS> * moments_SE = momentsGrid.get(i-1,j  ,k  );
-   std::array<Real, fsgrids::moments::N_MOMENTS> * moments_NE = momentsGrid.get(i-1,j-1,k  );
-   std::array<Real, fsgrids::moments::N_MOMENTS> * moments_NW = momentsGrid.get(i  ,j-1,k  );
-   std::array<Real, fsgrids::dmoments::N_DMOMENTS> * dmoments_SW = dMomentsGrid.get(i  ,j  ,k  );
-   std::array<Real, fsgrids::dmoments::N_DMOMENTS> * dmoments_SE = dMomentsGrid.get(i-1,j  ,k  );
-   std::array<Real, fsgrids::dmoments::N_DMOMENTS> * dmoments_NE = dMomentsGrid.get(i-1,j-1,k  );
-   std::array<Real, fsgrids::dmoments::N_DMOMENTS> * dmoments_NW = dMomentsGrid.get(i  ,j-1,k  );
-   std::array<Real, fsgrids::dperb::N_DPERB> * dperb_SW = dPerBGrid.get(i  ,j  ,k  );
-   std::array<Real, fsgrids::dperb::N_DPERB> * dperb_SE = dPerBGrid.get(i-1,j  ,k  );
-   std::array<Real, fsgrids::dperb::N_DPERB> * dperb_NE = dPerBGrid.get(i-1,j-1,k  );
-   std::array<Real, fsgrids::dperb::N_DPERB> * dperb_NW = dPerBGrid.get(i  ,j-1,k  );
-   
-   std::array<Real, fsgrids::efield::N_EFIELD> * efield_SW = EGrid.get(i,j,k);
+   FsCell<fsgrids::bfield::N_BFIELD> perb_SW = fsCell(perBGrid,i  ,j  ,k  );
+   FsCell<fsgrids::bfield::N_BFIELD> perb_SE = fsCell(perBGrid,i-1,j  ,k  );
+   FsCell<fsgrids::bfield::N_BFIELD> perb_NE = fsCell(perBGrid,i-1,j-1,k  );
+   FsCell<fsgrids::bfield::N_BFIELD> perb_NW = fsCell(perBGrid,i  ,j-1,k  );
+   FsCell<fsgrids::bgbfield::N_BGB> bgb_SW = fsCell(BgBGrid,i  ,j  ,k  );
+   FsCell<fsgrids::bgbfield::N_BGB> bgb_SE = fsCell(BgBGrid,i-1,j  ,k  );
+   FsCell<fsgrids::bgbfield::N_BGB> bgb_NE = fsCell(BgBGrid,i-1,j-1,k  );
+   FsCell<fsgrids::bgbfield::N_BGB> bgb_NW = fsCell(BgBGrid,i  ,j-1,k  );
+   FsCell<fsgrids::moments::N_MOMENTS> moments_SW = fsCell(momentsGrid,i  ,j  ,k  );
+   FsCell<fsgrids::moments::N_MOMENTS> moments_SE = fsCell(momentsGrid,i-1,j  ,k  );
+   FsCell<fsgrids::moments::N_MOMENTS> moments_NE = fsCell(momentsGrid,i-1,j-1,k  );
+   FsCell<fsgrids::moments::N_MOMENTS> moments_NW = fsCell(momentsGrid,i  ,j-1,k  );
+   FsCell<fsgrids::dmoments::N_DMOMENTS> dmoments_SW = fsCell(dMomentsGrid,i  ,j  ,k  );
+   FsCell<fsgrids::dmoments::N_DMOMENTS> dmoments_SE = fsCell(dMomentsGrid,i-1,j  ,k  );
+   FsCell<fsgrids::dmoments::N_DMOMENTS> dmoments_NE = fsCell(dMomentsGrid,i-1,j-1,k  );
+   FsCell<fsgrids::dmoments::N_DMOMENTS> dmoments_NW = fsCell(dMomentsGrid,i  ,j-1,k  );
+   FsCell<fsgrids::dperb::N_DPERB> dperb_SW = fsCell(dPerBGrid,i  ,j  ,k  );
+   FsCell<fsgrids::dperb::N_DPERB> dperb_SE = fsCell(dPerBGrid,i-1,j  ,k  );
+   FsCell<fsgrids::dperb::N_DPERB> dperb_NE = fsCell(dPerBGrid,i-1,j-1,k  );
+   FsCell<fsgrids::dperb::N_DPERB> dperb_NW = fsCell(dPerBGrid,i  ,j-1,k  );
+   
+   FsCell<fsgrids::efield::N_EFIELD> efield_SW = fsCell(EGrid,i,j,k);
    
    // Fetch needed plasma parameters/derivatives from the four cells:
    Real Bx_S, By_W, By_E, Bx_N, perBx_S, perBy_W, perBy_E, perBx_N;
    Real minRhom = std::numeric_limits<Real>::max();
    Real maxRhom = std::numeric_limits<Real>::min();
 
-   Bx_S    = perb_SW->at(fsgrids::bfield::PERBX) + bgb_SW->at(fsgrids::bgbfield::BGBX);
-   By_W    = perb_SW->at(fsgrids::bfield::PERBY) + bgb_SW->at(fsgrids::bgbfield::BGBY);
-   By_E    = perb_SE->at(fsgrids::bfield::PERBY) + bgb_SE->at(fsgrids::bgbfield::BGBY);
-   Bx_N    = perb_NW->at(fsgrids::bfield::PERBX) + bgb_NW->at(fsgrids::bgbfield::BGBX);
-   perBx_S    = perb_SW->at(fsgrids::bfield::PERBX);
-   perBy_W    = perb_SW->at(fsgrids::bfield::PERBY);
-   perBy_E    = perb_SE->at(fsgrids::bfield::PERBY);
-   perBx_N    = perb_NW->at(fsgrids::bfield::PERBX);
-   Vx0  = moments_SW->at(fsgrids::moments::VX);
-   Vy0  = moments_SW->at(fsgrids::moments::VY);
+   Bx_S    = perb_SW.at(fsgrids::bfield::PERBX) + bgb_SW.at(fsgrids::bgbfield::BGBX);
+   By_W    = perb_SW.at(fsgrids::bfield::PERBY) + bgb_SW.at(fsgrids::bgbfield::BGBY);
+   By_E    = perb_SE.at(fsgrids::bfield::PERBY) + bgb_SE.at(fsgrids::bgbfield::BGBY);
+   Bx_N    = perb_NW.at(fsgrids::bfield::PERBX) + bgb_NW.at(fsgrids::bgbfield::BGBX);
+   perBx_S    = perb_SW.at(fsgrids::bfield::PERBX);
+   perBy_W    = perb_SW.at(fsgrids::bfield::PERBY);
+   perBy_E    = perb_SE.at(fsgrids::bfield::PERBY);
+   perBx_N    = perb_NW.at(fsgrids::bfield::PERBX);
+   Vx0  = moments_SW.at(fsgrids::moments::VX);
+   Vy0  = moments_SW.at(fsgrids::moments::VY);
    minRhom = min(minRhom,
-         min(moments_SW->at(fsgrids::moments::RHOM),
-            min(moments_SE->at(fsgrids::moments::RHOM),
-               min(moments_NW->at(fsgrids::moments::RHOM),
-                  moments_NE->at(fsgrids::moments::RHOM))
+         min(moments_SW.at(fsgrids::moments::RHOM),
+            min(moments_SE.at(fsgrids::moments::RHOM),
+               min(moments_NW.at(fsgrids::moments::RHOM),
+                  moments_NE.at(fsgrids::moments::RHOM))
                )
             )
          );
    maxRhom = max(maxRhom,
-         max(moments_SW->at(fsgrids::moments::RHOM),
-            max(moments_SE->at(fsgrids::moments::RHOM),
-               max(moments_NW->at(fsgrids::moments::RHOM),
-                  moments_NE->at(fsgrids::moments::RHOM))
+         max(moments_SW.at(fsgrids::moments::RHOM),
+            max(moments_SE.at(fsgrids::moments::RHOM),
+               max(moments_NW.at(fsgrids::moments::RHOM),
+                  moments_NE.at(fsgrids::moments::RHOM))
                )
             )
          );
    
-   creal dBxdy_S = dperb_SW->at(fsgrids::dperb::dPERBxdy) + bgb_SW->at(fsgrids::bgbfield::dBGBxdy);
-   creal dBxdz_S = dperb_SW->at(fsgrids::dperb::dPERBxdz) + bgb_SW->at(fsgrids::bgbfield::dBGBxdz);
-   creal dBydx_W = dperb_SW->at(fsgrids::dperb::dPERBydx) + bgb_SW->at(fsgrids::bgbfield::dBGBydx);
-   creal dBydz_W = dperb_SW->at(fsgrids::dperb::dPERBydz) + bgb_SW->at(fsgrids::bgbfield::dBGBydz);
-   creal dBydx_E = dperb_SE->at(fsgrids::dperb::dPERBydx) + bgb_SE->at(fsgrids::bgbfield::dBGBydx);
-   creal dBydz_E = dperb_SE->at(fsgrids::dperb::dPERBydz) + bgb_SE->at(fsgrids::bgbfield::dBGBydz);
-   creal dBxdy_N = dperb_NW->at(fsgrids::dperb::dPERBxdy) + bgb_NW->at(fsgrids::bgbfield::dBGBxdy);
-   creal dBxdz_N = dperb_NW->at(fsgrids::dperb::dPERBxdz) + bgb_NW->at(fsgrids::bgbfield::dBGBxdz);
-   creal dperBxdy_S = dperb_SW->at(fsgrids::dperb::dPERBxdy);
-   creal dperBxdy_N = dperb_NW->at(fsgrids::dperb::dPERBxdy);
-   creal dperBydx_W = dperb_SW->at(fsgrids::dperb::dPERBydx);
-   creal dperBydx_E = dperb_SE->at(fsgrids::dperb::dPERBydx);
+   creal dBxdy_S = dperb_SW.at(fsgrids::dperb::dPERBxdy) + bgb_SW.at(fsgrids::bgbfield::dBGBxdy);
+   creal dBxdz_S = dperb_SW.at(fsgrids::dperb::dPERBxdz) + bgb_SW.at(fsgrids::bgbfield::dBGBxdz);
+   creal dBydx_W = dperb_SW.at(fsgrids::dperb::dPERBydx) + bgb_SW.at(fsgrids::bgbfield::dBGBydx);
+   creal dBydz_W = dperb_SW.at(fsgrids::dperb::dPERBydz) + bgb_SW.at(fsgrids::bgbfield::dBGBydz);
+   creal dBydx_E = dperb_SE.at(fsgrids::dperb::dPERBydx) + bgb_SE.at(fsgrids::bgbfield::dBGBydx);
+   creal dBydz_E = dperb_SE.at(fsgrids::dperb::dPERBydz) + bgb_SE.at(fsgrids::bgbfield::dBGBydz);
+   creal dBxdy_N = dperb_NW.at(fsgrids::dperb::dPERBxdy) + bgb_NW.at(fsgrids::bgbfield::dBGBxdy);
+   creal dBxdz_N = dperb_NW.at(fsgrids::dperb::dPERBxdz) + bgb_NW.at(fsgrids::bgbfield::dBGBxdz);
+   creal dperBxdy_S = dperb_SW.at(fsgrids::dperb::dPERBxdy);
+   creal dperBxdy_N = dperb_NW.at(fsgrids::dperb::dPERBxdy);
+   creal dperBydx_W = dperb_SW.at(fsgrids::dperb::dPERBydx);
+   creal dperBydx_E = dperb_SE.at(fsgrids::dperb::dPERBydx);
    
    // Ez and characteristic speeds on SW cell:
    // 1st order terms:
@@ -1251,32 +1251,32 @@ void calculateEdgeElectricFieldZ(
    // Resistive term
    if (Parameters::resistivity > 0) {
      Ez_SW += Parameters::resistivity *
-       sqrt((bgb_SW->at(fsgrids::bgbfield::BGBX)+perb_SW->at(fsgrids::bfield::PERBX))*
-            (bgb_SW->at(fsgrids::bgbfield::BGBX)+perb_SW->at(fsgrids::bfield::PERBX)) +
-            (bgb_SW->at(fsgrids::bgbfield::BGBY)+perb_SW->at(fsgrids::bfield::PERBY))*
-            (bgb_SW->at(fsgrids::bgbfield::BGBY)+perb_SW->at(fsgrids::bfield::PERBY)) +
-            (bgb_SW->at(fsgrids::bgbfield::BGBZ)+perb_SW->at(fsgrids::bfield::PERBZ))*
-            (bgb_SW->at(fsgrids::bgbfield::BGBZ)+perb_SW->at(fsgrids::bfield::PERBZ))
+       sqrt((bgb_SW.at(fsgrids::bgbfield::BGBX)+perb_SW.at(fsgrids::bfield::PERBX))*
+            (bgb_SW.at(fsgrids::bgbfield::BGBX)+perb_SW.at(fsgrids::bfield::PERBX)) +
+            (bgb_SW.at(fsgrids::bgbfield::BGBY)+perb_SW.at(fsgrids::bfield::PERBY))*
+            (bgb_SW.at(fsgrids::bgbfield::BGBY)+perb_SW.at(fsgrids::bfield::PERBY)) +
+            (bgb_SW.at(fsgrids::bgbfield::BGBZ)+perb_SW.at(fsgrids::bfield::PERBZ))*
+            (bgb_SW.at(fsgrids::bgbfield::BGBZ)+perb_SW.at(fsgrids::bfield::PERBZ))
            ) /
-       moments_SW->at(fsgrids::moments::RHOQ) /
+       moments_SW.at(fsgrids::moments::RHOQ) /
        physicalconstants::MU_0 *
-       (dperb_SW->at(fsgrids::dperb::dPERBydx)/technicalGrid.DX - dperb_SW->at(fsgrids::dperb::dPERBxdy)/technicalGrid.DY);
+       (dperb_SW.at(fsgrids::dperb::dPERBydx)/technicalGrid.DX - dperb_SW.at(fsgrids::dperb::dPERBxdy)/technicalGrid.DY);
    }
    
    // Hall term
    if (Parameters::ohmHallTerm > 0) {
-      Ez_SW += EHallGrid.get(i,j,k)->at(fsgrids::ehall::EZHALL_000_001);
+      Ez_SW += fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EZHALL_000_001);
    }
    
    // Electron pressure gradient term
    if(Parameters::ohmGradPeTerm > 0) {
-      Ez_SW += EGradPeGrid.get(i,j,k)->at(fsgrids::egradpe::EZGRADPE);
+      Ez_SW += fsCell(EGradPeGrid,i,j,k).at(fsgrids::egradpe::EZGRADPE);
    }
    
    #ifndef FS_1ST_ORDER_SPACE
       // 2nd order terms:
-      Ez_SW  += +HALF*((Bx_S - HALF*dBxdy_S)*(-dmoments_SW->at(fsgrids::dmoments::dVydx) - dmoments_SW->at(fsgrids::dmoments::dVydy)) - dBxdy_S*Vy0 + SIXTH*dBxdz_S*dmoments_SW->at(fsgrids::dmoments::dVydz));
-      Ez_SW  += -HALF*((By_W - HALF*dBydx_W)*(-dmoments_SW->at(fsgrids::dmoments::dVxdx) - dmoments_SW->at(fsgrids::dmoments::dVxdy)) - dBydx_W*Vx0 + SIXTH*dBydz_W*dmoments_SW->at(fsgrids::dmoments::dVxdz));
+      Ez_SW  += +HALF*((Bx_S - HALF*dBxdy_S)*(-dmoments_SW.at(fsgrids::dmoments::dVydx) - dmoments_SW.at(fsgrids::dmoments::dVydy)) - dBxdy_S*Vy0 + SIXTH*dBxdz_S*dmoments_SW.at(fsgrids::dmoments::dVydz));
+      Ez_SW  += -HALF*((By_W - HALF*dBydx_W)*(-dmoments_SW.at(fsgrids::dmoments::dVxdx) - dmoments_SW.at(fsgrids::dmoments::dVxdy)) - dBydx_W*Vx0 + SIXTH*dBydz_W*dmoments_SW.at(fsgrids::dmoments::dVxdz));
    #endif
    
    // Calculate maximum wave speed (fast magnetosonic speed) on SW cell. In order 
@@ -1300,8 +1300,8 @@ void calculateEdgeElectricFieldZ(
    maxV = max(maxV, calculateCflSpeed(Vx0, Vy0, vA, vS, vW));
 
    // Ez and characteristic speeds on SE (i-1) cell:
-   Vx0  = moments_SE->at(fsgrids::moments::VX);
-   Vy0  = moments_SE->at(fsgrids::moments::VY);
+   Vx0  = moments_SE.at(fsgrids::moments::VX);
+   Vy0  = moments_SE.at(fsgrids::moments::VY);
    
    // 1st order terms:
    Real Ez_SE = Bx_S*Vy0 - By_E*Vx0;
@@ -1309,32 +1309,32 @@ void calculateEdgeElectricFieldZ(
    // Resistive term
    if (Parameters::resistivity > 0) {
       Ez_SE += Parameters::resistivity *
-        sqrt((bgb_SE->at(fsgrids::bgbfield::BGBX)+perb_SE->at(fsgrids::bfield::PERBX))*
-             (bgb_SE->at(fsgrids::bgbfield::BGBX)+perb_SE->at(fsgrids::bfield::PERBX)) +
-             (bgb_SE->at(fsgrids::bgbfield::BGBY)+perb_SE->at(fsgrids::bfield::PERBY))*
-             (bgb_SE->at(fsgrids::bgbfield::BGBY)+perb_SE->at(fsgrids::bfield::PERBY)) +
-             (bgb_SE->at(fsgrids::bgbfield::BGBZ)+perb_SE->at(fsgrids::bfield::PERBZ))*
-             (bgb_SE->at(fsgrids::bgbfield::BGBZ)+perb_SE->at(fsgrids::bfield::PERBZ))
+        sqrt((bgb_SE.at(fsgrids::bgbfield::BGBX)+perb_SE.at(fsgrids::bfield::PERBX))*
+             (bgb_SE.at(fsgrids::bgbfield::BGBX)+perb_SE.at(fsgrids::bfield::PERBX)) +
+             (bgb_SE.at(fsgrids::bgbfield::BGBY)+perb_SE.at(fsgrids::bfield::PERBY))*
+             (bgb_SE.at(fsgrids::bgbfield::BGBY)+perb_SE.at(fsgrids::bfield::PERBY)) +
+             (bgb_SE.at(fsgrids::bgbfield::BGBZ)+perb_SE.at(fsgrids::bfield::PERBZ))*
+             (bgb_SE.at(fsgrids::bgbfield::BGBZ)+perb_SE.at(fsgrids::bfield::PERBZ))
             ) /
-        moments_SE->at(fsgrids::moments::RHOQ) /
+        moments_SE.at(fsgrids::moments::RHOQ) /
         physicalconstants::MU_0 *
-        (dperb_SE->at(fsgrids::dperb::dPERBydx)/technicalGrid.DX - dperb_SE->at(fsgrids::dperb::dPERBxdy)/technicalGrid.DY);
+        (dperb_SE.at(fsgrids::dperb::dPERBydx)/technicalGrid.DX - dperb_SE.at(fsgrids::dperb::dPERBxdy)/technicalGrid.DY);
    }
    
    // Hall term
    if (Parameters::ohmHallTerm > 0) {
-      Ez_SE += EHallGrid.get(i-1,j,k)->at(fsgrids::ehall::EZHALL_100_101);
+      Ez_SE += fsCell(EHallGrid,i-1,j,k).at(fsgrids::ehall::EZHALL_100_101);
    }
    
    // Electron pressure gradient term
    if(Parameters::ohmGradPeTerm > 0) {
-      Ez_SE += EGradPeGrid.get(i-1,j,k)->at(fsgrids::egradpe::EZGRADPE);
+      Ez_SE += fsCell(EGradPeGrid,i-1,j,k).at(fsgrids::egradpe::EZGRADPE);
    }
    
    #ifndef FS_1ST_ORDER_SPACE
       // 2nd order terms:
-      Ez_SE  += +HALF*((Bx_S - HALF*dBxdy_S)*(+dmoments_SE->at(fsgrids::dmoments::dVydx) - dmoments_SE->at(fsgrids::dmoments::dVydy)) - dBxdy_S*Vy0 + SIXTH*dBxdz_S*dmoments_SE->at(fsgrids::dmoments::dVydz));
-      Ez_SE  += -HALF*((By_E + HALF*dBydx_E)*(+dmoments_SE->at(fsgrids::dmoments::dVxdx) - dmoments_SE->at(fsgrids::dmoments::dVxdy)) + dBydx_E*Vx0 + SIXTH*dBydz_E*dmoments_SE->at(fsgrids::dmoments::dVxdz));
+      Ez_SE  += +HALF*((Bx_S - HALF*dBxdy_S)*(+dmoments_SE.at(fsgrids::dmoments::dVydx) - dmoments_SE.at(fsgrids::dmoments::dVydy)) - dBxdy_S*Vy0 + SIXTH*dBxdz_S*dmoments_SE.at(fsgrids::dmoments::dVydz));
+      Ez_SE  += -HALF*((By_E + HALF*dBydx_E)*(+dmoments_SE.at(fsgrids::dmoments::dVxdx) - dmoments_SE.at(fsgrids::dmoments::dVxdy)) + dBydx_E*Vx0 + SIXTH*dBydz_E*dmoments_SE.at(fsgrids::dmoments::dVxdz));
    #endif
    
    calculateWaveSpeedXY(
@@ -1356,8 +1356,8 @@ void calculateEdgeElectricFieldZ(
    maxV = max(maxV, calculateCflSpeed(Vx0, Vy0, vA, vS, vW));
 
    // Ez and characteristic speeds on NW (j-1) cell:
-   Vx0  = moments_NW->at(fsgrids::moments::VX);
-   Vy0  = moments_NW->at(fsgrids::moments::VY);
+   Vx0  = moments_NW.at(fsgrids::moments::VX);
+   Vy0  = moments_NW.at(fsgrids::moments::VY);
    
    // 1st order terms:
    Real Ez_NW = Bx_N*Vy0 - By_W*Vx0;
@@ -1365,32 +1365,32 @@ void calculateEdgeElectricFieldZ(
    // Resistive term
    if (Parameters::resistivity > 0) {
       Ez_NW += Parameters::resistivity *
-        sqrt((bgb_NW->at(fsgrids::bgbfield::BGBX)+perb_NW->at(fsgrids::bfield::PERBX))*
-             (bgb_NW->at(fsgrids::bgbfield::BGBX)+perb_NW->at(fsgrids::bfield::PERBX)) +
-             (bgb_NW->at(fsgrids::bgbfield::BGBY)+perb_NW->at(fsgrids::bfield::PERBY))*
-             (bgb_NW->at(fsgrids::bgbfield::BGBY)+perb_NW->at(fsgrids::bfield::PERBY)) +
-             (bgb_NW->at(fsgrids::bgbfield::BGBZ)+perb_NW->at(fsgrids::bfield::PERBZ))*
-             (bgb_NW->at(fsgrids::bgbfield::BGBZ)+perb_NW->at(fsgrids::bfield::PERBZ))
+        sqrt((bgb_NW.at(fsgrids::bgbfield::BGBX)+perb_NW.at(fsgrids::bfield::PERBX))*
+             (bgb_NW.at(fsgrids::bgbfield::BGBX)+perb_NW.at(fsgrids::bfield::PERBX)) +
+             (bgb_NW.at(fsgrids::bgbfield::BGBY)+perb_NW.at(fsgrids::bfield::PERBY))*
+             (bgb_NW.at(fsgrids::bgbfield::BGBY)+perb_NW.at(fsgrids::bfield::PERBY)) +
+             (bgb_NW.at(fsgrids::bgbfield::BGBZ)+perb_NW.at(fsgrids::bfield::PERBZ))*
+             (bgb_NW.at(fsgrids::bgbfield::BGBZ)+perb_NW.at(fsgrids::bfield::PERBZ))
             ) /
-        moments_NW->at(fsgrids::moments::RHOQ) /
+        moments_NW.at(fsgrids::moments::RHOQ) /
         physicalconstants::MU_0 *
-        (dperb_NW->at(fsgrids::dperb::dPERBydx)/technicalGrid.DX - dperb_NW->at(fsgrids::dperb::dPERBxdy)/technicalGrid.DY);
+        (dperb_NW.at(fsgrids::dperb::dPERBydx)/technicalGrid.DX - dperb_NW.at(fsgrids::dperb::dPERBxdy)/technicalGrid.DY);
    }
    
    // Hall term
    if(Parameters::ohmHallTerm > 0) {
-      Ez_NW += EHallGrid.get(i,j-1,k)->at(fsgrids::ehall::EZHALL_010_011);
+      Ez_NW += fsCell(EHallGrid,i,j-1,k).at(fsgrids::ehall::EZHALL_010_011);
    }
    
    // Electron pressure gradient term
    if(Parameters::ohmGradPeTerm > 0) {
-      Ez_NW += EGradPeGrid.get(i,j-1,k)->at(fsgrids::egradpe::EZGRADPE);
+      Ez_NW += fsCell(EGradPeGrid,i,j-1,k).at(fsgrids::egradpe::EZGRADPE);
    }
    
    #ifndef FS_1ST_ORDER_SPACE
       // 2nd order terms:
-      Ez_NW  += +HALF*((Bx_N + HALF*dBxdy_N)*(-dmoments_NW->at(fsgrids::dmoments::dVydx) + dmoments_NW->at(fsgrids::dmoments::dVydy)) + dBxdy_N*Vy0 + SIXTH*dBxdz_N*dmoments_NW->at(fsgrids::dmoments::dVydz));
-      Ez_NW  += -HALF*((By_W - HALF*dBydx_W)*(-dmoments_NW->at(fsgrids::dmoments::dVxdx) + dmoments_NW->at(fsgrids::dmoments::dVxdy)) - dBydx_W*Vx0 + SIXTH*dBydz_W*dmoments_NW->at(fsgrids::dmoments::dVxdz));
+      Ez_NW  += +HALF*((Bx_N + HALF*dBxdy_N)*(-dmoments_NW.at(fsgrids::dmoments::dVydx) + dmoments_NW.at(fsgrids::dmoments::dVydy)) + dBxdy_N*Vy0 + SIXTH*dBxdz_N*dmoments_NW.at(fsgrids::dmoments::dVydz));
+      Ez_NW  += -HALF*((By_W - HALF*dBydx_W)*(-dmoments_NW.at(fsgrids::dmoments::dVxdx) + dmoments_NW.at(fsgrids::dmoments::dVxdy)) - dBydx_W*Vx0 + SIXTH*dBydz_W*dmoments_NW.at(fsgrids::dmoments::dVxdz));
    #endif
    
    calculateWaveSpeedXY(
@@ -1412,8 +1412,8 @@ void calculateEdgeElectricFieldZ(
    maxV = max(maxV, calculateCflSpeed(Vx0, Vy0, vA, vS, vW));
    
    // Ez and characteristic speeds on NE (i-1,j-1) cell:
-   Vx0  = moments_NE->at(fsgrids::moments::VX);
-   Vy0  = moments_NE->at(fsgrids::moments::VY);
+   Vx0  = moments_NE.at(fsgrids::moments::VX);
+   Vy0  = moments_NE.at(fsgrids::moments::VY);
    
    // 1st order terms:
    Real Ez_NE = Bx_N*Vy0 - By_E*Vx0;
@@ -1421,32 +1421,32 @@ void calculateEdgeElectricFieldZ(
    // Resistive term
    if (Parameters::resistivity > 0) {
       Ez_NE += Parameters::resistivity *
-        sqrt((bgb_NE->at(fsgrids::bgbfield::BGBX)+perb_NE->at(fsgrids::bfield::PERBX))*
-             (bgb_NE->at(fsgrids::bgbfield::BGBX)+perb_NE->at(fsgrids::bfield::PERBX)) +
-             (bgb_NE->at(fsgrids::bgbfield::BGBY)+perb_NE->at(fsgrids::bfield::PERBY))*
-             (bgb_NE->at(fsgrids::bgbfield::BGBY)+perb_NE->at(fsgrids::bfield::PERBY)) +
-             (bgb_NE->at(fsgrids::bgbfield::BGBZ)+perb_NE->at(fsgrids::bfield::PERBZ))*
-             (bgb_NE->at(fsgrids::bgbfield::BGBZ)+perb_NE->at(fsgrids::bfield::PERBZ))
+        sqrt((bgb_NE.at(fsgrids::bgbfield::BGBX)+perb_NE.at(fsgrids::bfield::PERBX))*
+             (bgb_NE.at(fsgrids::bgbfield::BGBX)+perb_NE.at(fsgrids::bfield::PERBX)) +
+             (bgb_NE.at(fsgrids::bgbfield::BGBY)+perb_NE.at(fsgrids::bfield::PERBY))*
+             (bgb_NE.at(fsgrids::bgbfield::BGBY)+perb_NE.at(fsgrids::bfield::PERBY)) +
+             (bgb_NE.at(fsgrids::bgbfield::BGBZ)+perb_NE.at(fsgrids::bfield::PERBZ))*
+             (bgb_NE.at(fsgrids::bgbfield::BGBZ)+perb_NE.at(fsgrids::bfield::PERBZ))
             ) /
-        moments_NE->at(fsgrids::moments::RHOQ) /
+        moments_NE.at(fsgrids::moments::RHOQ) /
         physicalconstants::MU_0 *
-        (dperb_NE->at(fsgrids::dperb::dPERBydx)/technicalGrid.DX - dperb_NE->at(fsgrids::dperb::dPERBxdy)/technicalGrid.DY);
+        (dperb_NE.at(fsgrids::dperb::dPERBydx)/technicalGrid.DX - dperb_NE.at(fsgrids::dperb::dPERBxdy)/technicalGrid.DY);
    }
    
    // Hall term
    if(Parameters::ohmHallTerm > 0) {
-      Ez_NE += EHallGrid.get(i-1,j-1,k)->at(fsgrids::ehall::EZHALL_110_111);
+      Ez_NE += fsCell(EHallGrid,i-1,j-1,k).at(fsgrids::ehall::EZHALL_110_111);
    }
    
    // Electron pressure gradient term
    if(Parameters::ohmGradPeTerm > 0) {
-      Ez_NE += EGradPeGrid.get(i-1,j-1,k)->at(fsgrids::egradpe::EZGRADPE);
+      Ez_NE += fsCell(EGradPeGrid,i-1,j-1,k).at(fsgrids::egradpe::EZGRADPE);
    }
    
    #ifndef FS_1ST_ORDER_SPACE
       // 2nd order terms:
-      Ez_NE  += +HALF*((Bx_N + HALF*dBxdy_N)*(+dmoments_NE->at(fsgrids::dmoments::dVydx) + dmoments_NE->at(fsgrids::dmoments::dVydy)) + dBxdy_N*Vy0 + SIXTH*dBxdz_N*dmoments_NE->at(fsgrids::dmoments::dVydz));
-      Ez_NE  += -HALF*((By_E + HALF*dBydx_E)*(+dmoments_NE->at(fsgrids::dmoments::dVxdx) + dmoments_NE->at(fsgrids::dmoments::dVxdy)) + dBydx_E*Vx0 + SIXTH*dBydz_E*dmoments_NE->at(fsgrids::dmoments::dVxdz));
+      Ez_NE  += +HALF*((Bx_N + HALF*dBxdy_N)*(+dmoments_NE.at(fsgrids::dmoments::dVydx) + dmoments_NE.at(fsgrids::dmoments::dVydy)) + dBxdy_N*Vy0 + SIXTH*dBxdz_N*dmoments_NE.at(fsgrids::dmoments::dVydz));
+      Ez_NE  += -HALF*((By_E + HALF*dBydx_E)*(+dmoments_NE.at(fsgrids::dmoments::dVxdx) + dmoments_NE.at(fsgrids::dmoments::dVxdy)) + dBydx_E*Vx0 + SIXTH*dBydz_E*dmoments_NE.at(fsgrids::dmoments::dVxdz));
    #endif
    
    calculateWaveSpeedXY(
@@ -1468,16 +1468,16 @@ void calculateEdgeElectricFieldZ(
    maxV = max(maxV, calculateCflSpeed(Vx0, Vy0, vA, vS, vW));
 
    // Calculate properly upwinded edge-averaged Ez:
-   efield_SW->at(fsgrids::efield::EZ) = ax_pos*ay_pos*Ez_NE + ax_pos*ay_neg*Ez_SE + ax_neg*ay_pos*Ez_NW + ax_neg*ay_neg*Ez_SW;
-   efield_SW->at(fsgrids::efield::EZ) /= ((ax_pos+ax_neg)*(ay_pos+ay_neg)+EPS);
+   efield_SW.at(fsgrids::efield::EZ) = ax_pos*ay_pos*Ez_NE + ax_pos*ay_neg*Ez_SE + ax_neg*ay_pos*Ez_NW + ax_neg*ay_neg*Ez_SW;
+   efield_SW.at(fsgrids::efield::EZ) /= ((ax_pos+ax_neg)*(ay_pos+ay_neg)+EPS);
 
    if (Parameters::fieldSolverDiffusiveEterms) {
 #ifdef FS_1ST_ORDER_SPACE
-      efield_SW->at(fsgrids::efield::EZ) -= ay_pos*ay_neg/(ay_pos+ay_neg+EPS)*(perBx_S-perBx_N);
-      efield_SW->at(fsgrids::efield::EZ) += ax_pos*ax_neg/(ax_pos+ax_neg+EPS)*(perBy_W-perBy_E);
+      efield_SW.at(fsgrids::efield::EZ) -= ay_pos*ay_neg/(ay_pos+ay_neg+EPS)*(perBx_S-perBx_N);
+      efield_SW.at(fsgrids::efield::EZ) += ax_pos*ax_neg/(ax_pos+ax_neg+EPS)*(perBy_W-perBy_E);
 #else
-      efield_SW->at(fsgrids::efield::EZ) -= ay_pos*ay_neg/(ay_pos+ay_neg+EPS)*((perBx_S-HALF*dperBxdy_S) - (perBx_N+HALF*dperBxdy_N));
-      efield_SW->at(fsgrids::efield::EZ) += ax_pos*ax_neg/(ax_pos+ax_neg+EPS)*((perBy_W-HALF*dperBydx_W) - (perBy_E+HALF*dperBydx_E));
+      efield_SW.at(fsgrids::efield::EZ) -= ay_pos*ay_neg/(ay_pos+ay_neg+EPS)*((perBx_S-HALF*dperBxdy_S) - (perBx_N+HALF*dperBxdy_N));
+      efield_SW.at(fsgrids::efield::EZ) += ax_pos*ax_neg/(ax_pos+ax_neg+EPS)*((perBy_W-HALF*dperBydx_W) - (perBy_E+HALF*dperBydx_E));
 #endif
    }
    
@@ -1493,7 +1493,8 @@ void calculateEdgeElectricFieldZ(
 
 /*! \brief Electric field propagation function.
  * 
- * Calls the general or the system boundary electric field propagation functions.
+ * Calls the general electric field propagation functions for all three edge components of a cell.
+ * The caller decides whether the cell is computed or handled by the system boundary conditions.
  * 
  * \param perBGrid fsGrid holding the perturbed B quantities
  * \param EGrid fsGrid holding the electric field
@@ -1505,13 +1506,12 @@ void calculateEdgeElectricFieldZ(
  * \param BgBGrid fsGrid holding the background B quantities
  * \param technicalGrid fsGrid holding technical information (such as boundary types)
  * \param i,j,k fsGrid cell coordinates for the current cell
- * \param sysBoundaries System boundary conditions existing
  * \param RKCase Element in the enum defining the Runge-Kutta method steps
  * 
  * \sa calculateUpwindedElectricFieldSimple calculateEdgeElectricFieldX calculateEdgeElectricFieldY calculateEdgeElectricFieldZ
  * 
  */
-void calculateElectricField(
+static inline void calculateElectricField(
    FsGrid< std::array<Real, fsgrids::bfield::N_BFIELD>, 2> & perBGrid,
    FsGrid< std::array<Real, fsgrids::efield::N_EFIELD>, 2> & EGrid,
    FsGrid< std::array<Real, fsgrids::ehall::N_EHALL>, 2> & EHallGrid,
@@ -1524,66 +1524,11 @@ void calculateElectricField(
    cint i,
    cint j,
    cint k,
-   SysBoundary& sysBoundaries,
    cint& RKCase
 ) {
-   cuint cellSysBoundaryFlag = technicalGrid.get(i,j,k)->sysBoundaryFlag;
-   
-   if (cellSysBoundaryFlag == sysboundarytype::DO_NOT_COMPUTE) return;
-   
-   cuint cellSysBoundaryLayer = technicalGrid.get(i,j,k)->sysBoundaryLayer;
-   
-   if ((cellSysBoundaryFlag != sysboundarytype::NOT_SYSBOUNDARY) && (cellSysBoundaryLayer != 1)) {
-      sysBoundaries.getSysBoundary(cellSysBoundaryFlag)->fieldSolverBoundaryCondElectricField(EGrid, i, j, k, 0);
-      sysBoundaries.getSysBoundary(cellSysBoundaryFlag)->fieldSolverBoundaryCondElectricField(EGrid, i, j, k, 1);
-      sysBoundaries.getSysBoundary(cellSysBoundaryFlag)->fieldSolverBoundaryCondElectricField(EGrid, i, j, k, 2);
-   } else {
-      calculateEdgeElectricFieldX(
-         perBGrid,
-         EGrid,
-         EHallGrid,
-         EGradPeGrid,
-         momentsGrid,
-         dPerBGrid,
-         dMomentsGrid,
-         BgBGrid,
-         technicalGrid,
-         i,
-         j,
-         k,
-         RKCase
-      );
-      calculateEdgeElectricFieldY(
-         perBGrid,
-         EGrid,
-         EHallGrid,
-         EGradPeGrid,
-         momentsGrid,
-         dPerBGrid,
-         dMomentsGrid,
-         BgBGrid,
-         technicalGrid,
-         i,
-         j,
-         k,
-         RKCase
-      );
-      calculateEdgeElectricFieldZ(
-         perBGrid,
-         EGrid,
-         EHallGrid,
-         EGradPeGrid,
-         momentsGrid,
-         dPerBGrid,
-         dMomentsGrid,
-         BgBGrid,
-         technicalGrid,
-         i,
-         j,
-         k,
-         RKCase
-      );
-   }
+   calculateEdgeElectricFieldX(perBGrid, EGrid, EHallGrid, EGradPeGrid, momentsGrid, dPerBGrid, dMomentsGrid, BgBGrid, technicalGrid, i, j, k, RKCase);
+   calculateEdgeElectricFieldY(perBGrid, EGrid, EHallGrid, EGradPeGrid, momentsGrid, dPerBGrid, dMomentsGrid, BgBGrid, technicalGrid, i, j, k, RKCase);
+   calculateEdgeElectricFieldZ(perBGrid, EGrid, EHallGrid, EGradPeGrid, momentsGrid, dPerBGrid, dMomentsGrid, BgBGrid, technicalGrid, i, j, k, RKCase);
 }
 
 /*! \brief High-level electric field computation function.
@@ -1631,6 +1576,7 @@ void calculateUpwindedElectricFieldSimple(
    
    timer=phiprof::initializeTimer("MPI","MPI");
    phiprof::start(timer);
+   telemetry::start(telemetry::MPI_WAIT);
    if(P::ohmHallTerm > 0) {
       EHallGrid.updateGhostCells();
    }
@@ -1641,49 +1587,41 @@ void calculateUpwindedElectricFieldSimple(
       dPerBGrid.updateGhostCells();
       dMomentsGrid.updateGhostCells();
    }
+   telemetry::stop(telemetry::MPI_WAIT);
    phiprof::stop(timer);
    
-   // Calculate upwinded electric field on inner cells
+   // Fields of the current Runge-Kutta stage
+   const bool fullStep = (RKCase == RK_ORDER1 || RKCase == RK_ORDER2_STEP2);
+   FsGrid< std::array<Real, fsgrids::bfield::N_BFIELD>, 2> & curPerBGrid = fullStep ? perBGrid : perBDt2Grid;
+   FsGrid< std::array<Real, fsgrids::efield::N_EFIELD>, 2> & curEGrid = fullStep ? EGrid : EDt2Grid;
+   FsGrid< std::array<Real, fsgrids::moments::N_MOMENTS>, 2> & curMomentsGrid = fullStep ? momentsGrid : momentsDt2Grid;
+   const FsCellLists& cellLists = getFsCellLists(technicalGrid, sysBoundaries);
+   const vector<FsCellRun>& interiorRuns = cellLists.interiorRuns;
+   const vector<FsBoundaryCell>& boundaryCells = cellLists.boundaryCells;
+   
+   // Calculate upwinded electric field on interior cells, then on the system boundary cells
+   // (first layer is computed, the others get the boundary condition)
    timer=phiprof::initializeTimer("Compute cells");
    phiprof::start(timer);
-   #pragma omp parallel for collapse(3)
-   for (int k=0; k<gridDims[2]; k++) {
-      for (int j=0; j<gridDims[1]; j++) {
-         for (int i=0; i<gridDims[0]; i++) {
-            if (RKCase == RK_ORDER1 || RKCase == RK_ORDER2_STEP2) {
-               calculateElectricField(
-                  perBGrid,
-                  EGrid,
-                  EHallGrid,
-                  EGradPeGrid,
-                  momentsGrid,
-                  dPerBGrid,
-                  dMomentsGrid,
-                  BgBGrid,
-                  technicalGrid,
-                  i,
-                  j,
-                  k,
-                  sysBoundaries,
-                  RKCase
-               );
-            } else { // RKCase == RK_ORDER2_STEP1
-               calculateElectricField(
-                  perBDt2Grid,
-                  EDt2Grid,
-                  EHallGrid,
-                  EGradPeGrid,
-                  momentsDt2Grid,
-                  dPerBGrid,
-                  dMomentsGrid,
-                  BgBGrid,
-                  technicalGrid,
-                  i,
-                  j,
-                  k,
-                  sysBoundaries,
-                  RKCase
-               );
+   #pragma omp parallel
+   {
+      #pragma omp for schedule(dynamic,4) nowait
+      for (size_t r=0; r<interiorRuns.size(); r++) {
+         const FsCellRun& run = interiorRuns[r];
+         for (int i=run.iBegin; i<run.iEnd; i++) {
+            calculateElectricField(curPerBGrid, curEGrid, EHallGrid, EGradPeGrid, curMomentsGrid, dPerBGrid, dMomentsGrid,
+                                   BgBGrid, technicalGrid, i, run.j, run.k, RKCase);
+         }
+      }
+      #pragma omp for schedule(dynamic,16)
+      for (size_t c=0; c<boundaryCells.size(); c++) {
+         const FsBoundaryCell& cell = boundaryCells[c];
+         if (cell.sysBoundaryLayer == 1) {
+            calculateElectricField(curPerBGrid, curEGrid, EHallGrid, EGradPeGrid, curMomentsGrid, dPerBGrid, dMomentsGrid,
+                                   BgBGrid, technicalGrid, cell.i, cell.j, cell.k, RKCase);
+         } else {
+            for (int component=0; component<3; component++) {
+               cell.sysBoundary->fieldSolverBoundaryCondElectricField(curEGrid, cell.i, cell.j, cell.k, component);
             }
          }
       }
@@ -1692,12 +1630,14 @@ void calculateUpwindedElectricFieldSimple(
    
    timer=phiprof::initializeTimer("MPI","MPI");
    phiprof::start(timer);
+   telemetry::start(telemetry::MPI_WAIT);
    // Exchange electric field with neighbouring processes
    if (RKCase == RK_ORDER1 || RKCase == RK_ORDER2_STEP2) {
       EGrid.updateGhostCells();
    } else { 
       EDt2Grid.updateGhostCells();
    }
+   telemetry::stop(telemetry::MPI_WAIT);
    phiprof::stop(timer);
    
    phiprof::stop("Calculate upwinded electric field",N_cells,"Spatial Cells");
@@ -45,9 +45,9 @@ void calculateEdgeGradPeTermXComponents(
          break;
          
       case 1:
-         rhoq = momentsGrid.get(i,j,k)->at(fsgrids::moments::RHOQ);
+         rhoq = fsCell(momentsGrid,i,j,k).at(fsgrids::moments::RHOQ);
          hallRhoq = (rhoq <= Parameters::hallMinimumRhoq ) ? Parameters::hallMinimumRhoq : rhoq ;
-         EGradPeGrid.get(i,j,k)->at(fsgrids::egradpe::EXGRADPE) = -physicalconstants::K_B*Parameters::electronTemperature*dMomentsGrid.get(i,j,k)->at(fsgrids::dmoments::drhoqdx) / (hallRhoq*EGradPeGrid.DX);
+         fsCell(EGradPeGrid,i,j,k).at(fsgrids::egradpe::EXGRADPE) = -physicalconstants::K_B*Parameters::electronTemperature*fsCell(dMomentsGrid,i,j,k).at(fsgrids::dmoments::drhoqdx) / (hallRhoq*EGradPeGrid.DX);
          break;
          
       default:
@@ -72,9 +72,9 @@ void calculateEdgeGradPeTermYComponents(
          break;
          
       case 1:
-         rhoq = momentsGrid.get(i,j,k)->at(fsgrids::moments::RHOQ);
+         rhoq = fsCell(momentsGrid,i,j,k).at(fsgrids::moments::RHOQ);
          hallRhoq = (rhoq <= Parameters::hallMinimumRhoq ) ? Parameters::hallMinimumRhoq : rhoq ;
-         EGradPeGrid.get(i,j,k)->at(fsgrids::egradpe::EYGRADPE) = -physicalconstants::K_B*Parameters::electronTemperature*dMomentsGrid.get(i,j,k)->at(fsgrids::dmoments::drhoqdy) / (hallRhoq*EGradPeGrid.DY);
+         fsCell(EGradPeGrid,i,j,k).at(fsgrids::egradpe::EYGRADPE) = -physicalconstants::K_B*Parameters::electronTemperature*fsCell(dMomentsGrid,i,j,k).at(fsgrids::dmoments::drhoqdy) / (hallRhoq*EGradPeGrid.DY);
          break;
          
       default:
@@ -99,9 +99,9 @@ void calculateEdgeGradPeTermZComponents(
          break;
          
       case 1:
-         rhoq = momentsGrid.get(i,j,k)->at(fsgrids::moments::RHOQ);
+         rhoq = fsCell(momentsGrid,i,j,k).at(fsgrids::moments::RHOQ);
          hallRhoq = (rhoq <= Parameters::hallMinimumRhoq ) ? Parameters::hallMinimumRhoq : rhoq ;
-         EGradPeGrid.get(i,j,k)->at(fsgrids::egradpe::EZGRADPE) = -physicalconstants::K_B*Parameters::electronTemperature*dMomentsGrid.get(i,j,k)->at(fsgrids::dmoments::drhoqdz) / (hallRhoq*EGradPeGrid.DZ);
+         fsCell(EGradPeGrid,i,j,k).at(fsgrids::egradpe::EZGRADPE) = -physicalconstants::K_B*Parameters::electronTemperature*fsCell(dMomentsGrid,i,j,k).at(fsgrids::dmoments::drhoqdz) / (hallRhoq*EGradPeGrid.DZ);
          break;
          
       default:
@@ -164,7 +164,9 @@ void calculateGradPeTermSimple(
 
    timer=phiprof::initializeTimer("MPI","MPI");
    phiprof::start(timer);
+   telemetry::start(telemetry::MPI_WAIT);
    dMomentsGrid.updateGhostCells();
+   telemetry::stop(telemetry::MPI_WAIT);
    phiprof::stop(timer);
 
    // Calculate GradPe term
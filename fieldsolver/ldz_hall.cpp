@@ -456,55 +456,55 @@ void calculateEdgeHallTermXComponents(
       break;
       
     case 1:
-      By = perBGrid.get(i,j,k)->at(fsgrids::bfield::PERBY)+BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBY);
-      Bz = perBGrid.get(i,j,k)->at(fsgrids::bfield::PERBZ)+BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBZ);
+      By = fsCell(perBGrid,i,j,k).at(fsgrids::bfield::PERBY)+fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBY);
+      Bz = fsCell(perBGrid,i,j,k).at(fsgrids::bfield::PERBZ)+fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBZ);
       
-      hallRhoq =  (momentsGrid.get(i,j,k)->at(fsgrids::moments::RHOQ) <= Parameters::hallMinimumRhoq ) ? Parameters::hallMinimumRhoq : momentsGrid.get(i,j,k)->at(fsgrids::moments::RHOQ) ;
-      EXHall = (Bz*((BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::dBGBxdz)+dPerBGrid.get(i,j,k)->at(fsgrids::dperb::dPERBxdz))/technicalGrid.DZ -
-                     (BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::dBGBzdx)+dPerBGrid.get(i,j,k)->at(fsgrids::dperb::dPERBzdx))/technicalGrid.DX) -
-                  By*((BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::dBGBydx)+dPerBGrid.get(i,j,k)->at(fsgrids::dperb::dPERBydx))/technicalGrid.DX-
-                     ((BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::dBGBxdy)+dPerBGrid.get(i,j,k)->at(fsgrids::dperb::dPERBxdy))/technicalGrid.DY)));
+      hallRhoq =  (fsCell(momentsGrid,i,j,k).at(fsgrids::moments::RHOQ) <= Parameters::hallMinimumRhoq ) ? Parameters::hallMinimumRhoq : fsCell(momentsGrid,i,j,k).at(fsgrids::moments::RHOQ) ;
+      EXHall = (Bz*((fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::dBGBxdz)+fsCell(dPerBGrid,i,j,k).at(fsgrids::dperb::dPERBxdz))/technicalGrid.DZ -
+                     (fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::dBGBzdx)+fsCell(dPerBGrid,i,j,k).at(fsgrids::dperb::dPERBzdx))/technicalGrid.DX) -
+                  By*((fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::dBGBydx)+fsCell(dPerBGrid,i,j,k).at(fsgrids::dperb::dPERBydx))/technicalGrid.DX-
+                     ((fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::dBGBxdy)+fsCell(dPerBGrid,i,j,k).at(fsgrids::dperb::dPERBxdy))/technicalGrid.DY)));
       EXHall /= physicalconstants::MU_0 * hallRhoq;
       
-      EHallGrid.get(i,j,k)->at(fsgrids::ehall::EXHALL_000_100) =
-      EHallGrid.get(i,j,k)->at(fsgrids::ehall::EXHALL_010_110) =
-      EHallGrid.get(i,j,k)->at(fsgrids::ehall::EXHALL_001_101) =
-      EHallGrid.get(i,j,k)->at(fsgrids::ehall::EXHALL_011_111) = EXHall;
+      fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EXHALL_000_100) =
+      fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EXHALL_010_110) =
+      fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EXHALL_001_101) =
+      fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EXHALL_011_111) = EXHall;
 
       break;
     case 2:
       hallRhoq = FOURTH * (
-         momentsGrid.get(i  ,j  ,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i  ,j-1,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i  ,j  ,k-1)->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i  ,j-1,k-1)->at(fsgrids::moments::RHOQ)
+         fsCell(momentsGrid,i  ,j  ,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i  ,j-1,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i  ,j  ,k-1).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i  ,j-1,k-1).at(fsgrids::moments::RHOQ)
       );
       hallRhoq =  (hallRhoq <= Parameters::hallMinimumRhoq ) ? Parameters::hallMinimumRhoq : hallRhoq ;
-      EHallGrid.get(i,j,k)->at(fsgrids::ehall::EXHALL_000_100) = JXBX_000_100(perturbedCoefficients, BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBY), BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBZ), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
+      fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EXHALL_000_100) = JXBX_000_100(perturbedCoefficients, fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBY), fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBZ), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
       hallRhoq = FOURTH * (
-         momentsGrid.get(i  ,j  ,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i  ,j+1,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i  ,j  ,k-1)->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i  ,j+1,k-1)->at(fsgrids::moments::RHOQ)
+         fsCell(momentsGrid,i  ,j  ,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i  ,j+1,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i  ,j  ,k-1).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i  ,j+1,k-1).at(fsgrids::moments::RHOQ)
       );
       hallRhoq =  (hallRhoq <= Parameters::hallMinimumRhoq ) ? Parameters::hallMinimumRhoq : hallRhoq ;
-      EHallGrid.get(i,j,k)->at(fsgrids::ehall::EXHALL_010_110) = JXBX_010_110(perturbedCoefficients, BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBY), BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBZ), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
+      fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EXHALL_010_110) = JXBX_010_110(perturbedCoefficients, fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBY), fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBZ), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
       hallRhoq = FOURTH * (
-         momentsGrid.get(i  ,j  ,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i  ,j-1,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i  ,j  ,k+1)->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i  ,j-1,k+1)->at(fsgrids::moments::RHOQ)
+         fsCell(momentsGrid,i  ,j  ,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i  ,j-1,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i  ,j  ,k+1).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i  ,j-1,k+1).at(fsgrids::moments::RHOQ)
       );
       hallRhoq =  (hallRhoq <= Parameters::hallMinimumRhoq ) ? Parameters::hallMinimumRhoq : hallRhoq ;
-      EHallGrid.get(i,j,k)->at(fsgrids::ehall::EXHALL_001_101) = JXBX_001_101(perturbedCoefficients, BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBY), BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBZ), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
+      fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EXHALL_001_101) = JXBX_001_101(perturbedCoefficients, fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBY), fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBZ), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
       hallRhoq = FOURTH * (
-         momentsGrid.get(i  ,j  ,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i  ,j+1,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i  ,j  ,k+1)->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i  ,j+1,k+1)->at(fsgrids::moments::RHOQ)
+         fsCell(momentsGrid,i  ,j  ,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i  ,j+1,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i  ,j  ,k+1).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i  ,j+1,k+1).at(fsgrids::moments::RHOQ)
       );
       hallRhoq =  (hallRhoq <= Parameters::hallMinimumRhoq ) ? Parameters::hallMinimumRhoq : hallRhoq ;
-      EHallGrid.get(i,j,k)->at(fsgrids::ehall::EXHALL_011_111) = JXBX_011_111(perturbedCoefficients, BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBY), BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBZ), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
+      fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EXHALL_011_111) = JXBX_011_111(perturbedCoefficients, fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBY), fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBZ), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
       break;
       
     default:
@@ -554,55 +554,55 @@ void calculateEdgeHallTermYComponents(
       break;
       
     case 1:
-      Bx = perBGrid.get(i,j,k)->at(fsgrids::bfield::PERBX)+BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBX);
-      Bz = perBGrid.get(i,j,k)->at(fsgrids::bfield::PERBZ)+BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBZ);
+      Bx = fsCell(perBGrid,i,j,k).at(fsgrids::bfield::PERBX)+fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBX);
+      Bz = fsCell(perBGrid,i,j,k).at(fsgrids::bfield::PERBZ)+fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBZ);
       
-      hallRhoq =  (momentsGrid.get(i,j,k)->at(fsgrids::moments::RHOQ) <= Parameters::hallMinimumRhoq ) ? Parameters::hallMinimumRhoq : momentsGrid.get(i,j,k)->at(fsgrids::moments::RHOQ) ;
-      EYHall = (Bx*((BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::dBGBydx)+dPerBGrid.get(i,j,k)->at(fsgrids::dperb::dPERBydx))/technicalGrid.DX -
-                    (BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::dBGBxdy)+dPerBGrid.get(i,j,k)->at(fsgrids::dperb::dPERBxdy))/technicalGrid.DY) -
-                Bz*((BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::dBGBzdy)+dPerBGrid.get(i,j,k)->at(fsgrids::dperb::dPERBzdy))/technicalGrid.DY -
-                    ((BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::dBGBydz)+dPerBGrid.get(i,j,k)->at(fsgrids::dperb::dPERBydz))/technicalGrid.DZ )));
+      hallRhoq =  (fsCell(momentsGrid,i,j,k).at(fsgrids::moments::RHOQ) <= Parameters::hallMinimumRhoq ) ? Parameters::hallMinimumRhoq : fsCell(momentsGrid,i,j,k).at(fsgrids::moments::RHOQ) ;
+      EYHall = (Bx*((fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::dBGBydx)+fsCell(dPerBGrid,i,j,k).at(fsgrids::dperb::dPERBydx))/technicalGrid.DX -
+                    (fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::dBGBxdy)+fsCell(dPerBGrid,i,j,k).at(fsgrids::dperb::dPERBxdy))/technicalGrid.DY) -
+                Bz*((fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::dBGBzdy)+fsCell(dPerBGrid,i,j,k).at(fsgrids::dperb::dPERBzdy))/technicalGrid.DY -
+                    ((fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::dBGBydz)+fsCell(dPerBGrid,i,j,k).at(fsgrids::dperb::dPERBydz))/technicalGrid.DZ )));
       EYHall /= physicalconstants::MU_0 * hallRhoq;
       
-      EHallGrid.get(i,j,k)->at(fsgrids::ehall::EYHALL_000_010) =
-      EHallGrid.get(i,j,k)->at(fsgrids::ehall::EYHALL_100_110) =
-      EHallGrid.get(i,j,k)->at(fsgrids::ehall::EYHALL_101_111) =
-      EHallGrid.get(i,j,k)->at(fsgrids::ehall::EYHALL_001_011) = EYHall;
+      fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EYHALL_000_010) =
+      fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EYHALL_100_110) =
+      fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EYHALL_101_111) =
+      fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EYHALL_001_011) = EYHall;
       break;
       
     case 2:
       hallRhoq = FOURTH * (
-         momentsGrid.get(i  ,j  ,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i-1,j  ,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i  ,j  ,k-1)->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i-1,j  ,k-1)->at(fsgrids::moments::RHOQ)
+         fsCell(momentsGrid,i  ,j  ,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i-1,j  ,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i  ,j  ,k-1).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i-1,j  ,k-1).at(fsgrids::moments::RHOQ)
       );
       hallRhoq =  (hallRhoq <= Parameters::hallMinimumRhoq ) ? Parameters::hallMinimumRhoq : hallRhoq ;
-      EHallGrid.get(i,j,k)->at(fsgrids::ehall::EYHALL_000_010) = JXBY_000_010(perturbedCoefficients, BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBX), BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBZ), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
+      fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EYHALL_000_010) = JXBY_000_010(perturbedCoefficients, fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBX), fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBZ), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
       hallRhoq = FOURTH * (
-         momentsGrid.get(i  ,j  ,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i+1,j  ,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i  ,j  ,k-1)->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i+1,j  ,k-1)->at(fsgrids::moments::RHOQ)
+         fsCell(momentsGrid,i  ,j  ,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i+1,j  ,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i  ,j  ,k-1).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i+1,j  ,k-1).at(fsgrids::moments::RHOQ)
       );
       hallRhoq =  (hallRhoq <= Parameters::hallMinimumRhoq ) ? Parameters::hallMinimumRhoq : hallRhoq ;
-      EHallGrid.get(i,j,k)->at(fsgrids::ehall::EYHALL_100_110) = JXBY_100_110(perturbedCoefficients, BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBX), BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBZ), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
+      fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EYHALL_100_110) = JXBY_100_110(perturbedCoefficients, fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBX), fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBZ), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
       hallRhoq = FOURTH * (
-         momentsGrid.get(i  ,j  ,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i-1,j  ,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i  ,j  ,k+1)->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i-1,j  ,k+1)->at(fsgrids::moments::RHOQ)
+         fsCell(momentsGrid,i  ,j  ,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i-1,j  ,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i  ,j  ,k+1).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i-1,j  ,k+1).at(fsgrids::moments::RHOQ)
       );
       hallRhoq =  (hallRhoq <= Parameters::hallMinimumRhoq ) ? Parameters::hallMinimumRhoq : hallRhoq ;
-      EHallGrid.get(i,j,k)->at(fsgrids::ehall::EYHALL_001_011) = JXBY_001_011(perturbedCoefficients, BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBX), BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBZ), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
+      fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EYHALL_001_011) = JXBY_001_011(perturbedCoefficients, fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBX), fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBZ), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
       hallRhoq = FOURTH * (
-         momentsGrid.get(i  ,j  ,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i+1,j  ,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i  ,j  ,k+1)->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i+1,j  ,k+1)->at(fsgrids::moments::RHOQ)
+         fsCell(momentsGrid,i  ,j  ,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i+1,j  ,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i  ,j  ,k+1).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i+1,j  ,k+1).at(fsgrids::moments::RHOQ)
       );
       hallRhoq =  (hallRhoq <= Parameters::hallMinimumRhoq ) ? Parameters::hallMinimumRhoq : hallRhoq ;
-      EHallGrid.get(i,j,k)->at(fsgrids::ehall::EYHALL_101_111) = JXBY_101_111(perturbedCoefficients, BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBX), BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBZ), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
+      fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EYHALL_101_111) = JXBY_101_111(perturbedCoefficients, fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBX), fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBZ), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
       break;
       
     default:
@@ -652,55 +652,55 @@ void calculateEdgeHallTermZComponents(
      break;
 
    case 1:
-     Bx = perBGrid.get(i,j,k)->at(fsgrids::bfield::PERBX)+BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBX);
-     By = perBGrid.get(i,j,k)->at(fsgrids::bfield::PERBY)+BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBY);
+     Bx = fsCell(perBGrid,i,j,k).at(fsgrids::bfield::PERBX)+fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBX);
+     By = fsCell(perBGrid,i,j,k).at(fsgrids::bfield::PERBY)+fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBY);
      
-     hallRhoq =  (momentsGrid.get(i,j,k)->at(fsgrids::moments::RHOQ) <= Parameters::hallMinimumRhoq ) ? Parameters::hallMinimumRhoq : momentsGrid.get(i,j,k)->at(fsgrids::moments::RHOQ) ;
-     EZHall = (By*((BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::dBGBzdy)+dPerBGrid.get(i,j,k)->at(fsgrids::dperb::dPERBzdy))/technicalGrid.DY -
-              (BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::dBGBydz)+dPerBGrid.get(i,j,k)->at(fsgrids::dperb::dPERBydz))/technicalGrid.DZ) -
-           Bx*((BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::dBGBxdz)+dPerBGrid.get(i,j,k)->at(fsgrids::dperb::dPERBxdz))/technicalGrid.DZ -
-              ((BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::dBGBzdx)+dPerBGrid.get(i,j,k)->at(fsgrids::dperb::dPERBzdx))/technicalGrid.DX)));
+     hallRhoq =  (fsCell(momentsGrid,i,j,k).at(fsgrids::moments::RHOQ) <= Parameters::hallMinimumRhoq ) ? Parameters::hallMinimumRhoq : fsCell(momentsGrid,i,j,k).at(fsgrids::moments::RHOQ) ;
+     EZHall = (By*((fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::dBGBzdy)+fsCell(dPerBGrid,i,j,k).at(fsgrids::dperb::dPERBzdy))/technicalGrid.DY -
+              (fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::dBGBydz)+fsCell(dPerBGrid,i,j,k).at(fsgrids::dperb::dPERBydz))/technicalGrid.DZ) -
+           Bx*((fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::dBGBxdz)+fsCell(dPerBGrid,i,j,k).at(fsgrids::dperb::dPERBxdz))/technicalGrid.DZ -
+              ((fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::dBGBzdx)+fsCell(dPerBGrid,i,j,k).at(fsgrids::dperb::dPERBzdx))/technicalGrid.DX)));
      EZHall /= physicalconstants::MU_0 * hallRhoq;
 
-     EHallGrid.get(i,j,k)->at(fsgrids::ehall::EZHALL_000_001) =
-     EHallGrid.get(i,j,k)->at(fsgrids::ehall::EZHALL_100_101) =
-     EHallGrid.get(i,j,k)->at(fsgrids::ehall::EZHALL_110_111) =
-     EHallGrid.get(i,j,k)->at(fsgrids::ehall::EZHALL_010_011) = EZHall;
+     fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EZHALL_000_001) =
+     fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EZHALL_100_101) =
+     fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EZHALL_110_111) =
+     fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EZHALL_010_011) = EZHall;
      break;
 
    case 2:
       hallRhoq = FOURTH * (
-         momentsGrid.get(i  ,j  ,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i-1,j  ,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i  ,j-1,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i-1,j-1,k  )->at(fsgrids::moments::RHOQ)
+         fsCell(momentsGrid,i  ,j  ,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i-1,j  ,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i  ,j-1,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i-1,j-1,k  ).at(fsgrids::moments::RHOQ)
       );
       hallRhoq =  (hallRhoq <= Parameters::hallMinimumRhoq ) ? Parameters::hallMinimumRhoq : hallRhoq ;
-      EHallGrid.get(i,j,k)->at(fsgrids::ehall::EZHALL_000_001) = JXBZ_000_001(perturbedCoefficients, BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBX), BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBY), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
+      fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EZHALL_000_001) = JXBZ_000_001(perturbedCoefficients, fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBX), fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBY), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
       hallRhoq = FOURTH * (
-         momentsGrid.get(i  ,j  ,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i+1,j  ,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i  ,j-1,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i+1,j-1,k  )->at(fsgrids::moments::RHOQ)
+         fsCell(momentsGrid,i  ,j  ,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i+1,j  ,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i  ,j-1,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i+1,j-1,k  ).at(fsgrids::moments::RHOQ)
       );
       hallRhoq =  (hallRhoq <= Parameters::hallMinimumRhoq ) ? Parameters::hallMinimumRhoq : hallRhoq ;
-      EHallGrid.get(i,j,k)->at(fsgrids::ehall::EZHALL_100_101) = JXBZ_100_101(perturbedCoefficients, BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBX), BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBY), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
+      fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EZHALL_100_101) = JXBZ_100_101(perturbedCoefficients, fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBX), fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBY), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
       hallRhoq = FOURTH * (
-         momentsGrid.get(i  ,j  ,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i-1,j  ,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i  ,j+1,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i-1,j+1,k  )->at(fsgrids::moments::RHOQ)
+         fsCell(momentsGrid,i  ,j  ,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i-1,j  ,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i  ,j+1,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i-1,j+1,k  ).at(fsgrids::moments::RHOQ)
       );
       hallRhoq =  (hallRhoq <= Parameters::hallMinimumRhoq ) ? Parameters::hallMinimumRhoq : hallRhoq ;
-      EHallGrid.get(i,j,k)->at(fsgrids::ehall::EZHALL_010_011) = JXBZ_010_011(perturbedCoefficients, BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBX), BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBY), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
+      fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EZHALL_010_011) = JXBZ_010_011(perturbedCoefficients, fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBX), fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBY), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
       hallRhoq = FOURTH * (
-         momentsGrid.get(i  ,j  ,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i+1,j  ,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i  ,j+1,k  )->at(fsgrids::moments::RHOQ) +
-         momentsGrid.get(i+1,j+1,k  )->at(fsgrids::moments::RHOQ)
+         fsCell(momentsGrid,i  ,j  ,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i+1,j  ,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i  ,j+1,k  ).at(fsgrids::moments::RHOQ) +
+         fsCell(momentsGrid,i+1,j+1,k  ).at(fsgrids::moments::RHOQ)
       );
       hallRhoq =  (hallRhoq <= Parameters::hallMinimumRhoq ) ? Parameters::hallMinimumRhoq : hallRhoq ;
-      EHallGrid.get(i,j,k)->at(fsgrids::ehall::EZHALL_110_111) = JXBZ_110_111(perturbedCoefficients, BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBX), BgBGrid.get(i,j,k)->at(fsgrids::bgbfield::BGBY), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
+      fsCell(EHallGrid,i,j,k).at(fsgrids::ehall::EZHALL_110_111) = JXBZ_110_111(perturbedCoefficients, fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBX), fsCell(BgBGrid,i,j,k).at(fsgrids::bgbfield::BGBY), technicalGrid.DX, technicalGrid.DY, technicalGrid.DZ) / (physicalconstants::MU_0 * hallRhoq);
       break;
       
     default:
@@ -709,7 +709,10 @@ void calculateEdgeHallTermZComponents(
    }
 }
 
-/** \brief Calculate the numerator of the Hall term on all given cells.
+/** \brief Calculate the numerator of the Hall term in one cell.
+ *
+ * Only called for non-boundary cells and the first system boundary layer, the deeper
+ * boundary cells get their values from the boundary conditions in calculateHallTermSimple.
  *
  * \param perBGrid fsGrid holding the perturbed B quantities 
  * \param EHallGrid fsGrid holding the Hall contributions to the electric field
@@ -718,12 +721,11 @@ void calculateEdgeHallTermZComponents(
  * \param dMomentsGrid fsGrid holding the derviatives of moments
  * \param BgBGrid fsGrid holding the background B quantities
  * \param technicalGrid fsGrid holding technical information (such as boundary types)
- * \param sysBoundaries System boundary condition functions.
  * \param i,j,k fsGrid cell coordinates for the current cell
  * 
  * \sa calculateHallTermSimple calculateEdgeHallTermXComponents calculateEdgeHallTermYComponents calculateEdgeHallTermZComponents
  */
-void calculateHallTerm(
+static inline void calculateHallTerm(
    FsGrid< std::array<Real, fsgrids::bfield::N_BFIELD>, 2> & perBGrid,
    FsGrid< std::array<Real, fsgrids::ehall::N_EHALL>, 2> & EHallGrid,
    FsGrid< std::array<Real, fsgrids::moments::N_MOMENTS>, 2> & momentsGrid,
@@ -731,25 +733,10 @@ void calculateHallTerm(
    FsGrid< std::array<Real, fsgrids::dmoments::N_DMOMENTS>, 2> & dMomentsGrid,
    FsGrid< std::array<Real, fsgrids::bgbfield::N_BGB>, 2> & BgBGrid,
    FsGrid< fsgrids::technical, 2> & technicalGrid,
-   SysBoundary& sysBoundaries,
    cint i,
    cint j,
    cint k
 ) {
-
-   #ifdef DEBUG_FSOLVER
-   if (technicalGrid.get(i,j,k) == NULL) {
-      cerr << "NULL pointer in " << __FILE__ << ":" << __LINE__ << endl;
-      exit(1);
-   }
-   #endif
-   
-   cuint cellSysBoundaryFlag = technicalGrid.get(i,j,k)->sysBoundaryFlag;
-   
-   if (cellSysBoundaryFlag == sysboundarytype::DO_NOT_COMPUTE) return;
-   
-   cuint cellSysBoundaryLayer = technicalGrid.get(i,j,k)->sysBoundaryLayer;
-   
    Real perturbedCoefficients[Rec::N_REC_COEFFICIENTS];
 
    reconstructionCoefficients(
@@ -762,16 +749,9 @@ void calculateHallTerm(
       3 // Reconstruction order of the fields after Balsara 2009, 2 used for general B, 3 used here for 2nd-order Hall term
    );
 
-   if ((cellSysBoundaryFlag != sysboundarytype::NOT_SYSBOUNDARY) && (cellSysBoundaryLayer != 1)) {
-      sysBoundaries.getSysBoundary(cellSysBoundaryFlag)->fieldSolverBoundaryCondHallElectricField(EHallGrid, i, j, k, 0);
-      sysBoundaries.getSysBoundary(cellSysBoundaryFlag)->fieldSolverBoundaryCondHallElectricField(EHallGrid, i, j, k, 1);
-      sysBoundaries.getSysBoundary(cellSysBoundaryFlag)->fieldSolverBoundaryCondHallElectricField(EHallGrid, i, j, k, 2);
-   } else {
-      calculateEdgeHallTermXComponents(perBGrid, EHallGrid, momentsGrid, dPerBGrid, dMomentsGrid, BgBGrid, technicalGrid, perturbedCoefficients, i, j, k);
-      calculateEdgeHallTermYComponents(perBGrid, EHallGrid, momentsGrid, dPerBGrid, dMomentsGrid, BgBGrid, technicalGrid, perturbedCoefficients, i, j, k);
-      calculateEdgeHallTermZComponents(perBGrid, EHallGrid, momentsGrid, dPerBGrid, dMomentsGrid, BgBGrid, technicalGrid, perturbedCoefficients, i, j, k);
-   }
-
+   calculateEdgeHallTermXComponents(perBGrid, EHallGrid, momentsGrid, dPerBGrid, dMomentsGrid, BgBGrid, technicalGrid, perturbedCoefficients, i, j, k);
+   calculateEdgeHallTermYComponents(perBGrid, EHallGrid, momentsGrid, dPerBGrid, dMomentsGrid, BgBGrid, technicalGrid, perturbedCoefficients, i, j, k);
+   calculateEdgeHallTermZComponents(perBGrid, EHallGrid, momentsGrid, dPerBGrid, dMomentsGrid, BgBGrid, technicalGrid, perturbedCoefficients, i, j, k);
 }
 
 /*! \brief High-level function computing the Hall term.
@@ -815,21 +795,41 @@ void calculateHallTermSimple(
    phiprof::start("Calculate Hall term");
    timer=phiprof::initializeTimer("MPI","MPI");
    phiprof::start(timer);
+   telemetry::start(telemetry::MPI_WAIT);
    dPerBGrid.updateGhostCells();
    if(communicateMomentsDerivatives) {
       dMomentsGrid.updateGhostCells();
    }
+   telemetry::stop(telemetry::MPI_WAIT);
    phiprof::stop(timer);
    
+   FsGrid< std::array<Real, fsgrids::bfield::N_BFIELD>, 2> & curPerBGrid =
+      (RKCase == RK_ORDER1 || RKCase == RK_ORDER2_STEP2) ? perBGrid : perBDt2Grid;
+   FsGrid< std::array<Real, fsgrids::moments::N_MOMENTS>, 2> & curMomentsGrid =
+      (RKCase == RK_ORDER1 || RKCase == RK_ORDER2_STEP2) ? momentsGrid : momentsDt2Grid;
+   
+   const FsCellLists& cellLists = getFsCellLists(technicalGrid, sysBoundaries);
+   const vector<FsCellRun>& interiorRuns = cellLists.interiorRuns;
+   const vector<FsBoundaryCell>& boundaryCells = cellLists.boundaryCells;
+   
    phiprof::start("Compute cells");
-   #pragma omp parallel for collapse(3)
-   for (int k=0; k<gridDims[2]; k++) {
-      for (int j=0; j<gridDims[1]; j++) {
-         for (int i=0; i<gridDims[0]; i++) {
-            if (RKCase == RK_ORDER1 || RKCase == RK_ORDER2_STEP2) {
-               calculateHallTerm(perBGrid, EHallGrid, momentsGrid, dPerBGrid, dMomentsGrid, BgBGrid, technicalGrid,sysBoundaries, i, j, k);
-            } else {
-               calculateHallTerm(perBDt2Grid, EHallGrid, momentsDt2Grid, dPerBGrid, dMomentsGrid, BgBGrid, technicalGrid,sysBoundaries, i, j, k);
+   #pragma omp parallel
+   {
+      #pragma omp for schedule(dynamic,4) nowait
+      for (size_t r=0; r<interiorRuns.size(); r++) {
+         const FsCellRun& run = interiorRuns[r];
+         for (int i=run.iBegin; i<run.iEnd; i++) {
+            calculateHallTerm(curPerBGrid, EHallGrid, curMomentsGrid, dPerBGrid, dMomentsGrid, BgBGrid, technicalGrid, i, run.j, run.k);
+         }
+      }
+      #pragma omp for schedule(dynamic,16)
+      for (size_t c=0; c<boundaryCells.size(); c++) {
+         const FsBoundaryCell& cell = boundaryCells[c];
+         if (cell.sysBoundaryLayer == 1) {
+            calculateHallTerm(curPerBGrid, EHallGrid, curMomentsGrid, dPerBGrid, dMomentsGrid, BgBGrid, technicalGrid, cell.i, cell.j, cell.k);
+         } else {
+            for (uint component = 0; component < 3; component++) {
+               cell.sysBoundary->fieldSolverBoundaryCondHallElectricField(EHallGrid, cell.i, cell.j, cell.k, component);
             }
          }
       }
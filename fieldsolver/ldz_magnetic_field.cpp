@@ -64,34 +64,34 @@ void propagateMagneticField(
    creal dy = perBGrid.DY;
    creal dz = perBGrid.DZ;
    
-   std::array<Real, fsgrids::bfield::N_BFIELD> * perBGrid0 = perBGrid.get(i,j,k);
-   std::array<Real, fsgrids::efield::N_EFIELD> * EGrid0;
-   std::array<Real, fsgrids::efield::N_EFIELD> * EGrid1;
-   std::array<Real, fsgrids::efield::N_EFIELD> * EGrid2;
-   std::array<Real, fsgrids::bfield::N_BFIELD> * perBDt2Grid0;
+   FsCell<fsgrids::bfield::N_BFIELD> perBGrid0 = fsCell(perBGrid,i,j,k);
+   FsCell<fsgrids::efield::N_EFIELD> EGrid0;
+   FsCell<fsgrids::efield::N_EFIELD> EGrid1;
+   FsCell<fsgrids::efield::N_EFIELD> EGrid2;
+   FsCell<fsgrids::bfield::N_BFIELD> perBDt2Grid0;
    
    if (doX == true) {
       switch (RKCase) {
          case RK_ORDER1:
-            EGrid0 = EGrid.get(i,j,k);
-            EGrid1 = EGrid.get(i,j+1,k);
-            EGrid2 = EGrid.get(i,j,k+1);
-            perBGrid0->at(fsgrids::bfield::PERBX) += dt/dz*(EGrid2->at(fsgrids::efield::EY) - EGrid0->at(fsgrids::efield::EY)) + dt/dy*(EGrid0->at(fsgrids::efield::EZ) - EGrid1->at(fsgrids::efield::EZ));
+            EGrid0 = fsCell(EGrid,i,j,k);
+            EGrid1 = fsCell(EGrid,i,j+1,k);
+            EGrid2 = fsCell(EGrid,i,j,k+1);
+            perBGrid0.at(fsgrids::bfield::PERBX) += dt/dz*(EGrid2.at(fsgrids::efield::EY) - EGrid0.at(fsgrids::efield::EY)) + dt/dy*(EGrid0.at(fsgrids::efield::EZ) - EGrid1.at(fsgrids::efield::EZ));
             break;
             
          case RK_ORDER2_STEP1:
-            perBDt2Grid0 = perBDt2Grid.get(i,j,k);
-            EGrid0 = EGrid.get(i,j,k);
-            EGrid1 = EGrid.get(i,j+1,k);
-            EGrid2 = EGrid.get(i,j,k+1);
-            perBDt2Grid0->at(fsgrids::bfield::PERBX) = perBGrid0->at(fsgrids::bfield::PERBX) + 0.5*dt*(1.0/dz*(EGrid2->at(fsgrids::efield::EY) - EGrid0->at(fsgrids::efield::EY)) + 1.0/dy*(EGrid0->at(fsgrids::efield::EZ) - EGrid1->at(fsgrids::efield::EZ)));
+            perBDt2Grid0 = fsCell(perBDt2Grid,i,j,k);
+            EGrid0 = fsCell(EGrid,i,j,k);
+            EGrid1 = fsCell(EGrid,i,j+1,k);
+            EGrid2 = fsCell(EGrid,i,j,k+1);
+            perBDt2Grid0.at(fsgrids::bfield::PERBX) = perBGrid0.at(fsgrids::bfield::PERBX) + 0.5*dt*(1.0/dz*(EGrid2.at(fsgrids::efield::EY) - EGrid0.at(fsgrids::efield::EY)) + 1.0/dy*(EGrid0.at(fsgrids::efield::EZ) - EGrid1.at(fsgrids::efield::EZ)));
             break;
             
          case RK_ORDER2_STEP2:
-            EGrid0 = EDt2Grid.get(i,j,k);
-            EGrid1 = EDt2Grid.get(i,j+1,k);
-            EGrid2 = EDt2Grid.get(i,j,k+1);
-            perBGrid0->at(fsgrids::bfield::PERBX) += dt * (1.0/dz*(EGrid2->at(fsgrids::efield::EY) - EGrid0->at(fsgrids::efield::EY)) + 1.0/dy*(EGrid0->at(fsgrids::efield::EZ) - EGrid1->at(fsgrids::efield::EZ)));
+            EGrid0 = fsCell(EDt2Grid,i,j,k);
+            EGrid1 = fsCell(EDt2Grid,i,j+1,k);
+            EGrid2 = fsCell(EDt2Grid,i,j,k+1);
+            perBGrid0.at(fsgrids::bfield::PERBX) += dt * (1.0/dz*(EGrid2.at(fsgrids::efield::EY) - EGrid0.at(fsgrids::efield::EY)) + 1.0/dy*(EGrid0.at(fsgrids::efield::EZ) - EGrid1.at(fsgrids::efield::EZ)));
             break;
             
          default:
@@ -103,23 +103,23 @@ void propagateMagneticField(
    if (doY == true) {
       switch (RKCase) {
          case RK_ORDER1:
-            EGrid0 = EGrid.get(i,j,k);
-            EGrid1 = EGrid.get(i,j,k+1);
-            EGrid2 = EGrid.get(i+1,j,k);
-            perBGrid0->at(fsgrids::bfield::PERBY) += dt/dx*(EGrid2->at(fsgrids::efield::EZ) - EGrid0->at(fsgrids::efield::EZ)) + dt/dz*(EGrid0->at(fsgrids::efield::EX) - EGrid1->at(fsgrids::efield::EX));
+            EGrid0 = fsCell(EGrid,i,j,k);
+            EGrid1 = fsCell(EGrid,i,j,k+1);
+            EGrid2 = fsCell(EGrid,i+1,j,k);
+            perBGrid0.at(fsgrids::bfield::PERBY) += dt/dx*(EGrid2.at(fsgrids::efield::EZ) - EGrid0.at(fsgrids::efield::EZ)) + dt/dz*(EGrid0.at(fsgrids::efield::EX) - EGrid1.at(fsgrids::efield::EX));
             break;
          case RK_ORDER2_STEP1:
-            perBDt2Grid0 = perBDt2Grid.get(i,j,k);
-            EGrid0 = EGrid.get(i,j,k);
-            EGrid1 = EGrid.get(i,j,k+1);
-            EGrid2 = EGrid.get(i+1,j,k);
-            perBDt2Grid0->at(fsgrids::bfield::PERBY) = perBGrid0->at(fsgrids::bfield::PERBY) + 0.5*dt*(1.0/dx*(EGrid2->at(fsgrids::efield::EZ) - EGrid0->at(fsgrids::efield::EZ)) + 1.0/dz*(EGrid0->at(fsgrids::efield::EX) - EGrid1->at(fsgrids::efield::EX)));
+            perBDt2Grid0 = fsCell(perBDt2Grid,i,j,k);
+            EGrid0 = fsCell(EGrid,i,j,k);
+            EGrid1 = fsCell(EGrid,i,j,k+1);
+            EGrid2 = fsCell(EGrid,i+1,j,k);
+            perBDt2Grid0.at(fsgrids::bfield::PERBY) = perBGrid0.at(fsgrids::bfield::PERBY) + 0.5*dt*(1.0/dx*(EGrid2.at(fsgrids::efield::EZ) - EGrid0.at(fsgrids::efield::EZ)) + 1.0/dz*(EGrid0.at(fsgrids::efield::EX) - EGrid1.at(fsgrids::efield::EX)));
             break;
          case RK_ORDER2_STEP2:
-            EGrid0 = EDt2Grid.get(i,j,k);
-            EGrid1 = EDt2Grid.get(i,j,k+1);
-            EGrid2 = EDt2Grid.get(i+1,j,k);
-            perBGrid0->at(fsgrids::bfield::PERBY) += dt * (1.0/dx*(EGrid2->at(fsgrids::efield::EZ) - EGrid0->at(fsgrids::efield::EZ)) + 1.0/dz*(EGrid0->at(fsgrids::efield::EX) - EGrid1->at(fsgrids::efield::EX)));
+            EGrid0 = fsCell(EDt2Grid,i,j,k);
+            EGrid1 = fsCell(EDt2Grid,i,j,k+1);
+            EGrid2 = fsCell(EDt2Grid,i+1,j,k);
+            perBGrid0.at(fsgrids::bfield::PERBY) += dt * (1.0/dx*(EGrid2.at(fsgrids::efield::EZ) - EGrid0.at(fsgrids::efield::EZ)) + 1.0/dz*(EGrid0.at(fsgrids::efield::EX) - EGrid1.at(fsgrids::efield::EX)));
             break;
          default:
             std::cerr << __FILE__ << ":" << __LINE__ << ":" << "Invalid RK case." << std::endl;
@@ -130,23 +130,23 @@ void propagateMagneticField(
    if (doZ == true) {
       switch (RKCase) {
          case RK_ORDER1:
-            EGrid0 = EGrid.get(i,j,k);
-            EGrid1 = EGrid.get(i+1,j,k);
-            EGrid2 = EGrid.get(i,j+1,k);
-            perBGrid0->at(fsgrids::bfield::PERBZ) += dt/dy*(EGrid2->at(fsgrids::efield::EX) - EGrid0->at(fsgrids::efield::EX)) + dt/dx*(EGrid0->at(fsgrids::efield::EY) - EGrid1->at(fsgrids::efield::EY));
+            EGrid0 = fsCell(EGrid,i,j,k);
+            EGrid1 = fsCell(EGrid,i+1,j,k);
+            EGrid2 = fsCell(EGrid,i,j+1,k);
+            perBGrid0.at(fsgrids::bfield::PERBZ) += dt/dy*(EGrid2.at(fsgrids::efield::EX) - EGrid0.at(fsgrids::efield::EX)) + dt/dx*(EGrid0.at(fsgrids::efield::EY) - EGrid1.at(fsgrids::efield::EY));
             break;
          case RK_ORDER2_STEP1:
-            perBDt2Grid0 = perBDt2Grid.get(i,j,k);
-            EGrid0 = EGrid.get(i,j,k);
-            EGrid1 = EGrid.get(i+1,j,k);
-            EGrid2 = EGrid.get(i,j+1,k);
-            perBDt2Grid0->at(fsgrids::bfield::PERBZ) = perBGrid0->at(fsgrids::bfield::PERBZ) + 0.5*dt*(1.0/dy*(EGrid2->at(fsgrids::efield::EX) - EGrid0->at(fsgrids::efield::EX)) + 1.0/dx*(EGrid0->at(fsgrids::efield::EY) - EGrid1->at(fsgrids::efield::EY)));
+            perBDt2Grid0 = fsCell(perBDt2Grid,i,j,k);
+            EGrid0 = fsCell(EGrid,i,j,k);
+            EGrid1 = fsCell(EGrid,i+1,j,k);
+            EGrid2 = fsCell(EGrid,i,j+1,k);
+            perBDt2Grid0.at(fsgrids::bfield::PERBZ) = perBGrid0.at(fsgrids::bfield::PERBZ) + 0.5*dt*(1.0/dy*(EGrid2.at(fsgrids::efield::EX) - EGrid0.at(fsgrids::efield::EX)) + 1.0/dx*(EGrid0.at(fsgrids::efield::EY) - EGrid1.at(fsgrids::efield::EY)));
             break;
          case RK_ORDER2_STEP2:
-            EGrid0 = EDt2Grid.get(i,j,k);
-            EGrid1 = EDt2Grid.get(i+1,j,k);
-            EGrid2 = EDt2Grid.get(i,j+1,k);
-            perBGrid0->at(fsgrids::bfield::PERBZ) += dt  * (1.0/dy*(EGrid2->at(fsgrids::efield::EX) - EGrid0->at(fsgrids::efield::EX)) + 1.0/dx*(EGrid0->at(fsgrids::efield::EY) - EGrid1->at(fsgrids::efield::EY)));
+            EGrid0 = fsCell(EDt2Grid,i,j,k);
+            EGrid1 = fsCell(EDt2Grid,i+1,j,k);
+            EGrid2 = fsCell(EDt2Grid,i,j+1,k);
+            perBGrid0.at(fsgrids::bfield::PERBZ) += dt  * (1.0/dy*(EGrid2.at(fsgrids::efield::EX) - EGrid0.at(fsgrids::efield::EX)) + 1.0/dx*(EGrid0.at(fsgrids::efield::EY) - EGrid1.at(fsgrids::efield::EY)));
             break;
          default:
             std::cerr << __FILE__ << ":" << __LINE__ << ":" << "Invalid RK case." << std::endl;
@@ -164,8 +164,7 @@ void propagateMagneticField(
  * \param EGrid fsGrid holding the Electric field quantities at runge-kutta t=0
  * \param EDt2Grid fsGrid holding the Electric field quantities at runge-kutta t=0.5
  * \param technicalGrid fsGrid holding technical information (such as boundary types)
- * \param i,j,k fsGrid cell coordinates for the current cell
- * \param sysBoundaries System boundary conditions existing
+ * \param cell System boundary cell with its boundary condition
  * \param dt Length of the time step
  * \param RKCase Element in the enum defining the Runge-Kutta method steps
  * 
@@ -177,22 +176,18 @@ void propagateSysBoundaryMagneticField(
    FsGrid< std::array<Real, fsgrids::efield::N_EFIELD>, 2> & EGrid,
    FsGrid< std::array<Real, fsgrids::efield::N_EFIELD>, 2> & EDt2Grid,
    FsGrid< fsgrids::technical, 2> & technicalGrid,
-   cint i,
-   cint j,
-   cint k,
-   SysBoundary& sysBoundaries,
+   const FsBoundaryCell& cell,
    creal& dt,
    cint& RKCase
 ) {
-   std::array<Real, fsgrids::bfield::N_BFIELD> * bGrid;
+   FsCell<fsgrids::bfield::N_BFIELD> bGrid;
    if (RKCase == RK_ORDER1 || RKCase == RK_ORDER2_STEP2) {
-      bGrid = perBGrid.get(i,j,k);
+      bGrid = fsCell(perBGrid,cell.i,cell.j,cell.k);
    } else {
-      bGrid = perBDt2Grid.get(i,j,k);
+      bGrid = fsCell(perBDt2Grid,cell.i,cell.j,cell.k);
    }
-   cuint sysBoundaryFlag = technicalGrid.get(i,j,k)->sysBoundaryFlag;
    for (uint component = 0; component < 3; component++) {
-      bGrid->at(fsgrids::bfield::PERBX + component) = sysBoundaries.getSysBoundary(sysBoundaryFlag)->fieldSolverBoundaryCondMagneticField(perBGrid, perBDt2Grid, EGrid, EDt2Grid, technicalGrid, i, j, k, dt, RKCase, component);
+      bGrid.at(fsgrids::bfield::PERBX + component) = cell.sysBoundary->fieldSolverBoundaryCondMagneticField(perBGrid, perBDt2Grid, EGrid, EDt2Grid, technicalGrid, cell.i, cell.j, cell.k, dt, RKCase, component);
    }
 }
 
@@ -228,21 +223,19 @@ void propagateMagneticFieldSimple(
    
    phiprof::start("Propagate magnetic field");
    
+   const FsCellLists& cellLists = getFsCellLists(technicalGrid, sysBoundaries);
+   const vector<FsCellRun>& interiorRuns = cellLists.interiorRuns;
+   const vector<FsBoundaryCell>& boundaryCells = cellLists.boundaryCells;
+   
    timer=phiprof::initializeTimer("Compute cells");
    phiprof::start(timer);
    
-   #pragma omp parallel for collapse(3)
-   for (int k=0; k<gridDims[2]; k++) {
-      for (int j=0; j<gridDims[1]; j++) {
-         for (int i=0; i<gridDims[0]; i++) {
-
-            // Set the fsgrid rank in the technical grid
-            technicalGrid.get(i,j,k)->fsGridRank=technicalGrid.getRank();
-
-            if(technicalGrid.get(i,j,k)->sysBoundaryFlag != sysboundarytype::NOT_SYSBOUNDARY) continue;
-            // Propagate B on all local cells:
-            propagateMagneticField(perBGrid, perBDt2Grid, EGrid, EDt2Grid, i, j, k, dt, RKCase);
-         }
+   // Propagate B on all local interior cells:
+   #pragma omp parallel for schedule(dynamic,4)
+   for (size_t r=0; r<interiorRuns.size(); r++) {
+      const FsCellRun& run = interiorRuns[r];
+      for (int i=run.iBegin; i<run.iEnd; i++) {
+         propagateMagneticField(perBGrid, perBDt2Grid, EGrid, EDt2Grid, i, run.j, run.k, dt, RKCase);
       }
    }
    
@@ -254,6 +247,7 @@ void propagateMagneticFieldSimple(
    //TODO: do not transfer if there are no field boundaryconditions
    timer=phiprof::initializeTimer("MPI","MPI");
    phiprof::start(timer);
+   telemetry::start(telemetry::MPI_WAIT);
    if (RKCase == RK_ORDER1 || RKCase == RK_ORDER2_STEP2) {
       // Exchange PERBX,PERBY,PERBZ with neighbours
       perBGrid.updateGhostCells();
@@ -262,21 +256,15 @@ void propagateMagneticFieldSimple(
       perBDt2Grid.updateGhostCells();
    }
    
+   telemetry::stop(telemetry::MPI_WAIT);
    phiprof::stop(timer);
    
    // Propagate B on system boundary/process inner cells
    timer=phiprof::initializeTimer("Compute system boundary cells");
    phiprof::start(timer);
-   #pragma omp parallel for collapse(3)
-   for (int k=0; k<gridDims[2]; k++) {
-      for (int j=0; j<gridDims[1]; j++) {
-         for (int i=0; i<gridDims[0]; i++) {
-            if(technicalGrid.get(i,j,k)->sysBoundaryFlag != sysboundarytype::NOT_SYSBOUNDARY &&
-                  technicalGrid.get(i,j,k)->sysBoundaryFlag != sysboundarytype::DO_NOT_COMPUTE) {
-               propagateSysBoundaryMagneticField(perBGrid, perBDt2Grid, EGrid, EDt2Grid, technicalGrid, i, j, k, sysBoundaries, dt, RKCase);
-            }
-         }
-      }
+   #pragma omp parallel for schedule(dynamic,16)
+   for (size_t c=0; c<boundaryCells.size(); c++) {
+      propagateSysBoundaryMagneticField(perBGrid, perBDt2Grid, EGrid, EDt2Grid, technicalGrid, boundaryCells[c], dt, RKCase);
    }
    phiprof::stop(timer,N_cells,"Spatial Cells");
    
@@ -52,6 +52,7 @@
 #include "derivatives.hpp"
 #include "fs_limiters.h"
 #include "mpiconversion.h"
+#include "../telemetry.h"
 
 /*! Re-initialize field propagator after rebalance. E, BGB, RHO, RHO_V,
  cell_dimensions, sysboundaryflag need to be up to date for the
@@ -374,6 +375,7 @@ bool propagateFields(
 
          phiprof::start("MPI_Allreduce");
          technicalGrid.Allreduce(&(dtMaxLocal), &(dtMaxGlobal), 1, MPI_Type<Real>(), MPI_MIN);
+         telemetry::countCollective();
          phiprof::stop("MPI_Allreduce");
          
          //reduce dt if it is too high
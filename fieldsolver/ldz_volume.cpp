@@ -50,7 +50,7 @@ void calculateVolumeAveragedFields(
             if(technicalGrid.get(i,j,k)->sysBoundaryFlag == sysboundarytype::DO_NOT_COMPUTE) continue;
             
             Real perturbedCoefficients[Rec::N_REC_COEFFICIENTS];
-            std::array<Real, fsgrids::volfields::N_VOL> * volGrid0 = volGrid.get(i,j,k);
+            FsCell<fsgrids::volfields::N_VOL> volGrid0 = fsCell(volGrid,i,j,k);
             
             // Calculate reconstruction coefficients for this cell:
             reconstructionCoefficients(
@@ -64,9 +64,9 @@ void calculateVolumeAveragedFields(
             );
             
             // Calculate volume average of B:
-            volGrid0->at(fsgrids::volfields::PERBXVOL) = perturbedCoefficients[Rec::a_0];
-            volGrid0->at(fsgrids::volfields::PERBYVOL) = perturbedCoefficients[Rec::b_0];
-            volGrid0->at(fsgrids::volfields::PERBZVOL) = perturbedCoefficients[Rec::c_0];
+            volGrid0.at(fsgrids::volfields::PERBXVOL) = perturbedCoefficients[Rec::a_0];
+            volGrid0.at(fsgrids::volfields::PERBYVOL) = perturbedCoefficients[Rec::b_0];
+            volGrid0.at(fsgrids::volfields::PERBZVOL) = perturbedCoefficients[Rec::c_0];
          }
       }
    }
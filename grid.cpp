@@ -29,6 +29,8 @@
 #include <sstream>
 #include <ctime>
 #include <omp.h>
+#include <unordered_map>
+#include <unordered_set>
 #include "grid.h"
 #include "vlasovmover.h"
 #include "definitions.h"
@@ -43,6 +45,10 @@
 #include "iowrite.h"
 #include "ioread.h"
 #include "object_wrapper.h"
+#include "memoryallocation.h"
+#include "cell_affinity.h"
+#include "task_trace.h"
+#include "cell_order.h"
 
 #ifdef PAPI_MEM
 #include "papi.h" 
@@ -62,6 +68,9 @@ extern Logger logFile, diagnostic;
 void initVelocityGridGeometry(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid);
 void initSpatialCellCoordinates(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid);
 void initializeStencils(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid);
+static void setEstimatedCellWeights(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,const Project& project);
+static void updateAfterRepartition(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid, SysBoundary& sysBoundaries);
+static void reportStartupPhases(const vector<pair<string,double> >& phases);
 
 void writeVelMesh(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid) {
    const vector<CellID>& cells = getLocalCells();
@@ -99,6 +108,10 @@ void initializeGrids(
 ) {
    int myRank;
    MPI_Comm_rank(MPI_COMM_WORLD,&myRank);
+
+   // Wall clock time of the startup phases, reported at the end
+   vector<pair<string,double> > startupPhases;
+   double phaseStart = MPI_Wtime();
    
    // Init Zoltan:
    float zoltanVersion;
@@ -142,9 +155,30 @@ void initializeGrids(
    initVelocityGridGeometry(mpiGrid);
    initializeStencils(mpiGrid);
    
+   phiprof::start("Initialize system boundary conditions");
+   if(sysBoundaries.initSysBoundaries(project, P::t_min) == false) {
+      if (myRank == MASTER_RANK) cerr << "Error in initialising the system boundaries." << endl;
+      exit(1);
+   }
+   phiprof::stop("Initialize system boundary conditions");
+
    mpiGrid.set_partitioning_option("IMBALANCE_TOL", P::loadBalanceTolerance);
    phiprof::start("Initial load-balancing");
    if (myRank == MASTER_RANK) logFile << "(INIT): Starting initial load balance." << endl << writeVerbose;
+   if (P::isRestart == false) {
+      // Fresh start: partition with the estimated block counts while the cells are still empty.
+      // This is the final startup partition, velocity space is filled after it and never migrated.
+      // The estimate needs the system boundary types, so the cells are classified on the initial
+      // partition here and again on the final one below.
+      phiprof::start("Estimate velocity blocks");
+      initSpatialCellCoordinates(mpiGrid);
+      if(sysBoundaries.classifyCells(mpiGrid,technicalGrid) == false) {
+         cerr << "(MAIN) ERROR: System boundary conditions were not set correctly." << endl;
+         exit(1);
+      }
+      setEstimatedCellWeights(mpiGrid,project);
+      phiprof::stop("Estimate velocity blocks");
+   }
    mpiGrid.balance_load();
    recalculateLocalCellsCache();
 
@@ -153,6 +187,8 @@ void initializeGrids(
    }
    const vector<CellID>& cells = getLocalCells();
    phiprof::stop("Initial load-balancing");
+   startupPhases.push_back(make_pair("Grid setup and initial partition",MPI_Wtime()-phaseStart));
+   phaseStart = MPI_Wtime();
    
    if (myRank == MASTER_RANK) logFile << "(INIT): Set initial state." << endl << writeVerbose;
    phiprof::start("Set initial state");
@@ -161,13 +197,6 @@ void initializeGrids(
    initSpatialCellCoordinates(mpiGrid);
    phiprof::stop("Set spatial cell coordinates");
    
-   phiprof::start("Initialize system boundary conditions");
-   if(sysBoundaries.initSysBoundaries(project, P::t_min) == false) {
-      if (myRank == MASTER_RANK) cerr << "Error in initialising the system boundaries." << endl;
-      exit(1);
-   }
-   phiprof::stop("Initialize system boundary conditions");
-   
    // Initialise system boundary conditions (they need the initialised positions!!)
    phiprof::start("Classify cells (sys boundary conditions)");
    if(sysBoundaries.classifyCells(mpiGrid,technicalGrid) == false) {
@@ -183,6 +212,8 @@ void initializeGrids(
       exit(1);
    }
    phiprof::stop("Check boundary refinement");
+   startupPhases.push_back(make_pair("System boundary classification",MPI_Wtime()-phaseStart));
+   phaseStart = MPI_Wtime();
    
    if (P::isRestart) {
       logFile << "Restart from "<< P::restartFileName << std::endl << writeVerbose;
@@ -200,6 +231,9 @@ void initializeGrids(
          exit(1);
       }
       phiprof::stop("Apply system boundary conditions state");
+      project.reportInitialDistributionCache();
+      startupPhases.push_back(make_pair("Read restart",MPI_Wtime()-phaseStart));
+      phaseStart = MPI_Wtime();
    }
    
    if (!P::isRestart) {
@@ -232,6 +266,9 @@ void initializeGrids(
          exit(1);
       }
       phiprof::stop("Apply system boundary conditions state");
+      project.reportInitialDistributionCache();
+      startupPhases.push_back(make_pair("Fill velocity space",MPI_Wtime()-phaseStart));
+      phaseStart = MPI_Wtime();
       
       for (size_t i=0; i<cells.size(); ++i) {
          mpiGrid[cells[i]]->parameters[CellParams::LBWEIGHTCOUNTER] = 0;
@@ -252,6 +289,25 @@ void initializeGrids(
       }
       
       shrink_to_fit_grid_data(mpiGrid); //get rid of excess data already here
+      startupPhases.push_back(make_pair("Adjust velocity blocks",MPI_Wtime()-phaseStart));
+      phaseStart = MPI_Wtime();
+
+      // Report how well the estimate balanced the real block counts
+      uint64_t localBlocks = 0;
+      for (size_t i=0; i<cells.size(); ++i) {
+         for (uint popID=0; popID<getObjectWrapper().particleSpecies.size(); ++popID) {
+            localBlocks += mpiGrid[cells[i]]->get_number_of_velocity_blocks(popID);
+         }
+      }
+      uint64_t maxBlocks, sumBlocks;
+      MPI_Reduce(&localBlocks,&maxBlocks,1,MPI_UINT64_T,MPI_MAX,MASTER_RANK,MPI_COMM_WORLD);
+      MPI_Reduce(&localBlocks,&sumBlocks,1,MPI_UINT64_T,MPI_SUM,MASTER_RANK,MPI_COMM_WORLD);
+      if (myRank == MASTER_RANK && sumBlocks > 0) {
+         int nProcs;
+         MPI_Comm_size(MPI_COMM_WORLD,&nProcs);
+         logFile << "(INIT): Velocity block imbalance (max/average per process) of the estimated partition: ";
+         logFile << static_cast<double>(maxBlocks)*nProcs/sumBlocks << endl << writeVerbose;
+      }
 
       /*
       // Apply boundary conditions so that we get correct initial moments
@@ -270,8 +326,16 @@ void initializeGrids(
       exit(1);
    }
    
-   //Balance load before we transfer all data below
-   balanceLoad(mpiGrid, sysBoundaries);
+   if (P::isRestart) {
+      //Balance load before we transfer all data below
+      balanceLoad(mpiGrid, sysBoundaries);
+   } else {
+      // The partition from the block estimate is kept, only the data depending on it is set up
+      Parameters::meshRepartitioned = true;
+      updateAfterRepartition(mpiGrid, sysBoundaries);
+   }
+   startupPhases.push_back(make_pair("Load balance",MPI_Wtime()-phaseStart));
+   phaseStart = MPI_Wtime();
    
    phiprof::initializeTimer("Fetch Neighbour data","MPI");
    phiprof::start("Fetch Neighbour data");
@@ -291,6 +355,9 @@ void initializeGrids(
       phiprof::stop("Init moments");
    }
    
+   startupPhases.push_back(make_pair("Neighbour data and moments",MPI_Wtime()-phaseStart));
+   phaseStart = MPI_Wtime();
+   
    phiprof::start("setProjectBField");
    project.setProjectBField(perBGrid, BgBGrid, technicalGrid);
    perBGrid.updateGhostCells();
@@ -310,8 +377,54 @@ void initializeGrids(
    momentsDt2Grid.updateGhostCells();
    technicalGrid.updateGhostCells(); // This needs to be done at some point
    phiprof::stop("Finish fsgrid setup");
+   startupPhases.push_back(make_pair("Field setup",MPI_Wtime()-phaseStart));
    
    phiprof::stop("Set initial state");
+   reportStartupPhases(startupPhases);
+}
+
+/*! Sets the load balance weight of each local cell to the number of velocity blocks the project
+ * estimates for it, summed over populations. No velocity blocks are created. The cells have to be
+ * classified: DO_NOT_COMPUTE cells get no blocks and the minimum weight. The other system boundary
+ * cells get the estimate of the location, as their boundary distributions are of similar extent.
+ */
+static void setEstimatedCellWeights(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,const Project& project) {
+   const vector<CellID>& cells = mpiGrid.get_cells();
+   vector<Real> weights(cells.size());
+   #pragma omp parallel for
+   for (size_t i=0; i<cells.size(); ++i) {
+      if (mpiGrid[cells[i]]->sysBoundaryFlag == sysboundarytype::DO_NOT_COMPUTE) {
+         weights[i] = 1.0;
+         continue;
+      }
+      const std::array<double, 3> cell_min = mpiGrid.geometry.get_min(cells[i]);
+      const std::array<double, 3> cell_length = mpiGrid.geometry.get_length(cells[i]);
+      Real weight = 0.0;
+      for (uint popID=0; popID<getObjectWrapper().particleSpecies.size(); ++popID) {
+         weight += project.estimateVelocityBlocks(cell_min[0],cell_min[1],cell_min[2],
+                                                  cell_length[0],cell_length[1],cell_length[2],popID);
+      }
+      weights[i] = max(weight,(Real)1.0);
+   }
+   for (size_t i=0; i<cells.size(); ++i) mpiGrid.set_cell_weight(cells[i],weights[i]);
+}
+
+/*! Writes the wall clock time of each startup phase, maximum over processes, to logfile.
+ * Collective operation on MPI_COMM_WORLD.
+ */
+static void reportStartupPhases(const vector<pair<string,double> >& phases) {
+   vector<double> localTimes(phases.size());
+   vector<double> maxTimes(phases.size());
+   for (size_t i=0; i<phases.size(); ++i) localTimes[i] = phases[i].second;
+   MPI_Reduce(localTimes.data(),maxTimes.data(),phases.size(),MPI_DOUBLE,MPI_MAX,MASTER_RANK,MPI_COMM_WORLD);
+
+   double total = 0.0;
+   logFile << "(INIT): Startup phases (max over processes):" << endl;
+   for (size_t i=0; i<phases.size(); ++i) {
+      logFile << "\t " << phases[i].first << ": " << maxTimes[i] << " s" << endl;
+      total += maxTimes[i];
+   }
+   logFile << "\t Total: " << total << " s" << endl << writeVerbose;
 }
 
 // initialize velocity grid of spatial cells before creating cells in dccrg.initialize
@@ -509,10 +622,19 @@ void balanceLoad(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid, S
    mpiGrid.finish_balance_load();
    phiprof::stop("dccrg.finish_balance_load");
 
+   updateAfterRepartition(mpiGrid, sysBoundaries);
+   
+   phiprof::stop("Balancing load");
+}
+
+/*! Updates the cell caches, remote neighbour data, system boundaries and solvers after
+ * the partition has changed. Transfers of distribution data must be finished before this.
+ */
+static void updateAfterRepartition(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid, SysBoundary& sysBoundaries) {
    //Make sure transfers are enabled for all cells
    recalculateLocalCellsCache();
    getObjectWrapper().meshData.reallocate();
-   cells = mpiGrid.get_cells();
+   const vector<CellID>& cells = mpiGrid.get_cells();
    for (uint i=0; i<cells.size(); ++i) mpiGrid[cells[i]]->set_mpi_transfer_enabled(true);
 
    // Communicate all spatial data for FULL neighborhood, which
@@ -547,9 +669,255 @@ void balanceLoad(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid, S
       setFaceNeighborRanks( mpiGrid );
       phiprof::stop("set face neighbor ranks");
    }
-   
-   
-   phiprof::stop("Balancing load");
+
+   // Place the block data of the new partition on the home threads of the cells
+   cellaffinity::assignHomeThreads(mpiGrid);
+   cellorder::reportLocality(mpiGrid);
+}
+
+/*! Returns true if the refinement of the cell may be changed at run time. Cells
+ * closer than three layers to a system boundary keep their refinement level so
+ * that the boundary conditions and checkRefinement() remain valid.
+ */
+static bool isAdaptable(const SpatialCell* cell) {
+   return cell->sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY && cell->sysBoundaryLayer == 0;
+}
+
+void adaptRefinement(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid, SysBoundary& sysBoundaries) {
+   phiprof::initializeTimer("Adapt refinement", "Load balance");
+   phiprof::start("Adapt refinement");
+
+   static amr_ref_criteria::SpatialBase* criterion = NULL;
+   if (criterion == NULL) {
+      criterion = getObjectWrapper().amrSpatialRefCriteria.create(P::amrSpatialRefCriterion);
+      if (criterion == NULL || criterion->initialize("") == false) {
+         cerr << "(AMR) ERROR: unknown spatial refinement criterion '" << P::amrSpatialRefCriterion << "'" << endl;
+         abort();
+      }
+   }
+
+   // Face neighbors of local cells need up-to-date moments and fields
+   phiprof::start("evaluate criterion");
+   SpatialCell::set_mpi_transfer_type(Transfer::CELL_PARAMETERS);
+   mpiGrid.update_copies_of_remote_neighbors(NEAREST_NEIGHBORHOOD_ID);
+
+   const vector<CellID>& cells = getLocalCells();
+   vector<Real> criterionValues(cells.size(),0.0);
+   #pragma omp parallel for
+   for (size_t c=0; c<cells.size(); ++c) {
+      SpatialCell* cell = mpiGrid[cells[c]];
+      if (isAdaptable(cell) == false) continue;
+
+      vector<const Real*> nbrParams;
+      for (const auto& nbr : mpiGrid.get_face_neighbors_of(cells[c])) {
+         if (nbr.first == INVALID_CELLID) continue;
+         nbrParams.push_back(mpiGrid[nbr.first]->get_cell_parameters());
+      }
+      criterionValues[c] = criterion->evaluate(cell->get_cell_parameters(),nbrParams);
+   }
+   phiprof::stop("evaluate criterion");
+
+   // Mark cells for refinement. Sibling groups are coarsened only if all siblings
+   // are local, adaptable and below the coarsening limit, so that no velocity
+   // space data has to be sent between processes while the mesh is modified.
+   phiprof::start("mark cells");
+   unordered_map<CellID,Real> localValues;
+   for (size_t c=0; c<cells.size(); ++c) localValues[cells[c]] = criterionValues[c];
+
+   const int maxRefLevel = min(P::amrMaxSpatialRefLevel,(int)mpiGrid.mapping.get_maximum_refinement_level());
+   unordered_set<CellID> checkedParents;
+   uint64_t refineRequests = 0;
+   uint64_t coarsenRequests = 0;
+   for (size_t c=0; c<cells.size(); ++c) {
+      if (isAdaptable(mpiGrid[cells[c]]) == false) continue;
+      const int refLevel = mpiGrid.get_refinement_level(cells[c]);
+
+      if (criterionValues[c] > P::amrSpatialRefineLimit) {
+         if (refLevel < maxRefLevel) {
+            mpiGrid.refine_completely(cells[c]);
+            ++refineRequests;
+         }
+         continue;
+      }
+
+      if (refLevel == 0 || criterionValues[c] >= P::amrSpatialCoarsenLimit) continue;
+      const CellID parent = mpiGrid.mapping.get_parent(cells[c]);
+      if (checkedParents.insert(parent).second == false) continue;
+
+      bool coarsen = true;
+      for (const auto& sibling : mpiGrid.mapping.get_all_children(parent)) {
+         auto it = localValues.find(sibling);
+         if (it == localValues.end() || isAdaptable(mpiGrid[sibling]) == false || it->second >= P::amrSpatialCoarsenLimit) {
+            coarsen = false;
+            break;
+         }
+      }
+      if (coarsen) {
+         mpiGrid.unrefine_completely(cells[c]);
+         ++coarsenRequests;
+      }
+   }
+   phiprof::stop("mark cells");
+
+   phiprof::start("dccrg.stop_refining");
+   const vector<CellID> newCells = mpiGrid.stop_refining(true);
+   phiprof::stop("dccrg.stop_refining");
+
+   const size_t nPops = getObjectWrapper().particleSpecies.size();
+
+   // Prolongation: children inherit the distribution function of their parent.
+   // Phase-space density is a per-volume quantity and the children tile the
+   // parent exactly, so copying f conserves mass, momentum and energy.
+   phiprof::start("prolongation");
+   #pragma omp parallel for
+   for (size_t c=0; c<newCells.size(); ++c) {
+      const SpatialCell* parent = mpiGrid[mpiGrid.mapping.get_parent(newCells[c])];
+      SpatialCell* cell = mpiGrid[newCells[c]];
+
+      cell->parameters = parent->parameters;
+      cell->sysBoundaryFlag = parent->sysBoundaryFlag;
+      cell->sysBoundaryLayer = parent->sysBoundaryLayer;
+      for (size_t popID=0; popID<nPops; ++popID) {
+         cell->set_population(parent->get_population(popID),popID);
+      }
+   }
+   phiprof::stop("prolongation");
+
+   // Restriction: the coarse cell gets the volume average of its children,
+   // i.e. the sum of the children's f divided by the number of children.
+   phiprof::start("restriction");
+   unordered_map<CellID,vector<CellID> > removedChildren;
+   for (const auto& removed : mpiGrid.get_removed_cells()) {
+      removedChildren[mpiGrid.mapping.get_parent(removed)].push_back(removed);
+   }
+   vector<CellID> coarsenedCells;
+   for (const auto& parent : removedChildren) {
+      if (mpiGrid.is_local(parent.first)) coarsenedCells.push_back(parent.first);
+   }
+   #pragma omp parallel for
+   for (size_t c=0; c<coarsenedCells.size(); ++c) {
+      SpatialCell* cell = mpiGrid[coarsenedCells[c]];
+      const vector<CellID>& children = removedChildren.at(coarsenedCells[c]);
+      const Real weight = 1.0 / children.size();
+
+      cell->parameters.fill(0.0);
+      cell->sysBoundaryFlag = sysboundarytype::NOT_SYSBOUNDARY;
+      cell->sysBoundaryLayer = 0;
+      for (size_t ch=0; ch<children.size(); ++ch) {
+         const SpatialCell* child = mpiGrid[children[ch]];
+         for (uint i=0; i<CellParams::N_SPATIAL_CELL_PARAMS; ++i) {
+            cell->parameters[i] += weight*child->parameters[i];
+         }
+      }
+
+      for (size_t popID=0; popID<nPops; ++popID) {
+         cell->clear(popID);
+         for (size_t ch=0; ch<children.size(); ++ch) {
+            SpatialCell* child = mpiGrid[children[ch]];
+            for (vmesh::LocalID srcLID=0; srcLID<child->get_number_of_velocity_blocks(popID); ++srcLID) {
+               const vmesh::GlobalID blockGID = child->get_velocity_block_global_id(srcLID,popID);
+               vmesh::LocalID trgtLID = cell->get_velocity_block_local_id(blockGID,popID);
+               if (trgtLID == SpatialCell::invalid_local_id()) {
+                  cell->add_velocity_block(blockGID,popID);
+                  trgtLID = cell->get_velocity_block_local_id(blockGID,popID);
+               }
+               const Realf* src = child->get_data(srcLID,popID);
+               Realf* trgt = cell->get_data(trgtLID,popID);
+               for (uint i=0; i<WID3; ++i) trgt[i] += weight*src[i];
+            }
+         }
+      }
+      calculateCellMoments(cell,true,true);
+   }
+   phiprof::stop("restriction");
+
+   mpiGrid.clear_refined_unrefined_data();
+   recalculateLocalCellsCache();
+   initSpatialCellCoordinates(mpiGrid);
+
+   // New cells are weighted by their block count until acceleration has measured them
+   vector<CellID> changedCells(newCells);
+   changedCells.insert(changedCells.end(),coarsenedCells.begin(),coarsenedCells.end());
+   #pragma omp parallel for
+   for (size_t c=0; c<changedCells.size(); ++c) {
+      SpatialCell* cell = mpiGrid[changedCells[c]];
+      cell->parameters[CellParams::LBWEIGHTCOUNTER] = 0;
+      for (size_t popID=0; popID<nPops; ++popID) {
+         cell->parameters[CellParams::LBWEIGHTCOUNTER] += cell->get_number_of_velocity_blocks(popID);
+      }
+   }
+
+   uint64_t localCounts[3] = {refineRequests,coarsenRequests,changedCells.size()};
+   uint64_t globalCounts[3];
+   MPI_Allreduce(localCounts,globalCounts,3,MPI_UINT64_T,MPI_SUM,MPI_COMM_WORLD);
+   logFile << "(AMR): " << globalCounts[0] << " refine and " << globalCounts[1] << " coarsen requests, ";
+   logFile << globalCounts[2] << " cells created" << endl << writeVerbose;
+   phiprof::stop("Adapt refinement");
+
+   // Rebalance also rebuilds remote block lists, boundary and field solver
+   // bookkeeping and the face neighbor ranks for the new mesh
+   if (globalCounts[2] > 0) {
+      balanceLoad(mpiGrid, sysBoundaries);
+   }
+}
+
+/*! Send the velocity block content lists of population popID to the copies of remote neighbors.
+ * Only called by one thread, as it communicates with MPI.*/
+static void transferContentLists(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,const uint popID) {
+   SpatialCell::setCommunicatedSpecies(popID);
+   phiprof::initializeTimer("Transfer with_content_list","MPI");
+   phiprof::start("Transfer with_content_list");
+   SpatialCell::set_mpi_transfer_type(Transfer::VEL_BLOCK_WITH_CONTENT_STAGE1 );
+   mpiGrid.update_copies_of_remote_neighbors(NEAREST_NEIGHBORHOOD_ID);
+   SpatialCell::set_mpi_transfer_type(Transfer::VEL_BLOCK_WITH_CONTENT_STAGE2 );
+   mpiGrid.update_copies_of_remote_neighbors(NEAREST_NEIGHBORHOOD_ID);
+   phiprof::stop("Transfer with_content_list");
+}
+
+/*! Adjust the velocity blocks of population popID in one local cell, using the content
+ * lists of the cell and its nearest neighbors. Rescales the distribution afterwards if
+ * the species conserves mass.*/
+static void adjustCellBlocks(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+                             const CellID cell_id,const uint popID) {
+   Real density_pre_adjust=0.0;
+   Real density_post_adjust=0.0;
+   SpatialCell* cell = mpiGrid[cell_id];
+
+   // gather spatial neighbor list and create vector with pointers to neighbor spatial cells
+   const auto* neighbors = mpiGrid.get_neighbors_of(cell_id, NEAREST_NEIGHBORHOOD_ID);
+   vector<SpatialCell*> neighbor_ptrs;
+   neighbor_ptrs.reserve(neighbors->size());
+
+   for ( const auto& nbrPair : *neighbors) {
+      CellID neighbor_id = nbrPair.first;
+      if (neighbor_id == 0 || neighbor_id == cell_id) {
+         continue;
+      }
+      neighbor_ptrs.push_back(mpiGrid[neighbor_id]);
+   }
+   if (getObjectWrapper().particleSpecies[popID].sparse_conserve_mass) {
+      for (size_t i=0; i<cell->get_number_of_velocity_blocks(popID)*WID3; ++i) {
+         density_pre_adjust += cell->get_data(popID)[i];
+      }
+   }
+   cell->adjust_velocity_blocks(neighbor_ptrs,popID);
+
+   if (getObjectWrapper().particleSpecies[popID].sparse_conserve_mass) {
+      for (size_t i=0; i<cell->get_number_of_velocity_blocks(popID)*WID3; ++i) {
+         density_post_adjust += cell->get_data(popID)[i];
+      }
+      if (density_post_adjust != 0.0) {
+         for (size_t i=0; i<cell->get_number_of_velocity_blocks(popID)*WID3; ++i) {
+            cell->get_data(popID)[i] *= density_pre_adjust/density_post_adjust;
+         }
+      }
+   }
+
+   // Restore the brick order once enough blocks have been appended or moved into holes
+   if (P::blockReorderFraction > 0.0
+       && cell->get_population(popID).blockOrderChanges > P::blockReorderFraction*cell->get_number_of_velocity_blocks(popID)) {
+      cell->order_velocity_blocks(popID);
+   }
 }
 
 /*
@@ -563,7 +931,6 @@ bool adjustVelocityBlocks(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& m
                           const uint popID) {
    phiprof::initializeTimer("re-adjust blocks","Block adjustment");
    phiprof::start("re-adjust blocks");
-   SpatialCell::setCommunicatedSpecies(popID);
    const vector<CellID>& cells = getLocalCells();
 
    phiprof::start("Compute with_content_list");
@@ -573,55 +940,15 @@ bool adjustVelocityBlocks(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& m
       mpiGrid[cells[i]]->update_velocity_block_content_lists(popID);
    }
    phiprof::stop("Compute with_content_list");
-   
-   phiprof::initializeTimer("Transfer with_content_list","MPI");
-   phiprof::start("Transfer with_content_list");
-   SpatialCell::set_mpi_transfer_type(Transfer::VEL_BLOCK_WITH_CONTENT_STAGE1 );
-   mpiGrid.update_copies_of_remote_neighbors(NEAREST_NEIGHBORHOOD_ID);
-   SpatialCell::set_mpi_transfer_type(Transfer::VEL_BLOCK_WITH_CONTENT_STAGE2 );
-   mpiGrid.update_copies_of_remote_neighbors(NEAREST_NEIGHBORHOOD_ID);
-   phiprof::stop("Transfer with_content_list");
+
+   transferContentLists(mpiGrid,popID);
    
    //Adjusts velocity blocks in local spatial cells, doesn't adjust velocity blocks in remote cells.
 
    phiprof::start("Adjusting blocks");
-   #pragma omp parallel for schedule(dynamic)
-   for (size_t i=0; i<cellsToAdjust.size(); ++i) {
-      Real density_pre_adjust=0.0;
-      Real density_post_adjust=0.0;
-      CellID cell_id=cellsToAdjust[i];
-      SpatialCell* cell = mpiGrid[cell_id];
-      
-      // gather spatial neighbor list and create vector with pointers to neighbor spatial cells
-      const auto* neighbors = mpiGrid.get_neighbors_of(cell_id, NEAREST_NEIGHBORHOOD_ID);
-      vector<SpatialCell*> neighbor_ptrs;
-      neighbor_ptrs.reserve(neighbors->size());
-
-      for ( const auto& nbrPair : *neighbors) {
-         CellID neighbor_id = nbrPair.first;
-         if (neighbor_id == 0 || neighbor_id == cell_id) {
-            continue;
-         }
-         neighbor_ptrs.push_back(mpiGrid[neighbor_id]);
-      }
-      if (getObjectWrapper().particleSpecies[popID].sparse_conserve_mass) {
-         for (size_t i=0; i<cell->get_number_of_velocity_blocks(popID)*WID3; ++i) {
-            density_pre_adjust += cell->get_data(popID)[i];
-         }
-      }
-      cell->adjust_velocity_blocks(neighbor_ptrs,popID);
-
-      if (getObjectWrapper().particleSpecies[popID].sparse_conserve_mass) {
-         for (size_t i=0; i<cell->get_number_of_velocity_blocks(popID)*WID3; ++i) {
-            density_post_adjust += cell->get_data(popID)[i];
-         }
-         if (density_post_adjust != 0.0) {
-            for (size_t i=0; i<cell->get_number_of_velocity_blocks(popID)*WID3; ++i) {
-               cell->get_data(popID)[i] *= density_pre_adjust/density_post_adjust;
-            }
-         }
-      }
-   }
+   cellaffinity::forEachCell(mpiGrid, cellsToAdjust, cellaffinity::DYNAMIC, [&](const size_t c) {
+      adjustCellBlocks(mpiGrid,cellsToAdjust[c],popID);
+   });
    phiprof::stop("Adjusting blocks");
 
    //Updated newly adjusted velocity block lists on remote cells, and
@@ -633,6 +960,71 @@ bool adjustVelocityBlocks(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& m
    return true;
 }
 
+/*
+  Adjust the velocity blocks of several populations, overlapping the MPI transfers of one
+  population with the block adjustment of another.
+
+  Further documentation in grid.h
+*/
+void adjustVelocityBlocksOverlapped(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+                                    const vector<uint>& pops,
+                                    const vector<vector<CellID> >& cellsToAdjust,
+                                    const vector<bool>& doPrepareToReceiveBlocks) {
+   phiprof::initializeTimer("re-adjust blocks","Block adjustment");
+   phiprof::start("re-adjust blocks");
+   const vector<CellID>& cells = getLocalCells();
+   const size_t nPops = pops.size();
+
+   // Content lists are per population, so all of them can be computed in one sweep
+   phiprof::start("Compute with_content_list");
+   #pragma omp parallel for schedule(dynamic,1)
+   for (size_t i=0; i<nPops*cells.size(); ++i) {
+      const uint popID = pops[i / cells.size()];
+      SpatialCell* cell = mpiGrid[cells[i % cells.size()]];
+      const double t0 = tasktrace::start();
+      cell->updateSparseMinValue(popID);
+      cell->update_velocity_block_content_lists(popID);
+      tasktrace::record("content lists",popID,t0);
+   }
+   phiprof::stop("Compute with_content_list");
+
+   // Stage k: the master thread transfers the content lists of pops[k] and the adjusted
+   // block lists of pops[k-2], while the other threads adjust pops[k-1]. The transfers are
+   // blocking, so the master joins the adjustment once they are done. Stages are separated
+   // by the implicit barrier at the end of each parallel region.
+   phiprof::start("Adjusting blocks");
+   for (size_t k=0; k<nPops+2; ++k) {
+      #pragma omp parallel
+      {
+         #pragma omp master
+         {
+            if (k < nPops) {
+               const double t0 = tasktrace::start();
+               transferContentLists(mpiGrid,pops[k]);
+               tasktrace::record("transfer content lists",pops[k],t0);
+            }
+            if (k >= 2 && doPrepareToReceiveBlocks[k-2]) {
+               const double t0 = tasktrace::start();
+               updateRemoteVelocityBlockLists(mpiGrid,pops[k-2]);
+               tasktrace::record("transfer block lists",pops[k-2],t0);
+            }
+         }
+         if (k >= 1 && k <= nPops) {
+            const uint popID = pops[k-1];
+            const vector<CellID>& adjust = cellsToAdjust[k-1];
+            #pragma omp for schedule(dynamic,1) nowait
+            for (size_t c=0; c<adjust.size(); ++c) {
+               const double t0 = tasktrace::start();
+               adjustCellBlocks(mpiGrid,adjust[c],popID);
+               tasktrace::record("adjust",popID,t0);
+            }
+         }
+      }
+   }
+   phiprof::stop("Adjusting blocks");
+   phiprof::stop("re-adjust blocks");
+}
+
 /*! Shrink to fit velocity space data to save memory.
  * \param mpiGrid Spatial grid
  */
@@ -705,6 +1097,84 @@ void report_grid_memory_consumption(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Ge
    logFile << writeVerbose;
 }
 
+void update_grid_memory_accounting(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid) {
+   const vector<CellID>& cells = getLocalCells();
+   const std::vector<CellID> remote_cells = mpiGrid.get_remote_cells_on_process_boundary();
+   
+   uint64_t blocks = 0;
+   uint64_t ghosts = 0;
+   uint64_t neighbors = remote_cells.size() * sizeof(SpatialCell);
+   for (size_t i=0; i<cells.size(); ++i) {
+      blocks += mpiGrid[cells[i]]->get_cell_memory_capacity();
+      const auto* nbrs = mpiGrid.get_neighbors_of(cells[i]);
+      if (nbrs != NULL) neighbors += nbrs->capacity() * sizeof((*nbrs)[0]);
+   }
+   for (size_t i=0; i<remote_cells.size(); ++i) {
+      ghosts += mpiGrid[remote_cells[i]]->get_cell_memory_capacity();
+   }
+   
+   set_subsystem_memory(memorysubsystem::VELOCITY_BLOCKS,blocks);
+   set_subsystem_memory(memorysubsystem::GHOST_COPIES,ghosts);
+   set_subsystem_memory(memorysubsystem::NEIGHBOR_BUFFERS,neighbors);
+}
+
+/*! Multiply the sparse thresholds of all populations by the given factor. Cells pick up
+ *  the new value in SpatialCell::updateSparseMinValue during the next block adjustment.
+ */
+static void scaleSparseThresholds(const Real factor) {
+   for (uint popID=0; popID<getObjectWrapper().particleSpecies.size(); ++popID) {
+      species::Species& population = getObjectWrapper().particleSpecies[popID];
+      population.sparseMinValue *= factor;
+      population.sparseDynamicMinValue1 *= factor;
+      population.sparseDynamicMinValue2 *= factor;
+   }
+}
+
+void check_memory_budget(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid) {
+   // Actions taken so far, the decision is identical on all processes
+   static uint sparseRaises = 0;
+   static bool rebalanceRequested = false;
+   static bool restartRequested = false;
+
+   int myRank;
+   MPI_Comm_rank(MPI_COMM_WORLD,&myRank);
+   const double GiB = pow(2,30);
+   
+   update_grid_memory_accounting(mpiGrid);
+   const double nodeMemory = get_max_node_resident_memory();
+   const double usage = nodeMemory / (P::memoryNodeBudget*GiB);
+   
+   if (usage >= P::memoryRestartFraction && restartRequested == false) {
+      logFile << "(MEM) Node memory " << nodeMemory/GiB << " GiB is " << usage*100 << "% of budget, forcing a restart write, tstep = " << P::tstep << endl;
+      if (myRank == MASTER_RANK) globalflags::writeRestart = true;
+      restartRequested = true;
+   }
+   if (usage >= P::memorySparsifyFraction && sparseRaises < P::memoryMaxSparseRaises) {
+      scaleSparseThresholds(P::memorySparseRaiseFactor);
+      ++sparseRaises;
+      logFile << "(MEM) Node memory " << nodeMemory/GiB << " GiB is " << usage*100 << "% of budget, raising sparse thresholds by factor "
+              << P::memorySparseRaiseFactor << " (" << sparseRaises << "/" << P::memoryMaxSparseRaises << "), tstep = " << P::tstep << endl;
+   }
+   if (usage >= P::memoryRebalanceFraction) {
+      if (rebalanceRequested == false) {
+         logFile << "(MEM) Node memory " << nodeMemory/GiB << " GiB is " << usage*100 << "% of budget, requesting early load balance, tstep = " << P::tstep << endl;
+         if (myRank == MASTER_RANK) globalflags::balanceLoad = true;
+         rebalanceRequested = true;
+      }
+   } else {
+      // Memory use has dropped, re-arm the actions and undo the sparse threshold raises one at a time
+      rebalanceRequested = false;
+      restartRequested = false;
+      if (sparseRaises > 0) {
+         scaleSparseThresholds(1.0/P::memorySparseRaiseFactor);
+         --sparseRaises;
+         logFile << "(MEM) Node memory " << nodeMemory/GiB << " GiB is " << usage*100 << "% of budget, lowering sparse thresholds back ("
+                 << sparseRaises << "/" << P::memoryMaxSparseRaises << "), tstep = " << P::tstep << endl;
+      }
+   }
+   logFile << writeVerbose;
+}
+
 /*! Deallocates all block data in remote cells in order to save
  *  memory
  * \param mpiGrid Spatial grid
@@ -55,6 +55,18 @@ void initializeGrids(
 */
 void balanceLoad(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid, SysBoundary& sysBoundaries);
 
+/*!
+  \brief Refine and coarsen spatial cells according to the spatial refinement criterion
+
+  Evaluates AMR.spatial_refinement_criterion in all local cells, refines cells above
+  AMR.spatial_refine_limit and coarsens sibling groups below AMR.spatial_coarsen_limit.
+  Distribution functions are prolongated and restricted conservatively, after which
+  the load is rebalanced. Cells near system boundaries are never modified.
+
+    \param[in,out] mpiGrid The DCCRG grid with spatial cells
+*/
+void adaptRefinement(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid, SysBoundary& sysBoundaries);
+
 /*!
 
 Updates velocity block lists between remote neighbors and
@@ -93,11 +105,40 @@ bool adjustVelocityBlocks(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& m
                           bool doPrepareToReceiveBlocks,
                             const uint popID);
 
+/*! Adjust the velocity blocks of several populations, same as calling adjustVelocityBlocks for
+ each of them in turn, but the content list and block list transfers of one population run on the
+ master thread while the other threads adjust the blocks of the previous population.
+
+ \param mpiGrid  Parallel grid with spatial cells
+ \param pops  Populations to adjust, in the order they are processed
+ \param cellsToAdjust  For each entry of pops, the cells which blocks are added or removed
+ \param doPrepareToReceiveBlocks  For each entry of pops, whether remote cells are set up to receive velocity space data. Has to be the same for all processes.
+*/
+void adjustVelocityBlocksOverlapped(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+                                    const std::vector<uint>& pops,
+                                    const std::vector<std::vector<CellID> >& cellsToAdjust,
+                                    const std::vector<bool>& doPrepareToReceiveBlocks);
+
 /*! Estimates memory consumption and writes it into logfile. Collective operation on MPI_COMM_WORLD
  * \param mpiGrid Spatial grid
  */
 void report_grid_memory_consumption(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid);
 
+/*! Updates the memory accounting of the velocity block, ghost copy and neighbour buffer
+ *  subsystems on this process, see set_subsystem_memory. Local operation.
+ * \param mpiGrid Spatial grid
+ */
+void update_grid_memory_accounting(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid);
+
+/*! Checks the node memory use against memory.node_budget and takes defensive actions
+ *  before running out of memory: an early load balance is requested, the sparse thresholds
+ *  of all populations are raised (and lowered back once memory use has dropped) and finally
+ *  a restart write is forced. Load balance and restart are requested through globalflags, so
+ *  this has to be called before they are evaluated. Collective operation on MPI_COMM_WORLD
+ * \param mpiGrid Spatial grid
+ */
+void check_memory_budget(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid);
+
 /*! Shrink to fit velocity space data to save memory.
  * \param mpiGrid Spatial grid
  */
@@ -38,6 +38,8 @@
 #include "vlsv_reader_parallel.h"
 #include "vlasovmover.h"
 #include "object_wrapper.h"
+#include "control_channel.h"
+#include "telemetry.h"
 
 using namespace std;
 using namespace phiprof;
@@ -46,63 +48,121 @@ extern Logger logFile, diagnostic;
 
 typedef Parameters P;
 
+// Commands received on MASTER_RANK that have to be executed on all processes
+static vector<string> broadcastCommands;
+
 /*!
- * \brief Checks for command files written to the local directory.
- * If a file STOP was written and is readable, then a bailout with restart writing is initiated.
- * If a file KILL was written and is readable, then a bailout without a restart is initiated.
- * If a file SAVE was written and is readable, then restart writing without a bailout is initiated.
- * If a file DOLB was written and is readable, then a new load balancing is initiated.
- * To avoid bailing out upfront on a new run the files are renamed with the date to keep a trace.
- * The function should only be called by MASTER_RANK. This ensures that resetting P::bailout_write_restart works.
+ * \brief Executes an external command on MASTER_RANK.
+ * STOP initiates a bailout with restart writing, KILL a bailout without a restart.
+ * SAVE initiates restart writing without a bailout and DOLB a new load balancing.
+ * OUTPUT, TELEMETRY and PHIPROF act on all processes and are queued for broadcastExternalCommands().
  */
-void checkExternalCommands() {
-   struct stat tempStat;
-   if (stat("STOP", &tempStat) == 0) {
+static void executeExternalCommand(const string& command) {
+   istringstream input(command);
+   string name;
+   input >> name;
+   if (name == "STOP") {
       bailout(true, "Received an external STOP command. Setting bailout.write_restart to true.");
       P::bailout_write_restart = true;
-      char newName[80];
-      // Get the current time.
-      const time_t rawTime = time(NULL);
-      const struct tm * timeInfo = localtime(&rawTime);
-      strftime(newName, 80, "STOP_%F_%H-%M-%S", timeInfo);
-      rename("STOP", newName);
-      return;
-   }
-   if(stat("KILL", &tempStat) == 0) {
+   } else if (name == "KILL") {
       bailout(true, "Received an external KILL command. Setting bailout.write_restart to false.");
       P::bailout_write_restart = false;
-      char newName[80];
-      // Get the current time.
-      const time_t rawTime = time(NULL);
-      const struct tm * timeInfo = localtime(&rawTime);
-      strftime(newName, 80, "KILL_%F_%H-%M-%S", timeInfo);
-      rename("KILL", newName);
-      return;
-   }
-   if(stat("SAVE", &tempStat) == 0) {
+   } else if (name == "SAVE") {
       cerr << "Received an external SAVE command. Writing a restart file." << endl;
       globalflags::writeRestart = true;
-      char newName[80];
-      // Get the current time.
-      const time_t rawTime = time(NULL);
-      const struct tm * timeInfo = localtime(&rawTime);
-      strftime(newName, 80, "SAVE_%F_%H-%M-%S", timeInfo);
-      rename("SAVE", newName);
-      return;
-   }
-   if(stat("DOLB", &tempStat) == 0) {
+   } else if (name == "DOLB") {
       cerr << "Received an external DOLB command. Balancing load." << endl;
       globalflags::balanceLoad = true;
+   } else if (name == "OUTPUT" || name == "TELEMETRY" || name == "PHIPROF") {
+      broadcastCommands.push_back(command);
+   } else {
+      logFile << "(COMMAND): Ignoring unknown external command '" << command << "'" << endl << writeVerbose;
+   }
+}
+
+/*!
+ * \brief Checks for external commands.
+ * If io.control_socket is set, the commands arrive through the control channel and only an atomic
+ * flag is read on steps without commands. Otherwise the local directory is checked for the command
+ * files STOP, KILL, SAVE and DOLB, see executeExternalCommand().
+ * To avoid bailing out upfront on a new run the files are renamed with the date to keep a trace.
+ * The function should only be called by MASTER_RANK. This ensures that resetting P::bailout_write_restart works.
+ */
+void checkExternalCommands() {
+   if (controlchannel::isOpen()) {
+      if (controlchannel::pending() == false) return;
+      const vector<string> commands = controlchannel::receive();
+      for (size_t c=0; c<commands.size(); ++c) {
+         logFile << "(COMMAND): Received '" << commands[c] << "' at tstep = " << P::tstep << endl << writeVerbose;
+         executeExternalCommand(commands[c]);
+      }
+      return;
+   }
+
+   const char* commandFiles[4] = {"STOP","KILL","SAVE","DOLB"};
+   struct stat tempStat;
+   for (int c=0; c<4; ++c) {
+      if (stat(commandFiles[c], &tempStat) != 0) continue;
+      executeExternalCommand(commandFiles[c]);
       char newName[80];
       // Get the current time.
       const time_t rawTime = time(NULL);
       const struct tm * timeInfo = localtime(&rawTime);
-      strftime(newName, 80, "DOLB_%F_%H-%M-%S", timeInfo);
-      rename("DOLB", newName);
+      strftime(newName, 80, "_%F_%H-%M-%S", timeInfo);
+      rename(commandFiles[c], (string(commandFiles[c]) + newName).c_str());
       return;
    }
 }
 
+bool externalCommandsPending() {
+   return broadcastCommands.empty() == false;
+}
+
+/*!
+ * \brief Broadcasts the queued commands from MASTER_RANK and executes them on all processes.
+ * OUTPUT i interval sets the write interval of output class i (io.system_write_t_interval), negative disables it.
+ * TELEMETRY writes a telemetry record at the end of this step.
+ * PHIPROF writes the phiprof profile now.
+ */
+void broadcastExternalCommands() {
+   int myRank;
+   MPI_Comm_rank(MPI_COMM_WORLD,&myRank);
+   string commands;
+   if (myRank == MASTER_RANK) {
+      for (size_t c=0; c<broadcastCommands.size(); ++c) commands += broadcastCommands[c] + "\n";
+      broadcastCommands.clear();
+   }
+   int length = commands.size();
+   MPI_Bcast(&length,1,MPI_INT,MASTER_RANK,MPI_COMM_WORLD);
+   if (length == 0) return;
+   commands.resize(length);
+   MPI_Bcast(&(commands[0]),length,MPI_CHAR,MASTER_RANK,MPI_COMM_WORLD);
+
+   istringstream lines(commands);
+   string line;
+   while (getline(lines,line)) {
+      istringstream input(line);
+      string name;
+      input >> name;
+      if (name == "OUTPUT") {
+         uint index;
+         Real interval;
+         if (!(input >> index >> interval) || index >= P::systemWriteTimeInterval.size()) {
+            logFile << "(COMMAND): Usage is OUTPUT <class index> <interval>, ignoring '" << line << "'" << endl << writeVerbose;
+            continue;
+         }
+         P::systemWriteTimeInterval[index] = interval;
+         // The file index is the simulation time in units of the interval, continue from the next one
+         if (interval > 0.0) P::systemWrites[index] = (int)(P::t/interval) + 1;
+         logFile << "(COMMAND): Output class " << P::systemWriteName[index] << " is now written every " << interval << " s" << endl << writeVerbose;
+      } else if (name == "TELEMETRY") {
+         telemetry::requestRecord();
+      } else if (name == "PHIPROF") {
+         phiprof::print(MPI_COMM_WORLD,"phiprof");
+      }
+   }
+}
+
 /*!
   \brief Collective exit on error functions
 
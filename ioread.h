@@ -44,9 +44,19 @@ bool readGrid(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
 
 
 /*!
- * \brief Check in local directory for external commands passed to the simulation. Only executed by MASTER_RANK
+ * \brief Check the control channel, or the local directory, for external commands passed to the simulation. Only executed by MASTER_RANK
  */
 void checkExternalCommands();
 
+/*!
+ * \brief Returns true if MASTER_RANK has received commands that have to be passed to broadcastExternalCommands
+ */
+bool externalCommandsPending();
+
+/*!
+ * \brief Broadcast the pending external commands from MASTER_RANK and execute them. Collective operation on MPI_COMM_WORLD
+ */
+void broadcastExternalCommands();
+
 
 #endif
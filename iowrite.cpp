@@ -40,6 +40,7 @@
 #include "phiprof.hpp"
 #include "parameters.h"
 #include "logger.h"
+#include "memoryallocation.h"
 #include "vlasovmover.h"
 #include "object_wrapper.h"
 
@@ -255,7 +256,7 @@ bool writeVelocityDistributionData(const uint popID,Writer& vlsvWriter,
    attribs["name"] = popName;      // Name of the velocity space distribution is written avgs
    const string datatype_avgs = "float";
    const uint64_t arraySize_avgs = totalBlocks;
-   const uint64_t vectorSize_avgs = WID3; // There are 64 elements in every velocity block
+   const uint64_t vectorSize_avgs = WID3; // There are WID3 elements in every velocity block
 
    // Get the data size needed for writing in data
    uint64_t dataSize_avgs = sizeof(Realf);
@@ -273,7 +274,7 @@ bool writeVelocityDistributionData(const uint popID,Writer& vlsvWriter,
       char* arrayToWrite = reinterpret_cast<char*>(SC->get_data(popID));
 
       // Add a subarray to write
-      vlsvWriter.addMultiwriteUnit(arrayToWrite, arrayElements); // Note: We told beforehands that the vectorsize = WID3 = 64
+      vlsvWriter.addMultiwriteUnit(arrayToWrite, arrayElements); // Note: We told beforehands that the vectorsize = WID3
    }
    if (cells.size() == 0) {
       vlsvWriter.addMultiwriteUnit(NULL, 0); //Dummy write to avoid hang in end multiwrite
@@ -1065,6 +1066,7 @@ bool writeGrid(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
    }
    
    vlsvWriter.setBuffer(P::vlsvBufferSize);
+   set_subsystem_memory(memorysubsystem::IO_BUFFERS,P::vlsvBufferSize);
 
    phiprof::start("metadataIO");
 
@@ -1159,6 +1161,7 @@ bool writeGrid(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
 
    phiprof::start("close");
    vlsvWriter.close();
+   set_subsystem_memory(memorysubsystem::IO_BUFFERS,0);
    phiprof::stop("close");
    phiprof::stop("writeGrid-reduced",bytesWritten*1e-9,"GB");
    return success;
@@ -1247,6 +1250,7 @@ bool writeRestart(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
    phiprof::stop("open");
 
    vlsvWriter.setBuffer(P::vlsvBufferSize);
+   set_subsystem_memory(memorysubsystem::IO_BUFFERS,P::vlsvBufferSize);
 
    phiprof::start("metadataIO");
    
@@ -1372,6 +1376,7 @@ bool writeRestart(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
 
    phiprof::start("close");
    vlsvWriter.close();
+   set_subsystem_memory(memorysubsystem::IO_BUFFERS,0);
    phiprof::stop("close");
 
    phiprof::start("updateRemoteBlocks");
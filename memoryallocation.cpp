@@ -23,12 +23,14 @@
 #include <string.h>
 #include <iostream>
 #include <math.h>
+#include <algorithm>
 #include <unordered_map> // for hasher
 #include <limits>
 #include "logger.h"
 #include "memoryallocation.h"
 #include "common.h"
 #include "parameters.h"
+#include "block_pool.h"
 #ifdef PAPI_MEM
 #include "papi.h" 
 #endif 
@@ -186,3 +188,92 @@ void report_process_memory_consumption(){
 
 
 
+static uint64_t subsystemMemory[memorysubsystem::N_SUBSYSTEMS] = {0};
+static uint64_t subsystemHighWater[memorysubsystem::N_SUBSYSTEMS] = {0};
+
+void set_subsystem_memory(const memorysubsystem::Type subsystem,const uint64_t bytes) {
+   subsystemMemory[subsystem] = bytes;
+   subsystemHighWater[subsystem] = max(subsystemHighWater[subsystem],bytes);
+}
+
+/*! Return the resident set size of this process in bytes (0 if not available)*/
+uint64_t get_process_resident_memory() {
+   uint64_t resident = 0;
+   FILE * in_file = fopen("/proc/self/status", "r");
+   if (in_file == NULL) return resident;
+   char line[256];
+   while (fgets(line, sizeof(line), in_file) != NULL) {
+      unsigned long long memory;
+      // VmRSS is given in kB, transform to B
+      if (sscanf(line, "VmRSS: %llu", &memory) == 1) {
+         resident = (uint64_t)memory * 1024;
+         break;
+      }
+   }
+   fclose(in_file);
+   return resident;
+}
+
+/*! Return the largest resident memory of any node in bytes. Collective operation on MPI_COMM_WORLD.
+ * The intra-node communicator is created on the first call and reused afterwards.
+ */
+double get_max_node_resident_memory() {
+   static MPI_Comm nodeComm = MPI_COMM_NULL;
+   if (nodeComm == MPI_COMM_NULL) {
+      char nodename[MPI_MAX_PROCESSOR_NAME];
+      int namelength, rank;
+      hash<string> hasher;
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      MPI_Get_processor_name(nodename,&namelength);
+      const int nodehash=(int)(hasher(string(nodename)) % std::numeric_limits<int>::max());
+      MPI_Comm_split(MPI_COMM_WORLD, nodehash, rank, &nodeComm);
+   }
+
+   double resident = (double)get_process_resident_memory();
+   double nodeResident;
+   double maxNodeResident;
+   MPI_Allreduce(&resident, &nodeResident, 1, MPI_DOUBLE, MPI_SUM, nodeComm);
+   MPI_Allreduce(&nodeResident, &maxNodeResident, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+   return maxNodeResident;
+}
+
+/*! Writes the current and high-water memory use of each subsystem into logfile. Collective operation on MPI_COMM_WORLD
+ */
+void report_subsystem_memory_consumption() {
+   const int N = memorysubsystem::N_SUBSYSTEMS;
+   const char* names[N] = {"velocity blocks","ghost copies","neighbour buffers","fsgrid","I/O buffers"};
+   const double GiB = pow(2,30);
+   int nProcs;
+   MPI_Comm_size(MPI_COMM_WORLD, &nProcs);
+
+   // Current use followed by high-water marks, reduced in one go
+   double mem[2*N];
+   double sum_mem[2*N];
+   double max_mem[2*N];
+   for (int i=0; i<N; ++i) {
+      mem[i]   = subsystemMemory[i];
+      mem[N+i] = subsystemHighWater[i];
+   }
+   MPI_Reduce(mem, sum_mem, 2*N, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+   MPI_Reduce(mem, max_mem, 2*N, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+   logFile << "(MEM) Per-process memory by subsystem in GiB (avg, max / high water avg, max):" << endl;
+   for (int i=0; i<N; ++i) {
+      logFile << "(MEM)   " << names[i] << ": " << sum_mem[i]/nProcs/GiB << " " << max_mem[i]/GiB
+              << " / " << sum_mem[N+i]/nProcs/GiB << " " << max_mem[N+i]/GiB << endl;
+   }
+
+   #ifdef USE_BLOCK_POOL
+   // Mapped memory of the block pool and the number of mmap calls and shared list
+   // refills since the previous report, which stay small once the pool has warmed up
+   const blockpool::Statistics stats = blockpool::getStatistics();
+   double pool[4] = {(double)stats.slabBytes,(double)stats.largeBytes,(double)stats.mapCalls,(double)stats.centralRefills};
+   double max_pool[4];
+   MPI_Reduce(pool, max_pool, 4, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+   logFile << "(MEM) Block pool max per process: " << max_pool[0]/GiB << " GiB slabs, " << max_pool[1]/GiB << " GiB large mappings, "
+           << max_pool[2] << " mmap calls, " << max_pool[3] << " refills since last report";
+   if (stats.hugeTLB) logFile << (stats.hugeTLBFailed ? ", MAP_HUGETLB failed on rank 0, using THP" : ", MAP_HUGETLB");
+   logFile << endl;
+   #endif
+   logFile << writeVerbose;
+}
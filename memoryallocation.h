@@ -37,6 +37,36 @@ uint64_t get_node_free_memory();
  */
 void report_process_memory_consumption();
 
+/*! Subsystems whose memory use is accounted separately.*/
+namespace memorysubsystem {
+   enum Type {
+      VELOCITY_BLOCKS,  /*!< Velocity meshes and block containers of local cells.*/
+      GHOST_COPIES,     /*!< Velocity meshes and block containers of remote (ghost) cells.*/
+      NEIGHBOR_BUFFERS, /*!< Remote cell objects and neighbour lists of the spatial grid.*/
+      FSGRID,           /*!< Field solver grids including ghost layers.*/
+      IO_BUFFERS,       /*!< VLSV writer buffers.*/
+      N_SUBSYSTEMS
+   };
+}
+
+/*! Set the current memory use of a subsystem on this process in bytes. The high-water
+ *  mark of each subsystem is updated as well.
+ */
+void set_subsystem_memory(const memorysubsystem::Type subsystem,const uint64_t bytes);
+
+/*! Return the resident set size of this process in bytes (0 if not available)*/
+uint64_t get_process_resident_memory();
+
+/*! Return the largest resident memory of any node in bytes, i.e. the per-node sum of
+ *  get_process_resident_memory. Collective operation on MPI_COMM_WORLD.
+ */
+double get_max_node_resident_memory();
+
+/*! Writes the current and high-water memory use of each subsystem into logfile
+ *  (average and maximum over processes). Collective operation on MPI_COMM_WORLD
+ */
+void report_subsystem_memory_consumption();
+
 /*! Alligned malloc, could be done using aligned_alloc*/
 inline void * aligned_malloc(size_t size,std::size_t align) {
    /* Allocate necessary memory area
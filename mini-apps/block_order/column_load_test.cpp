@@ -0,0 +1,116 @@
+/*
+ * Benchmark of the column loads of the semi-Lagrangian acceleration for different
+ * storage orders of the velocity blocks (vlasovsolver.blockReorderFraction).
+ *
+ * A Maxwellian velocity distribution is represented by the blocks inside a sphere. For
+ * each sweep dimension the blocks are sorted into columns as in sortBlocklistByDimension,
+ * and the data of every block is gathered in column order through a global to local ID
+ * map and then overwritten, as loadColumnBlockData does. The block storage order is one of
+ *   insertion  random order, as left by many block additions and removals
+ *   id         global ID order, as after creating the blocks of a new cell
+ *   brick      Morton order of the block indices (SpatialCell::order_velocity_blocks)
+ *
+ * Usage: column_load_test [radius in blocks (30)] [repetitions (20)]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+static const int WID = 4;
+static const int WID3 = WID*WID*WID;
+static const uint32_t GRID = 200; // blocks per dimension of the velocity mesh
+
+static inline uint32_t spreadBlockIndex(uint32_t x) {
+   x &= 0x3ff;
+   x = (x | x << 16) & 0x30000ff;
+   x = (x | x << 8)  & 0x300f00f;
+   x = (x | x << 4)  & 0x30c30c3;
+   x = (x | x << 2)  & 0x9249249;
+   return x;
+}
+
+struct Store {
+   std::vector<uint32_t> globalIDs;                // local ID -> global ID
+   std::unordered_map<uint32_t,uint32_t> localIDs; // global ID -> local ID
+   std::vector<float> data;
+};
+
+static void build(Store& store,const std::vector<uint32_t>& order) {
+   store.globalIDs = order;
+   store.localIDs.clear();
+   for (uint32_t b=0; b<order.size(); ++b) store.localIDs[order[b]] = b;
+   store.data.assign(order.size()*WID3,1.0f);
+}
+
+/*! Global ID with the sweep dimension as the fastest index, the key sortBlocklistByDimension sorts by.*/
+static inline uint32_t columnKey(const uint32_t gid,const int dimension) {
+   const uint32_t i = gid % GRID;
+   const uint32_t j = (gid / GRID) % GRID;
+   const uint32_t k = gid / (GRID*GRID);
+   if (dimension == 0) return gid;
+   if (dimension == 1) return j + i*GRID + k*GRID*GRID;
+   return k + j*GRID + i*GRID*GRID;
+}
+
+/*! Gather all blocks in column order along dimension, return seconds.*/
+static double loadColumns(Store& store,const int dimension,std::vector<float>& values) {
+   std::vector<std::pair<uint32_t,uint32_t> > sorted(store.globalIDs.size());
+   for (uint32_t b=0; b<store.globalIDs.size(); ++b) sorted[b] = std::make_pair(columnKey(store.globalIDs[b],dimension),store.globalIDs[b]);
+   std::sort(sorted.begin(),sorted.end());
+
+   const auto start = std::chrono::steady_clock::now();
+   values.resize(sorted.size()*WID3);
+   for (size_t b=0; b<sorted.size(); ++b) {
+      float* data = store.data.data() + store.localIDs[sorted[b].second]*WID3;
+      // Transposed gather so that the sweep dimension is the slowest index
+      for (int k=0; k<WID; ++k) for (int j=0; j<WID; ++j) for (int i=0; i<WID; ++i) {
+         const int cell = dimension == 0 ? k + j*WID + i*WID*WID : (dimension == 1 ? i + k*WID + j*WID*WID : i + j*WID + k*WID*WID);
+         values[b*WID3 + i + j*WID + k*WID*WID] = data[cell];
+      }
+      for (int c=0; c<WID3; ++c) data[c] = 1.0f;
+   }
+   return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc,char* argv[]) {
+   const int radius = argc > 1 ? atoi(argv[1]) : 30;
+   const int repetitions = argc > 2 ? atoi(argv[2]) : 20;
+
+   std::vector<uint32_t> blocks;
+   const int c = GRID/2;
+   for (uint32_t k=0; k<GRID; ++k) for (uint32_t j=0; j<GRID; ++j) for (uint32_t i=0; i<GRID; ++i) {
+      const int di = (int)i-c, dj = (int)j-c, dk = (int)k-c;
+      if (di*di + dj*dj + dk*dk <= radius*radius) blocks.push_back(i + j*GRID + k*GRID*GRID);
+   }
+   printf("%zu blocks, %.1f MiB of block data\n",blocks.size(),blocks.size()*WID3*sizeof(float)/1048576.0);
+
+   std::vector<uint32_t> insertion(blocks);
+   std::shuffle(insertion.begin(),insertion.end(),std::mt19937(12345));
+   std::vector<uint32_t> brick(blocks);
+   std::sort(brick.begin(),brick.end(),[](const uint32_t a,const uint32_t b) {
+      const uint64_t ka = spreadBlockIndex(a%GRID) | spreadBlockIndex((a/GRID)%GRID) << 1 | (uint64_t)spreadBlockIndex(a/(GRID*GRID)) << 2;
+      const uint64_t kb = spreadBlockIndex(b%GRID) | spreadBlockIndex((b/GRID)%GRID) << 1 | (uint64_t)spreadBlockIndex(b/(GRID*GRID)) << 2;
+      return ka < kb;
+   });
+
+   const char* names[3] = {"insertion","id","brick"};
+   const std::vector<uint32_t>* orders[3] = {&insertion,&blocks,&brick};
+   std::vector<float> values;
+   printf("%-10s %12s %12s %12s  (ms per sweep)\n","order","x","y","z");
+   for (int o=0; o<3; ++o) {
+      Store store;
+      build(store,*orders[o]);
+      double best[3] = {1e30,1e30,1e30};
+      for (int r=0; r<repetitions; ++r) {
+         for (int d=0; d<3; ++d) best[d] = std::min(best[d],loadColumns(store,d,values));
+      }
+      printf("%-10s %12.3f %12.3f %12.3f\n",names[o],1e3*best[0],1e3*best[1],1e3*best[2]);
+   }
+   return 0;
+}
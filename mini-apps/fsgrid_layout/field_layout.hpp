@@ -0,0 +1,89 @@
+/*
+ * This file is part of Vlasiator.
+ * Copyright 2010-2016 Finnish Meteorological Institute
+ *
+ * For details of usage, see the COPYING file and read the "Rules of the Road"
+ * at http://www.physics.helsinki.fi/vlasiator/
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef FIELD_LAYOUT_HPP
+#define FIELD_LAYOUT_HPP
+
+#include <cstdlib>
+#include <vector>
+
+#include "../../definitions.h"
+
+/*! Storage of an N-component field on a local block of fsgrid cells with a ghost
+ * layer of width STENCIL, in the same array-of-structs layout as
+ * FsGrid< std::array<Real,N>, 2>: all components of one cell are contiguous.
+ */
+template<int N, int STENCIL=2> class FieldAoS {
+ public:
+   FieldAoS(cint nx,cint ny,cint nz): nx(nx),ny(ny),nz(nz),
+      sx(nx+2*STENCIL),sy(ny+2*STENCIL),data(N*(size_t)sx*sy*(nz+2*STENCIL),0.0) { }
+
+   /*! Component c of cell (i,j,k), ghost cells are at -STENCIL..-1 and n..n+STENCIL-1.*/
+   inline Real& operator()(cint c,cint i,cint j,cint k) {
+      return data[N*cellIndex(i,j,k) + c];
+   }
+   inline Real operator()(cint c,cint i,cint j,cint k) const {
+      return data[N*cellIndex(i,j,k) + c];
+   }
+   static const char* name() {return "AoS";}
+
+ private:
+   inline size_t cellIndex(cint i,cint j,cint k) const {
+      return (i+STENCIL) + (size_t)sx*((j+STENCIL) + (size_t)sy*(k+STENCIL));
+   }
+   const int nx,ny,nz,sx,sy;
+   std::vector<Real> data;
+};
+
+/*! Storage of an N-component field in structure-of-arrays layout: every component
+ * is a separate contiguous 3D array, so a kernel reading two of the N components
+ * only streams those two arrays. Same interface as FieldAoS.
+ */
+template<int N, int STENCIL=2> class FieldSoA {
+ public:
+   FieldSoA(cint nx,cint ny,cint nz): nx(nx),ny(ny),nz(nz),
+      sx(nx+2*STENCIL),sy(ny+2*STENCIL),nCells((size_t)sx*sy*(nz+2*STENCIL)),data(N*nCells,0.0) { }
+
+   inline Real& operator()(cint c,cint i,cint j,cint k) {
+      return data[c*nCells + cellIndex(i,j,k)];
+   }
+   inline Real operator()(cint c,cint i,cint j,cint k) const {
+      return data[c*nCells + cellIndex(i,j,k)];
+   }
+   static const char* name() {return "SoA";}
+
+ private:
+   inline size_t cellIndex(cint i,cint j,cint k) const {
+      return (i+STENCIL) + (size_t)sx*((j+STENCIL) + (size_t)sy*(k+STENCIL));
+   }
+   const int nx,ny,nz,sx,sy;
+   const size_t nCells;
+   std::vector<Real> data;
+};
+
+// Layout used by the benchmark, selected at build time
+#ifdef FS_LAYOUT_SOA
+template<int N> struct Field {typedef FieldSoA<N> type;};
+#else
+template<int N> struct Field {typedef FieldAoS<N> type;};
+#endif
+
+#endif
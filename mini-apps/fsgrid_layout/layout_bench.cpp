@@ -0,0 +1,241 @@
+/*
+ * This file is part of Vlasiator.
+ * Copyright 2010-2016 Finnish Meteorological Institute
+ *
+ * For details of usage, see the COPYING file and read the "Rules of the Road"
+ * at http://www.physics.helsinki.fi/vlasiator/
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/* Bandwidth benchmark of the five field solver stages (derivatives, Hall term,
+ * electric field, magnetic field propagation, volume averages) with the fsgrid
+ * field quantities stored either as array-of-structs (as FsGrid does) or as
+ * structure-of-arrays. The kernels touch the same components with the same
+ * stencils as the solver in fieldsolver/, with simplified arithmetic.
+ *
+ * Build both variants with make, then run e.g.
+ *    ./layout_bench_aos 100 100 100 20
+ *    ./layout_bench_soa 100 100 100 20
+ * The reported bandwidth counts every component read or written once per cell,
+ * so the ratio of the two runs shows how much of the AoS traffic is unused data.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <omp.h>
+
+#include "../../common.h"
+#include "field_layout.hpp"
+
+using namespace fsgrids;
+
+typedef Field<N_BFIELD>::type BField;
+typedef Field<N_EFIELD>::type EField;
+typedef Field<N_EHALL>::type EHallField;
+typedef Field<N_MOMENTS>::type MomentsField;
+typedef Field<N_DPERB>::type DPerBField;
+typedef Field<N_DMOMENTS>::type DMomentsField;
+typedef Field<N_BGB>::type BgBField;
+typedef Field<N_VOL>::type VolField;
+
+static inline Real limiter(creal& left,creal& cent,creal& rght) {
+   const Real forw = rght-cent;
+   const Real back = cent-left;
+   if (forw*back <= 0.0) return 0.0;
+   const Real cnt = 0.5*(rght-left);
+   Real minimum = std::min(2.0*std::fabs(forw),2.0*std::fabs(back));
+   minimum = std::min(minimum,(Real)std::fabs(cnt));
+   return cnt > 0.0 ? minimum : -minimum;
+}
+
+struct Grids {
+   Grids(cint nx,cint ny,cint nz): perB(nx,ny,nz),E(nx,ny,nz),EHall(nx,ny,nz),moments(nx,ny,nz),
+      dPerB(nx,ny,nz),dMoments(nx,ny,nz),BgB(nx,ny,nz),vol(nx,ny,nz) { }
+   BField perB;
+   EField E;
+   EHallField EHall;
+   MomentsField moments;
+   DPerBField dPerB;
+   DMomentsField dMoments;
+   BgBField BgB;
+   VolField vol;
+};
+
+void initialize(Grids& g,cint nx,cint ny,cint nz) {
+   #pragma omp parallel for collapse(2)
+   for (int k=-2; k<nz+2; k++) for (int j=-2; j<ny+2; j++) for (int i=-2; i<nx+2; i++) {
+      const Real x = 0.1*i, y = 0.07*j, z = 0.05*k;
+      for (int c=0; c<N_BFIELD; c++) g.perB(c,i,j,k) = 1e-9*std::sin(x+c)*std::cos(y-z);
+      for (int c=0; c<N_MOMENTS; c++) g.moments(c,i,j,k) = 1e6*(2.0+std::sin(x*(c+1)+y+z));
+      for (int c=0; c<N_BGB; c++) g.BgB(c,i,j,k) = 1e-8*std::cos(x+y*c);
+      for (int c=0; c<N_EFIELD; c++) g.E(c,i,j,k) = 1e-3*std::sin(x-y+c);
+   }
+}
+
+// Stage 1: face derivatives of perturbed B and moments (calculateDerivatives)
+void derivatives(Grids& g,cint nx,cint ny,cint nz) {
+   #pragma omp parallel for collapse(2)
+   for (int k=0; k<nz; k++) for (int j=0; j<ny; j++) for (int i=0; i<nx; i++) {
+      const int d[3][3] = {{1,0,0},{0,1,0},{0,0,1}};
+      for (int dir=0; dir<3; dir++) {
+         cint il=i-d[dir][0], jl=j-d[dir][1], kl=k-d[dir][2];
+         cint ir=i+d[dir][0], jr=j+d[dir][1], kr=k+d[dir][2];
+         g.dMoments(drhomdx+dir,i,j,k) = limiter(g.moments(RHOM,il,jl,kl),g.moments(RHOM,i,j,k),g.moments(RHOM,ir,jr,kr));
+         g.dMoments(drhoqdx+dir,i,j,k) = limiter(g.moments(RHOQ,il,jl,kl),g.moments(RHOQ,i,j,k),g.moments(RHOQ,ir,jr,kr));
+         g.dMoments(dp11dx+dir,i,j,k)  = limiter(g.moments(P_11,il,jl,kl),g.moments(P_11,i,j,k),g.moments(P_11,ir,jr,kr));
+         g.dMoments(dp22dx+dir,i,j,k)  = limiter(g.moments(P_22,il,jl,kl),g.moments(P_22,i,j,k),g.moments(P_22,ir,jr,kr));
+         g.dMoments(dp33dx+dir,i,j,k)  = limiter(g.moments(P_33,il,jl,kl),g.moments(P_33,i,j,k),g.moments(P_33,ir,jr,kr));
+         g.dMoments(dVxdx+dir,i,j,k)   = limiter(g.moments(VX,il,jl,kl),g.moments(VX,i,j,k),g.moments(VX,ir,jr,kr));
+         g.dMoments(dVydx+dir,i,j,k)   = limiter(g.moments(VY,il,jl,kl),g.moments(VY,i,j,k),g.moments(VY,ir,jr,kr));
+         g.dMoments(dVzdx+dir,i,j,k)   = limiter(g.moments(VZ,il,jl,kl),g.moments(VZ,i,j,k),g.moments(VZ,ir,jr,kr));
+      }
+      g.dPerB(dPERBydx,i,j,k) = limiter(g.perB(PERBY,i-1,j,k),g.perB(PERBY,i,j,k),g.perB(PERBY,i+1,j,k));
+      g.dPerB(dPERBzdx,i,j,k) = limiter(g.perB(PERBZ,i-1,j,k),g.perB(PERBZ,i,j,k),g.perB(PERBZ,i+1,j,k));
+      g.dPerB(dPERBxdy,i,j,k) = limiter(g.perB(PERBX,i,j-1,k),g.perB(PERBX,i,j,k),g.perB(PERBX,i,j+1,k));
+      g.dPerB(dPERBzdy,i,j,k) = limiter(g.perB(PERBZ,i,j-1,k),g.perB(PERBZ,i,j,k),g.perB(PERBZ,i,j+1,k));
+      g.dPerB(dPERBxdz,i,j,k) = limiter(g.perB(PERBX,i,j,k-1),g.perB(PERBX,i,j,k),g.perB(PERBX,i,j,k+1));
+      g.dPerB(dPERBydz,i,j,k) = limiter(g.perB(PERBY,i,j,k-1),g.perB(PERBY,i,j,k),g.perB(PERBY,i,j,k+1));
+   }
+}
+
+// Stage 2: Hall term on the cell edges (calculateHallTerm)
+void hallTerm(Grids& g,cint nx,cint ny,cint nz) {
+   #pragma omp parallel for collapse(2)
+   for (int k=0; k<nz; k++) for (int j=0; j<ny; j++) for (int i=0; i<nx; i++) {
+      const Real rhoq = std::max(g.moments(RHOQ,i,j,k),(Real)1e-10);
+      const Real Bx = g.perB(PERBX,i,j,k) + g.BgB(BGBX,i,j,k);
+      const Real By = g.perB(PERBY,i,j,k) + g.BgB(BGBY,i,j,k);
+      const Real Bz = g.perB(PERBZ,i,j,k) + g.BgB(BGBZ,i,j,k);
+      const Real Jx = g.dPerB(dPERBzdy,i,j,k) - g.dPerB(dPERBydz,i,j,k);
+      const Real Jy = g.dPerB(dPERBxdz,i,j,k) - g.dPerB(dPERBzdx,i,j,k);
+      const Real Jz = g.dPerB(dPERBydx,i,j,k) - g.dPerB(dPERBxdy,i,j,k);
+      const Real EX = (Jy*Bz - Jz*By)/rhoq;
+      const Real EY = (Jz*Bx - Jx*Bz)/rhoq;
+      const Real EZ = (Jx*By - Jy*Bx)/rhoq;
+      g.EHall(EXHALL_000_100,i,j,k) = EX; g.EHall(EXHALL_010_110,i,j,k) = EX;
+      g.EHall(EXHALL_001_101,i,j,k) = EX; g.EHall(EXHALL_011_111,i,j,k) = EX;
+      g.EHall(EYHALL_000_010,i,j,k) = EY; g.EHall(EYHALL_100_110,i,j,k) = EY;
+      g.EHall(EYHALL_001_011,i,j,k) = EY; g.EHall(EYHALL_101_111,i,j,k) = EY;
+      g.EHall(EZHALL_000_001,i,j,k) = EZ; g.EHall(EZHALL_100_101,i,j,k) = EZ;
+      g.EHall(EZHALL_010_011,i,j,k) = EZ; g.EHall(EZHALL_110_111,i,j,k) = EZ;
+   }
+}
+
+// Stage 3: upwinded edge electric field, averaged over the four cells sharing the edge (calculateEdgeElectricField*)
+void electricField(Grids& g,cint nx,cint ny,cint nz) {
+   #pragma omp parallel for collapse(2)
+   for (int k=0; k<nz; k++) for (int j=0; j<ny; j++) for (int i=0; i<nx; i++) {
+      Real Ex = 0.0, Ey = 0.0, Ez = 0.0;
+      for (int a=0; a<2; a++) for (int b=0; b<2; b++) {
+         // x-edge shared by (j-a,k-b), y-edge by (i-a,k-b), z-edge by (i-a,j-b)
+         Ex += g.moments(VZ,i,j-a,k-b)*(g.perB(PERBY,i,j-a,k-b)+g.BgB(BGBY,i,j-a,k-b)
+             + b*g.dPerB(dPERBydz,i,j-a,k-b))
+             - g.moments(VY,i,j-a,k-b)*(g.perB(PERBZ,i,j-a,k-b)+g.BgB(BGBZ,i,j-a,k-b)
+             + a*g.dPerB(dPERBzdy,i,j-a,k-b));
+         Ey += g.moments(VX,i-a,j,k-b)*(g.perB(PERBZ,i-a,j,k-b)+g.BgB(BGBZ,i-a,j,k-b)
+             + a*g.dPerB(dPERBzdx,i-a,j,k-b))
+             - g.moments(VZ,i-a,j,k-b)*(g.perB(PERBX,i-a,j,k-b)+g.BgB(BGBX,i-a,j,k-b)
+             + b*g.dPerB(dPERBxdz,i-a,j,k-b));
+         Ez += g.moments(VY,i-a,j-b,k)*(g.perB(PERBX,i-a,j-b,k)+g.BgB(BGBX,i-a,j-b,k)
+             + b*g.dPerB(dPERBxdy,i-a,j-b,k))
+             - g.moments(VX,i-a,j-b,k)*(g.perB(PERBY,i-a,j-b,k)+g.BgB(BGBY,i-a,j-b,k)
+             + a*g.dPerB(dPERBydx,i-a,j-b,k));
+      }
+      g.E(EX,i,j,k) = 0.25*Ex + g.EHall(EXHALL_000_100,i,j,k);
+      g.E(EY,i,j,k) = 0.25*Ey + g.EHall(EYHALL_000_010,i,j,k);
+      g.E(EZ,i,j,k) = 0.25*Ez + g.EHall(EZHALL_000_001,i,j,k);
+   }
+}
+
+// Stage 4: Faraday's law on the cell faces (propagateMagneticField)
+void magneticField(Grids& g,cint nx,cint ny,cint nz,creal dt) {
+   #pragma omp parallel for collapse(2)
+   for (int k=0; k<nz; k++) for (int j=0; j<ny; j++) for (int i=0; i<nx; i++) {
+      g.perB(PERBX,i,j,k) += dt*(g.E(EY,i,j,k+1) - g.E(EY,i,j,k) + g.E(EZ,i,j,k) - g.E(EZ,i,j+1,k));
+      g.perB(PERBY,i,j,k) += dt*(g.E(EZ,i+1,j,k) - g.E(EZ,i,j,k) + g.E(EX,i,j,k) - g.E(EX,i,j,k+1));
+      g.perB(PERBZ,i,j,k) += dt*(g.E(EX,i,j+1,k) - g.E(EX,i,j,k) + g.E(EY,i,j,k) - g.E(EY,i+1,j,k));
+   }
+}
+
+// Stage 5: volume averaged fields and their derivatives (calculateVolumeAveragedFields)
+void volumeAverages(Grids& g,cint nx,cint ny,cint nz) {
+   #pragma omp parallel for collapse(2)
+   for (int k=0; k<nz; k++) for (int j=0; j<ny; j++) for (int i=0; i<nx; i++) {
+      g.vol(PERBXVOL,i,j,k) = 0.5*(g.perB(PERBX,i,j,k) + g.perB(PERBX,i+1,j,k));
+      g.vol(PERBYVOL,i,j,k) = 0.5*(g.perB(PERBY,i,j,k) + g.perB(PERBY,i,j+1,k));
+      g.vol(PERBZVOL,i,j,k) = 0.5*(g.perB(PERBZ,i,j,k) + g.perB(PERBZ,i,j,k+1));
+      g.vol(dPERBXVOLdy,i,j,k) = 0.5*(g.dPerB(dPERBxdy,i,j,k) + g.dPerB(dPERBxdy,i+1,j,k));
+      g.vol(dPERBXVOLdz,i,j,k) = 0.5*(g.dPerB(dPERBxdz,i,j,k) + g.dPerB(dPERBxdz,i+1,j,k));
+      g.vol(dPERBYVOLdx,i,j,k) = 0.5*(g.dPerB(dPERBydx,i,j,k) + g.dPerB(dPERBydx,i,j+1,k));
+      g.vol(dPERBYVOLdz,i,j,k) = 0.5*(g.dPerB(dPERBydz,i,j,k) + g.dPerB(dPERBydz,i,j+1,k));
+      g.vol(dPERBZVOLdx,i,j,k) = 0.5*(g.dPerB(dPERBzdx,i,j,k) + g.dPerB(dPERBzdx,i,j,k+1));
+      g.vol(dPERBZVOLdy,i,j,k) = 0.5*(g.dPerB(dPERBzdy,i,j,k) + g.dPerB(dPERBzdy,i,j,k+1));
+   }
+}
+
+int main(int argn,char* args[]) {
+   if (argn < 4) {
+      fprintf(stderr,"Usage: %s nx ny nz [repetitions]\n",args[0]);
+      return 1;
+   }
+   cint nx = atoi(args[1]);
+   cint ny = atoi(args[2]);
+   cint nz = atoi(args[3]);
+   cint reps = argn > 4 ? atoi(args[4]) : 10;
+   const double nCells = (double)nx*ny*nz;
+
+   Grids g(nx,ny,nz);
+   initialize(g,nx,ny,nz);
+
+   // Components read + written per cell by each stage, each counted once
+   const char* stageNames[5] = {"derivatives","hall term","electric field","magnetic field","volume averages"};
+   cint components[5] = {
+      8+3 + 24+6,    // moments, perB -> dMoments, dPerB
+      1+3+3+6 + 12,  // RHOQ, perB, BgB, dPerB -> EHall
+      3+3+3+6+3 + 3, // V, perB, BgB, dPerB, EHall -> E
+      3+3 + 3,       // E, perB -> perB
+      3+6 + 9        // perB, dPerB -> vol
+   };
+   double times[5] = {0.0,0.0,0.0,0.0,0.0};
+
+   for (int r=0; r<reps+1; r++) {
+      double t[6];
+      t[0] = omp_get_wtime(); derivatives(g,nx,ny,nz);
+      t[1] = omp_get_wtime(); hallTerm(g,nx,ny,nz);
+      t[2] = omp_get_wtime(); electricField(g,nx,ny,nz);
+      t[3] = omp_get_wtime(); magneticField(g,nx,ny,nz,1e-3);
+      t[4] = omp_get_wtime(); volumeAverages(g,nx,ny,nz);
+      t[5] = omp_get_wtime();
+      if (r == 0) continue; // warm-up
+      for (int s=0; s<5; s++) times[s] += t[s+1]-t[s];
+   }
+
+   printf("Layout %s, %d x %d x %d cells, %d repetitions, %d threads\n",
+          BField::name(),nx,ny,nz,reps,omp_get_max_threads());
+   printf("%-16s %12s %12s\n","stage","time/rep (s)","GB/s");
+   double total = 0.0;
+   for (int s=0; s<5; s++) {
+      const double t = times[s]/reps;
+      const double bytes = components[s]*nCells*sizeof(Real);
+      printf("%-16s %12.4e %12.3f\n",stageNames[s],t,bytes/t*1e-9);
+      total += t;
+   }
+   printf("%-16s %12.4e\n","total",total);
+   // Print a checksum so that the kernels cannot be optimized away
+   printf("checksum %e\n",g.vol(PERBXVOL,nx/2,ny/2,nz/2) + g.E(EX,nx/2,ny/2,nz/2));
+   return 0;
+}
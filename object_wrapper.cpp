@@ -77,6 +77,13 @@ bool ObjectWrapper::addPopulationParameters() {
      Readparameters::add(pop + "_precipitation.emax", "Highest energy channel (in eV) for precipitation differential flux evaluation", 100.0);
      Readparameters::add(pop + "_precipitation.lossConeAngle", "Fixed loss cone opening angle (in deg) for precipitation differential flux evaluation", 10.0);
 
+     // Velocity space slice parameters
+     Readparameters::add(pop + "_vslice.cellStride", "Write velocity space slices of every arg'th cell (by cell ID) when populations_VelocitySlice is output. 0 disables the slices.", 0);
+     Readparameters::add(pop + "_vslice.resolution", "Number of bins per dimension in a velocity space slice.", 64);
+     Readparameters::add(pop + "_vslice.halfWidth", "Half width (in m/s) of a velocity space slice, centered on the bulk velocity of the population.", 2.0e6);
+     Readparameters::add(pop + "_vslice.thickness", "Thickness (in m/s) of a velocity space slice along the plane normal. 0 projects the whole distribution onto the plane.", 0.0);
+     Readparameters::add(pop + "_vslice.frame", "Plane of the velocity space slices: B (v_par, v_perp1), xy, xz or yz.", std::string("B"));
+
      // Energy density parameters
      Readparameters::add(pop + "_energydensity.limit1", "Lower limit of second bin for energy density, given in units of solar wind ram energy.", 5.0);
      Readparameters::add(pop + "_energydensity.limit2", "Lower limit of third bin for energy density, given in units of solar wind ram energy.", 10.0);
@@ -189,6 +196,21 @@ bool ObjectWrapper::getParameters() {
       // Convert from eV to SI units
       species.precipitationEmin = species.precipitationEmin*physicalconstants::CHARGE;
       species.precipitationEmax = species.precipitationEmax*physicalconstants::CHARGE;
+
+      // Get velocity space slice parameters
+      Readparameters::get(pop + "_vslice.cellStride", species.vsliceCellStride);
+      Readparameters::get(pop + "_vslice.resolution", species.vsliceResolution);
+      Readparameters::get(pop + "_vslice.halfWidth", species.vsliceHalfWidth);
+      Readparameters::get(pop + "_vslice.thickness", species.vsliceThickness);
+      Readparameters::get(pop + "_vslice.frame", species.vsliceFrame);
+      if (species.vsliceFrame != "B" && species.vsliceFrame != "xy" && species.vsliceFrame != "xz" && species.vsliceFrame != "yz") {
+         std::cerr << "Invalid velocity slice frame for species " << pop << ": '" << species.vsliceFrame << "'" << std::endl;
+         return false;
+      }
+      if (species.vsliceResolution <= 0 || species.vsliceHalfWidth <= 0.0 || species.vsliceThickness < 0.0) {
+         std::cerr << "Invalid velocity slice resolution, half width or thickness for species " << pop << std::endl;
+         return false;
+      }
    }
 
    return true;
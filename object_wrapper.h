@@ -38,6 +38,7 @@ struct ObjectWrapper {
    ObjectWrapper() { }
 
    ObjectFactory<amr_ref_criteria::Base> amrVelRefCriteria; /**< Factory for all known AMR refinement criteria.*/
+   ObjectFactory<amr_ref_criteria::SpatialBase> amrSpatialRefCriteria; /**< Factory for all known spatial AMR refinement criteria.*/
    mesh::MeshDataContainer meshData;                        /**< Container for user-defined mesh data.*/
    std::vector<species::Species> particleSpecies;           /**< Parameters for all particle species.*/
    projects::Project*                    project;           /**< Simulated project.*/
@@ -63,6 +63,10 @@ Real P::t_max = LARGE_REAL;
 Real P::dt = NAN;
 Real P::vlasovSolverMaxCFL = NAN;
 Real P::vlasovSolverMinCFL = NAN;
+bool P::packedStencilTransfer = false;
+bool P::populationTasks = false;
+uint P::populationTaskTrace = 0;
+Real P::blockReorderFraction = 0.0;
 Real P::fieldSolverMaxCFL = NAN;
 Real P::fieldSolverMinCFL = NAN;
 uint P::fieldSolverSubcycles = 1;
@@ -92,6 +96,9 @@ uint P::exitAfterRestarts = numeric_limits<uint>::max();
 uint64_t P::vlsvBufferSize = 0;
 int P::restartStripeFactor = -1;
 string P::restartWritePath = string("");
+uint P::telemetryInterval = 0;
+string P::telemetryFileName = string("telemetry.jsonl");
+string P::controlSocket = string("");
 
 uint P::transmit = 0;
 
@@ -117,6 +124,8 @@ int P::writeAsFloat = false;
 string P::loadBalanceAlgorithm = string("");
 string P::loadBalanceTolerance = string("");
 uint P::rebalanceInterval = numeric_limits<uint>::max();
+bool P::threadAffinity = false;
+int P::cellOrder = cellorder::DCCRG;
 
 vector<string> P::outputVariableList;
 vector<string> P::diagnosticVariableList;
@@ -131,6 +140,15 @@ bool P::bailout_write_restart = false;
 Real P::bailout_min_dt = NAN;
 Real P::bailout_max_memory = 1073741824.;
 
+Real P::memoryNodeBudget = 0.0;
+uint P::memoryCheckInterval = 10;
+Real P::memoryRebalanceFraction = 0.8;
+Real P::memorySparsifyFraction = 0.9;
+Real P::memoryRestartFraction = 0.95;
+Real P::memorySparseRaiseFactor = 2.0;
+uint P::memoryMaxSparseRaises = 3;
+bool P::memoryBlockPoolHugeTLB = false;
+
 uint P::amrMaxVelocityRefLevel = 0;
 Realf P::amrRefineLimit = 1.0;
 Realf P::amrCoarsenLimit = 0.5;
@@ -142,6 +160,10 @@ int P::amrBoxHalfWidthZ = 1;
 Realf P::amrBoxCenterX = 0.0;
 Realf P::amrBoxCenterY = 0.0;
 Realf P::amrBoxCenterZ = 0.0;
+uint P::amrAdaptInterval = 0;
+string P::amrSpatialRefCriterion = string("");
+Real P::amrSpatialRefineLimit = 0.5;
+Real P::amrSpatialCoarsenLimit = 0.1;
 
 bool Parameters::addParameters(){
    //the other default parameters we read through the add/get interface
@@ -165,6 +187,9 @@ bool Parameters::addParameters(){
    Readparameters::add("io.write_restart_stripe_factor","Stripe factor for restart writing.", -1);
    Readparameters::add("io.write_as_float","If true, write in floats instead of doubles", false);
    Readparameters::add("io.restart_write_path", "Path to the location where restart files should be written. Defaults to the local directory, also if the specified destination is not writeable.", string("./"));
+   Readparameters::add("io.telemetry_interval", "Write a performance telemetry record (per-process min/max/avg of phase times and load) every arg time steps. 0 is none.", 0);
+   Readparameters::add("io.telemetry_file", "File name of the performance telemetry output, one JSON record per line.", string("telemetry.jsonl"));
+   Readparameters::add("io.control_socket", "Path of a Unix domain datagram socket on which the master process receives the commands STOP, KILL, SAVE, DOLB, OUTPUT <class index> <interval>, TELEMETRY and PHIPROF. If empty, the STOP, KILL, SAVE and DOLB files are polled for every step.", string(""));
    
    Readparameters::add("propagate_field","Propagate magnetic field during the simulation",true);
    Readparameters::add("propagate_vlasov_acceleration","Propagate distribution functions during the simulation in velocity space. If false, it is propagated with zero length timesteps.",true);
@@ -207,11 +232,17 @@ bool Parameters::addParameters(){
    Readparameters::add("vlasovsolver.maxSlAccelerationSubcycles","Maximum number of subcycles for acceleration",1);
    Readparameters::add("vlasovsolver.maxCFL","The maximum CFL limit for vlasov propagation in ordinary space. Used to set timestep if dynamic_timestep is true.",0.99);
    Readparameters::add("vlasovsolver.minCFL","The minimum CFL limit for vlasov propagation in ordinary space. Used to set timestep if dynamic_timestep is true.",0.8);
+   Readparameters::add("vlasovsolver.populationTasks","If true, the subcycles of all populations are accelerated together in one work queue, and the block list transfers of one population overlap with the block adjustment of another.",false);
+   Readparameters::add("vlasovsolver.populationTaskTrace","Write a per-thread timeline of the population tasks of the master process for the first arg time steps to task_trace.json (Chrome trace format). 0 is none.",0);
+   Readparameters::add("vlasovsolver.blockReorderFraction","Store the velocity blocks of a cell in Morton (2x2x2 brick) order, so that the block columns of the acceleration are near-contiguous in memory. A cell is reordered at block adjustment once the blocks added or moved since its last reordering exceed this fraction of its blocks. 0 keeps the insertion order.",0.0);
+   Readparameters::add("vlasovsolver.packedStencilTransfer","If true, the distribution function of remote translation stencil cells is transferred as 16-bit floats scaled per block, halving the MPI volume at a relative accuracy of about 5e-4.",false);
 
    // Load balancing parameters
    Readparameters::add("loadBalance.algorithm", "Load balancing algorithm to be used", string("RCB"));
    Readparameters::add("loadBalance.tolerance", "Load imbalance tolerance", string("1.05"));
    Readparameters::add("loadBalance.rebalanceInterval", "Load rebalance interval (steps)", 10);
+   Readparameters::add("loadBalance.threadAffinity", "If true, every local cell gets a home OpenMP thread which first touches its velocity blocks, and the acceleration, moment and block adjustment loops run cells on their home threads with work stealing. Use with pinned threads (OMP_PROC_BIND).", false);
+   Readparameters::add("loadBalance.cellOrder", "Order of the local cell list after each load balance, so that spatial neighbours are close in memory and in thread schedules: dccrg (cell ID order), morton or hilbert.", string("dccrg"));
    
 // Output variable parameters
    // NOTE Do not remove the : before the list of variable names as this is parsed by tools/check_vlasiator_cfg.sh
@@ -223,7 +254,7 @@ bool Parameters::addParameters(){
 				"V vg_V fg_V populations_V "+
 				"populations_moments_Backstream populations_moments_NonBackstream "+
 				"populations_EffectiveSparsityThreshold populations_RhoLossAdjust "+
-				"populations_EnergyDensity populations_PrecipitationFlux "+
+				"populations_EnergyDensity populations_PrecipitationFlux populations_VelocitySlice "+
 				"LBweight MaxVdt MaxRdt populations_MaxVdt populations_MaxRdt MaxFieldsdt "+
 				"MPIrank vg_rank FsGridRank fg_rank "+
 				"FsGridBoundaryType BoundaryType vg_BoundaryType fg_BoundaryType BoundaryLayer vg_BoundaryLayer fg_BoundaryLayer "+
@@ -249,6 +280,16 @@ bool Parameters::addParameters(){
    Readparameters::add("bailout.min_dt", "Minimum time step below which bailout occurs (s).", 1e-6);
    Readparameters::add("bailout.max_memory", "Maximum amount of memory used per node (in GiB) over which bailout occurs.", 1073741824.);
 
+   // memory budget parameters
+   Readparameters::add("memory.node_budget", "Memory budget per node (in GiB). Approaching it triggers an early load balance, raised sparse thresholds and a forced restart write. 0 disables.", 0.0);
+   Readparameters::add("memory.check_interval", "Check node memory use against memory.node_budget every arg time steps.", 10);
+   Readparameters::add("memory.rebalance_fraction", "Request an early load balance when node memory use exceeds this fraction of the budget.", 0.8);
+   Readparameters::add("memory.sparsify_fraction", "Raise the sparse thresholds of all populations when node memory use exceeds this fraction of the budget.", 0.9);
+   Readparameters::add("memory.restart_fraction", "Force a restart write when node memory use exceeds this fraction of the budget.", 0.95);
+   Readparameters::add("memory.sparse_raise_factor", "Factor by which sparse thresholds are raised, and lowered back once memory use has dropped below memory.rebalance_fraction.", 2.0);
+   Readparameters::add("memory.max_sparse_raises", "Maximum number of consecutive raises of the sparse thresholds.", 3);
+   Readparameters::add("memory.block_pool_hugetlb", "If true, velocity block data is allocated from reserved huge pages (MAP_HUGETLB) instead of transparent huge pages. Only used when built with -DUSE_BLOCK_POOL.", false);
+
    // Refinement parameters
    Readparameters::add("AMR.vel_refinement_criterion","Name of the velocity refinement criterion",string(""));
    Readparameters::add("AMR.max_velocity_level","Maximum velocity mesh refinement level",(uint)0);
@@ -261,6 +302,10 @@ bool Parameters::addParameters(){
    Readparameters::add("AMR.box_center_x","x coordinate of the center of the box that is refined (for testing)",0.0);
    Readparameters::add("AMR.box_center_y","y coordinate of the center of the box that is refined (for testing)",0.0);
    Readparameters::add("AMR.box_center_z","z coordinate of the center of the box that is refined (for testing)",0.0);
+   Readparameters::add("AMR.adapt_interval","Re-evaluate spatial refinement every this many time steps (0: refinement is only done at initialization)",(uint)0);
+   Readparameters::add("AMR.spatial_refinement_criterion","Name of the spatial refinement criterion (rhom_gradient, perb_gradient)",string("rhom_gradient"));
+   Readparameters::add("AMR.spatial_refine_limit","If the spatial refinement criterion returns a larger value than this, cell is refined",0.5);
+   Readparameters::add("AMR.spatial_coarsen_limit","If the spatial refinement criterion returns a smaller value than this in all siblings, they are coarsened",0.1);
    return true;
 }
 
@@ -283,6 +328,9 @@ bool Parameters::getParameters(){
    Readparameters::get("io.write_restart_stripe_factor", P::restartStripeFactor);
    Readparameters::get("io.restart_write_path", P::restartWritePath);
    Readparameters::get("io.write_as_float", P::writeAsFloat);
+   Readparameters::get("io.telemetry_interval", P::telemetryInterval);
+   Readparameters::get("io.telemetry_file", P::telemetryFileName);
+   Readparameters::get("io.control_socket", P::controlSocket);
    
    // Checks for validity of io and restart parameters
    int myRank;
@@ -423,6 +471,10 @@ bool Parameters::getParameters(){
    Readparameters::get("AMR.vel_refinement_criterion",P::amrVelRefCriterion);
    Readparameters::get("AMR.refine_limit",P::amrRefineLimit);
    Readparameters::get("AMR.coarsen_limit",P::amrCoarsenLimit);
+   Readparameters::get("AMR.adapt_interval",P::amrAdaptInterval);
+   Readparameters::get("AMR.spatial_refinement_criterion",P::amrSpatialRefCriterion);
+   Readparameters::get("AMR.spatial_refine_limit",P::amrSpatialRefineLimit);
+   Readparameters::get("AMR.spatial_coarsen_limit",P::amrSpatialCoarsenLimit);
    
    if (geometryString == "XY4D") P::geometry = geometry::XY4D;
    else if (geometryString == "XZ4D") P::geometry = geometry::XZ4D;
@@ -435,6 +487,10 @@ bool Parameters::getParameters(){
    }
    
    if (P::amrCoarsenLimit >= P::amrRefineLimit) return false;
+   if (P::amrAdaptInterval > 0 && P::amrSpatialCoarsenLimit >= P::amrSpatialRefineLimit) {
+      cerr << "AMR.spatial_coarsen_limit must be smaller than AMR.spatial_refine_limit" << endl;
+      return false;
+   }
    if (P::xmax < P::xmin || (P::ymax < P::ymin || P::zmax < P::zmin)) return false;
    
    // Set some parameter values. 
@@ -471,12 +527,26 @@ bool Parameters::getParameters(){
    Readparameters::get("vlasovsolver.maxSlAccelerationSubcycles",P::maxSlAccelerationSubcycles);
    Readparameters::get("vlasovsolver.maxCFL",P::vlasovSolverMaxCFL);
    Readparameters::get("vlasovsolver.minCFL",P::vlasovSolverMinCFL);
+   Readparameters::get("vlasovsolver.packedStencilTransfer",P::packedStencilTransfer);
+   Readparameters::get("vlasovsolver.populationTasks",P::populationTasks);
+   Readparameters::get("vlasovsolver.populationTaskTrace",P::populationTaskTrace);
+   Readparameters::get("vlasovsolver.blockReorderFraction",P::blockReorderFraction);
 
    
    // Get load balance parameters
    Readparameters::get("loadBalance.algorithm", P::loadBalanceAlgorithm);
    Readparameters::get("loadBalance.tolerance", P::loadBalanceTolerance);
    Readparameters::get("loadBalance.rebalanceInterval", P::rebalanceInterval);
+   Readparameters::get("loadBalance.threadAffinity", P::threadAffinity);
+   string cellOrderString;
+   Readparameters::get("loadBalance.cellOrder", cellOrderString);
+   if (cellOrderString == "dccrg") P::cellOrder = cellorder::DCCRG;
+   else if (cellOrderString == "morton") P::cellOrder = cellorder::MORTON;
+   else if (cellOrderString == "hilbert") P::cellOrder = cellorder::HILBERT;
+   else {
+      cerr << "Unknown loadBalance.cellOrder " << cellOrderString << ", use dccrg, morton or hilbert" << endl;
+      return false;
+   }
    
    // Get output variable parameters
    Readparameters::get("variables.output", P::outputVariableList);
@@ -497,6 +567,30 @@ bool Parameters::getParameters(){
    Readparameters::get("bailout.min_dt", P::bailout_min_dt);
    Readparameters::get("bailout.max_memory", P::bailout_max_memory);
 
+   // Get parameters related to the memory budget
+   Readparameters::get("memory.node_budget", P::memoryNodeBudget);
+   Readparameters::get("memory.check_interval", P::memoryCheckInterval);
+   Readparameters::get("memory.rebalance_fraction", P::memoryRebalanceFraction);
+   Readparameters::get("memory.sparsify_fraction", P::memorySparsifyFraction);
+   Readparameters::get("memory.restart_fraction", P::memoryRestartFraction);
+   Readparameters::get("memory.sparse_raise_factor", P::memorySparseRaiseFactor);
+   Readparameters::get("memory.max_sparse_raises", P::memoryMaxSparseRaises);
+   Readparameters::get("memory.block_pool_hugetlb", P::memoryBlockPoolHugeTLB);
+   if (P::memoryNodeBudget > 0.0) {
+      if (P::memoryCheckInterval == 0) {
+         cerr << "memory.check_interval must be larger than 0 when memory.node_budget is set" << endl;
+         return false;
+      }
+      if (P::memoryRebalanceFraction > P::memorySparsifyFraction || P::memorySparsifyFraction > P::memoryRestartFraction) {
+         cerr << "memory.rebalance_fraction <= memory.sparsify_fraction <= memory.restart_fraction is required" << endl;
+         return false;
+      }
+      if (P::memorySparseRaiseFactor <= 1.0) {
+         cerr << "memory.sparse_raise_factor must be larger than 1" << endl;
+         return false;
+      }
+   }
+
    for (size_t s=0; s<P::systemWriteName.size(); ++s) P::systemWrites.push_back(0);
    
    return true;
@@ -58,6 +58,10 @@ struct Parameters {
    static Real fieldSolverMinCFL;     /*!< The minimum CFL limit for propagation of fields. Used to set timestep if useCFLlimit is true.*/
    static Real fieldSolverMaxCFL;     /*!< The maximum CFL limit for propagation of fields. Used to set timestep if useCFLlimit is true.*/
    static uint fieldSolverSubcycles;     /*!< The number of field solver subcycles to compute.*/
+   static bool packedStencilTransfer;    /*!< If true, remote translation stencil data is transferred packed to 16 bits per value.*/
+   static bool populationTasks;          /*!< If true, all populations are accelerated in lockstep and their block adjustments are pipelined.*/
+   static uint populationTaskTrace;      /*!< Number of time steps for which the master process records a task timeline, 0 is none.*/
+   static Real blockReorderFraction;     /*!< Velocity blocks are reordered into bricks when this fraction of them has changed, 0 is never.*/
 
    static uint tstep_min;           /*!< Timestep when simulation starts, needed for restarts.*/
    static uint tstep_max;           /*!< Maximum timestep. */
@@ -83,6 +87,9 @@ struct Parameters {
    static uint64_t vlsvBufferSize;          /*!< Buffer size in bytes passed to VLSV writer. */
    static int restartStripeFactor;          /*!< stripe_factor for restart writing*/
    static std::string restartWritePath;          /*!< Path to the location where restart files should be written. Defaults to the local directory, also if the specified destination is not writeable. */
+   static uint telemetryInterval;           /*!< Write a performance telemetry record every this many time steps, 0 disables telemetry. */
+   static std::string telemetryFileName;    /*!< Name of the performance telemetry file (JSON lines). */
+   static std::string controlSocket;        /*!< Path of the Unix domain socket for external commands, empty to poll for command files. */
    
    static uint transmit;
    /*!< Indicates the data that needs to be transmitted to remote nodes.
@@ -112,6 +119,8 @@ struct Parameters {
    static std::string loadBalanceAlgorithm; /*!< Algorithm to be used for load balance.*/
    static std::string loadBalanceTolerance; /*!< Load imbalance tolerance. */ 
    static uint rebalanceInterval; /*!< Load rebalance interval (steps). */
+   static bool threadAffinity; /*!< If true, cells are updated on their home OpenMP threads, see cell_affinity.h. */
+   static int cellOrder; /*!< Order of the local cell list, one of the values defined in cellorder::Curve. */
    static bool prepareForRebalance; /**< If true, propagators should measure their time consumption in preparation
                                      * for mesh repartitioning.*/
 
@@ -129,6 +138,15 @@ struct Parameters {
    static Real bailout_min_dt; /*!< Minimum time step below which bailout occurs (s). */
    static Real bailout_max_memory; /*!< Maximum amount of memory used per node (in GiB) over which bailout occurs. */
 
+   static Real memoryNodeBudget;          /*!< Memory budget per node (in GiB) for defensive actions, 0 disables them. */
+   static uint memoryCheckInterval;       /*!< Node memory use is checked against the budget every this many time steps. */
+   static Real memoryRebalanceFraction;   /*!< Fraction of the budget over which an early load balance is requested. */
+   static Real memorySparsifyFraction;    /*!< Fraction of the budget over which the sparse thresholds are raised. */
+   static Real memoryRestartFraction;     /*!< Fraction of the budget over which a restart write is forced. */
+   static Real memorySparseRaiseFactor;   /*!< Factor by which the sparse thresholds are raised (and lowered back) per check. */
+   static uint memoryMaxSparseRaises;     /*!< Maximum number of times the sparse thresholds are raised on top of each other. */
+   static bool memoryBlockPoolHugeTLB;    /*!< If true, the velocity block pool maps MAP_HUGETLB pages (builds with -DUSE_BLOCK_POOL). */
+
    static uint amrMaxVelocityRefLevel;    /**< Maximum velocity mesh refinement level, defaults to 0.*/
    static Realf amrCoarsenLimit;          /**< If the value of refinement criterion is below this value, block can be coarsened.
                                            * The value must be smaller than amrRefineLimit.*/
@@ -142,6 +160,11 @@ struct Parameters {
    static Realf amrBoxCenterX;
    static Realf amrBoxCenterY;
    static Realf amrBoxCenterZ;
+   static uint amrAdaptInterval;             /**< Spatial refinement is re-evaluated every this many time steps, 0=static mesh.*/
+   static std::string amrSpatialRefCriterion; /**< Name of the spatial cell refinement criterion function.*/
+   static Real amrSpatialRefineLimit;        /**< If the spatial criterion is larger than this value, cell is refined.*/
+   static Real amrSpatialCoarsenLimit;       /**< If the spatial criterion is below this value in all siblings, they are coarsened.
+                                              * The value must be smaller than amrSpatialRefineLimit.*/
 
    /*! \brief Add the global parameters.
     * 
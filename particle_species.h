@@ -70,6 +70,12 @@ namespace species {
       Real precipitationEmax;                  /*!< Highest energy channel (in keV) for precipitation differential flux evaluation. Default 100. */
       Real precipitationLossConeAngle;         /*!< Fixed loss cone opening angle (in deg) for precipitation differential flux evaluation. Default 10. */
 
+      int vsliceCellStride;       /*!< Velocity space slices are written for every this many cells (by cell ID). 0 disables the slices. */
+      int vsliceResolution;       /*!< Number of bins per dimension in a velocity space slice. Default 64. */
+      Real vsliceHalfWidth;       /*!< Half width (in m/s) of a velocity space slice around the bulk velocity. Default 2e6. */
+      Real vsliceThickness;       /*!< Thickness (in m/s) of a velocity space slice, 0 projects the whole distribution onto the plane. Default 0. */
+      std::string vsliceFrame;    /*!< Plane of the velocity space slices: B (v_par, v_perp1), xy, xz or yz. Default B. */
+
        Species();
        Species(const Species& other);
        ~Species();
@@ -248,6 +248,90 @@ namespace projects {
       }
    }
    
+   void Magnetosphere::calcPhaseSpaceDensityBlock(creal& x,creal& y,creal& z,creal& dx,creal& dy,creal& dz,
+                                                  creal& vxBlock,creal& vyBlock,creal& vzBlock,
+                                                  creal& dvx,creal& dvy,creal& dvz,
+                                                  cuint nvx,cuint nvy,cuint nvz,
+                                                  const uint popID,Real* values) const {
+      const MagnetosphereSpeciesParameters& sP = this->speciesParams[popID];
+      creal mass = getObjectWrapper().particleSpecies[popID].mass;
+      creal normalization = pow(mass / (2.0 * M_PI * physicalconstants::K_B * sP.T), 1.5);
+      creal c = mass / (2.0 * physicalconstants::K_B * sP.T);
+      const std::array<Real, 3> coeff {{c, c, c}};
+
+      // Same sample points as calcPhaseSpaceDensity: cell corners and edges when sampling, cell centre otherwise
+      const bool sample = (sP.nSpaceSamples > 1) && (sP.nVelocitySamples > 1);
+      cuint nSpace    = sample ? sP.nSpaceSamples : 1;
+      cuint nVelocity = sample ? sP.nVelocitySamples : 1;
+      creal spaceStart    = sample ? 0.0 : 0.5;
+      creal spaceStep     = sample ? 1.0 / (sP.nSpaceSamples-1) : 0.0;
+      creal velocityStart = sample ? 0.0 : 0.5;
+      creal velocityStep  = sample ? 1.0 / (sP.nVelocitySamples-1) : 0.0;
+
+      // Density and bulk velocity only depend on the spatial sample, so they are evaluated once per block
+      for (uint i=0; i<nSpace; ++i) for (uint j=0; j<nSpace; ++j) for (uint k=0; k<nSpace; ++k) {
+         creal xs = x + (spaceStart + i*spaceStep)*dx;
+         creal ys = y + (spaceStart + j*spaceStep)*dy;
+         creal zs = z + (spaceStart + k*spaceStep)*dz;
+         const std::array<Real, 3> initV0 = this->getV0(xs, ys, zs, popID)[0];
+         addMaxwellianSamplesToBlock(vxBlock,vyBlock,vzBlock,dvx,dvy,dvz,nvx,nvy,nvz,
+                                     nVelocity,velocityStart,velocityStep,
+                                     this->getInitRho(xs, ys, zs, popID) * normalization,initV0,coeff,values);
+      }
+
+      creal nSamplesTotal = nSpace*nSpace*nSpace*nVelocity*nVelocity*nVelocity;
+      for (uint kc=0; kc<nvz; ++kc) for (uint jc=0; jc<nvy; ++jc) for (uint ic=0; ic<nvx; ++ic) {
+         values[cellIndex(ic,jc,kc)] /= nSamplesTotal;
+      }
+   }
+   
+   Real Magnetosphere::estimateVelocityBlocks(creal& x, creal& y, creal& z, creal& dx, creal& dy, creal& dz, const uint popID) const {
+      const MagnetosphereSpeciesParameters& sP = this->speciesParams[popID];
+      const std::array<Real, 3> T {{sP.T, sP.T, sP.T}};
+      return estimateMaxwellianBlocks(popID, this->getInitRho(x+0.5*dx, y+0.5*dy, z+0.5*dz, popID), T);
+   }
+
+   /*! The distribution is a Maxwellian with the project temperature, so it is determined by the density and
+    * bulk velocity at the spatial sample points. It is only cached if these are the same at all sample points,
+    * which is the case e.g. everywhere in the solar wind outside the ionosphere taper region. */
+   bool Magnetosphere::getInitialDistributionKey(const spatial_cell::SpatialCell* cell,const uint popID,std::vector<Real>& key) const {
+      const MagnetosphereSpeciesParameters& sP = this->speciesParams[popID];
+      creal x  = cell->parameters[CellParams::XCRD];
+      creal y  = cell->parameters[CellParams::YCRD];
+      creal z  = cell->parameters[CellParams::ZCRD];
+      creal dx = cell->parameters[CellParams::DX];
+      creal dy = cell->parameters[CellParams::DY];
+      creal dz = cell->parameters[CellParams::DZ];
+
+      const bool sample = (sP.nSpaceSamples > 1) && (sP.nVelocitySamples > 1);
+      cuint nSpace = sample ? sP.nSpaceSamples : 1;
+      creal spaceStart = sample ? 0.0 : 0.5;
+      creal spaceStep  = sample ? 1.0 / (sP.nSpaceSamples-1) : 0.0;
+
+      Real rho = 0.0;
+      std::array<Real, 3> V0 {{0.0, 0.0, 0.0}};
+      for (uint i=0; i<nSpace; ++i) for (uint j=0; j<nSpace; ++j) for (uint k=0; k<nSpace; ++k) {
+         creal xs = x + (spaceStart + i*spaceStep)*dx;
+         creal ys = y + (spaceStart + j*spaceStep)*dy;
+         creal zs = z + (spaceStart + k*spaceStep)*dz;
+         creal sampleRho = this->getInitRho(xs, ys, zs, popID);
+         const std::array<Real, 3> sampleV0 = this->getV0(xs, ys, zs, popID)[0];
+         if (i == 0 && j == 0 && k == 0) {
+            rho = sampleRho;
+            V0 = sampleV0;
+         } else if (sampleRho != rho || sampleV0 != V0) {
+            return false;
+         }
+      }
+
+      key.push_back(rho);
+      key.push_back(V0[0]);
+      key.push_back(V0[1]);
+      key.push_back(V0[2]);
+      key.push_back(sP.T);
+      return true;
+   }
+
    /*! Magnetosphere does not set any extra perturbed B. */
    void Magnetosphere::calcCellParameters(spatial_cell::SpatialCell* cell,creal& t) { }
 
@@ -394,9 +478,19 @@ namespace projects {
            const uint popID) const
    {
       const MagnetosphereSpeciesParameters& sP = this->speciesParams[popID];
-      Real initRho = sP.rho;
+      Real initRho = this->getInitRho(x, y, z, popID);
       std::array<Real, 3> initV0 = this->getV0(x, y, z, popID)[0];
       
+      Real mass = getObjectWrapper().particleSpecies[popID].mass;
+
+      return initRho * pow(mass / (2.0 * M_PI * physicalconstants::K_B * sP.T), 1.5) *
+      exp(- mass * ((vx-initV0[0])*(vx-initV0[0]) + (vy-initV0[1])*(vy-initV0[1]) + (vz-initV0[2])*(vz-initV0[2])) / (2.0 * physicalconstants::K_B * sP.T));
+   }
+
+   /*! Number density at the given point, tapered towards the ionosphere density inside ionosphere.taperRadius. */
+   Real Magnetosphere::getInitRho(creal& x,creal& y,creal& z,const uint popID) const {
+      const MagnetosphereSpeciesParameters& sP = this->speciesParams[popID];
+      Real initRho = sP.rho;
       Real radius;
       
       switch(this->ionosphereGeometry) {
@@ -433,10 +527,7 @@ namespace projects {
          }
       }
 
-      Real mass = getObjectWrapper().particleSpecies[popID].mass;
-
-      return initRho * pow(mass / (2.0 * M_PI * physicalconstants::K_B * sP.T), 1.5) *
-      exp(- mass * ((vx-initV0[0])*(vx-initV0[0]) + (vy-initV0[1])*(vy-initV0[1]) + (vz-initV0[2])*(vz-initV0[2])) / (2.0 * physicalconstants::K_B * sP.T));
+      return initRho;
    }
 
    vector<std::array<Real, 3> > Magnetosphere::getV0(
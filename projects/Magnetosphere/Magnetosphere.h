@@ -59,8 +59,18 @@ namespace projects {
                                          creal& dvx, creal& dvy, creal& dvz,
                                          const uint popID
                                         ) const;
+      virtual void calcPhaseSpaceDensityBlock(
+                                              creal& x, creal& y, creal& z,
+                                              creal& dx, creal& dy, creal& dz,
+                                              creal& vxBlock, creal& vyBlock, creal& vzBlock,
+                                              creal& dvx, creal& dvy, creal& dvz,
+                                              cuint nvx, cuint nvy, cuint nvz,
+                                              const uint popID, Real* values) const;
+      virtual Real estimateVelocityBlocks(creal& x, creal& y, creal& z, creal& dx, creal& dy, creal& dz, const uint popID) const;
       
     protected:
+      virtual bool getInitialDistributionKey(const spatial_cell::SpatialCell* cell,const uint popID,std::vector<Real>& key) const;
+      Real getInitRho(creal& x, creal& y, creal& z, const uint popID) const;
       Real getDistribValue(
                            creal& x,creal& y, creal& z,
                            creal& vx, creal& vy, creal& vz,
@@ -212,6 +212,111 @@ namespace projects {
       return avgTotal / N3_sum;
    }
 
+   void MultiPeak::calcPhaseSpaceDensityBlock(creal& x, creal& y, creal& z, creal& dx, creal& dy, creal& dz,
+                                              creal& vxBlock, creal& vyBlock, creal& vzBlock,
+                                              creal& dvx, creal& dvy, creal& dvz,
+                                              cuint nvx, cuint nvy, cuint nvz,
+                                              const uint popID, Real* values) const {
+      // Same iterative sampling as calcPhaseSpaceDensity, done for all cells of the block at once.
+      // Each iteration evaluates the peaks with N*N*N points in every cell that has not converged yet.
+      const MultiPeakSpeciesParameters& sP = speciesParams[popID];
+      creal mass = getObjectWrapper().particleSpecies[popID].mass;
+      creal kb = physicalconstants::K_B;
+      const Real avgLimit = 0.01*getObjectWrapper().particleSpecies[popID].sparseMinValue;
+
+      Real rhoFactor = 1.0;
+      if (densityModel == TestCase) {
+         if ((x >= 3.9e5 && x <= 6.1e5) && (y >= 3.9e5 && y <= 6.1e5)) {
+            rhoFactor = 1.5;
+         }
+      }
+
+      Real avgTotal[WID3];
+      Real avg[WID3];
+      bool converged[WID3];
+      for (uint c=0; c<WID3; ++c) {
+         avgTotal[c] = 0.0;
+         converged[c] = false;
+      }
+
+      uint N = nVelocitySamples;
+      int N3_sum = 0;
+      bool allConverged = false;
+      while (allConverged == false) {
+         for (uint c=0; c<WID3; ++c) avg[c] = 0.0;
+         for (uint i=0; i<sP.numberOfPeaks; ++i) {
+            const std::array<Real, 3> V0 {{sP.Vx[i], sP.Vy[i], sP.Vz[i]}};
+            const std::array<Real, 3> coeff {{mass / (2.0 * kb * sP.Tx[i]), mass / (2.0 * kb * sP.Ty[i]), mass / (2.0 * kb * sP.Tz[i])}};
+            creal amplitude = (sP.rho[i] + sP.rhoPertAbsAmp[i] * rhoRnd)
+               * pow(mass / (2.0 * M_PI * kb ), 1.5) / sqrt(sP.Tx[i]*sP.Ty[i]*sP.Tz[i]);
+            addMaxwellianSamplesToBlock(vxBlock,vyBlock,vzBlock,dvx,dvy,dvz,nvx,nvy,nvz,
+                                        N,0.5/N,1.0/N,amplitude,V0,coeff,avg);
+         }
+
+         allConverged = true;
+         for (uint kc=0; kc<nvz; ++kc) for (uint jc=0; jc<nvy; ++jc) for (uint ic=0; ic<nvx; ++ic) {
+            cuint c = cellIndex(ic,jc,kc);
+            if (converged[c] == true) continue;
+            creal cellAvg = avg[c] * rhoFactor;
+
+            // Compare the current and accumulated volume averages:
+            Real eps = max(numeric_limits<creal>::min(),cellAvg * static_cast<Real>(1e-6));
+            Real avgAccum   = avgTotal[c] / (cellAvg + N3_sum);
+            Real avgCurrent = cellAvg / (N*N*N);
+            if (fabs(avgCurrent-avgAccum)/(avgAccum+eps) < 0.01) converged[c] = true;
+            else if (cellAvg < avgLimit) converged[c] = true;
+            else if (N > 10) converged[c] = true;
+
+            avgTotal[c] += cellAvg;
+            if (converged[c] == true) values[c] = avgTotal[c] / (N3_sum + N*N*N);
+            else allConverged = false;
+         }
+         N3_sum += N*N*N;
+         ++N;
+      }
+   }
+
+   Real MultiPeak::estimateVelocityBlocks(creal& x, creal& y, creal& z, creal& dx, creal& dy, creal& dz, const uint popID) const {
+      // Overlapping peaks are counted separately, which overestimates close peaks
+      const MultiPeakSpeciesParameters& sP = speciesParams[popID];
+      Real blocks = 0.0;
+      for (uint i=0; i<sP.numberOfPeaks; ++i) {
+         const std::array<Real, 3> T {{sP.Tx[i], sP.Ty[i], sP.Tz[i]}};
+         blocks += estimateMaxwellianBlocks(popID, sP.rho[i], T);
+      }
+      return blocks;
+   }
+
+   /*! The peaks only depend on the cell through the random density perturbation and the test case density factor.
+    * The random perturbation differs in every cell, so populations with a perturbation are not cached. */
+   bool MultiPeak::getInitialDistributionKey(const spatial_cell::SpatialCell* cell,const uint popID,std::vector<Real>& key) const {
+      const MultiPeakSpeciesParameters& sP = speciesParams[popID];
+      for (uint i=0; i<sP.numberOfPeaks; ++i) {
+         if (sP.rhoPertAbsAmp[i] != 0.0) return false;
+      }
+      creal x = cell->parameters[CellParams::XCRD];
+      creal y = cell->parameters[CellParams::YCRD];
+
+      Real rhoFactor = 1.0;
+      if (densityModel == TestCase) {
+         if ((x >= 3.9e5 && x <= 6.1e5) && (y >= 3.9e5 && y <= 6.1e5)) {
+            rhoFactor = 1.5;
+         }
+      }
+
+      key.push_back(rhoFactor);
+      for (uint i=0; i<sP.numberOfPeaks; ++i) {
+         key.push_back(sP.rho[i]);
+         key.push_back(sP.Vx[i]);
+         key.push_back(sP.Vy[i]);
+         key.push_back(sP.Vz[i]);
+         key.push_back(sP.Tx[i]);
+         key.push_back(sP.Ty[i]);
+         key.push_back(sP.Tz[i]);
+      }
+      return true;
+   }
+
    void MultiPeak::calcCellParameters(spatial_cell::SpatialCell* cell,creal& t) {
       setRandomCellSeed(cell);
       rhoRnd = 0.5 - getRandomNumber();
@@ -66,18 +66,27 @@ namespace projects {
          FsGrid< std::array<Real, fsgrids::bgbfield::N_BGB>, 2>& BgBGrid,
          FsGrid< fsgrids::technical, 2>& technicalGrid
       );
+      virtual Real estimateVelocityBlocks(creal& x, creal& y, creal& z, creal& dx, creal& dy, creal& dz, const uint popID) const;
     protected:
       Real getDistribValue(
                            creal& x,creal& y, creal& z,
                            creal& vx, creal& vy, creal& vz,
                           const uint popID) const;
       virtual void calcCellParameters(spatial_cell::SpatialCell* cell,creal& t);
+      virtual bool getInitialDistributionKey(const spatial_cell::SpatialCell* cell,const uint popID,std::vector<Real>& key) const;
       virtual Real calcPhaseSpaceDensity(
                                          creal& x, creal& y, creal& z,
                                          creal& dx, creal& dy, creal& dz,
                                          creal& vx, creal& vy, creal& vz,
                                          creal& dvx, creal& dvy, creal& dvz,
                                          const uint popID) const;
+      virtual void calcPhaseSpaceDensityBlock(
+                                              creal& x, creal& y, creal& z,
+                                              creal& dx, creal& dy, creal& dz,
+                                              creal& vxBlock, creal& vyBlock, creal& vzBlock,
+                                              creal& dvx, creal& dvy, creal& dvz,
+                                              cuint nvx, cuint nvy, cuint nvz,
+                                              const uint popID, Real* values) const;
       virtual std::vector<std::array<Real, 3> > getV0(
                                                       creal x,
                                                       creal y,
@@ -22,6 +22,7 @@
 
 #include "project.h"
 #include <cstdlib>
+#include <cstring>
 #include "../common.h"
 #include "../parameters.h"
 #include "../readparameters.h"
@@ -98,6 +99,10 @@ static VelocityMeshParams* velMeshParams = NULL;
 namespace projects {
    Project::Project() { 
       baseClassInitialized = false;
+      initialDistributionCacheSize = 0;
+      initialDistributionCacheActive = true;
+      initialDistributionCacheLookups = 0;
+      initialDistributionCacheHits = 0;
    }
    
    Project::~Project() { }
@@ -129,12 +134,14 @@ namespace projects {
       projects::verificationLarmor::addParameters();
       projects::Shocktest::addParameters();
       RP::add("Project_common.seed", "Seed for the RNG", 42);
+      RP::add("Project_common.initialDistributionCacheSize", "Maximum number of distinct initial velocity distributions cached per process, cells with identical distribution parameters get a copy instead of a recomputation. 0 disables the cache.", 64);
       
    }
 
    void Project::getParameters() {
       typedef Readparameters RP;
       RP::get("Project_common.seed", this->seed);
+      RP::get("Project_common.initialDistributionCacheSize", this->initialDistributionCacheSize);
 
 
       // Note that configuration files need to be re-parsed after this.
@@ -303,16 +310,17 @@ namespace projects {
       creal dvzCell = parameters[blockLID*BlockParams::N_VELOCITY_BLOCK_PARAMS + BlockParams::DVZ];
       
       // Calculate volume average of distribution function for each phase-space cell in the block.
+      Real values[WID3];
+      for (uint i=0; i<WID3; ++i) values[i] = 0.0;
+      calcPhaseSpaceDensityBlock(
+         x, y, z, dx, dy, dz,
+         vxBlock,vyBlock,vzBlock,
+         dvxCell,dvyCell,dvzCell,
+         WID_VX,WID_VY,WID_VZ,popID,values);
+
       Real maxValue = 0.0;
       for (uint kc=0; kc<WID_VZ; ++kc) for (uint jc=0; jc<WID_VY; ++jc) for (uint ic=0; ic<WID_VX; ++ic) {
-         creal vxCell = vxBlock + ic*dvxCell;
-         creal vyCell = vyBlock + jc*dvyCell;
-         creal vzCell = vzBlock + kc*dvzCell;
-         creal average =
-            calcPhaseSpaceDensity(
-               x, y, z, dx, dy, dz,
-               vxCell,vyCell,vzCell,
-               dvxCell,dvyCell,dvzCell,popID);
+         creal average = values[cellIndex(ic,jc,kc)];
          if (average != 0.0) {
             data[blockLID*SIZE_VELBLOCK+cellIndex(ic,jc,kc)] = average;
             maxValue = max(maxValue,average);
@@ -322,9 +330,78 @@ namespace projects {
       return maxValue;
    }
    
+   void Project::calcPhaseSpaceDensityBlock(
+      creal& x, creal& y, creal& z,
+      creal& dx, creal& dy, creal& dz,
+      creal& vxBlock, creal& vyBlock, creal& vzBlock,
+      creal& dvx, creal& dvy, creal& dvz,
+      cuint nvx, cuint nvy, cuint nvz,
+      const uint popID, Real* values) const {
+      for (uint kc=0; kc<nvz; ++kc) for (uint jc=0; jc<nvy; ++jc) for (uint ic=0; ic<nvx; ++ic) {
+         values[cellIndex(ic,jc,kc)] =
+            calcPhaseSpaceDensity(
+               x, y, z, dx, dy, dz,
+               vxBlock + ic*dvx, vyBlock + jc*dvy, vzBlock + kc*dvz,
+               dvx,dvy,dvz,popID);
+      }
+   }
+   
+   void Project::addMaxwellianSamplesToBlock(
+      creal& vxBlock, creal& vyBlock, creal& vzBlock,
+      creal& dvx, creal& dvy, creal& dvz,
+      cuint nvx, cuint nvy, cuint nvz,
+      cuint nSamples, creal& sampleStart, creal& sampleStep,
+      creal& amplitude, const std::array<Real, 3>& V0, const std::array<Real, 3>& coeff,
+      Real* values) const {
+      // Per-direction sums of exp(-coeff*(v-V0)^2) over the sample points of each cell
+      Real gx[WID], gy[WID], gz[WID];
+      for (uint ic=0; ic<nvx; ++ic) {
+         gx[ic] = 0.0;
+         for (uint s=0; s<nSamples; ++s) {
+            creal v = vxBlock + (ic + sampleStart + s*sampleStep)*dvx - V0[0];
+            gx[ic] += exp(-coeff[0]*v*v);
+         }
+      }
+      for (uint jc=0; jc<nvy; ++jc) {
+         gy[jc] = 0.0;
+         for (uint s=0; s<nSamples; ++s) {
+            creal v = vyBlock + (jc + sampleStart + s*sampleStep)*dvy - V0[1];
+            gy[jc] += exp(-coeff[1]*v*v);
+         }
+      }
+      for (uint kc=0; kc<nvz; ++kc) {
+         gz[kc] = 0.0;
+         for (uint s=0; s<nSamples; ++s) {
+            creal v = vzBlock + (kc + sampleStart + s*sampleStep)*dvz - V0[2];
+            gz[kc] += exp(-coeff[2]*v*v);
+         }
+      }
+
+      for (uint kc=0; kc<nvz; ++kc) for (uint jc=0; jc<nvy; ++jc) {
+         creal ayz = amplitude*gy[jc]*gz[kc];
+         Real* row = values + cellIndex(0u,jc,kc);
+#pragma ivdep
+#pragma GCC ivdep
+         for (uint ic=0; ic<nvx; ++ic) row[ic] += ayz*gx[ic];
+      }
+   }
+   
    void Project::setVelocitySpace(const uint popID,SpatialCell* cell) const {
       vmesh::VelocityMesh<vmesh::GlobalID,vmesh::LocalID>& vmesh = cell->get_velocity_mesh(popID);
 
+      // Cells whose distribution is determined by the same parameters get a copy of the cached one
+      vector<Real> cacheKey;
+      bool cacheable = false;
+      if (initialDistributionCacheActive == true && initialDistributionCacheSize > 0 &&
+          Parameters::amrMaxVelocityRefLevel == 0 && vmesh.size() == 0) {
+         cacheKey.push_back(popID);
+         cacheable = getInitialDistributionKey(cell,popID,cacheKey);
+      }
+      if (cacheable == true && copyFromInitialDistributionCache(cacheKey,cell,popID) == true) {
+         if (rescalesDensity(popID) == true) rescaleDensity(cell,popID);
+         return;
+      }
+
       vector<vmesh::GlobalID> blocksToInitialize = this->findBlocksToInitialize(cell,popID);
       vector<vmesh::GlobalID> removeList;
       for (uint i=0; i<blocksToInitialize.size(); ++i) {
@@ -342,6 +419,7 @@ namespace projects {
       // Get AMR refinement criterion and use it to test which blocks should be refined
       amr_ref_criteria::Base* refCriterion = getObjectWrapper().amrVelRefCriteria.create(Parameters::amrVelRefCriterion);
       if (refCriterion == NULL) {
+         if (cacheable == true) storeInInitialDistributionCache(cacheKey,cell,popID);
          if (rescalesDensity(popID) == true) rescaleDensity(cell,popID);
          return;
       }
@@ -405,9 +483,100 @@ namespace projects {
 
       delete refCriterion;
 
+      if (cacheable == true) storeInInitialDistributionCache(cacheKey,cell,popID);
       if (rescalesDensity(popID) == true) rescaleDensity(cell,popID);
    }
 
+   Real Project::estimateVelocityBlocks(creal& x, creal& y, creal& z, creal& dx, creal& dy, creal& dz, const uint popID) const {
+      return 1.0;
+   }
+
+   Real Project::estimateMaxwellianBlocks(const uint popID,creal& rho,const std::array<Real, 3>& T) const {
+      const species::Species& species = getObjectWrapper().particleSpecies[popID];
+      const vmesh::MeshParameters& meshParams = getObjectWrapper().velocityMeshes[species.velocityMesh];
+      creal mass = species.mass;
+
+      Real maxBlocks = 1.0;
+      Real blockSize[3];
+      for (int i=0; i<3; ++i) {
+         blockSize[i] = (meshParams.meshLimits[2*i+1] - meshParams.meshLimits[2*i]) / meshParams.gridLength[i];
+         maxBlocks *= meshParams.gridLength[i];
+      }
+
+      // Peak value of the distribution compared to the sparsity threshold
+      creal peak = rho * pow(mass / (2.0 * M_PI * physicalconstants::K_B), 1.5) / sqrt(T[0]*T[1]*T[2]);
+      if (rho <= 0.0 || peak <= species.sparseMinValue) return 0.0;
+      creal logRatio = log(peak / species.sparseMinValue);
+
+      // Semi-axes of the ellipsoid f > sparseMinValue, padded with the kept neighbour blocks
+      Real blocks = 4.0 / 3.0 * M_PI;
+      for (int i=0; i<3; ++i) {
+         creal semiAxis = sqrt(2.0 * physicalconstants::K_B * T[i] * logRatio / mass);
+         blocks *= (semiAxis + species.sparseBlockAddWidthV * blockSize[i]) / blockSize[i];
+      }
+      return min(blocks,maxBlocks);
+   }
+
+   bool Project::getInitialDistributionKey(const spatial_cell::SpatialCell* cell,const uint popID,std::vector<Real>& key) const {
+      return false;
+   }
+
+   /** Set the velocity space of an empty population from the initial distribution cache.
+    * @return If false, the key was not found and the distribution has to be computed.*/
+   bool Project::copyFromInitialDistributionCache(const std::vector<Real>& key,spatial_cell::SpatialCell* cell,const uint popID) const {
+      const InitialDistribution* entry = NULL;
+      #pragma omp critical(initialDistributionCache)
+      {
+         ++initialDistributionCacheLookups;
+         map<vector<Real>,InitialDistribution>::const_iterator it = initialDistributionCache.find(key);
+         if (it != initialDistributionCache.end()) {
+            ++initialDistributionCacheHits;
+            entry = &(it->second);
+         }
+      }
+      if (entry == NULL) return false;
+
+      // Entries are never modified or erased while cells are being set, so the
+      // copy can be done outside the critical section
+      if (entry->blocks.size() > 0) {
+         cell->add_velocity_blocks(entry->blocks,popID);
+         memcpy(cell->get_data(popID),entry->data.data(),entry->data.size()*sizeof(Realf));
+      }
+      return true;
+   }
+
+   void Project::storeInInitialDistributionCache(const std::vector<Real>& key,const spatial_cell::SpatialCell* cell,const uint popID) const {
+      InitialDistribution entry;
+      const vmesh::LocalID nBlocks = cell->get_number_of_velocity_blocks(popID);
+      entry.blocks.resize(nBlocks);
+      for (vmesh::LocalID blockLID=0; blockLID<nBlocks; ++blockLID) {
+         entry.blocks[blockLID] = cell->get_velocity_block_global_id(blockLID,popID);
+      }
+      entry.data.assign(cell->get_data(popID),cell->get_data(popID) + nBlocks*WID3);
+
+      #pragma omp critical(initialDistributionCache)
+      {
+         if (initialDistributionCache.size() < initialDistributionCacheSize) {
+            // If another thread stored the same key meanwhile, insert keeps the existing entry
+            initialDistributionCache.insert(make_pair(key,std::move(entry)));
+         }
+      }
+   }
+
+   void Project::reportInitialDistributionCache() {
+      uint64_t counts[3] = {initialDistributionCacheHits,initialDistributionCacheLookups,initialDistributionCache.size()};
+      uint64_t globalCounts[3];
+      MPI_Reduce(counts,globalCounts,3,MPI_UINT64_T,MPI_SUM,MASTER_RANK,MPI_COMM_WORLD);
+      if (initialDistributionCacheSize > 0) {
+         logFile << "(PROJECT): Initial distribution cache: " << globalCounts[0] << " hits in " << globalCounts[1] << " lookups";
+         if (globalCounts[1] > 0) logFile << " (" << 100.0*globalCounts[0]/globalCounts[1] << "%)";
+         logFile << ", " << globalCounts[2] << " distributions computed and cached" << endl << writeVerbose;
+      }
+
+      initialDistributionCacheActive = false;
+      map<vector<Real>,InitialDistribution>().swap(initialDistributionCache);
+   }
+
    /** Check if the project wants to rescale densities.
     * @param popID ID of the particle species.
     * @return If true, rescaleDensity is called for this species.*/
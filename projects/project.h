@@ -27,6 +27,8 @@
 #include <dccrg.hpp>
 #include <dccrg_cartesian_geometry.hpp>
 #include "fsgrid.hpp"
+#include <map>
+#include <vector>
 
 namespace projects {
    class Project {
@@ -73,6 +75,27 @@ namespace projects {
        */
       virtual void setupBeforeSetCell(const std::vector<CellID>& cells);
 
+      /** Estimate the number of velocity blocks the initial distribution of the given population will
+       * have in the given spatial cell, without creating any blocks. This is used as the load balance
+       * weight of the startup partition, which is made before velocity space is filled. The base
+       * class returns 1, i.e. all cells are weighted equally.
+       * NOTE: This function is called inside parallel region so it must be declared as const.
+       * @param x Starting value of the x-coordinate of the cell.
+       * @param y Starting value of the y-coordinate of the cell.
+       * @param z Starting value of the z-coordinate of the cell.
+       * @param dx The size of the cell in x-direction.
+       * @param dy The size of the cell in y-direction.
+       * @param dz The size of the cell in z-direction.
+       * @param popID Particle species ID.
+       * @return Estimated number of velocity blocks.*/
+      virtual Real estimateVelocityBlocks(creal& x, creal& y, creal& z, creal& dx, creal& dy, creal& dz, const uint popID) const;
+
+      /*! Write the hit rate of the initial distribution cache to logfile and release the cache.
+       * Cells initialised with setCell after this call are computed without the cache.
+       * Collective operation on MPI_COMM_WORLD.
+       */
+      void reportInitialDistributionCache();
+
       /*!\brief Set the perturbed fields and distribution of a cell according to the default simulation settings.
        * This is used for the NOT_SYSBOUNDARY cells and some other system boundary conditions (e.g. Outflow).
        * NOTE: This function is called inside parallel region so it must be declared as const.
@@ -141,6 +164,59 @@ namespace projects {
                                          creal& dvx, creal& dvy, creal& dvz,
                                          const uint popID) const = 0;
       
+      /** Calculate the volume averages of the distribution function in all phase-space cells of a velocity block.
+       * The default implementation calls calcPhaseSpaceDensity once per velocity cell. Projects with an
+       * analytic distribution should override this to evaluate the whole block at once.
+       * NOTE: This function is called inside parallel region so it must be declared as const.
+       * @param x Starting value of the x-coordinate of the spatial cell.
+       * @param y Starting value of the y-coordinate of the spatial cell.
+       * @param z Starting value of the z-coordinate of the spatial cell.
+       * @param dx The size of the spatial cell in x-direction.
+       * @param dy The size of the spatial cell in y-direction.
+       * @param dz The size of the spatial cell in z-direction.
+       * @param vxBlock Starting value of the vx-coordinate of the velocity block.
+       * @param vyBlock Starting value of the vy-coordinate of the velocity block.
+       * @param vzBlock Starting value of the vz-coordinate of the velocity block.
+       * @param dvx The size of a velocity cell in vx-direction.
+       * @param dvy The size of a velocity cell in vy-direction.
+       * @param dvz The size of a velocity cell in vz-direction.
+       * @param nvx Number of velocity cells to evaluate in vx-direction (WID, or 1 if vx is not used).
+       * @param nvy Number of velocity cells to evaluate in vy-direction (WID, or 1 if vy is not used).
+       * @param nvz Number of velocity cells to evaluate in vz-direction (WID, or 1 if vz is not used).
+       * @param popID Particle species ID.
+       * @param values Array of WID3 values, indexed with cellIndex, where the volume averages are written.
+       * Cells outside nvx*nvy*nvz are not touched.*/
+      virtual void calcPhaseSpaceDensityBlock(
+                                              creal& x, creal& y, creal& z,
+                                              creal& dx, creal& dy, creal& dz,
+                                              creal& vxBlock, creal& vyBlock, creal& vzBlock,
+                                              creal& dvx, creal& dvy, creal& dvz,
+                                              cuint nvx, cuint nvy, cuint nvz,
+                                              const uint popID, Real* values) const;
+      
+      /** Add samples of a drifting (bi-)Maxwellian, amplitude*exp(-sum_d coeff[d]*(v_d-V0[d])^2), to each
+       * velocity cell of a block. In each direction the cells are sampled at nSamples points
+       * v = cell start + (sampleStart + s*sampleStep)*dv, and the sum over all nSamples^3 sample points
+       * of a cell is added to values. The distribution is separable, so only 3*WID*nSamples
+       * exponentials are evaluated per block instead of WID3*nSamples^3.
+       * @param values Array of WID3 values, indexed with cellIndex.*/
+      void addMaxwellianSamplesToBlock(
+                                       creal& vxBlock, creal& vyBlock, creal& vzBlock,
+                                       creal& dvx, creal& dvy, creal& dvz,
+                                       cuint nvx, cuint nvy, cuint nvz,
+                                       cuint nSamples, creal& sampleStart, creal& sampleStep,
+                                       creal& amplitude, const std::array<Real, 3>& V0, const std::array<Real, 3>& coeff,
+                                       Real* values) const;
+      
+      /** Estimate the number of velocity blocks of a drifting (bi-)Maxwellian with the given number
+       * density and temperatures. The ellipsoid where the distribution exceeds the sparsity threshold,
+       * padded with the sparse block add width, is compared to the block volume of the velocity mesh.
+       * @param popID Particle species ID.
+       * @param rho Number density.
+       * @param T Temperatures along vx, vy and vz.
+       * @return Estimated number of velocity blocks, at most the number of blocks in the mesh.*/
+      Real estimateMaxwellianBlocks(const uint popID,creal& rho,const std::array<Real, 3>& T) const;
+      
       /*!
        Get random number between 0 and 1.0. One should always first initialize the rng.
        */
@@ -148,6 +224,17 @@ namespace projects {
          
       void printPopulations();
       
+      /** Collect the parameters that fully determine the initial distribution of the given
+       * population in the given cell, e.g. density, bulk velocity and temperature. Cells with
+       * bit-identical keys get their velocity space copied from the initial distribution cache
+       * instead of recomputing it. The base class returns false, i.e. the distribution is not cached.
+       * NOTE: This function is called inside parallel region so it must be declared as const.
+       * @param cell Spatial cell, calcCellParameters has already been called for it.
+       * @param popID Particle species ID.
+       * @param key Parameters of the distribution are appended here.
+       * @return If true, the distribution depends on key only and can be cached.*/
+      virtual bool getInitialDistributionKey(const spatial_cell::SpatialCell* cell,const uint popID,std::vector<Real>& key) const;
+      
       virtual bool rescalesDensity(const uint popID) const;
       void rescaleDensity(spatial_cell::SpatialCell* cell,const uint popID) const;
       
@@ -171,6 +258,20 @@ namespace projects {
       #pragma omp threadprivate(rngStateBuffer,rngDataBuffer)
 
       bool baseClassInitialized;                      /**< If true, base class has been initialized.*/
+
+      /** Velocity space of one population as set by setVelocitySpace, blocks in local ID order.*/
+      struct InitialDistribution {
+         std::vector<vmesh::GlobalID> blocks;
+         std::vector<Realf> data;
+      };
+      bool copyFromInitialDistributionCache(const std::vector<Real>& key,spatial_cell::SpatialCell* cell,const uint popID) const;
+      void storeInInitialDistributionCache(const std::vector<Real>& key,const spatial_cell::SpatialCell* cell,const uint popID) const;
+
+      uint initialDistributionCacheSize;              /**< Maximum number of cached distributions, 0 disables the cache.*/
+      mutable bool initialDistributionCacheActive;    /**< If false, the cache has been released after initialisation.*/
+      mutable std::map<std::vector<Real>,InitialDistribution> initialDistributionCache; /**< Cached distributions, keyed by popID followed by getInitialDistributionKey.*/
+      mutable uint64_t initialDistributionCacheLookups;
+      mutable uint64_t initialDistributionCacheHits;
    };
    
    Project* createProject();
@@ -20,6 +20,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <cstring>
 #include <unordered_set>
 #include <vectorclass.h>
 
@@ -41,6 +42,7 @@ namespace spatial_cell {
    SpatialCell::SpatialCell() {
       // Block list and cache always have room for all blocks
       this->sysBoundaryLayer=0; // Default value, layer not yet initialized
+      this->homeThread=0;
       for (unsigned int i=0; i<WID3; ++i) null_block_data[i] = 0.0;
 
       // reset spatial cell parameters
@@ -60,7 +62,7 @@ namespace spatial_cell {
       
       //is transferred by default
       this->mpiTransferEnabled=true;
-      
+
       // Set correct number of populations
       populations.resize(getObjectWrapper().particleSpecies.size());
       
@@ -70,20 +72,22 @@ namespace spatial_cell {
          populations[popID].vmesh.initialize(spec.velocityMesh);
          populations[popID].velocityBlockMinValue = spec.sparseMinValue;
          populations[popID].N_blocks = 0;
+         for (int i=0; i<3; ++i) populations[popID].velocityExtent[i] = 0.0;
+         populations[popID].velocityExtentValid = true;
       }
    }
 
    SpatialCell::SpatialCell(const SpatialCell& other):
      sysBoundaryFlag(other.sysBoundaryFlag),
      sysBoundaryLayer(other.sysBoundaryLayer),
-     velocity_block_with_content_list(other.velocity_block_with_content_list),
-     velocity_block_with_no_content_list(other.velocity_block_with_no_content_list),
+     homeThread(other.homeThread),
      initialized(other.initialized),
      mpiTransferEnabled(other.mpiTransferEnabled),
      populations(other.populations),
      parameters(other.parameters),
      derivativesBVOL(other.derivativesBVOL),
      null_block_data(std::array<Realf,WID3> {}) {
+      for (size_t p=0; p<populations.size(); ++p) populations[p].contentListsValid = false;
    }
 
    /** Adds "important" and removes "unimportant" velocity blocks
@@ -129,8 +133,8 @@ namespace spatial_cell {
       //add neighbor content info for velocity space neighbors to map. We loop over blocks
       //with content and raise the neighbors_have_content for
       //itself, and for all its neighbors
-      for (vmesh::LocalID block_index=0; block_index<velocity_block_with_content_list.size(); ++block_index) {
-         vmesh::GlobalID block = velocity_block_with_content_list[block_index];
+      for (vmesh::LocalID block_index=0; block_index<populations[popID].velocity_block_with_content_list.size(); ++block_index) {
+         vmesh::GlobalID block = populations[popID].velocity_block_with_content_list[block_index];
 
          const uint8_t refLevel=0;
          const velocity_block_indices_t indices = SpatialCell::get_velocity_block_indices(popID,block);
@@ -153,8 +157,8 @@ namespace spatial_cell {
       //flag for the local block with same block id
       for (std::vector<SpatialCell*>::const_iterator neighbor=spatial_neighbors.begin();
            neighbor != spatial_neighbors.end(); ++neighbor) {
-         for (vmesh::LocalID block_index=0; block_index<(*neighbor)->velocity_block_with_content_list.size(); ++block_index) {
-            vmesh::GlobalID block = (*neighbor)->velocity_block_with_content_list[block_index];
+         for (vmesh::LocalID block_index=0; block_index<(*neighbor)->populations[popID].velocity_block_with_content_list.size(); ++block_index) {
+            vmesh::GlobalID block = (*neighbor)->populations[popID].velocity_block_with_content_list[block_index];
             neighbors_have_content.insert(block);
          }
       }
@@ -163,8 +167,8 @@ namespace spatial_cell {
       // better to do it in the reverse order, as then blocks at the
       // end are removed first, and we may avoid copying extra data.
       if (doDeleteEmptyBlocks) {
-         for (int block_index= this->velocity_block_with_no_content_list.size()-1; block_index>=0; --block_index) {
-            const vmesh::GlobalID blockGID = velocity_block_with_no_content_list[block_index];
+         for (int block_index= populations[popID].velocity_block_with_no_content_list.size()-1; block_index>=0; --block_index) {
+            const vmesh::GlobalID blockGID = populations[popID].velocity_block_with_no_content_list[block_index];
             #ifdef DEBUG_SPATIAL_CELL
             if (blockGID == invalid_global_id()) {
                cerr << "Got invalid block at " << __FILE__ << ' ' << __LINE__ << endl; 
@@ -217,8 +221,8 @@ namespace spatial_cell {
       //  we only check for removal for blocks with no content
       std::unordered_set<vmesh::GlobalID> neighbors_have_content;
 
-      for (vmesh::LocalID block_index=0; block_index<velocity_block_with_content_list.size(); ++block_index) {
-         vmesh::GlobalID blockGID = velocity_block_with_content_list[block_index];
+      for (vmesh::LocalID block_index=0; block_index<populations[popID].velocity_block_with_content_list.size(); ++block_index) {
+         vmesh::GlobalID blockGID = populations[popID].velocity_block_with_content_list[block_index];
          vector<vmesh::GlobalID> neighborGIDs;
          populations[popID].vmesh.getNeighborsExistingAtSameLevel(blockGID,neighborGIDs);
          neighbors_have_content.insert(neighborGIDs.begin(),neighborGIDs.end());
@@ -231,8 +235,8 @@ namespace spatial_cell {
       unordered_set<vmesh::GlobalID> spat_nbr_has_content;
       for (std::vector<SpatialCell*>::const_iterator neighbor=spatial_neighbors.begin();
            neighbor != spatial_neighbors.end(); ++neighbor) {
-         for (vmesh::LocalID block_index=0; block_index<(*neighbor)->velocity_block_with_content_list.size(); ++block_index) {
-            vmesh::GlobalID block = (*neighbor)->velocity_block_with_content_list[block_index];
+         for (vmesh::LocalID block_index=0; block_index<(*neighbor)->populations[popID].velocity_block_with_content_list.size(); ++block_index) {
+            vmesh::GlobalID block = (*neighbor)->populations[popID].velocity_block_with_content_list[block_index];
             spat_nbr_has_content.insert(block);
          }
       }      
@@ -241,8 +245,8 @@ namespace spatial_cell {
       // better to do it in the reverse order, as then blocks at the
       // end are removed first, and we may avoid copying extra data.
       if (doDeleteEmptyBlocks) {
-         for (int block_index= this->velocity_block_with_no_content_list.size()-1; block_index>=0; --block_index) {
-            const vmesh::GlobalID blockGID = this->velocity_block_with_no_content_list[block_index];
+         for (int block_index= populations[popID].velocity_block_with_no_content_list.size()-1; block_index>=0; --block_index) {
+            const vmesh::GlobalID blockGID = populations[popID].velocity_block_with_no_content_list[block_index];
             #ifdef DEBUG_SPATIAL_CELL
                if (blockGID == invalid_global_id()) {
                   cerr << "Got invalid block at " << __FILE__ << ' ' << __LINE__ << endl;
@@ -527,17 +531,7 @@ namespace spatial_cell {
       const vmesh::LocalID blockLID = get_velocity_block_local_id(blockGID,popID);
       if (blockLID == invalid_local_id()) return false;
             
-      bool has_content = false;
-      const Real velocity_block_min_value = getVelocityBlockMinValue(popID);
-      const Realf* block_data = populations[popID].blockContainer.getData(blockLID);
-      for (unsigned int i=0; i<VELOCITY_BLOCK_LENGTH; ++i) {
-         if (block_data[i] >= velocity_block_min_value) {
-            has_content = true;
-            break;
-         }
-      }
-      
-      return has_content;
+      return velocity_block_has_content(populations[popID].blockContainer.getData(blockLID),getVelocityBlockMinValue(popID));
    }
    
    /** Get maximum translation timestep for the given species.
@@ -570,6 +564,207 @@ namespace spatial_cell {
       return populations[popID].max_dt[species::MAXVDT];
    }
 
+   /** Get the velocity extent of the given species, i.e. the largest |v| of the outermost
+    * velocity cell centres of all blocks along vx, vy and vz. The extent is kept up to date
+    * when blocks are added and only recomputed from the block parameters after outermost
+    * blocks have been removed or the mesh has been replaced.
+    * @param popID ID of the particle species.
+    * @return Pointer to the three extents.*/
+   const Real* SpatialCell::get_velocity_extent(const uint popID) {
+      #ifdef DEBUG_SPATIAL_CELL
+      if (popID >= populations.size()) {
+         std::cerr << "ERROR, popID " << popID << " exceeds populations.size() " << populations.size() << " in ";
+         std::cerr << __FILE__ << ":" << __LINE__ << std::endl;             
+         exit(1);
+      }
+      #endif
+
+      Population& pop = populations[popID];
+      if (pop.velocityExtentValid == false) {
+         const Real* blockParams = pop.blockContainer.getParameters();
+         const vmesh::LocalID nBlocks = pop.blockContainer.size();
+         Real vx = 0.0, vy = 0.0, vz = 0.0;
+         for (vmesh::LocalID blockLID=0; blockLID<nBlocks; ++blockLID) {
+            const Real* p = blockParams + blockLID*BlockParams::N_VELOCITY_BLOCK_PARAMS;
+            vx = max(vx,max(fabs(p[BlockParams::VXCRD] + 0.5*p[BlockParams::DVX]),fabs(p[BlockParams::VXCRD] + (WID-0.5)*p[BlockParams::DVX])));
+            vy = max(vy,max(fabs(p[BlockParams::VYCRD] + 0.5*p[BlockParams::DVY]),fabs(p[BlockParams::VYCRD] + (WID-0.5)*p[BlockParams::DVY])));
+            vz = max(vz,max(fabs(p[BlockParams::VZCRD] + 0.5*p[BlockParams::DVZ]),fabs(p[BlockParams::VZCRD] + (WID-0.5)*p[BlockParams::DVZ])));
+         }
+         pop.velocityExtent[0] = vx;
+         pop.velocityExtent[1] = vy;
+         pop.velocityExtent[2] = vz;
+         pop.velocityExtentValid = true;
+      }
+      return pop.velocityExtent;
+   }
+
+   /** Spread the lowest 10 bits of x to every third bit.*/
+   static inline uint32_t spreadBlockIndex(uint32_t x) {
+      x &= 0x3ff;
+      x = (x | x << 16) & 0x30000ff;
+      x = (x | x << 8)  & 0x300f00f;
+      x = (x | x << 4)  & 0x30c30c3;
+      x = (x | x << 2)  & 0x9249249;
+      return x;
+   }
+
+   /** Reorder the velocity blocks of the given population into bricks: the blocks are
+    * stored in Morton order of their indices, so every aligned 2x2x2, 4x4x4, ... group of
+    * existing blocks is contiguous in memory. The blocks of a velocity column are then
+    * close to each other whatever the sweep dimension of the acceleration is. Block
+    * global IDs, and thus the content lists, are unchanged.
+    * @param popID ID of the particle species.*/
+   void SpatialCell::order_velocity_blocks(const uint popID) {
+      Population& pop = populations[popID];
+      const vmesh::LocalID nBlocks = pop.vmesh.size();
+      pop.blockOrderChanges = 0;
+
+      std::vector<std::pair<uint64_t,vmesh::LocalID> > keys(nBlocks);
+      bool ordered = true;
+      for (vmesh::LocalID b=0; b<nBlocks; ++b) {
+         uint8_t refLevel;
+         vmesh::LocalID i,j,k;
+         pop.vmesh.getIndices(pop.vmesh.getGlobalID(b),refLevel,i,j,k);
+         // Refinement level is the most significant part so that levels do not interleave
+         keys[b].first = ((uint64_t)refLevel << 32) | spreadBlockIndex(i) | spreadBlockIndex(j) << 1 | spreadBlockIndex(k) << 2;
+         keys[b].second = b;
+         if (b > 0 && keys[b].first < keys[b-1].first) ordered = false;
+      }
+      if (ordered) return;
+      std::sort(keys.begin(),keys.end());
+
+      std::vector<vmesh::LocalID> order(nBlocks);
+      std::vector<vmesh::GlobalID> globalIDs(nBlocks);
+      for (vmesh::LocalID b=0; b<nBlocks; ++b) {
+         order[b] = keys[b].second;
+         globalIDs[b] = pop.vmesh.getGlobalID(keys[b].second);
+      }
+      pop.blockContainer.permute(order);
+      pop.vmesh.setGrid(globalIDs);
+   }
+
+   /** Convert a float with |value| <= 1 to an IEEE half precision float, rounding to nearest.
+    * Values below the smallest subnormal half are flushed to zero.*/
+   static inline uint16_t floatToHalf(const float value) {
+      uint32_t bits;
+      std::memcpy(&bits,&value,sizeof(float));
+      const uint16_t sign = (bits >> 16) & 0x8000;
+      const int exponent = (int)((bits >> 23) & 0xff) - 127 + 15;
+      uint32_t mantissa = bits & 0x7fffff;
+      if (exponent <= 0) {
+         if (exponent < -10) return sign;
+         mantissa |= 0x800000;
+         const int shift = 14 - exponent;
+         return sign | (uint16_t)((mantissa + (1u << (shift-1))) >> shift);
+      }
+      return sign | (uint16_t)(((uint32_t)exponent << 10) + ((mantissa + 0x1000) >> 13));
+   }
+
+   static inline float halfToFloat(const uint16_t half) {
+      const uint32_t sign = (uint32_t)(half & 0x8000) << 16;
+      const uint32_t exponent = (half >> 10) & 0x1f;
+      const uint32_t mantissa = half & 0x3ff;
+      if (exponent == 0) {
+         const float value = ldexp((float)mantissa,-24);
+         return sign ? -value : value;
+      }
+      const uint32_t bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+      float value;
+      std::memcpy(&value,&bits,sizeof(float));
+      return value;
+   }
+
+   /** Pack the block data of the given population into 16-bit half precision floats,
+    * scaled block by block with the largest absolute value in the block. This keeps a
+    * relative accuracy of about 5e-4 for values down to 6e-5 times the block maximum.
+    * The packed data is sent instead of the block data with Transfer::VEL_BLOCK_DATA_PACKED.
+    * @param popID ID of the particle species.*/
+   void SpatialCell::pack_block_data(const uint popID) {
+      Population& pop = populations[popID];
+      const vmesh::LocalID nBlocks = pop.blockContainer.size();
+      pop.packedBlockData.resize(nBlocks*WID3);
+      pop.packedBlockScales.resize(nBlocks);
+
+      const Realf* data = pop.blockContainer.getData();
+      for (vmesh::LocalID blockLID=0; blockLID<nBlocks; ++blockLID) {
+         const Realf* blockData = data + blockLID*WID3;
+         float scale = 0.0;
+         for (uint i=0; i<WID3; ++i) scale = max(scale,(float)fabs(blockData[i]));
+         pop.packedBlockScales[blockLID] = scale;
+
+         const float inverseScale = (scale > 0.0) ? 1.0/scale : 0.0;
+         uint16_t* packed = pop.packedBlockData.data() + blockLID*WID3;
+         for (uint i=0; i<WID3; ++i) packed[i] = floatToHalf(blockData[i]*inverseScale);
+      }
+   }
+
+   /** Unpack block data received with Transfer::VEL_BLOCK_DATA_PACKED into the block container.
+    * @param popID ID of the particle species.*/
+   void SpatialCell::unpack_block_data(const uint popID) {
+      Population& pop = populations[popID];
+      const vmesh::LocalID nBlocks = pop.blockContainer.size();
+      if (pop.packedBlockScales.size() < nBlocks) {
+         std::cerr << "ERROR, packed block data of " << pop.packedBlockScales.size() << " blocks in a cell with ";
+         std::cerr << nBlocks << " blocks in " << __FILE__ << ":" << __LINE__ << std::endl;
+         exit(1);
+      }
+
+      Realf* data = pop.blockContainer.getData();
+      for (vmesh::LocalID blockLID=0; blockLID<nBlocks; ++blockLID) {
+         const float scale = pop.packedBlockScales[blockLID];
+         const uint16_t* packed = pop.packedBlockData.data() + blockLID*WID3;
+         Realf* blockData = data + blockLID*WID3;
+         for (uint i=0; i<WID3; ++i) blockData[i] = halfToFloat(packed[i])*scale;
+      }
+      release_packed_block_data(popID);
+   }
+
+   /** Free the packed block data buffers of the given population. Called after the
+    * packed data has been unpacked on the receiving side, and after the transfer on the
+    * sending side, so that the buffers do not hold memory between translations.
+    * @param popID ID of the particle species.*/
+   void SpatialCell::release_packed_block_data(const uint popID) {
+      Population& pop = populations[popID];
+      std::vector<uint16_t>().swap(pop.packedBlockData);
+      std::vector<float>().swap(pop.packedBlockScales);
+   }
+
+   /** Compare the packed block data of the given population, as written by pack_block_data,
+    * with the block data it was packed from. Relative errors are accumulated for the values
+    * at or above the sparse threshold, the mass over all values. Results are added to the
+    * values already in the arguments.
+    * @param popID ID of the particle species.
+    * @param maxRelativeError Largest relative error of a value.
+    * @param sumSquaredRelativeError Sum of the squared relative errors.
+    * @param nValues Number of values the relative errors were computed for.
+    * @param mass Sum of the block data.
+    * @param packedMass Sum of the block data after a pack and unpack.*/
+   void SpatialCell::get_packed_block_data_error(const uint popID,Real& maxRelativeError,Real& sumSquaredRelativeError,
+                                                 uint64_t& nValues,Real& mass,Real& packedMass) const {
+      const Population& pop = populations[popID];
+      const vmesh::LocalID nBlocks = pop.blockContainer.size();
+      if (pop.packedBlockScales.size() < nBlocks) return;
+      const Real minValue = getVelocityBlockMinValue(popID);
+
+      const Realf* data = pop.blockContainer.getData();
+      for (vmesh::LocalID blockLID=0; blockLID<nBlocks; ++blockLID) {
+         const float scale = pop.packedBlockScales[blockLID];
+         const uint16_t* packed = pop.packedBlockData.data() + blockLID*WID3;
+         const Realf* blockData = data + blockLID*WID3;
+         for (uint i=0; i<WID3; ++i) {
+            const Real value = blockData[i];
+            const Real unpacked = halfToFloat(packed[i])*scale;
+            mass += value;
+            packedMass += unpacked;
+            if (value < minValue) continue;
+            const Real relativeError = fabs(unpacked-value)/value;
+            maxRelativeError = max(maxRelativeError,relativeError);
+            sumSquaredRelativeError += relativeError*relativeError;
+            ++nValues;
+         }
+      }
+   }
+
    /** Get MPI datatype for sending the cell data.
     * @param cellID Spatial cell (dccrg) ID.
     * @param sender_rank Rank of the MPI process sending data from this cell.
@@ -607,6 +802,7 @@ namespace spatial_cell {
             if (receiving) {
                //mpi_number_of_blocks transferred earlier
                populations[activePopID].vmesh.setNewSize(populations[activePopID].N_blocks);
+               populations[activePopID].velocityExtentValid = false;
             } else {
                 //resize to correct size (it will avoid reallocation if it is big enough, I assume)
                 populations[activePopID].N_blocks = populations[activePopID].blockContainer.size();
@@ -619,18 +815,20 @@ namespace spatial_cell {
 
          if ((SpatialCell::mpi_transfer_type & Transfer::VEL_BLOCK_WITH_CONTENT_STAGE1) !=0) {
             //Communicate size of list so that buffers can be allocated on receiving side
-            if (!receiving) this->velocity_block_with_content_list_size = this->velocity_block_with_content_list.size();
-            displacements.push_back((uint8_t*) &(this->velocity_block_with_content_list_size) - (uint8_t*) this);
+            Population& pop = populations[activePopID];
+            if (!receiving) pop.velocity_block_with_content_list_size = pop.velocity_block_with_content_list.size();
+            displacements.push_back((uint8_t*) &(pop.velocity_block_with_content_list_size) - (uint8_t*) this);
             block_lengths.push_back(sizeof(vmesh::LocalID));
          }
          if ((SpatialCell::mpi_transfer_type & Transfer::VEL_BLOCK_WITH_CONTENT_STAGE2) !=0) {
+            Population& pop = populations[activePopID];
             if (receiving) {
-               this->velocity_block_with_content_list.resize(this->velocity_block_with_content_list_size);
+               pop.velocity_block_with_content_list.resize(pop.velocity_block_with_content_list_size);
             }
 
             //velocity_block_with_content_list_size should first be updated, before this can be done (STAGE1)
-            displacements.push_back((uint8_t*) &(this->velocity_block_with_content_list[0]) - (uint8_t*) this);
-            block_lengths.push_back(sizeof(vmesh::GlobalID)*this->velocity_block_with_content_list_size);
+            displacements.push_back((uint8_t*) &(pop.velocity_block_with_content_list[0]) - (uint8_t*) this);
+            block_lengths.push_back(sizeof(vmesh::GlobalID)*pop.velocity_block_with_content_list_size);
          }
 
          if ((SpatialCell::mpi_transfer_type & Transfer::VEL_BLOCK_DATA) !=0) {
@@ -638,6 +836,19 @@ namespace spatial_cell {
             block_lengths.push_back(sizeof(Realf) * VELOCITY_BLOCK_LENGTH * populations[activePopID].blockContainer.size());
          }
 
+         if ((SpatialCell::mpi_transfer_type & Transfer::VEL_BLOCK_DATA_PACKED) !=0) {
+            // Sending side has been packed with pack_block_data, receiving side is unpacked after the transfer
+            Population& pop = populations[activePopID];
+            if (receiving) {
+               pop.packedBlockData.resize(pop.blockContainer.size()*WID3);
+               pop.packedBlockScales.resize(pop.blockContainer.size());
+            }
+            displacements.push_back((uint8_t*) pop.packedBlockScales.data() - (uint8_t*) this);
+            block_lengths.push_back(sizeof(float) * pop.packedBlockScales.size());
+            displacements.push_back((uint8_t*) pop.packedBlockData.data() - (uint8_t*) this);
+            block_lengths.push_back(sizeof(uint16_t) * pop.packedBlockData.size());
+         }
+
          if ((SpatialCell::mpi_transfer_type & Transfer::NEIGHBOR_VEL_BLOCK_DATA) != 0) {
             /*We are actually transferring the data of a
             * neighbor. The values of neighbor_block_data
@@ -1395,6 +1606,9 @@ namespace spatial_cell {
    }
 
    /** Update the two lists containing blocks with content, and blocks without content.
+    * If the acceleration solver already filled the lists for this population with the
+    * current sparse threshold (see set_velocity_block_content_lists_valid), they are
+    * used as they are. Otherwise the blocks are scanned in local ID order.
     * @see adjustVelocityBlocks */
    void SpatialCell::update_velocity_block_content_lists(const uint popID) {
       #ifdef DEBUG_SPATIAL_CELL
@@ -1404,19 +1618,50 @@ namespace spatial_cell {
          exit(1);
       }
       #endif
-      
-      velocity_block_with_content_list.clear();
-      velocity_block_with_no_content_list.clear();
-      
-      for (vmesh::LocalID block_index=0; block_index<populations[popID].vmesh.size(); ++block_index) {
+
+      Population& pop = populations[popID];
+      const Real velocity_block_min_value = getVelocityBlockMinValue(popID);
+      const vmesh::LocalID nBlocks = pop.vmesh.size();
+      const bool listsValid = (pop.contentListsValid
+                               && pop.contentListsMinValue == velocity_block_min_value
+                               && pop.velocity_block_with_content_list.size() + pop.velocity_block_with_no_content_list.size() == nBlocks);
+      pop.contentListsValid = false;
+      if (listsValid) return;
+
+      pop.velocity_block_with_content_list.clear();
+      pop.velocity_block_with_no_content_list.clear();
+
+      const Realf* data = populations[popID].blockContainer.getData();
+      for (vmesh::LocalID block_index=0; block_index<nBlocks; ++block_index) {
          const vmesh::GlobalID globalID = populations[popID].vmesh.getGlobalID(block_index);
-         if (compute_block_has_content(globalID,popID)){
-            velocity_block_with_content_list.push_back(globalID);
+         if (velocity_block_has_content(data + block_index*WID3,velocity_block_min_value)) {
+            pop.velocity_block_with_content_list.push_back(globalID);
          } else {
-            velocity_block_with_no_content_list.push_back(globalID);
+            pop.velocity_block_with_no_content_list.push_back(globalID);
          }
       }
    }
+
+   /** Mark the content lists as filled for the given population. Called by the acceleration
+    * solver after it has pushed every block of the population into either
+    * velocity_block_with_content_list or velocity_block_with_no_content_list, using the
+    * threshold returned by getVelocityBlockMinValue. The next call to
+    * update_velocity_block_content_lists for the same population then skips the scan
+    * over the block data. The lists and the flag are kept separately for each population,
+    * so accelerating several populations before their block adjustment is safe.
+    * @param popID Population ID.*/
+   void SpatialCell::set_velocity_block_content_lists_valid(const uint popID) {
+      #ifdef DEBUG_SPATIAL_CELL
+      if (popID >= populations.size()) {
+         std::cerr << "ERROR, popID " << popID << " exceeds populations.size() " << populations.size() << " in ";
+         std::cerr << __FILE__ << ":" << __LINE__ << std::endl;
+         exit(1);
+      }
+      #endif
+
+      populations[popID].contentListsValid = true;
+      populations[popID].contentListsMinValue = getVelocityBlockMinValue(popID);
+   }
    
    void SpatialCell::printMeshSizes() {
       cerr << "SC::printMeshSizes:" << endl;
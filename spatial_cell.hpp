@@ -117,6 +117,7 @@ namespace spatial_cell {
       const uint64_t POP_METADATA             = (1ull<<26);
       const uint64_t RANDOMGEN                = (1ull<<27);
       const uint64_t CELL_GRADPE_TERM         = (1ull<<28);
+      const uint64_t VEL_BLOCK_DATA_PACKED    = (1ull<<29); /**< Block data packed to 16 bits, see pack_block_data.*/
       //all data
       const uint64_t ALL_DATA =
       CELL_PARAMETERS
@@ -169,8 +170,37 @@ namespace spatial_cell {
                                                                       * in this spatial cell. Cells are identified by their unique 
                                                                       * global IDs.*/
       vmesh::VelocityBlockContainer<vmesh::LocalID> blockContainer;  /**< Velocity block data.*/
+      Real velocityExtent[3];                                        /**< Largest |v| of the outermost velocity cells of all blocks
+                                                                      * along vx, vy and vz. Updated when blocks are added.*/
+      bool velocityExtentValid;                                      /**< If false, velocityExtent is recomputed on the next request.*/
+      std::vector<uint16_t> packedBlockData;                         /**< Block data as 16-bit floats scaled by packedBlockScales,
+                                                                      * only used for Transfer::VEL_BLOCK_DATA_PACKED.*/
+      std::vector<float> packedBlockScales;                          /**< Largest absolute value in each packed block.*/
+      std::vector<vmesh::GlobalID> velocity_block_with_content_list; /**< List of existing blocks with content, only up-to-date after
+                                                                      * call to update_velocity_block_content_lists().*/
+      vmesh::LocalID velocity_block_with_content_list_size;          /**< Size of vector. Needed for MPI communication of size before actual list transfer.*/
+      std::vector<vmesh::GlobalID> velocity_block_with_no_content_list; /**< List of existing blocks with no content, only up-to-date after
+                                                                      * call to update_velocity_block_content_lists. This is also never
+                                                                      * transferred over MPI, so is invalid on remote cells.*/
+      bool contentListsValid = false;                                /**< True if the acceleration solver filled the content lists.*/
+      Real contentListsMinValue = 0.0;                               /**< Sparse threshold used when the lists were filled.*/
+      vmesh::LocalID blockOrderChanges = 0;                          /**< Blocks added or moved since order_velocity_blocks was last called.*/
    };
 
+   /** Returns true if any value of the velocity block is at or above the sparse threshold.
+    * The block is scanned one WID2 plane at a time without branches inside a plane, so the
+    * comparisons of a plane vectorize, and the scan stops at the first plane with content.
+    * @param data Block data, WID3 values.
+    * @param minValue Sparse threshold of the population.*/
+   inline bool velocity_block_has_content(const Realf* data,const Real minValue) {
+      for (unsigned int k=0; k<WID; ++k) {
+         bool planeHasContent = false;
+         for (unsigned int i=0; i<WID2; ++i) planeHasContent |= (data[k*WID2+i] >= minValue);
+         if (planeHasContent) return true;
+      }
+      return false;
+   }
+
    class SpatialCell {
    public:
       SpatialCell();
@@ -207,6 +237,7 @@ namespace spatial_cell {
       uint8_t get_maximum_refinement_level(const uint popID);
       const Real& get_max_r_dt(const uint popID) const;
       const Real& get_max_v_dt(const uint popID) const;
+      const Real* get_velocity_extent(const uint popID);
 
       const vmesh::LocalID* get_velocity_grid_length(const uint popID,const uint8_t& refLevel=0);
       const Real* get_velocity_grid_block_size(const uint popID,const uint8_t& refLevel=0);
@@ -268,6 +299,7 @@ namespace spatial_cell {
                                   const uint popID,
                                   bool doDeleteEmptyBlocks=true);
       void update_velocity_block_content_lists(const uint popID);
+      void set_velocity_block_content_lists_valid(const uint popID);
       bool checkMesh(const uint popID);
       void clear(const uint popID);
       void coarsen_block(const vmesh::GlobalID& parent,const std::vector<vmesh::GlobalID>& children,const uint popID);
@@ -275,10 +307,17 @@ namespace spatial_cell {
       uint64_t get_cell_memory_capacity();
       uint64_t get_cell_memory_size();
       void merge_values(const uint popID);
+      void order_velocity_blocks(const uint popID);
+      void pack_block_data(const uint popID);
+      void unpack_block_data(const uint popID);
+      void release_packed_block_data(const uint popID);
+      void get_packed_block_data_error(const uint popID,Real& maxRelativeError,Real& sumSquaredRelativeError,
+                                       uint64_t& nValues,Real& mass,Real& packedMass) const;
       void prepare_to_receive_blocks(const uint popID);
       bool shrink_to_fit();
       size_t size(const uint popID) const;
       void remove_velocity_block(const vmesh::GlobalID& block,const uint popID);
+      void invalidate_velocity_extent(const uint popID);
       void swap(vmesh::VelocityMesh<vmesh::GlobalID,vmesh::LocalID>& vmesh,
                 vmesh::VelocityBlockContainer<vmesh::LocalID>& blockContainer,const uint popID);
       vmesh::VelocityMesh<vmesh::GlobalID,vmesh::LocalID>& get_velocity_mesh(const size_t& popID);
@@ -334,13 +373,9 @@ namespace spatial_cell {
                                                                                * Enumerated in the sysboundarytype namespace's enum.*/
       uint sysBoundaryLayer;                                                  /**< Layers counted from closest systemBoundary. If 0 then it has not 
                                                                                * been computed. First sysboundary layer is layer 1.*/
+      uint homeThread;                                                        /**< OpenMP thread that allocates and preferably updates the velocity
+                                                                               * blocks of this cell, see cell_affinity.h.*/
       int sysBoundaryLayerNew;
-      std::vector<vmesh::GlobalID> velocity_block_with_content_list;          /**< List of existing cells with content, only up-to-date after
-                                                                               * call to update_has_content().*/
-      vmesh::LocalID velocity_block_with_content_list_size;                   /**< Size of vector. Needed for MPI communication of size before actual list transfer.*/
-      std::vector<vmesh::GlobalID> velocity_block_with_no_content_list;       /**< List of existing cells with no content, only up-to-date after
-                                                                               * call to update_has_content. This is also never transferred
-                                                                               * over MPI, so is invalid on remote cells.*/
       static uint64_t mpi_transfer_type;                                      /**< Which data is transferred by the mpi datatype given by spatial cells.*/
       static bool mpiTransferAtSysBoundaries;                                 /**< Do we only transfer data at boundaries (true), or in the whole system (false).*/
 
@@ -349,6 +384,8 @@ namespace spatial_cell {
       //SpatialCell& operator=(const SpatialCell&);
       
       bool compute_block_has_content(const vmesh::GlobalID& block,const uint popID) const;
+      static void add_block_velocity_extent(const Real* blockParameters,Real* extent);
+
       void merge_values_recursive(const uint popID,vmesh::GlobalID parentGID,vmesh::GlobalID blockGID,uint8_t refLevel,bool recursive,const Realf* data,
 				  std::set<vmesh::GlobalID>& blockRemovalList);
 
@@ -1592,6 +1629,9 @@ namespace spatial_cell {
        
       populations[popID].vmesh.clear();
       populations[popID].blockContainer.clear();
+      for (int i=0; i<3; ++i) populations[popID].velocityExtent[i] = 0.0;
+      populations[popID].velocityExtentValid = true;
+      populations[popID].contentListsValid = false;
     }
 
    /*!
@@ -1605,14 +1645,14 @@ namespace spatial_cell {
       size += blockContainerTemp.sizeInBytes();
       size += 2 * WID3 * sizeof(Realf);
       //size += mpi_velocity_block_list.size() * sizeof(vmesh::GlobalID);
-      size += velocity_block_with_content_list.size() * sizeof(vmesh::GlobalID);
-      size += velocity_block_with_no_content_list.size() * sizeof(vmesh::GlobalID);
       size += CellParams::N_SPATIAL_CELL_PARAMS * sizeof(Real);
       size += bvolderivatives::N_BVOL_DERIVATIVES * sizeof(Real);
 
       for (size_t p=0; p<populations.size(); ++p) {
           size += populations[p].vmesh.sizeInBytes();
           size += populations[p].blockContainer.sizeInBytes();
+          size += populations[p].velocity_block_with_content_list.size() * sizeof(vmesh::GlobalID);
+          size += populations[p].velocity_block_with_no_content_list.size() * sizeof(vmesh::GlobalID);
       }
 
       return size;
@@ -1630,14 +1670,16 @@ namespace spatial_cell {
       capacity += blockContainerTemp.capacityInBytes();
       capacity += 2 * WID3 * sizeof(Realf);
       //capacity += mpi_velocity_block_list.capacity()  * sizeof(vmesh::GlobalID);
-      capacity += velocity_block_with_content_list.capacity()  * sizeof(vmesh::GlobalID);
-      capacity += velocity_block_with_no_content_list.capacity()  * sizeof(vmesh::GlobalID);
       capacity += CellParams::N_SPATIAL_CELL_PARAMS * sizeof(Real);
       capacity += bvolderivatives::N_BVOL_DERIVATIVES * sizeof(Real);
       
       for (size_t p=0; p<populations.size(); ++p) {
         capacity += populations[p].vmesh.capacityInBytes();
         capacity += populations[p].blockContainer.capacityInBytes();
+        capacity += populations[p].packedBlockData.capacity() * sizeof(uint16_t);
+        capacity += populations[p].packedBlockScales.capacity() * sizeof(float);
+        capacity += populations[p].velocity_block_with_content_list.capacity() * sizeof(vmesh::GlobalID);
+        capacity += populations[p].velocity_block_with_no_content_list.capacity() * sizeof(vmesh::GlobalID);
       }
       
       return capacity;
@@ -1666,6 +1708,7 @@ namespace spatial_cell {
       }
 
       const vmesh::LocalID VBC_LID = populations[popID].blockContainer.push_back();
+      ++populations[popID].blockOrderChanges;
 
       // Set block data to zero values:
       Realf* data = populations[popID].blockContainer.getData(VBC_LID);
@@ -1678,6 +1721,7 @@ namespace spatial_cell {
       parameters[BlockParams::VYCRD] = get_velocity_block_vy_min(popID,block);
       parameters[BlockParams::VZCRD] = get_velocity_block_vz_min(popID,block);
       populations[popID].vmesh.getCellSize(block,&(parameters[BlockParams::DVX]));
+      if (populations[popID].velocityExtentValid) add_block_velocity_extent(parameters,populations[popID].velocityExtent);
 
       // The following call 'should' be the fastest, but is actually 
       // much slower that the parameter setting above
@@ -1703,6 +1747,7 @@ namespace spatial_cell {
 
       // Add blocks to block container
       vmesh::LocalID startLID = populations[popID].blockContainer.push_back(blocks.size());
+      populations[popID].blockOrderChanges += blocks.size();
       Real* parameters = populations[popID].blockContainer.getParameters(startLID);
 
       #ifdef DEBUG_SPATIAL_CELL
@@ -1717,6 +1762,7 @@ namespace spatial_cell {
          parameters[BlockParams::VYCRD] = get_velocity_block_vy_min(popID,blocks[b]);
          parameters[BlockParams::VZCRD] = get_velocity_block_vz_min(popID,blocks[b]);
          populations[popID].vmesh.getCellSize(blocks[b],&(parameters[BlockParams::DVX]));
+         if (populations[popID].velocityExtentValid) add_block_velocity_extent(parameters,populations[popID].velocityExtent);
          parameters += BlockParams::N_VELOCITY_BLOCK_PARAMS;
       }
    }
@@ -1814,6 +1860,15 @@ namespace spatial_cell {
          return;
       }
 
+      // The extent only has to be recomputed if the removed block was one of the outermost ones
+      if (populations[popID].velocityExtentValid) {
+         Real extent[3] = {0.0,0.0,0.0};
+         add_block_velocity_extent(get_block_parameters(removedLID,popID),extent);
+         for (int i=0; i<3; ++i) {
+            if (extent[i] >= populations[popID].velocityExtent[i]) populations[popID].velocityExtentValid = false;
+         }
+      }
+
       // Get local ID of the last block:
       const vmesh::LocalID lastLID = populations[popID].vmesh.size()-1;
 
@@ -1822,6 +1877,7 @@ namespace spatial_cell {
 
       populations[popID].blockContainer.copy(lastLID,removedLID);
       populations[popID].blockContainer.pop();
+      ++populations[popID].blockOrderChanges;
    }
 
    inline void SpatialCell::swap(vmesh::VelocityMesh<vmesh::GlobalID,vmesh::LocalID>& vmesh,
@@ -1841,6 +1897,26 @@ namespace spatial_cell {
 
       populations[popID].vmesh.swap(vmesh);
       populations[popID].blockContainer.swap(blockContainer);
+      populations[popID].velocityExtentValid = false;
+   }
+
+   /** Mark the velocity extent of the given population out of date. This has to be called
+    * by code that adds or removes velocity blocks without the member functions of this class.
+    * @param popID ID of the particle species.*/
+   inline void SpatialCell::invalidate_velocity_extent(const uint popID) {
+      populations[popID].velocityExtentValid = false;
+   }
+
+   /** Fold the velocity extent of one block, i.e. the largest |v| of its outermost
+    * velocity cell centres in each direction, into the given extent.
+    * @param blockParameters Parameters of the velocity block.
+    * @param extent Extent along vx, vy and vz, updated by this function.*/
+   inline void SpatialCell::add_block_velocity_extent(const Real* blockParameters,Real* extent) {
+      for (int i=0; i<3; ++i) {
+         const Real vMin = blockParameters[BlockParams::VXCRD+i] + 0.5*blockParameters[BlockParams::DVX+i];
+         const Real vMax = blockParameters[BlockParams::VXCRD+i] + (WID-0.5)*blockParameters[BlockParams::DVX+i];
+         extent[i] = std::max(extent[i],std::max(fabs(vMin),fabs(vMax)));
+      }
    }
 
    /*!
@@ -539,6 +539,56 @@ namespace SBC {
 //      phiprof::stop("vlasovBoundaryCondition (Outflow)");
    }
    
+   /** Same face and layer logic as vlasovBoundaryCondition, but the copies are 
+    * recorded into the plan instead of being executed.
+    */
+   void Outflow::getVlasovCopyPlan(
+      const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+      const CellID& cellID,
+      const uint popID,
+      std::vector<VlasovCopyOp>& plan
+   ) {
+      const OutflowSpeciesParameters& sP = this->speciesParams[popID];
+      SpatialCell* cell = mpiGrid[cellID];
+      creal* const cellParams = cell->parameters.data();
+      creal dx = cellParams[CellParams::DX];
+      creal dy = cellParams[CellParams::DY];
+      creal dz = cellParams[CellParams::DZ];
+      creal x = cellParams[CellParams::XCRD] + 0.5*dx;
+      creal y = cellParams[CellParams::YCRD] + 0.5*dy;
+      creal z = cellParams[CellParams::ZCRD] + 0.5*dz;
+      
+      bool isThisCellOnAFace[6];
+      determineFace(&isThisCellOnAFace[0], x, y, z, dx, dy, dz, true);
+      
+      for(uint i=0; i<6; i++) {
+         if(isThisCellOnAFace[i] && facesToProcess[i] && !sP.facesToSkipVlasov[i]) {
+            switch(sP.faceVlasovScheme[i]) {
+               case vlasovscheme::NONE:
+                  break;
+               case vlasovscheme::COPY:
+                  if (cell->sysBoundaryLayer == 1) {
+                     plan.push_back(makeCopyOp(mpiGrid,cellID,VlasovCopyOp::COPY));
+                  } else {
+                     plan.push_back(makeCopyOp(mpiGrid,cellID,VlasovCopyOp::COPY_MOMENTS));
+                  }
+                  break;
+               case vlasovscheme::LIMIT:
+                  if (cell->sysBoundaryLayer == 1) {
+                     plan.push_back(makeCopyOp(mpiGrid,cellID,VlasovCopyOp::COPY_LIMIT));
+                  } else {
+                     plan.push_back(makeCopyOp(mpiGrid,cellID,VlasovCopyOp::COPY_MOMENTS));
+                  }
+                  break;
+               default:
+                  std::cerr << __FILE__ << ":" << __LINE__ << "ERROR: invalid Outflow Vlasov scheme!" << std::endl;
+                  exit(1);
+                  break;
+            }
+         }
+      }
+   }
+   
    void Outflow::getFaces(bool* faces) {
       for(uint i=0; i<6; i++) faces[i] = facesToProcess[i];
    }
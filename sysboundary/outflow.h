@@ -125,6 +125,12 @@ namespace SBC {
          const CellID& cellID,
          const uint popID
       );
+      virtual void getVlasovCopyPlan(
+         const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+         const CellID& cellID,
+         const uint popID,
+         std::vector<VlasovCopyOp>& plan
+      );
       
       virtual void getFaces(bool* faces);
       virtual std::string getName() const;
@@ -25,10 +25,17 @@
  * This serves as the base class for further classes like SysBoundaryCondition::SetMaxwellian.
  */
 
+#include <cmath>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <algorithm>
 
 #include <assert.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "setbyuser.h"
 #include "../vlasovmover.h"
 #include "../fieldsolver/fs_common.h"
@@ -44,7 +51,10 @@
 using namespace std;
 
 namespace SBC {
-   SetByUser::SetByUser(): SysBoundaryCondition() { }
+   /*! Magic string at the beginning of binary input files, see loadBinaryFile. */
+   static const char binaryInputMagic[8] = {'V','L','S','B','C','I','N','1'};
+   
+   SetByUser::SetByUser(): SysBoundaryCondition(), templateTolerance(0.0) { }
    SetByUser::~SetByUser() { }
    
    bool SetByUser::initSysBoundary(
@@ -73,7 +83,8 @@ namespace SBC {
       for(unsigned int i=0; i<speciesParams.size(); i++) {
          success = loadInputData(i);
       }
-      success = success & generateTemplateCells(t);
+      // All templates are generated here as none has an input yet
+      generateTemplateCells(t);
       
       return success;
    }
@@ -272,6 +283,22 @@ namespace SBC {
       // No need to do anything in this function, as the propagators do not touch the distribution function   
    }
    
+   /*! Regenerate the template cells for time t if the interpolated input changed beyond
+    * templateTolerance, and copy them into the boundary cells.
+    * \retval True if the boundary cells were changed.
+    */
+   bool SetByUser::updateState(
+      const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+      creal& t
+   ) {
+      if (generateTemplateCells(t) == 0) return false;
+      
+      for (uint popID=0; popID<getObjectWrapper().particleSpecies.size(); ++popID) {
+         setCellsFromTemplate(mpiGrid, popID);
+      }
+      return true;
+   }
+   
    bool SetByUser::setBFromTemplate(const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
                                     FsGrid< std::array<Real, fsgrids::bfield::N_BFIELD>, 2> & perBGrid) {
 
@@ -394,6 +421,14 @@ namespace SBC {
          cerr << "Couldn't open parameter file " << fn << endl;
          exit(1);
       }
+      
+      // Binary files are recognized from their header
+      char magic[sizeof(binaryInputMagic)];
+      if (fread(magic, 1, sizeof(magic), fp) == sizeof(magic) && memcmp(magic, binaryInputMagic, sizeof(magic)) == 0) {
+         fclose(fp);
+         return loadBinaryFile(fn, nParams);
+      }
+      rewind(fp);
       uint nlines = 0;
       int ret = nParams;
 
@@ -458,21 +493,125 @@ namespace SBC {
       return dataset;
    }
    
-   /*! Loops through the array of template cells and generates the ones needed. The function
-    * generateTemplateCell is defined in the inheriting class such as to have the specific
-    * condition needed.
+   /*! Load user-set boundary data from a binary file by memory-mapping it.
+    * The file starts with the 8 characters "VLSBCIN1", followed by the number of lines
+    * and the number of entries per line as uint64_t, followed by the lines as doubles.
+    * The first entry of each line is the time, as in the text format.
+    * 
+    * \param fn Name of the file to be opened.
+    * \param nParams Expected number of entries per line.
+    * \retval dataset Vector of Real vectors, one per line.
+    */
+   vector<vector<Real> > SetByUser::loadBinaryFile(const char *fn, unsigned int nParams) {
+      int myRank;
+      MPI_Comm_rank(MPI_COMM_WORLD,&myRank);
+      
+      const int fd = open(fn, O_RDONLY);
+      struct stat fileStat;
+      if (fd < 0 || fstat(fd, &fileStat) != 0) {
+         cerr << "Couldn't open parameter file " << fn << endl;
+         exit(1);
+      }
+      const size_t headerSize = sizeof(binaryInputMagic) + 2*sizeof(uint64_t);
+      const size_t fileSize = fileStat.st_size;
+      if (fileSize < headerSize) {
+         cerr << "Binary parameter file " << fn << " is truncated" << endl;
+         exit(1);
+      }
+      void* map = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+      close(fd);
+      if (map == MAP_FAILED) {
+         cerr << "Couldn't memory-map parameter file " << fn << endl;
+         exit(1);
+      }
+      
+      const char* bytes = static_cast<const char*>(map);
+      uint64_t header[2];
+      memcpy(header, bytes + sizeof(binaryInputMagic), sizeof(header));
+      const uint64_t nlines = header[0];
+      if (header[1] != nParams) {
+         cerr << "Binary parameter file " << fn << " has " << header[1] << " values per line, expected " << nParams << endl;
+         exit(1);
+      }
+      if (nlines < 1 || fileSize < headerSize + nlines*nParams*sizeof(double)) {
+         cerr << "Binary parameter file " << fn << " is truncated or empty" << endl;
+         exit(1);
+      }
+      
+      if (myRank == 0) cout << "Parameter data file (" << fn << ", binary) has " << nlines << " values"<< endl;
+      
+      // The data block is not necessarily aligned for doubles, copy line by line
+      vector<vector<Real> > dataset(nlines, vector<Real>(nParams));
+      const char* data = bytes + headerSize;
+      vector<double> line(nParams);
+      for (uint64_t l=0; l<nlines; l++) {
+         memcpy(line.data(), data + l*nParams*sizeof(double), nParams*sizeof(double));
+         for (uint i=0; i<nParams; i++) dataset[l][i] = line[i];
+         if (l > 0 && dataset[l][0] < dataset[l-1][0]) {
+            cerr << "Parameter data must be in ascending temporal order" << endl;
+            exit(1);
+         }
+      }
+      munmap(map, fileSize);
+      
+      return dataset;
+   }
+   
+   /*! Generates the template cells whose interpolated input has changed by more than
+    * templateTolerance since they were last generated. Populations and faces are generated
+    * in parallel by generateTemplateCellPopulation, which is defined in the inheriting class
+    * such as to have the specific condition needed.
     * \param t Simulation time.
-    * \sa generateTemplateCell
+    * \retval Number of regenerated (face, population) templates.
+    * \sa generateTemplateCellPopulation finalizeTemplateCell
     */
-   bool SetByUser::generateTemplateCells(creal& t) {
+   uint SetByUser::generateTemplateCells(creal& t) {
+      const uint nPops = speciesParams.size();
+      vector<pair<uint,uint> > tasks; // (face, population)
+      vector<bool> faceChanged(6, false);
+      
+      for(uint i=0; i<6; i++) {
+         if(!facesToProcess[i]) continue;
+         for(uint popID=0; popID<nPops; popID++) {
+            UserSpeciesParameters& sP = speciesParams[popID];
+            vector<Real> input(sP.nParams-1);
+            interpolate(i, popID, t, input.data());
+            
+            bool changed = sP.templateInput[i].size() != input.size();
+            for(uint p=0; p<input.size() && !changed; p++) {
+               creal norm = max(fabs(input[p]), fabs(sP.templateInput[i][p]));
+               changed = fabs(input[p] - sP.templateInput[i][p]) > templateTolerance*norm;
+            }
+            if(changed) {
+               sP.templateInput[i] = input;
+               tasks.push_back(make_pair(i, popID));
+               faceChanged[i] = true;
+            }
+         }
+      }
+      if(tasks.size() == 0) return 0;
+      
+      #pragma omp parallel for schedule(dynamic,1)
+      for(uint task=0; task<tasks.size(); task++) {
+         const uint i = tasks[task].first;
+         const uint popID = tasks[task].second;
+         templateCells[i].clear(popID);
+         generateTemplateCellPopulation(templateCells[i], speciesParams[popID].templateInput[i].data(), popID);
+      }
+      
+      // Block adjustment and moments use lists shared by all populations of a cell,
+      // so they are done per face.
       #pragma omp parallel for
       for(uint i=0; i<6; i++) {
-         int index;
-         if(facesToProcess[i]) {
-            generateTemplateCell(templateCells[i], templateB[i], i, t);
+         if(!faceChanged[i]) continue;
+         for(uint task=0; task<tasks.size(); task++) {
+            //let's get rid of blocks not fulfilling the criteria here to save
+            //memory.
+            if(tasks[task].first == i) templateCells[i].adjustSingleCellVelocityBlocks(tasks[task].second);
          }
+         finalizeTemplateCell(templateCells[i], templateB[i], speciesParams[nPops-1].templateInput[i].data());
       }
-      return true;
+      return tasks.size();
    }
    
    /*!Interpolate the input data to the given time.
@@ -499,12 +638,13 @@ namespace SBC {
          i1 = i2 = 0;
          s = 0;
       } else {
-         for (uint i=0; i<sP.inputData[inputDataIndex].size(); i++) {
-            if (sP.inputData[inputDataIndex][i][0] >= t) {
-               found = true;
-               i2 = (int)i;
-               break;
-            }
+         // Lines are in ascending temporal order (checked in loadFile)
+         const vector<vector<Real> >& data = sP.inputData[inputDataIndex];
+         vector<vector<Real> >::const_iterator it = lower_bound(data.begin(), data.end(), t,
+            [](const vector<Real>& line, creal time) { return line[0] < time; });
+         if (it != data.end()) {
+            found = true;
+            i2 = (int)(it - data.begin());
          }
          if (found) {
             // i2 is now "ceil(t)"
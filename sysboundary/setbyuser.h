@@ -43,6 +43,9 @@ namespace SBC {
 
       /*! Number of parameters per input file line. */
       uint nParams;
+      
+      /*! Interpolated input (without time) the current template cell of each face was generated from. Empty if not generated yet. */
+      std::vector<Real> templateInput[6];
    };
 
    /*!\brief Base class for system boundary conditions with user-set settings and parameters read from file.
@@ -130,6 +133,10 @@ namespace SBC {
          const CellID& cellID,
          const uint popID
       );
+      virtual bool updateState(
+         const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+         creal& t
+      );
       
       virtual void getFaces(bool* faces);
       
@@ -139,10 +146,17 @@ namespace SBC {
    protected:
       bool loadInputData(const uint popID);
       std::vector<std::vector<Real> > loadFile(const char* file, unsigned int nParams);
+      std::vector<std::vector<Real> > loadBinaryFile(const char* file, unsigned int nParams);
       void interpolate(const int inputDataIndex, const uint popID, creal t, Real* outputData);
       
-      bool generateTemplateCells(creal& t);
-      virtual void generateTemplateCell(spatial_cell::SpatialCell& templateCell, Real B[3], int inputDataIndex, creal& t) = 0;
+      uint generateTemplateCells(creal& t);
+      /*! Fill the velocity space of one population of a template cell from the interpolated
+       * input (file line without the time). Called in parallel for different populations 
+       * and faces, so only populations[popID] of the template cell may be touched.*/
+      virtual void generateTemplateCellPopulation(spatial_cell::SpatialCell& templateCell, const Real* input, const uint popID) = 0;
+      /*! Set moments, flags and B of a template cell after all its populations have been generated.
+       * input is the interpolated input of the last population.*/
+      virtual void finalizeTemplateCell(spatial_cell::SpatialCell& templateCell, Real B[3], const Real* input) = 0;
       bool setCellsFromTemplate(const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,const uint popID);
       bool setBFromTemplate(const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
                             FsGrid< std::array<Real, fsgrids::bfield::N_BFIELD>, 2> & perBGrid);
@@ -154,6 +168,8 @@ namespace SBC {
       Real templateB[6][3];
       /*! List of faces on which user-set boundary conditions are to be applied ([xyz][+-]). */
       std::vector<std::string> faceList;
+      /*! Template cells are only regenerated if an interpolated input parameter changes relatively more than this. */
+      Real templateTolerance;
 
       std::vector<UserSpeciesParameters> speciesParams;
    };
@@ -40,17 +40,18 @@ namespace SBC {
       Readparameters::addComposing("maxwellian.face", "List of faces on which set Maxwellian boundary conditions are to be applied ([xyz][+-]).");
       Readparameters::add("maxwellian.precedence", "Precedence value of the set Maxwellian system boundary condition (integer), the higher the stronger.", 3);
       Readparameters::add("maxwellian.reapplyUponRestart", "If 0 (default), keep going with the state existing in the restart file. If 1, calls again applyInitialState. Can be used to change boundary condition behaviour during a run.", 0);
+      Readparameters::add("maxwellian.templateTolerance", "Dynamic inflow: template cells are regenerated only if an interpolated input parameter changes relatively more than this.", 1e-3);
 
       // Per-population parameters
       for(uint i=0; i< getObjectWrapper().particleSpecies.size(); i++) {
         const std::string& pop = getObjectWrapper().particleSpecies[i].name;
 
-        Readparameters::add(pop + "_maxwellian.file_x+", "Input files for the set Maxwellian inflow parameters on face x+. Data format per line: time (s) density (p/m^3) Temperature (K) Vx Vy Vz (m/s) Bx By Bz (T).", "");
-        Readparameters::add(pop + "_maxwellian.file_x-", "Input files for the set Maxwellian inflow parameters on face x-. Data format per line: time (s) density (p/m^3) Temperature (K) Vx Vy Vz (m/s) Bx By Bz (T).", "");
-        Readparameters::add(pop + "_maxwellian.file_y+", "Input files for the set Maxwellian inflow parameters on face y+. Data format per line: time (s) density (p/m^3) Temperature (K) Vx Vy Vz (m/s) Bx By Bz (T).", "");
-        Readparameters::add(pop + "_maxwellian.file_y-", "Input files for the set Maxwellian inflow parameters on face y-. Data format per line: time (s) density (p/m^3) Temperature (K) Vx Vy Vz (m/s) Bx By Bz (T).", "");
-        Readparameters::add(pop + "_maxwellian.file_z+", "Input files for the set Maxwellian inflow parameters on face z+. Data format per line: time (s) density (p/m^3) Temperature (K) Vx Vy Vz (m/s) Bx By Bz (T).", "");
-        Readparameters::add(pop + "_maxwellian.file_z-", "Input files for the set Maxwellian inflow parameters on face z-. Data format per line: time (s) density (p/m^3) Temperature (K) Vx Vy Vz (m/s) Bx By Bz (T).", "");
+        Readparameters::add(pop + "_maxwellian.file_x+", "Input files for the set Maxwellian inflow parameters on face x+. Data format per line: time (s) density (p/m^3) Temperature (K) Vx Vy Vz (m/s) Bx By Bz (T). Binary files (see SetByUser::loadBinaryFile) are detected automatically.", "");
+        Readparameters::add(pop + "_maxwellian.file_x-", "Input files for the set Maxwellian inflow parameters on face x-. Data format per line: time (s) density (p/m^3) Temperature (K) Vx Vy Vz (m/s) Bx By Bz (T). Binary files (see SetByUser::loadBinaryFile) are detected automatically.", "");
+        Readparameters::add(pop + "_maxwellian.file_y+", "Input files for the set Maxwellian inflow parameters on face y+. Data format per line: time (s) density (p/m^3) Temperature (K) Vx Vy Vz (m/s) Bx By Bz (T). Binary files (see SetByUser::loadBinaryFile) are detected automatically.", "");
+        Readparameters::add(pop + "_maxwellian.file_y-", "Input files for the set Maxwellian inflow parameters on face y-. Data format per line: time (s) density (p/m^3) Temperature (K) Vx Vy Vz (m/s) Bx By Bz (T). Binary files (see SetByUser::loadBinaryFile) are detected automatically.", "");
+        Readparameters::add(pop + "_maxwellian.file_z+", "Input files for the set Maxwellian inflow parameters on face z+. Data format per line: time (s) density (p/m^3) Temperature (K) Vx Vy Vz (m/s) Bx By Bz (T). Binary files (see SetByUser::loadBinaryFile) are detected automatically.", "");
+        Readparameters::add(pop + "_maxwellian.file_z-", "Input files for the set Maxwellian inflow parameters on face z-. Data format per line: time (s) density (p/m^3) Temperature (K) Vx Vy Vz (m/s) Bx By Bz (T). Binary files (see SetByUser::loadBinaryFile) are detected automatically.", "");
         Readparameters::add(pop + "_maxwellian.nVelocitySamples", "Number of sampling points per velocity dimension (template cells)", 5);
         Readparameters::add(pop + "_maxwellian.dynamic", "Boolean value, is the set Maxwellian inflow dynamic in time or not.", 0);
       }
@@ -76,6 +77,10 @@ namespace SBC {
       if(reapply == 1) {
          this->applyUponRestart = true;
       }
+      if(!Readparameters::get("maxwellian.templateTolerance", templateTolerance)) {
+         if(myRank == MASTER_RANK) cerr << __FILE__ << ":" << __LINE__ << " ERROR: This option has not been added!" << endl;
+         exit(1);
+      }
 
       // Per-population parameters
       for(uint i=0; i< getObjectWrapper().particleSpecies.size(); i++) {
@@ -201,22 +206,89 @@ namespace SBC {
       return blocksToInitialize;
    }
    
-   /*!\brief Generate the template cell for the face corresponding to the index passed.
-    * This function generates a spatial cell which is to be used as a template for the
-    * system boundary condition.
+   /*!\brief Generate one population of the template cell from the interpolated input parameters.
+    * This function generates the velocity space of a spatial cell which is to be used as a
+    * template for the system boundary condition.
     * \param templateCell Address of the template cell to be generated.
-    * \param inputDataIndex Index used for the location of the input data.
-    * \param t Current simulation time.
+    * \param input Interpolated input: density, temperature, Vx, Vy, Vz, Bx, By, Bz.
+    * \param popID Population to generate.
     */
-   void SetMaxwellian::generateTemplateCell(
+   void SetMaxwellian::generateTemplateCellPopulation(
       spatial_cell::SpatialCell& templateCell,
-      Real B[3],
-      int inputDataIndex,
-      creal& t
+      const Real* input,
+      const uint popID
    ) {
-      Real rho, T, Vx, Vy, Vz, Bx=0.0, By=0.0, Bz=0.0, buffer[8];
+      creal rho = input[0];
+      creal T = input[1];
+      creal Vx = input[2];
+      creal Vy = input[3];
+      creal Vz = input[4];
       
+      vector<vmesh::GlobalID> blocksToInitialize = this->findBlocksToInitialize(popID,templateCell, rho, T, Vx, Vy, Vz);
+      Realf* data = templateCell.get_data(popID);
       
+      for(vmesh::GlobalID i=0; i<blocksToInitialize.size(); ++i) {
+         const vmesh::GlobalID blockGID = blocksToInitialize[i];
+         const vmesh::LocalID blockLID = templateCell.get_velocity_block_local_id(blockGID,popID);
+         const Real* block_parameters = templateCell.get_block_parameters(blockLID,popID);
+         creal vxBlock = block_parameters[BlockParams::VXCRD];
+         creal vyBlock = block_parameters[BlockParams::VYCRD];
+         creal vzBlock = block_parameters[BlockParams::VZCRD];
+         creal dvxCell = block_parameters[BlockParams::DVX];
+         creal dvyCell = block_parameters[BlockParams::DVY];
+         creal dvzCell = block_parameters[BlockParams::DVZ];
+         
+         // Calculate volume average of distrib. function for each cell in the block.
+         for (uint kc=0; kc<WID; ++kc) for (uint jc=0; jc<WID; ++jc) for (uint ic=0; ic<WID; ++ic) {
+            creal vxCell = vxBlock + ic*dvxCell;
+            creal vyCell = vyBlock + jc*dvyCell;
+            creal vzCell = vzBlock + kc*dvzCell;
+            Real average = 0.0;
+            if(speciesParams[popID].nVelocitySamples > 1) {
+               creal d_vx = dvxCell / (speciesParams[popID].nVelocitySamples-1);
+               creal d_vy = dvyCell / (speciesParams[popID].nVelocitySamples-1);
+               creal d_vz = dvzCell / (speciesParams[popID].nVelocitySamples-1);
+               for (uint vi=0; vi<speciesParams[popID].nVelocitySamples; ++vi)
+                 for (uint vj=0; vj<speciesParams[popID].nVelocitySamples; ++vj)
+                   for (uint vk=0; vk<speciesParams[popID].nVelocitySamples; ++vk) {
+                      average +=  maxwellianDistribution(
+                                                         popID,
+                                                         rho,
+                                                         T,
+                                                         vxCell + vi*d_vx - Vx,
+                                                         vyCell + vj*d_vy - Vy,
+                                                         vzCell + vk*d_vz - Vz
+                                                        );
+                   }
+               average /= speciesParams[popID].nVelocitySamples * speciesParams[popID].nVelocitySamples * speciesParams[popID].nVelocitySamples;
+            } else {
+               average =   maxwellianDistribution(
+                                                  popID,
+                                                  rho,
+                                                  T,
+                                                  vxCell + 0.5*dvxCell - Vx,
+                                                  vyCell + 0.5*dvyCell - Vy,
+                                                  vzCell + 0.5*dvzCell - Vz
+                                                 );
+            }
+            
+            if (average != 0.0) {
+               data[blockLID*WID3+cellIndex(ic,jc,kc)] = average;
+            } 
+         } // for-loop over cells in velocity block
+      } // for-loop over velocity blocks
+   }
+   
+   /*!\brief Set the moments, flags and magnetic field of a generated template cell.
+    * \param templateCell Address of the template cell.
+    * \param B Magnetic field of the template cell is written here.
+    * \param input Interpolated input of the last population, B is taken from it.
+    */
+   void SetMaxwellian::finalizeTemplateCell(
+      spatial_cell::SpatialCell& templateCell,
+      Real B[3],
+      const Real* input
+   ) {
       templateCell.sysBoundaryFlag = this->getIndex();
       templateCell.sysBoundaryLayer = 1;
       
@@ -227,105 +299,22 @@ namespace SBC {
       templateCell.parameters[CellParams::DY] = 1;
       templateCell.parameters[CellParams::DZ] = 1;
       
-      // Init all particle species
-      for (uint popID=0; popID<getObjectWrapper().particleSpecies.size(); ++popID) {
-         interpolate(inputDataIndex, popID, t, &buffer[0]);
-         rho = buffer[0];
-         T = buffer[1];
-         Vx = buffer[2];
-         Vy = buffer[3];
-         Vz = buffer[4];
-         Bx = buffer[5];
-         By = buffer[6];
-         Bz = buffer[7];
-
-         vector<vmesh::GlobalID> blocksToInitialize = this->findBlocksToInitialize(popID,templateCell, rho, T, Vx, Vy, Vz);
-         Realf* data = templateCell.get_data(popID);
-
-         for(vmesh::GlobalID i=0; i<blocksToInitialize.size(); ++i) {
-            const vmesh::GlobalID blockGID = blocksToInitialize[i];
-            const vmesh::LocalID blockLID = templateCell.get_velocity_block_local_id(blockGID,popID);
-            const Real* block_parameters = templateCell.get_block_parameters(blockLID,popID);
-            creal vxBlock = block_parameters[BlockParams::VXCRD];
-            creal vyBlock = block_parameters[BlockParams::VYCRD];
-            creal vzBlock = block_parameters[BlockParams::VZCRD];
-            creal dvxCell = block_parameters[BlockParams::DVX];
-            creal dvyCell = block_parameters[BlockParams::DVY];
-            creal dvzCell = block_parameters[BlockParams::DVZ];
-         
-            creal x = templateCell.parameters[CellParams::XCRD];
-            creal y = templateCell.parameters[CellParams::YCRD];
-            creal z = templateCell.parameters[CellParams::ZCRD];
-            creal dx = templateCell.parameters[CellParams::DX];
-            creal dy = templateCell.parameters[CellParams::DY];
-            creal dz = templateCell.parameters[CellParams::DZ];
-         
-            // Calculate volume average of distrib. function for each cell in the block.
-            for (uint kc=0; kc<WID; ++kc) for (uint jc=0; jc<WID; ++jc) for (uint ic=0; ic<WID; ++ic) {
-               creal vxCell = vxBlock + ic*dvxCell;
-               creal vyCell = vyBlock + jc*dvyCell;
-               creal vzCell = vzBlock + kc*dvzCell;
-               Real average = 0.0;
-               if(speciesParams[popID].nVelocitySamples > 1) {
-                  creal d_vx = dvxCell / (speciesParams[popID].nVelocitySamples-1);
-                  creal d_vy = dvyCell / (speciesParams[popID].nVelocitySamples-1);
-                  creal d_vz = dvzCell / (speciesParams[popID].nVelocitySamples-1);
-                  for (uint vi=0; vi<speciesParams[popID].nVelocitySamples; ++vi)
-                    for (uint vj=0; vj<speciesParams[popID].nVelocitySamples; ++vj)
-                      for (uint vk=0; vk<speciesParams[popID].nVelocitySamples; ++vk) {
-                         average +=  maxwellianDistribution(
-                                                            popID,
-                                                            rho,
-                                                            T,
-                                                            vxCell + vi*d_vx - Vx,
-                                                            vyCell + vj*d_vy - Vy,
-                                                            vzCell + vk*d_vz - Vz
-                                                           );
-                      }
-                  average /= speciesParams[popID].nVelocitySamples * speciesParams[popID].nVelocitySamples * speciesParams[popID].nVelocitySamples;
-               } else {
-                  average =   maxwellianDistribution(
-                                                     popID,
-                                                     rho,
-                                                     T,
-                                                     vxCell + 0.5*dvxCell - Vx,
-                                                     vyCell + 0.5*dvyCell - Vy,
-                                                     vzCell + 0.5*dvzCell - Vz
-                                                    );
-               }
-               
-               if (average != 0.0) {
-                  data[blockLID*WID3+cellIndex(ic,jc,kc)] = average;
-               } 
-            } // for-loop over cells in velocity block
-         } // for-loop over velocity blocks
-         
-         //let's get rid of blocks not fulfilling the criteria here to save
-         //memory.
-         templateCell.adjustSingleCellVelocityBlocks(popID);
-      } // for-loop over particle species
-      
-      B[0] = Bx;
-      B[1] = By;
-      B[2] = Bz;
+      B[0] = input[5];
+      B[1] = input[6];
+      B[2] = input[7];
       
       calculateCellMoments(&templateCell,true,true);
       
-      if(!this->isThisDynamic) {
-         // WARNING Time-independence assumed here.
-         templateCell.parameters[CellParams::RHOM_DT2] = templateCell.parameters[CellParams::RHOM];
-         templateCell.parameters[CellParams::VX_DT2] = templateCell.parameters[CellParams::VX];
-         templateCell.parameters[CellParams::VY_DT2] = templateCell.parameters[CellParams::VY];
-         templateCell.parameters[CellParams::VZ_DT2] = templateCell.parameters[CellParams::VZ];
-         templateCell.parameters[CellParams::RHOQ_DT2] = templateCell.parameters[CellParams::RHOQ];
-         templateCell.parameters[CellParams::P_11_DT2] = templateCell.parameters[CellParams::P_11];
-         templateCell.parameters[CellParams::P_22_DT2] = templateCell.parameters[CellParams::P_22];
-         templateCell.parameters[CellParams::P_33_DT2] = templateCell.parameters[CellParams::P_33];
-      } else {
-         cerr << "ERROR: this is not dynamic in time, please code it!" << endl;
-         abort();
-      }
-
+      // The template describes the inflow at the time it was generated, also
+      // for dynamic boundaries, which regenerate it when the input changes.
+      templateCell.parameters[CellParams::RHOM_DT2] = templateCell.parameters[CellParams::RHOM];
+      templateCell.parameters[CellParams::VX_DT2] = templateCell.parameters[CellParams::VX];
+      templateCell.parameters[CellParams::VY_DT2] = templateCell.parameters[CellParams::VY];
+      templateCell.parameters[CellParams::VZ_DT2] = templateCell.parameters[CellParams::VZ];
+      templateCell.parameters[CellParams::RHOQ_DT2] = templateCell.parameters[CellParams::RHOQ];
+      templateCell.parameters[CellParams::P_11_DT2] = templateCell.parameters[CellParams::P_11];
+      templateCell.parameters[CellParams::P_22_DT2] = templateCell.parameters[CellParams::P_22];
+      templateCell.parameters[CellParams::P_33_DT2] = templateCell.parameters[CellParams::P_33];
    }
    
    string SetMaxwellian::getName() const {return "SetMaxwellian";}
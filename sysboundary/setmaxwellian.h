@@ -59,7 +59,8 @@ namespace SBC {
       virtual uint getIndex() const;
       
    protected:
-      void generateTemplateCell(spatial_cell::SpatialCell& templateCell, Real B[3], int inputDataIndex, creal& t);
+      void generateTemplateCellPopulation(spatial_cell::SpatialCell& templateCell, const Real* input, const uint popID);
+      void finalizeTemplateCell(spatial_cell::SpatialCell& templateCell, Real B[3], const Real* input);
       
       Real maxwellianDistribution(const uint popID,
          creal& rho, creal& T, creal& vx, creal& vy, creal& vz
@@ -29,6 +29,8 @@
 
 #include "../grid.h"
 #include "../object_wrapper.h"
+#include "../telemetry.h"
+#include "../fieldsolver/fs_common.h"
 
 #include "sysboundary.h"
 #include "donotcompute.h"
@@ -50,7 +52,7 @@ bool precedenceSort(const SBC::SysBoundaryCondition* first,
 // ************************************************************
 
 /*! Constructor for class SysBoundary.*/
-SysBoundary::SysBoundary() { }
+SysBoundary::SysBoundary(): isThisDynamic(false), vlasovCopyPlansValid(false) { }
 
 /*!\brief Destructor for class SysBoundary.
  * 
@@ -521,6 +523,7 @@ bool SysBoundary::classifyCells(dccrg::Dccrg<spatial_cell::SpatialCell,dccrg::Ca
    }
    
    technicalGrid.updateGhostCells();
+   invalidateFsCellLists();
    
    return success;
 }
@@ -588,6 +591,23 @@ void SysBoundary::applySysBoundaryVlasovConditions(
       Transfer::CELL_SYSBOUNDARYFLAG,true);
    mpiGrid.update_copies_of_remote_neighbors(SYSBOUNDARIES_EXTENDED_NEIGHBORHOOD_ID);
    
+   // The copy plans only change when the mesh is repartitioned
+   if (vlasovCopyPlansValid == false) {
+      phiprof::start("Build Vlasov copy plans");
+      const size_t nPops = getObjectWrapper().particleSpecies.size();
+      vector<CellID> innerCells;
+      vector<CellID> boundaryCells;
+      getBoundaryCellList(mpiGrid,mpiGrid.get_local_cells_not_on_process_boundary(SYSBOUNDARIES_NEIGHBORHOOD_ID),innerCells);
+      getBoundaryCellList(mpiGrid,mpiGrid.get_local_cells_on_process_boundary(SYSBOUNDARIES_NEIGHBORHOOD_ID),boundaryCells);
+      vlasovCopyPlans.resize(nPops);
+      for (uint popID=0; popID<nPops; ++popID) {
+         buildVlasovCopyPlan(mpiGrid,innerCells,popID,vlasovCopyPlans[popID][0]);
+         buildVlasovCopyPlan(mpiGrid,boundaryCells,popID,vlasovCopyPlans[popID][1]);
+      }
+      vlasovCopyPlansValid = true;
+      phiprof::stop("Build Vlasov copy plans");
+   }
+   
    // Loop over existing particle species
    for (uint popID=0; popID<getObjectWrapper().particleSpecies.size(); ++popID) {
       SpatialCell::setCommunicatedSpecies(popID);
@@ -603,36 +623,27 @@ void SysBoundary::applySysBoundaryVlasovConditions(
       phiprof::start(timer);
 
       // Compute Vlasov boundary condition on system boundary/process inner cells
-      vector<CellID> localCells;
-      getBoundaryCellList(mpiGrid,mpiGrid.get_local_cells_not_on_process_boundary(SYSBOUNDARIES_NEIGHBORHOOD_ID),localCells);
-   
-      #pragma omp parallel for
-      for (uint i=0; i<localCells.size(); i++) {
-         cuint sysBoundaryType = mpiGrid[localCells[i]]->sysBoundaryFlag;
-         this->getSysBoundary(sysBoundaryType)->vlasovBoundaryCondition(mpiGrid,localCells[i],popID);
-      }
+      applyVlasovCopyPlan(mpiGrid,vlasovCopyPlans[popID][0],popID);
       phiprof::stop(timer);
    
       timer=phiprof::initializeTimer("Wait for receives","MPI","Wait");
       phiprof::start(timer);
+      telemetry::start(telemetry::MPI_WAIT);
       mpiGrid.wait_remote_neighbor_copy_update_receives(SYSBOUNDARIES_NEIGHBORHOOD_ID);
+      telemetry::stop(telemetry::MPI_WAIT);
       phiprof::stop(timer);
 
       // Compute vlasov boundary on system boundary/process boundary cells
       timer=phiprof::initializeTimer("Compute process boundary cells");
       phiprof::start(timer);
-      vector<CellID> boundaryCells;
-      getBoundaryCellList(mpiGrid,mpiGrid.get_local_cells_on_process_boundary(SYSBOUNDARIES_NEIGHBORHOOD_ID),boundaryCells);
-      #pragma omp parallel for
-      for (uint i=0; i<boundaryCells.size(); i++) {
-         cuint sysBoundaryType = mpiGrid[boundaryCells[i]]->sysBoundaryFlag;
-         this->getSysBoundary(sysBoundaryType)->vlasovBoundaryCondition(mpiGrid, boundaryCells[i],popID);
-      }
+      applyVlasovCopyPlan(mpiGrid,vlasovCopyPlans[popID][1],popID);
       phiprof::stop(timer);
 
       timer=phiprof::initializeTimer("Wait for sends","MPI","Wait");
       phiprof::start(timer);
+      telemetry::start(telemetry::MPI_WAIT);
       mpiGrid.wait_remote_neighbor_copy_update_sends();
+      telemetry::stop(telemetry::MPI_WAIT);
       phiprof::stop(timer);
 
       // WARNING Blocks are changed but lists not updated now, if you need to use/communicate them before the next update is done, add an update here.
@@ -641,6 +652,73 @@ void SysBoundary::applySysBoundaryVlasovConditions(
    } // for-loop over populations
 }
 
+/*!\brief Update the state of the dynamic system boundary conditions to time t.
+ * 
+ * If any boundary changed the velocity blocks of its cells, the block lists of
+ * remote copies are updated. Collective operation, the decision is identical on
+ * all processes as it only depends on t and the boundary input.
+ * \param mpiGrid Grid
+ * \param t Simulation time
+ */
+void SysBoundary::updateSysBoundaryStates(
+   dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+   creal& t
+) {
+   bool changed = false;
+   for (list<SBC::SysBoundaryCondition*>::iterator it=sysBoundaries.begin(); it!=sysBoundaries.end(); ++it) {
+      if ((*it)->isDynamic()) {
+         changed = (*it)->updateState(mpiGrid, t) || changed;
+      }
+   }
+   if (changed) {
+      for (uint popID=0; popID<getObjectWrapper().particleSpecies.size(); ++popID) {
+         updateRemoteVelocityBlockLists(mpiGrid, popID);
+      }
+   }
+}
+
+/*! Collect the Vlasov boundary operations of the given cells into plan.
+ * \param mpiGrid Grid
+ * \param cells System boundary cells, see getBoundaryCellList
+ * \param popID Particle species ID
+ * \param plan The plan to (re)build
+ */
+void SysBoundary::buildVlasovCopyPlan(
+   dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+   const vector<CellID>& cells,
+   const uint popID,
+   VlasovCopyPlan& plan
+) {
+   plan.ops.clear();
+   plan.cellOffsets.resize(cells.size()+1);
+   plan.cellOffsets[0] = 0;
+   for (size_t c=0; c<cells.size(); ++c) {
+      cuint sysBoundaryType = mpiGrid[cells[c]]->sysBoundaryFlag;
+      this->getSysBoundary(sysBoundaryType)->getVlasovCopyPlan(mpiGrid,cells[c],popID,plan.ops);
+      plan.cellOffsets[c+1] = plan.ops.size();
+   }
+}
+
+/*! Apply a Vlasov copy plan, cells in parallel and the operations of each cell in order.
+ * \param mpiGrid Grid
+ * \param plan The plan to apply
+ * \param popID Particle species ID
+ */
+void SysBoundary::applyVlasovCopyPlan(
+   dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+   const VlasovCopyPlan& plan,
+   const uint popID
+) {
+   const size_t nCells = plan.cellOffsets.size() - 1;
+   #pragma omp parallel for schedule(dynamic,1)
+   for (size_t c=0; c<nCells; ++c) {
+      for (size_t i=plan.cellOffsets[c]; i<plan.cellOffsets[c+1]; ++i) {
+         const SBC::VlasovCopyOp& op = plan.ops[i];
+         op.sbc->applyVlasovCopyOp(mpiGrid,op,popID);
+      }
+   }
+}
+
 /*! Get a pointer to the SysBoundaryCondition of given index.
  * \param sysBoundaryType Type of the system boundary condition to return
  * \return Pointer to the instance of the SysBoundaryCondition. NULL if sysBoundaryType is invalid.
@@ -700,6 +778,8 @@ bool getBoundaryCellList(
  */
 bool SysBoundary::updateSysBoundariesAfterLoadBalance(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid) {
    phiprof::start("updateSysBoundariesAfterLoadBalance");
+   // Copy plans hold cell pointers and closest cells, rebuild them on next use
+   vlasovCopyPlansValid = false;
    vector<uint64_t> local_cells_on_boundary;
    getBoundaryCellList(mpiGrid, mpiGrid.get_cells(), local_cells_on_boundary);
    // Loop over sysboundaries:
@@ -76,6 +76,7 @@ class SysBoundary {
                           Project& project
                          );
    void applySysBoundaryVlasovConditions(dccrg::Dccrg<spatial_cell::SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid, creal& t);
+   void updateSysBoundaryStates(dccrg::Dccrg<spatial_cell::SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid, creal& t);
    unsigned int size() const;
    SBC::SysBoundaryCondition* getSysBoundary(cuint sysBoundaryType) const;
    bool isDynamic() const;
@@ -85,6 +86,24 @@ class SysBoundary {
    private:
       /*! Private copy-constructor to prevent copying the class. */
       SysBoundary(const SysBoundary& bc);
+      
+      /*! Vlasov boundary operations of a set of cells. The operations of cell c are 
+       * ops[cellOffsets[c]] ... ops[cellOffsets[c+1]-1] and are applied in that order.*/
+      struct VlasovCopyPlan {
+         std::vector<SBC::VlasovCopyOp> ops;
+         std::vector<size_t> cellOffsets;
+      };
+      void buildVlasovCopyPlan(
+         dccrg::Dccrg<spatial_cell::SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+         const std::vector<CellID>& cells,
+         const uint popID,
+         VlasovCopyPlan& plan
+      );
+      void applyVlasovCopyPlan(
+         dccrg::Dccrg<spatial_cell::SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+         const VlasovCopyPlan& plan,
+         const uint popID
+      );
    
       //std::set<SBC::SysBoundaryCondition*,SBC::Comparator> sysBoundaries;
 
@@ -99,6 +118,11 @@ class SysBoundary {
 
       /*! Array of bool telling whether the system is periodic in any direction. */
       bool isPeriodic[3];
+      
+      /*! Vlasov copy plans per population, for process inner [0] and process boundary [1] cells.*/
+      std::vector<std::array<VlasovCopyPlan,2> > vlasovCopyPlans;
+      /*! If false, vlasovCopyPlans are rebuilt before the Vlasov boundary conditions are applied. Reset after load balance.*/
+      bool vlasovCopyPlansValid;
 };
 
 bool precedenceSort(const SBC::SysBoundaryCondition* first, 
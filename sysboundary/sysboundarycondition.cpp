@@ -262,63 +262,88 @@ namespace SBC {
       const uint popID
       ) {
       const CellID closestCell = getTheClosestNonsysboundaryCell(cellID);
-      SpatialCell * from = mpiGrid[closestCell];
-      SpatialCell * to = mpiGrid[cellID];
       
       if(closestCell == INVALID_CELLID) {
          cerr << __FILE__ << ":" << __LINE__ << ": No closest cell found!" << endl;
          abort();
       }
       
-      const std::array<SpatialCell*,27> flowtoCells = getFlowtoCells(cellID);
+      vlasovBoundaryCopyAndLimit(mpiGrid[closestCell],mpiGrid[cellID],getFlowtoCells(cellID),popID);
+   }
+   
+   /*! Copy the distribution of from into the existing blocks of to, limiting each value to the
+    * values of the flowto cells in the quadrant the velocity cell flows into. Moments are recomputed.
+    * \param from Closest non-boundary cell.
+    * \param to Boundary cell.
+    * \param flowtoCells Flowto cells of the boundary cell, see getFlowtoCells.
+    */
+   void SysBoundaryCondition::vlasovBoundaryCopyAndLimit(
+      SpatialCell* from,
+      SpatialCell* to,
+      const std::array<SpatialCell*,27>& flowtoCells,
+      const uint popID
+   ) {
       //Do not allow block adjustment, the block structure when calling vlasovBoundaryCondition should be static
       //just copy data to existing blocks, no modification of to blocks allowed
       for (vmesh::LocalID blockLID=0; blockLID<to->get_number_of_velocity_blocks(popID); ++blockLID) {
          const vmesh::GlobalID blockGID = to->get_velocity_block_global_id(blockLID,popID);
-//          const Realf* fromBlock_data = from->get_data(from->get_velocity_block_local_id(blockGID) );
          Realf* toBlock_data = to->get_data(blockLID,popID);
-         if (from->get_velocity_block_local_id(blockGID,popID) == from->invalid_local_id()) {
+         const vmesh::LocalID fromLID = from->get_velocity_block_local_id(blockGID,popID);
+         if (fromLID == from->invalid_local_id()) {
             for (unsigned int i = 0; i < VELOCITY_BLOCK_LENGTH; i++) {
                toBlock_data[i] = 0.0; //block did not exist in from cell, fill with zeros.
             }
-         } else {
-            const Real* blockParameters = to->get_block_parameters(blockLID, popID);
-            // check where cells are
-            creal vxBlock = blockParameters[BlockParams::VXCRD];
-            creal vyBlock = blockParameters[BlockParams::VYCRD];
-            creal vzBlock = blockParameters[BlockParams::VZCRD];
-            creal dvxCell = blockParameters[BlockParams::DVX];
-            creal dvyCell = blockParameters[BlockParams::DVY];
-            creal dvzCell = blockParameters[BlockParams::DVZ];
-            
-            std::array<Realf*,27> flowtoCellsBlockCache = getFlowtoCellsBlock(flowtoCells, blockGID, popID);
-            
-            for (uint kc=0; kc<WID; ++kc) {
-               for (uint jc=0; jc<WID; ++jc) {
-                  for (uint ic=0; ic<WID; ++ic) {
-                     velocity_cell_indices_t indices = {ic, jc, kc};
-                     const uint cell = from->get_velocity_cell(indices);
-                     
-                     creal vxCellCenter = vxBlock + (ic+convert<Real>(0.5))*dvxCell;
-                     creal vyCellCenter = vyBlock + (jc+convert<Real>(0.5))*dvyCell;
-                     creal vzCellCenter = vzBlock + (kc+convert<Real>(0.5))*dvzCell;
-                     const int vxCellSign = vxCellCenter < 0 ? -1 : 1;
-                     const int vyCellSign = vyCellCenter < 0 ? -1 : 1;
-                     const int vzCellSign = vzCellCenter < 0 ? -1 : 1;
-                     Realf value = from->get_value(blockGID, cell, popID);
-                     //loop over spatial cells in quadrant of influence
-                     for(int dvx = 0 ; dvx <= 1; dvx++) {
-                        for(int dvy = 0 ; dvy <= 1; dvy++) {
-                           for(int dvz = 0 ; dvz <= 1; dvz++) {
-                              const int flowToId = nbrID(dvx * vxCellSign, dvy * vyCellSign, dvz * vzCellSign);
-                              if(flowtoCells.at(flowToId)){
-                                 value = min(value, flowtoCellsBlockCache.at(flowToId)[cell]);
-                              }
+            continue;
+         }
+         const Realf* fromBlock_data = from->get_data(fromLID,popID);
+         
+         // Resolve the block in all flowto cells once, a missing block limits the value to zero
+         std::array<const Realf*,27> flowtoBlock;
+         flowtoBlock.fill(NULL);
+         for (uint i=0; i<27; i++) {
+            if (flowtoCells[i] == NULL) continue;
+            const vmesh::LocalID nbrLID = flowtoCells[i]->get_velocity_block_local_id(blockGID,popID);
+            if (nbrLID == flowtoCells[i]->invalid_local_id()) {
+               flowtoBlock[i] = flowtoCells[i]->null_block_data.data();
+            } else {
+               flowtoBlock[i] = flowtoCells[i]->get_data(nbrLID,popID);
+            }
+         }
+         
+         const Real* blockParameters = to->get_block_parameters(blockLID, popID);
+         // check where cells are
+         creal vxBlock = blockParameters[BlockParams::VXCRD];
+         creal vyBlock = blockParameters[BlockParams::VYCRD];
+         creal vzBlock = blockParameters[BlockParams::VZCRD];
+         creal dvxCell = blockParameters[BlockParams::DVX];
+         creal dvyCell = blockParameters[BlockParams::DVY];
+         creal dvzCell = blockParameters[BlockParams::DVZ];
+         
+         for (uint kc=0; kc<WID; ++kc) {
+            creal vzCellCenter = vzBlock + (kc+convert<Real>(0.5))*dvzCell;
+            const int vzCellSign = vzCellCenter < 0 ? -1 : 1;
+            for (uint jc=0; jc<WID; ++jc) {
+               creal vyCellCenter = vyBlock + (jc+convert<Real>(0.5))*dvyCell;
+               const int vyCellSign = vyCellCenter < 0 ? -1 : 1;
+               for (uint ic=0; ic<WID; ++ic) {
+                  creal vxCellCenter = vxBlock + (ic+convert<Real>(0.5))*dvxCell;
+                  const int vxCellSign = vxCellCenter < 0 ? -1 : 1;
+                  velocity_cell_indices_t indices = {ic, jc, kc};
+                  const uint cell = from->get_velocity_cell(indices);
+                  
+                  Realf value = fromBlock_data[cell];
+                  //loop over spatial cells in quadrant of influence
+                  for(int dvx = 0 ; dvx <= 1; dvx++) {
+                     for(int dvy = 0 ; dvy <= 1; dvy++) {
+                        for(int dvz = 0 ; dvz <= 1; dvz++) {
+                           const int flowToId = nbrID(dvx * vxCellSign, dvy * vyCellSign, dvz * vzCellSign);
+                           if(flowtoBlock[flowToId]){
+                              value = min(value, flowtoBlock[flowToId][cell]);
                            }
                         }
                      }
-                     to->set_value(blockGID, cell,  value, popID);
                   }
+                  toBlock_data[cell] = value;
                }
             }
          }
@@ -326,6 +351,73 @@ namespace SBC {
       calculateCellMoments(to,true,true);
    }
    
+   /*! Create a copy operation from the closest sysboundarytype::NOT_SYSBOUNDARY cell into the given cell.
+    * \param mpiGrid Grid
+    * \param cellID The cell's ID.
+    * \param type Type of the copy.
+    */
+   VlasovCopyOp SysBoundaryCondition::makeCopyOp(
+      const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+      const CellID& cellID,
+      const VlasovCopyOp::Type type
+   ) {
+      const CellID closestCell = getTheClosestNonsysboundaryCell(cellID);
+      if(closestCell == INVALID_CELLID) {
+         cerr << __FILE__ << ":" << __LINE__ << ": No closest cell found!" << endl;
+         abort();
+      }
+      
+      VlasovCopyOp op;
+      op.type = type;
+      op.cellID = cellID;
+      op.sbc = this;
+      op.from = mpiGrid[closestCell];
+      op.to = mpiGrid[cellID];
+      op.flowtoCells = (type == VlasovCopyOp::COPY_LIMIT) ? &getFlowtoCells(cellID) : NULL;
+      return op;
+   }
+   
+   void SysBoundaryCondition::getVlasovCopyPlan(
+      const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+      const CellID& cellID,
+      const uint popID,
+      std::vector<VlasovCopyOp>& plan
+   ) {
+      VlasovCopyOp op;
+      op.type = VlasovCopyOp::GENERIC;
+      op.cellID = cellID;
+      op.sbc = this;
+      op.from = NULL;
+      op.to = mpiGrid[cellID];
+      op.flowtoCells = NULL;
+      plan.push_back(op);
+   }
+   
+   /*! Apply one operation of a Vlasov copy plan, see getVlasovCopyPlan.
+    * \param mpiGrid Grid
+    * \param op The operation.
+    */
+   void SysBoundaryCondition::applyVlasovCopyOp(
+      const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+      const VlasovCopyOp& op,
+      const uint popID
+   ) {
+      switch(op.type) {
+         case VlasovCopyOp::GENERIC:
+            vlasovBoundaryCondition(mpiGrid,op.cellID,popID);
+            break;
+         case VlasovCopyOp::COPY:
+            copyCellData(op.from,op.to,false,false,popID);
+            break;
+         case VlasovCopyOp::COPY_MOMENTS:
+            copyCellData(op.from,op.to,false,true,popID);
+            break;
+         case VlasovCopyOp::COPY_LIMIT:
+            vlasovBoundaryCopyAndLimit(op.from,op.to,*op.flowtoCells,popID);
+            break;
+      }
+   }
+   
    /*! Function used to copy the distribution and moments from one cell to another. In layer 2, copy only the moments.
     * \param from Pointer to parent cell to copy from.
     * \param to Pointer to destination cell.
@@ -851,6 +943,13 @@ namespace SBC {
     */
    bool SysBoundaryCondition::isDynamic() const {return isThisDynamic;}
    
+   bool SysBoundaryCondition::updateState(
+      const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+      creal& t
+   ) {
+      return false;
+   }
+   
    void SysBoundaryCondition::setPeriodicity(
       bool isFacePeriodic[3]
    ) {
@@ -37,6 +37,29 @@ using namespace spatial_cell;
 using namespace projects;
 
 namespace SBC {
+   class SysBoundaryCondition;
+
+   /*!\brief One precomputed step of the Vlasov boundary condition of a boundary cell.
+    * 
+    * The operations are collected by SysBoundaryCondition::getVlasovCopyPlan after load
+    * balancing, so that applying the boundary conditions does not need to look up faces,
+    * layers or closest cells again. Cell pointers are valid until the next load balance.
+    */
+   struct VlasovCopyOp {
+      enum Type {
+         GENERIC,      /*!< Call vlasovBoundaryCondition() of the boundary condition.*/
+         COPY,         /*!< Copy distribution and moments from the closest non-boundary cell.*/
+         COPY_MOMENTS, /*!< Copy only the moments from the closest non-boundary cell.*/
+         COPY_LIMIT    /*!< Copy the distribution limited by the flowto cells, recompute moments.*/
+      };
+      Type type;
+      CellID cellID;
+      SysBoundaryCondition* sbc;
+      SpatialCell* from;
+      SpatialCell* to;
+      const std::array<SpatialCell*,27>* flowtoCells;
+   };
+
    /*!\brief SBC::SysBoundaryCondition is the base class for system boundary conditions.
     * 
     * SBC::SysBoundaryCondition defines a base class for applying boundary conditions.
@@ -150,7 +173,37 @@ namespace SBC {
             const CellID& cellID,
             const uint popID
         )=0;
+         
+         /** Append the operations that vlasovBoundaryCondition() would perform on 
+          * the given cell to the plan. The default is a single GENERIC operation, 
+          * boundary conditions that copy from their neighbors override this.
+          * @param mpiGrid Parallel grid.
+          * @param cellID Spatial cell ID.
+          * @param popID Particle species ID.
+          * @param plan Operations are appended here.*/
+         virtual void getVlasovCopyPlan(
+            const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+            const CellID& cellID,
+            const uint popID,
+            std::vector<VlasovCopyOp>& plan
+         );
+         void applyVlasovCopyOp(
+            const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+            const VlasovCopyOp& op,
+            const uint popID
+         );
 
+         /** Update the state of a dynamic boundary condition to time t. The result must 
+          * only depend on t and the input, as the return value is assumed to be equal on 
+          * all processes.
+          * @param mpiGrid Parallel grid.
+          * @param t Simulation time.
+          * @return If true, velocity blocks of boundary cells were changed.*/
+         virtual bool updateState(
+            const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+            creal& t
+         );
+         
          virtual void getFaces(bool* faces);
          virtual std::string getName() const=0;
          virtual uint getIndex() const=0;
@@ -217,6 +270,17 @@ namespace SBC {
                const CellID& cellID,
                const uint popID
          );
+         void vlasovBoundaryCopyAndLimit(
+               SpatialCell* from,
+               SpatialCell* to,
+               const std::array<SpatialCell*,27>& flowtoCells,
+               const uint popID
+         );
+         VlasovCopyOp makeCopyOp(
+               const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+               const CellID& cellID,
+               const VlasovCopyOp::Type type
+         );
          void vlasovBoundaryCopyFromAllClosestNbrs(
             const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
             const CellID& cellID,
@@ -0,0 +1,84 @@
+/*
+ * This file is part of Vlasiator.
+ * Copyright 2010-2016 Finnish Meteorological Institute
+ *
+ * For details of usage, see the COPYING file and read the "Rules of the Road"
+ * at http://www.physics.helsinki.fi/vlasiator/
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <fstream>
+#include <vector>
+
+#include "task_trace.h"
+
+using namespace std;
+
+namespace tasktrace {
+   namespace detail {
+      bool enabled = false;
+   }
+
+   struct Event {
+      const char* name;
+      uint popID;
+      double start;
+      double end;
+   };
+
+   static string fileName;
+   static uint stepsLeft = 0;
+   static double origin = 0.0;
+   static vector<vector<Event> > events; // one list per thread, so recording needs no locking
+
+   void open(const std::string& fname,const uint steps) {
+      fileName = fname;
+      stepsLeft = steps;
+      origin = omp_get_wtime();
+      events.assign(omp_get_max_threads(),vector<Event>());
+      detail::enabled = steps > 0;
+   }
+
+   void record(const char* name,const uint popID,const double startTime) {
+      if (detail::enabled == false) return;
+      const Event event = {name,popID,startTime,omp_get_wtime()};
+      events[omp_get_thread_num()].push_back(event);
+   }
+
+   void endStep() {
+      if (detail::enabled == false) return;
+      if (--stepsLeft > 0) return;
+      detail::enabled = false;
+
+      // Complete events ("ph":"X") with microsecond time stamps, one row (tid) per thread
+      ofstream out(fileName.c_str());
+      out << "{\"traceEvents\":[" << endl;
+      bool first = true;
+      for (size_t t=0; t<events.size(); ++t) {
+         for (size_t e=0; e<events[t].size(); ++e) {
+            const Event& event = events[t][e];
+            if (!first) out << "," << endl;
+            first = false;
+            out << "{\"name\":\"" << event.name << " pop" << event.popID << "\",\"cat\":\"" << event.name
+                << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << t
+                << ",\"ts\":" << (event.start-origin)*1e6 << ",\"dur\":" << (event.end-event.start)*1e6
+                << ",\"args\":{\"popID\":" << event.popID << "}}";
+         }
+      }
+      out << endl << "]}" << endl;
+      events.clear();
+   }
+}
@@ -0,0 +1,61 @@
+/*
+ * This file is part of Vlasiator.
+ * Copyright 2010-2016 Finnish Meteorological Institute
+ *
+ * For details of usage, see the COPYING file and read the "Rules of the Road"
+ * at http://www.physics.helsinki.fi/vlasiator/
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef TASK_TRACE_H
+#define TASK_TRACE_H
+
+#include <string>
+#include <omp.h>
+
+/*! Per-thread timeline of the population tasks (vlasovsolver.populationTaskTrace).
+ *
+ * Records the start and end of every acceleration, content list, block adjustment and
+ * transfer task of one process for a number of time steps, and writes them in the Chrome
+ * trace event format (open in chrome://tracing or ui.perfetto.dev). One row per OpenMP
+ * thread shows how the transfers of one population on the master thread overlap with the
+ * work of the other threads on other populations.
+ */
+namespace tasktrace {
+   namespace detail {
+      extern bool enabled; /*!< If true, tasks are recorded.*/
+   }
+
+   /*! Start tracing on this process. Has to be called outside of parallel regions.
+    * \param fname Output file name.
+    * \param steps Number of time steps traced, 0 disables tracing.*/
+   void open(const std::string& fname,const uint steps);
+
+   /*! Return the start time of a task, to be passed to record.*/
+   inline double start() {
+      return detail::enabled ? omp_get_wtime() : 0.0;
+   }
+
+   /*! Record a task of the calling thread that started at startTime and ends now.
+    * \param name Task name, has to be a string literal.
+    * \param popID Population the task worked on.
+    * \param startTime Return value of start().*/
+   void record(const char* name,const uint popID,const double startTime);
+
+   /*! Mark the end of a time step. Writes the trace file after the last traced step.*/
+   void endStep();
+}
+
+#endif
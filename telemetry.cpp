@@ -0,0 +1,173 @@
+/*
+ * This file is part of Vlasiator.
+ * Copyright 2010-2016 Finnish Meteorological Institute
+ *
+ * For details of usage, see the COPYING file and read the "Rules of the Road"
+ * at http://www.physics.helsinki.fi/vlasiator/
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include "telemetry.h"
+
+using namespace std;
+
+namespace telemetry {
+   namespace detail {
+      bool enabled = false;
+      double phaseStart[N_PHASES] = {0.0};
+      double phaseTime[N_PHASES] = {0.0};
+      uint64_t collectives = 0;
+   }
+
+   // Per-process values in a record: phase times, total step time, blocks, cells and collectives per step.
+   static const int STEP_TIME   = N_PHASES;
+   static const int BLOCKS      = N_PHASES+1;
+   static const int CELLS       = N_PHASES+2;
+   static const int COLLECTIVES = N_PHASES+3;
+   static const int N_VALUES    = N_PHASES+4;
+   static const char* valueNames[N_VALUES] = {
+      "spatial_space","velocity_space","propagate_fields","io","mpi_wait","step","blocks","cells","collectives"
+   };
+
+   static MPI_Comm comm = MPI_COMM_NULL;
+   static int masterRank = 0;
+   static int myRank = 0;
+   static int nProcesses = 1;
+   static uint interval = 0;
+   static uint stepsInRecord = 0;
+   static bool recordRequested = false;
+   static double recordStartTime = 0.0;
+   static MPI_Datatype recordType = MPI_DATATYPE_NULL;
+   static MPI_Op recordOp = MPI_OP_NULL;
+   static ofstream* out = NULL;
+
+   /*! Reduction operator for records laid out as [min[N_VALUES],max[N_VALUES],sum[N_VALUES]].
+    * A whole record is a single element of recordType, so MPI never splits it.*/
+   static void reduceRecord(void* invec,void* inoutvec,int* len,MPI_Datatype* datatype) {
+      const double* in = reinterpret_cast<const double*>(invec);
+      double* inout = reinterpret_cast<double*>(inoutvec);
+      for (int r=0; r<*len; ++r) {
+         for (int i=0; i<N_VALUES; ++i) {
+            inout[i]            = min(inout[i],in[i]);
+            inout[N_VALUES+i]   = max(inout[N_VALUES+i],in[N_VALUES+i]);
+            inout[2*N_VALUES+i] += in[2*N_VALUES+i];
+         }
+         in    += 3*N_VALUES;
+         inout += 3*N_VALUES;
+      }
+   }
+
+   bool open(MPI_Comm communicator,const int& master,const std::string& fname,const uint& telemetryInterval,const bool& append) {
+      detail::enabled = false;
+      interval = telemetryInterval;
+      if (interval == 0) return true;
+
+      MPI_Comm_dup(communicator,&comm);
+      MPI_Comm_rank(comm,&myRank);
+      MPI_Comm_size(comm,&nProcesses);
+      masterRank = master;
+
+      MPI_Type_contiguous(3*N_VALUES,MPI_DOUBLE,&recordType);
+      MPI_Type_commit(&recordType);
+      MPI_Op_create(&reduceRecord,1,&recordOp);
+
+      int success = 1;
+      if (myRank == masterRank) {
+         out = new ofstream(fname.c_str(),append ? (ios::out | ios::app) : (ios::out | ios::trunc));
+         if (out->good() == false) {
+            success = 0;
+            delete out;
+            out = NULL;
+         }
+      }
+      MPI_Bcast(&success,1,MPI_INT,masterRank,comm);
+      if (success == 0) {
+         close();
+         return false;
+      }
+
+      for (int p=0; p<N_PHASES; ++p) detail::phaseTime[p] = 0.0;
+      detail::collectives = 0;
+      stepsInRecord = 0;
+      recordStartTime = MPI_Wtime();
+      detail::enabled = true;
+      return true;
+   }
+
+   void close() {
+      detail::enabled = false;
+      if (out != NULL) {
+         out->close();
+         delete out;
+         out = NULL;
+      }
+      if (recordOp != MPI_OP_NULL) MPI_Op_free(&recordOp);
+      if (recordType != MPI_DATATYPE_NULL) MPI_Type_free(&recordType);
+      if (comm != MPI_COMM_NULL) MPI_Comm_free(&comm);
+   }
+
+   void requestRecord() {
+      recordRequested = detail::enabled;
+   }
+
+   void endStep(const uint& tstep,const Real& t,const Real& dt,const uint64_t& localBlocks,const uint64_t& localCells) {
+      if (detail::enabled == false) return;
+      ++stepsInRecord;
+      if (tstep % interval != 0 && recordRequested == false) return;
+      recordRequested = false;
+
+      const double now = MPI_Wtime();
+      double local[3*N_VALUES];
+      double global[3*N_VALUES];
+      for (int p=0; p<N_PHASES; ++p) local[p] = detail::phaseTime[p] / stepsInRecord;
+      local[STEP_TIME]   = (now - recordStartTime) / stepsInRecord;
+      local[BLOCKS]      = localBlocks;
+      local[CELLS]       = localCells;
+      local[COLLECTIVES] = double(detail::collectives) / stepsInRecord;
+      for (int i=0; i<N_VALUES; ++i) {
+         local[N_VALUES+i]   = local[i];
+         local[2*N_VALUES+i] = local[i];
+      }
+
+      MPI_Reduce(local,global,1,recordType,recordOp,masterRank,comm);
+
+      if (myRank == masterRank && out != NULL) {
+         stringstream record;
+         record << setprecision(6);
+         record << "{\"tstep\":" << tstep << ",\"t\":" << t << ",\"dt\":" << dt;
+         record << ",\"steps\":" << stepsInRecord << ",\"processes\":" << nProcesses;
+         for (int i=0; i<N_VALUES; ++i) {
+            const double avg = global[2*N_VALUES+i] / nProcesses;
+            const double imbalance = (avg > 0.0) ? global[N_VALUES+i] / avg : 1.0;
+            record << ",\"" << valueNames[i] << "\":{\"min\":" << global[i]
+                   << ",\"max\":" << global[N_VALUES+i]
+                   << ",\"avg\":" << avg
+                   << ",\"imbalance\":" << imbalance << "}";
+         }
+         record << "}" << endl;
+         (*out) << record.str() << flush;
+      }
+
+      for (int p=0; p<N_PHASES; ++p) detail::phaseTime[p] = 0.0;
+      detail::collectives = 0;
+      stepsInRecord = 0;
+      recordStartTime = MPI_Wtime();
+   }
+}
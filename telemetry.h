@@ -0,0 +1,97 @@
+/*
+ * This file is part of Vlasiator.
+ * Copyright 2010-2016 Finnish Meteorological Institute
+ *
+ * For details of usage, see the COPYING file and read the "Rules of the Road"
+ * at http://www.physics.helsinki.fi/vlasiator/
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <mpi.h>
+#include <stdint.h>
+#include <string>
+
+#include "definitions.h"
+
+/*! Lightweight per-step performance telemetry.
+ * 
+ * Each process accumulates the wall time spent in the main propagation phases and in
+ * MPI waits. Every io.telemetry_interval steps the per-process values (averaged per step)
+ * are reduced to the master process with a single MPI_Reduce, and the master writes one
+ * JSON record per line containing the min/max/avg over processes and the imbalance max/avg.
+ * The number of global collectives issued per step is counted with countCollective().
+ * When telemetry is disabled start/stop reduce to a single branch.
+ */
+namespace telemetry {
+   enum Phase {
+      SPATIAL_SPACE,    /*!< Time spent in "Spatial-space".*/
+      VELOCITY_SPACE,   /*!< Time spent in "Velocity-space".*/
+      PROPAGATE_FIELDS, /*!< Time spent in "Propagate Fields".*/
+      IO,               /*!< Time spent in "IO".*/
+      MPI_WAIT,         /*!< Time spent waiting for ghost/remote data. Also included in the phase that issued the wait.*/
+      N_PHASES
+   };
+
+   namespace detail {
+      extern bool enabled;               /*!< If true, telemetry is collected.*/
+      extern double phaseStart[N_PHASES]; /*!< MPI_Wtime when the phase was last started.*/
+      extern double phaseTime[N_PHASES];  /*!< Accumulated time in each phase since last record.*/
+      extern uint64_t collectives;        /*!< Number of global collectives since last record.*/
+   }
+
+   /*! Open the telemetry output. Collective operation on comm.
+    * \param comm Communicator over which telemetry is reduced.
+    * \param masterRank Rank that writes the records.
+    * \param fname Output file name.
+    * \param interval Write a record every this many time steps, 0 disables telemetry.
+    * \param append If true, records are appended to an existing file (restarts).
+    * \return If true, telemetry was opened successfully on all processes.*/
+   bool open(MPI_Comm comm,const int& masterRank,const std::string& fname,const uint& interval,const bool& append);
+
+   /*! Close the telemetry output and free the reduction operator.*/
+   void close();
+
+   /*! Mark the end of a time step. Collective operation on the communicator given to open()
+    * on steps that are multiples of the interval, all processes must call this on every step.
+    * \param tstep Time step that was just completed.
+    * \param t Simulation time at the beginning of the step.
+    * \param dt Time step length.
+    * \param localBlocks Number of velocity blocks (all populations) on this process.
+    * \param localCells Number of spatial cells on this process.*/
+   void endStep(const uint& tstep,const Real& t,const Real& dt,const uint64_t& localBlocks,const uint64_t& localCells);
+
+   inline void start(const Phase& phase) {
+      if (detail::enabled) detail::phaseStart[phase] = MPI_Wtime();
+   }
+
+   inline void stop(const Phase& phase) {
+      if (detail::enabled) detail::phaseTime[phase] += MPI_Wtime() - detail::phaseStart[phase];
+   }
+
+   /*! Write a record at the end of the current step even if it is not a multiple of the
+    * interval. Has to be called on all processes of the communicator.*/
+   void requestRecord();
+
+   /*! Count one global (MPI_COMM_WORLD wide) collective operation issued in the time loop.*/
+   inline void countCollective() {
+      if (detail::enabled) ++detail::collectives;
+   }
+}
+
+#endif
@@ -33,6 +33,8 @@
  * "$ vlsvdiff <folder1> <folder2> <Variable> <component>": Gives single-file statistics and distances between pairs of files grid*.vlsv taken in alphanumeric order in the two folders given, for the variable and component given
  * 
  * "$ vlsvdiff <file1> <folder2> <Variable> <component>" or "$ vlsvdiff <folder1> <file2> <Variable> <component>": Gives single-file statistics and distances between a file, and files grid*.vlsv taken in alphanumeric order in the given folder, for the variable and component given
+ * 
+ * In the folder modes the pairs of files are compared concurrently by the OpenMP threads (set OMP_NUM_THREADS), and the results are printed in file order.
  */
 
 
@@ -49,6 +51,9 @@
 #include <typeinfo>
 #include <algorithm>
 #include <cstring>
+#include <array>
+#include <vector>
+#include <unordered_map>
 
 #include "definitions.h"
 #include <vlsv_reader.h>
@@ -171,32 +176,50 @@ bool cloneMesh(const string& inputFileName,vlsv::Writer& output,const string& me
    return success;
 }
 
+/*! Values of one variable component read from one file, sorted by spatial cell ID. The
+ * comparisons below are plain loops over these arrays.
+ */
+struct CellData {
+   vector<uint64_t> cellIds;   /*!< Spatial cell IDs in ascending order.*/
+   vector<Real> values;        /*!< Variable component of each cell.*/
+   vector<uint64_t> fileIndex; /*!< Position of each cell in the file, used when writing the difference file.*/
+
+   size_t size() const {return cellIds.size();}
+};
+
+/*! Results of comparing one pair of files. In non-verbose mode these are collected while
+ * the pairs are processed and printed in file order afterwards.
+ */
+struct PairResult {
+   vector<Real> stats;     /*!< Size, min, max, average and standard deviation of both files.*/
+   vector<Real> distances; /*!< Absolute and relative distances in the order listed by printNonVerboseData.*/
+   string text;            /*!< Output of the distribution function comparison.*/
+};
+
+static const uint64_t cellReadChunk = 65536;   /*!< Number of spatial cells read at a time when streaming variable data.*/
+static const uint64_t blockReadChunk = 262144; /*!< Approximate number of velocity blocks read at a time when streaming distribution functions.*/
+
 /*! Extracts the dataset from the VLSV file opened by convertSILO.
  * \param vlsvReader vlsvinterface::Reader class object used to access the VLSV file
  * \param meshName Address of the string containing the name of the mesh to be extracted
  * \param varToExtract Pointer to the char array containing the name of the variable to extract
  * \param compToExtract Unsigned int designating the component to extract (0 for scalars)
- * \param orderedData Pointer to the return argument map which will get the extracted dataset
+ * \param data Return argument which will get the extracted dataset, sorted by cell ID
  */
 bool convertMesh(vlsvinterface::Reader& vlsvReader,
                  const string& meshName,
                  const char * varToExtract,
                  const uint compToExtract,
-                 map<uint, Real> * orderedData,
-                 unordered_map<size_t,size_t>& cellOrder,
-                 const bool& storeCellOrder) {
+                 CellData& data) {
 
    //Check for null pointer:
-   if( !varToExtract || !orderedData ) {
+   if( !varToExtract ) {
       cerr << "ERROR, PASSED A NULL POINTER AT " << __FILE__ << " " << __LINE__ << endl;
       return false;
    }
-   bool meshSuccess = true;
    bool variableSuccess = true;
    
-   datatype::type meshDataType;
    datatype::type variableDataType;
-   uint64_t meshArraySize, meshVectorSize, meshDataSize;
    uint64_t variableArraySize, variableVectorSize, variableDataSize;
 
    list<pair<string, string> > variableAttributes;
@@ -224,80 +247,81 @@ bool convertMesh(vlsvinterface::Reader& vlsvReader,
       cerr << "ERROR invalid component, this variable has size " << variableVectorSize << endl;
       abort();
    }
-   
-   // Read the mesh array one node (of a spatial cell) at a time 
-   // and create a map which contains each cell's CellID and variable to be extracted
-   char* variableBuffer = new char[variableVectorSize*variableDataSize];
-   float* variablePtrFloat = reinterpret_cast<float*>(variableBuffer);
-   double* variablePtrDouble = reinterpret_cast<double*>(variableBuffer);
-   uint* variablePtrUint = reinterpret_cast<uint*>(variableBuffer);
-   int* variablePtrInt = reinterpret_cast<int*>(variableBuffer);
-
-   if (storeCellOrder == true) {
-      cellOrder.clear();
+   if (variableDataType == datatype::type::UNKNOWN) {
+      cerr << "ERROR, BAD DATATYPE AT " << __FILE__ << " " << __LINE__ << endl;
    }
-   
-   orderedData->clear();
 
-   for (uint64_t i=0; i<local_cells.size(); ++i) {
-      const short int amountToReadIn = 1;
-      const uint64_t & startingReadIndex = i;
-      if (vlsvReader.readArray("VARIABLE", variableAttributes, startingReadIndex, amountToReadIn, variableBuffer) == false) {
+   // Stream the variable array in chunks of cellReadChunk cells and pick the wanted
+   // component of each cell. Values stay in file order until all of them have been read.
+   const int64_t nCells = local_cells.size();
+   const uint64_t bytesPerCell = variableVectorSize*variableDataSize;
+   vector<Real> fileValues(nCells, NAN);
+   char* variableBuffer = new char[min(cellReadChunk,(uint64_t)max(nCells,(int64_t)1))*bytesPerCell];
+
+   for (int64_t start=0; start<nCells; start+=cellReadChunk) {
+      const int64_t amountToReadIn = min((int64_t)cellReadChunk,nCells-start);
+      if (vlsvReader.readArray("VARIABLE", variableAttributes, start, amountToReadIn, variableBuffer) == false) {
          cerr << "ERROR, failed to read variable '" << _varToExtract << "' at " << __FILE__ << " " << __LINE__ << endl;
          variableSuccess = false; 
          break;
       }
-      // Get the CellID
-      uint64_t & CellID = local_cells[i];
-      
-      // Get the variable value
-      Real extract = NAN;
 
-      switch (variableDataType) {
-         case datatype::type::FLOAT:
-            if(variableDataSize == sizeof(float)) extract = (Real)(variablePtrFloat[compToExtract]);
-            if(variableDataSize == sizeof(double)) extract = (Real)(variablePtrDouble[compToExtract]);
-            break;
-         case datatype::type::UINT:
-            extract = (Real)(variablePtrUint[compToExtract]);
-            break;
-         case datatype::type::INT:
-            extract = (Real)(variablePtrInt[compToExtract]);
-            break;
-         case datatype::type::UNKNOWN:
-            cerr << "ERROR, BAD DATATYPE AT " << __FILE__ << " " << __LINE__ << endl;
-            break;
-      }
-      // Put those into the map
-      orderedData->insert(pair<uint64_t, Real>(CellID, extract));
-      if (storeCellOrder == true) {
-         cellOrder[CellID] = i;
+      #pragma omp parallel for
+      for (int64_t i=0; i<amountToReadIn; ++i) {
+         const char* ptr = variableBuffer + i*bytesPerCell;
+         Real extract = NAN;
+         switch (variableDataType) {
+            case datatype::type::FLOAT:
+               if(variableDataSize == sizeof(float)) extract = (Real)(reinterpret_cast<const float*>(ptr)[compToExtract]);
+               if(variableDataSize == sizeof(double)) extract = (Real)(reinterpret_cast<const double*>(ptr)[compToExtract]);
+               break;
+            case datatype::type::UINT:
+               extract = (Real)(reinterpret_cast<const uint*>(ptr)[compToExtract]);
+               break;
+            case datatype::type::INT:
+               extract = (Real)(reinterpret_cast<const int*>(ptr)[compToExtract]);
+               break;
+            default:
+               break;
+         }
+         fileValues[start+i] = extract;
       }
    }
+   delete [] variableBuffer;
+
+   // Sort by cell ID
+   vector<uint64_t> order(nCells);
+   for (int64_t i=0; i<nCells; ++i) order[i] = i;
+   sort(order.begin(),order.end(),[&local_cells](const uint64_t& a,const uint64_t& b) {return local_cells[a] < local_cells[b];});
 
-   if (meshSuccess == false) {
-      cerr << "ERROR reading array MESH" << endl;
+   data.cellIds.resize(nCells);
+   data.values.resize(nCells);
+   data.fileIndex.resize(nCells);
+   #pragma omp parallel for
+   for (int64_t i=0; i<nCells; ++i) {
+      data.cellIds[i]   = local_cells[order[i]];
+      data.values[i]    = fileValues[order[i]];
+      data.fileIndex[i] = order[i];
    }
+
    if (variableSuccess == false) {
       cerr << "ERROR reading array VARIABLE " << varToExtract << endl;
    }
-   return meshSuccess && variableSuccess;
+   return variableSuccess;
 }
 
 /*! Opens the VLSV file and extracts the mesh names. Sends for processing to convertMesh.
  * \param fileName String containing the name of the file to be processed
  * \param varToExtract Pointer to the char array containing the name of the variable to extract
  * \param compToExtract Unsigned int designating the component to extract (0 for scalars)
- * \param orderedData Pointer to the return argument map which will get the extracted dataset
+ * \param data Return argument which will get the extracted dataset
  * \sa convertMesh
  */
 template <class T>
 bool convertSILO(const string fileName,
                  const char * varToExtract,
                  const uint compToExtract,
-                 map<uint, Real> * orderedData,
-                 unordered_map<size_t,size_t>& cellOrder,
-                 const bool& storeCellOrder=false) {
+                 CellData& data) {
    bool success = true;
 
    // Open VLSV file for reading:
@@ -317,12 +341,14 @@ bool convertSILO(const string fileName,
    }
 
    // Clear old data
-   orderedData->clear();
+   data.cellIds.clear();
+   data.values.clear();
+   data.fileIndex.clear();
 
    for (list<string>::const_iterator it=meshNames.begin(); it!=meshNames.end(); ++it) {
-      if (*it != attributes["--meshname"]) continue;
+      if (*it != attributes.at("--meshname")) continue;
 
-      if (convertMesh(vlsvReader, *it, varToExtract, compToExtract, orderedData, cellOrder, storeCellOrder) == false) {
+      if (convertMesh(vlsvReader, *it, varToExtract, compToExtract, data) == false) {
          return false;
       }      
    }
@@ -330,38 +356,50 @@ bool convertSILO(const string fileName,
    return success;
 }
 
-/*! Shift the second file to the average of the first
- * \param orderedData1 Pointer to the reference file's data
- * \param orderedData2 Pointer to the data to be shifted
- * \param shiftedData2 Pointer to where the shifted data of the second file will be put
+/*! Find for each cell of the first dataset the index of the same cell in the second one.
+ * Both datasets are sorted by cell ID, so a single merge pass is enough.
+ * \param data1 Reference file's data
+ * \param data2 Second file's data
+ * \param match Return argument, index into data2 for each cell of data1, or -1 if the cell is missing from data2
  */
-bool shiftAverage(const map<uint, Real>* const orderedData1,
-                  const map<uint, Real>* const orderedData2,
-                  map<uint,Real>* shiftedData2
-                 ) {
-   map<uint, Real>::const_iterator it1, it2;
-   Real avg1 = 0.0;
-   Real avg2 = 0.0;
-   
-   for(it1=orderedData1->begin(), it2=orderedData2->begin();
-       it1 != orderedData1->end(), it2 != orderedData2->end();
-       it1++, it2++)
-   {
-      avg1 += orderedData1->at(it1->first);
-      avg2 += orderedData2->at(it2->first);
+void matchCells(const CellData& data1,
+                const CellData& data2,
+                vector<int64_t>& match) {
+   match.assign(data1.size(),-1);
+   size_t j = 0;
+   for (size_t i=0; i<data1.size(); ++i) {
+      while (j < data2.size() && data2.cellIds[j] < data1.cellIds[i]) ++j;
+      if (j < data2.size() && data2.cellIds[j] == data1.cellIds[i]) match[i] = j;
    }
-   avg1 /= orderedData1->size();
-   avg2 /= orderedData1->size();
-   
-   for(it2=orderedData2->begin(); it2 != orderedData2->end(); it2++)
-   {
-      shiftedData2->insert(pair<uint, Real>(it2->first, it2->second - avg2 + avg1));
+}
+
+/*! Compute the averages used to shift the second file to the average of the first
+ * \param data1 Reference file's data
+ * \param data2 Data to be shifted
+ * \param avg1 Return argument, average of the reference data
+ * \param avg2 Return argument, average of the shifted data
+ */
+bool shiftAverage(const CellData& data1,
+                  const CellData& data2,
+                  Real& avg1,
+                  Real& avg2
+                 ) {
+   const int64_t N = min(data1.size(),data2.size());
+   Real sum1 = 0.0;
+   Real sum2 = 0.0;
+
+   #pragma omp parallel for reduction(+:sum1,sum2)
+   for (int64_t i=0; i<N; ++i) {
+      sum1 += data1.values[i];
+      sum2 += data2.values[i];
    }
+   avg1 = sum1 / data1.size();
+   avg2 = sum2 / data1.size();
    
    return 0;
 }
 
-/*! Compute the absolute and relative \f$ p \f$-distance between two datasets X(x) provided in the maps orderedData1 and orderedData2. Note that the dataset passed in orderedData1 will be taken as the reference dataset both when shifting averages and when computing relative distances.
+/*! Compute the absolute and relative \f$ p \f$-distance between two datasets X(x) provided in data1 and data2. Note that the dataset passed in data1 will be taken as the reference dataset both when shifting averages and when computing relative distances.
  * 
  * For \f$ p \neq 0 \f$:
  * 
@@ -383,77 +421,82 @@ bool shiftAverage(const map<uint, Real>* const orderedData1,
  * 
  * \f$ \|X_1 - X_2\|_\infty = \max_i\left(|X_1(i) - X_2(i)|\right) / \|X_1\|_\infty \f$
  * 
- * \param orderedData1 Pointer to the first file's data map
- * \param orderedData2 Pointer to the second file's data map
+ * \param data1 First file's data
+ * \param data2 Second file's data
+ * \param match Index of each cell of data1 in data2, see matchCells
  * \param p Parameter of the distance formula
  * \param absolute Return argument pointer, absolute value
  * \param relative Return argument pointer, relative value
  * \param doShiftAverage Boolean argument to determine whether to shift the second file's data
  * \sa shiftAverage
  */
-bool pDistance(const map<uint, Real>& orderedData1,
-               const map<uint, Real>& orderedData2,
+bool pDistance(const CellData& data1,
+               const CellData& data2,
+               const vector<int64_t>& match,
                creal p,
                Real * absolute,
                Real * relative,
                const bool doShiftAverage,
-               const unordered_map<size_t,size_t>& cellOrder,
                vlsv::Writer& outputFile,
                const std::string& meshName,
                const std::string& varName
               ) {
-   map<uint,Real> shiftedData2;
-   map<uint,Real>* data2 = const_cast< map<uint,Real>* >(&orderedData2);   
-
+   Real avg1 = 0.0;
+   Real avg2 = 0.0;
    if (doShiftAverage == true) {
-      shiftAverage(&orderedData1,&orderedData2,&shiftedData2);
-      data2 = &shiftedData2;
+      shiftAverage(data1,data2,avg1,avg2);
    }
 
    // Reset old values
    *absolute = 0.0;
    *relative = 0.0;
 
-   vector<Real> array(orderedData1.size());
-   for (size_t i=0; i<array.size(); ++i) array[i] = -1.0;
+   // Difference of each cell, in the cell order of the first file
+   const int64_t N = data1.size();
+   vector<Real> array(N,-1.0);
 
+   Real distance = 0.0;
    Real length = 0.0;
    if (p == 0) {
-      for (map<uint,Real>::const_iterator it1=orderedData1.begin(); it1!=orderedData1.end(); ++it1) {
-         map<uint,Real>::const_iterator it2 = data2->find(it1->first);
+      #pragma omp parallel for reduction(max:distance,length)
+      for (int64_t i=0; i<N; ++i) {
          Real value = 0.0;
-         if (it2 != data2->end()) {
-            value = abs(it1->second - it2->second);
-            *absolute = max(*absolute, value);
-            length    = max(length, abs(it1->second));
+         if (match[i] >= 0) {
+            const Real value2 = doShiftAverage ? data2.values[match[i]] - avg2 + avg1 : data2.values[match[i]];
+            value = abs(data1.values[i] - value2);
+            distance = max(distance, value);
+            length   = max(length, abs(data1.values[i]));
          }
-         array[cellOrder.at(it1->first)] = value;
+         array[data1.fileIndex[i]] = value;
       }
    } else if (p == 1) {
-      for (map<uint,Real>::const_iterator it1=orderedData1.begin(); it1!=orderedData1.end(); ++it1) {
-         map<uint,Real>::const_iterator it2 = data2->find(it1->first);
+      #pragma omp parallel for reduction(+:distance,length)
+      for (int64_t i=0; i<N; ++i) {
          Real value = 0.0;
-         if (it2 != data2->end()) {
-            value = abs(it1->second - it2->second);
-            *absolute += value;
-            length    += abs(it1->second);
+         if (match[i] >= 0) {
+            const Real value2 = doShiftAverage ? data2.values[match[i]] - avg2 + avg1 : data2.values[match[i]];
+            value = abs(data1.values[i] - value2);
+            distance += value;
+            length   += abs(data1.values[i]);
          }
-         array[cellOrder.at(it1->first)] = value;
+         array[data1.fileIndex[i]] = value;
       }
    } else {
-      for (map<uint,Real>::const_iterator it1=orderedData1.begin(); it1!=orderedData1.end(); ++it1) {
-         map<uint,Real>::const_iterator it2 = data2->find(it1->first);
+      #pragma omp parallel for reduction(+:distance,length)
+      for (int64_t i=0; i<N; ++i) {
          Real value = 0.0;
-         if (it2 != data2->end()) {
-            value = pow(abs(it1->second - it2->second), p);
-            *absolute += value;
-            length    += pow(abs(it1->second), p);
+         if (match[i] >= 0) {
+            const Real value2 = doShiftAverage ? data2.values[match[i]] - avg2 + avg1 : data2.values[match[i]];
+            value = pow(abs(data1.values[i] - value2), p);
+            distance += value;
+            length   += pow(abs(data1.values[i]), p);
          }
-         array[cellOrder.at(it1->first)] = pow(value,1.0/p);
+         array[data1.fileIndex[i]] = pow(value,1.0/p);
       }
-      *absolute = pow(*absolute, 1.0 / p);
+      distance = pow(distance, 1.0 / p);
       length = pow(length, 1.0 / p);
    }
+   *absolute = distance;
 
    if (length != 0.0) *relative = *absolute / length;
    else {
@@ -475,13 +518,13 @@ bool pDistance(const map<uint, Real>& orderedData1,
    return 0;
 }
 
-/*! In verbose mode print the distance, in non-verbose store them for later output when lastCall is true
+/*! In verbose mode print the distance, in non-verbose store them in the pair's result for later output
  * \param p Parameter of the distance
  * \param absolute Absolute value pointer
  * \param relative Relative value pointer
  * \param shiftedAverage Boolean parameter telling whether the dataset is average-shifted
  * \param verboseOutput Boolean parameter telling whether the output is verbose or compact
- * \param lastCall Boolean parameter telling whether this is the last call to the function
+ * \param result Results of the pair of files being processed
  * \sa shiftAverage pDistance
  */
 bool outputDistance(const Real p,
@@ -489,7 +532,7 @@ bool outputDistance(const Real p,
                     const Real * relative,
                     const bool shiftedAverage,
                     const bool verboseOutput,
-                    const bool lastCall
+                    PairResult& result
 )
 {
    if(verboseOutput == true) {
@@ -501,32 +544,21 @@ bool outputDistance(const Real p,
          cout << "The average-shifted relative " << p << "-distance between both datasets is " << *relative  << endl;
       }
    } else {
-      static vector<Real> fileOutputData;
-      static uint fileNumber = 0;
-      
-      if(lastCall == true) {
-         vector<Real>::const_iterator it;
-         for(it = fileOutputData.begin(); it != fileOutputData.end(); it++) {
-            cout << *it << "\t";
-         }
-         fileOutputData.clear();
-         return 0;
-      }
-      
-      fileOutputData.push_back(*absolute);
-      fileOutputData.push_back(*relative);
+      result.distances.push_back(*absolute);
+      result.distances.push_back(*relative);
    }
    return 0;
 }
 
 /*! Compute statistics on a single file
+ * \param data Dataset
  * \param size Return argument pointer, dataset size
  * \param mini Return argument pointer, dataset minimum
  * \param maxi Return argument pointer, dataset maximum
  * \param avg Return argument pointer, dataset average
  * \param stdev Return argument pointer, dataset standard deviation
  */
-bool singleStatistics(map<uint, Real> * orderedData,
+bool singleStatistics(const CellData& data,
                       Real * size,
                       Real * mini,
                       Real * maxi,
@@ -534,41 +566,41 @@ bool singleStatistics(map<uint, Real> * orderedData,
                       Real * stdev
 )
 {
-   /*
-    * Returns basic statistics on the map passed to it.
-    */
-   map<uint, Real>::const_iterator it;
-   
-   *size = orderedData->size();
-   *mini = numeric_limits<Real>::max();
-   *maxi = numeric_limits<Real>::min();
-   *avg = 0.0;
-   *stdev = 0.0;
-   
-   for(it=orderedData->begin(); it != orderedData->end() ; it++)
-   {
-      *mini = min(*mini, orderedData->at(it->first));
-      *maxi = max(*maxi, orderedData->at(it->first));
-      *avg += orderedData->at(it->first);
-   }
-   *avg /= *size;
-   for(it=orderedData->begin(); it != orderedData->end() ; it++)
-   {
-      *stdev += pow(orderedData->at(it->first) - *avg, 2.0);
-   }
-   *stdev = sqrt(*stdev);
+   const int64_t N = data.size();
+   Real minValue = numeric_limits<Real>::max();
+   Real maxValue = numeric_limits<Real>::min();
+   Real sum = 0.0;
+
+   #pragma omp parallel for reduction(min:minValue) reduction(max:maxValue) reduction(+:sum)
+   for (int64_t i=0; i<N; ++i) {
+      minValue = min(minValue, data.values[i]);
+      maxValue = max(maxValue, data.values[i]);
+      sum += data.values[i];
+   }
+   *size = N;
+   *mini = minValue;
+   *maxi = maxValue;
+   *avg = sum / *size;
+
+   const Real average = *avg;
+   Real variance = 0.0;
+   #pragma omp parallel for reduction(+:variance)
+   for (int64_t i=0; i<N; ++i) {
+      variance += pow(data.values[i] - average, 2.0);
+   }
+   *stdev = sqrt(variance);
    *stdev /= (*size - 1);
    return 0;
 }
 
-/*! In verbose mode print the statistics, in non-verbose store them for later output when lastCall is true
+/*! In verbose mode print the statistics, in non-verbose store them in the pair's result for later output
  * \param size Pointer to dataset size
  * \param mini Pointer to dataset minimum
  * \param maxi Pointer to dataset maximum
  * \param avg Pointer to dataset average
  * \param stdev Pointer to dataset standard deviation
  * \param verboseOutput Boolean parameter telling whether the output is verbose or compact
- * \param lastCall Boolean parameter telling whether this is the last call to the function
+ * \param result Results of the pair of files being processed
  * \sa singleStatistics
  */
 bool outputStats(const Real * size,
@@ -577,7 +609,7 @@ bool outputStats(const Real * size,
                  const Real * avg,
                  const Real * stdev,
                  const bool verboseOutput,
-                 const bool lastCall
+                 PairResult& result
                  ) {
    if(verboseOutput == true)
    {
@@ -590,38 +622,21 @@ bool outputStats(const Real * size,
    }
    else
    {
-      static uint fileNumber = 0;
-      static vector<Real> pairStats;
-      
-      if(lastCall == true)
-      {
-         vector<Real>::const_iterator it;
-         for(it = pairStats.begin(); it != pairStats.end(); it++)
-         {
-            cout << *it << "\t";
-         }
-         pairStats.clear();
-         return 0;
-      }
-      
-      if(fileNumber%2 == 0)
-      {
-         pairStats.push_back(fileNumber / 2 + 1);
-      }
-      pairStats.push_back(*size);
-      pairStats.push_back(*mini);
-      pairStats.push_back(*maxi);
-      pairStats.push_back(*avg);
-      pairStats.push_back(*stdev);
-      fileNumber++;
+      result.stats.push_back(*size);
+      result.stats.push_back(*mini);
+      result.stats.push_back(*maxi);
+      result.stats.push_back(*avg);
+      result.stats.push_back(*stdev);
    }
    return 0;
 }
 
 /*! In folder-processing, non-verbose mode the data are stored during the processing and output at the end to have the data sorted properly
+ * \param fileNumber Number of the pair of files in the folder, starting from 1
+ * \param result Results of the pair of files
  * \sa outputStats outputDistance
  */
-bool printNonVerboseData()
+bool printNonVerboseData(const uint fileNumber,const PairResult& result)
 {
    static bool header = true;
    if(header == true)
@@ -655,65 +670,14 @@ bool printNonVerboseData()
    }
    
    // Data
-   // last argument (lastCall) is true to get the output of the whole stored dataset
-   outputStats(NULL, NULL, NULL, NULL, NULL, false, true);
-   outputDistance(0, NULL, NULL, false, false, true);
+   cout << result.text;
+   if (result.stats.size() > 0) cout << fileNumber << "\t";
+   for (vector<Real>::const_iterator it=result.stats.begin(); it!=result.stats.end(); ++it) cout << *it << "\t";
+   for (vector<Real>::const_iterator it=result.distances.begin(); it!=result.distances.end(); ++it) cout << *it << "\t";
    
    return 0;
 }
 
-bool getBlockIds(vlsvinterface::Reader& vlsvReader,
-                 const unordered_map<uint64_t, pair<uint64_t, uint32_t>> & cellsWithBlocksLocations,
-                 const uint64_t & cellId,
-                 vector<uint32_t> & blockIds ) {
-   // Read the block ids:
-   //Check if the cell id can be found:
-   unordered_map<uint64_t, pair<uint64_t, uint32_t>>::const_iterator it = cellsWithBlocksLocations.find( cellId );
-   if( it == cellsWithBlocksLocations.end() ) {
-      cerr << "COULDNT FIND CELL ID " << cellId << " AT " << __FILE__ << " " << __LINE__ << endl;
-      return false;
-   }
-   //Get offset and number of blocks:
-   pair<uint64_t, uint32_t> offsetAndBlocks = it->second;
-   const uint64_t blockOffset = get<0>(offsetAndBlocks);
-   const uint32_t N_blocks = get<1>(offsetAndBlocks);
-
-   // Get some required info from VLSV file:
-   list<pair<string, string> > attribs;
-   attribs.push_back(make_pair("mesh", attributes["--meshname"]));
-
-   //READ BLOCK IDS:
-   uint64_t blockIds_arraySize, blockIds_vectorSize, blockIds_dataSize;
-   vlsv::datatype::type blockIds_dataType;
-   //Input blockIds_arraySize, blockIds_vectorSize, blockIds_dataSize blockIds_dataType: (Returns false if fails)
-   if (vlsvReader.getArrayInfo("BLOCKIDS", attribs, blockIds_arraySize, blockIds_vectorSize, blockIds_dataType, blockIds_dataSize) == false) {
-      cerr << "ERROR, COULD NOT FIND BLOCKIDS AT " << __FILE__ << " " << __LINE__ << endl;
-      return false;
-   }
-   //Make sure blockid's datatype is correct:
-   if( blockIds_dataType != vlsv::datatype::type::UINT ) {
-      cerr << "ERROR, bad datatype at " << __FILE__ << " " << __LINE__ << endl;
-      return false;
-   }
-   //Create buffer for reading in data:  (Note: arraySize, vectorSize, etc were fetched from getArrayInfo)
-   char * blockIds_buffer = new char[N_blocks*blockIds_vectorSize*blockIds_dataSize];
-   //Read the data into the buffer:
-   if( vlsvReader.readArray( "BLOCKIDS", attribs, blockOffset, N_blocks, blockIds_buffer ) == false ) {
-      cerr << "ERROR, FAILED TO READ BLOCKIDS AT " << __FILE__ << " " << __LINE__ << endl;
-      delete[] blockIds_buffer;
-      return false;
-   }
-   //Input the block ids:
-   blockIds.reserve(N_blocks);
-   for (uint64_t i = 0; i < N_blocks; ++i) {
-      const uint64_t blockId = convUInt(blockIds_buffer + i*blockIds_dataSize, blockIds_dataType, blockIds_dataSize);
-      blockIds.push_back( (uint32_t)(blockId) );
-   }
-   delete[] blockIds_buffer;
-   return true;
-
-}
-
 uint32_t getBlockId( const double vx,
                      const double vy,
                      const double vz,
@@ -737,99 +701,13 @@ uint32_t getBlockId( const double vx,
     return blockId;
 }
 
-// Reads avgs values of some given cell id
-// Input:
-// [0] vlsvReader -- Some vlsv reader with a file open
-// [1] cellId -- The spatial cell's ID
-// Output:
-// [2] avgs -- Saves the output into an unordered map with block id as the key and an array of avgs as the value
-// return false or true depending on whether the operation was successful
-template <class T>
-bool readAvgs( T & vlsvReader,
-               string name,
-               const unordered_map<uint64_t, pair<uint64_t, uint32_t>> & cellsWithBlocksLocations,
-               const uint64_t & cellId, 
-               unordered_map<uint32_t, array<double, 64> > & avgs ) {
-   // Get the block ids:
-   vector<uint32_t> blockIds;
-   if( getBlockIds( vlsvReader, cellsWithBlocksLocations, cellId, blockIds ) == false ) { return false; }
-   // Read avgs:
-   list<pair<string, string> > attribs;
-   attribs.push_back(make_pair("name", name));
-   attribs.push_back(make_pair("mesh", attributes["--meshname"]));
-
-   datatype::type dataType;
-   uint64_t arraySize, vectorSize, dataSize;
-   if (vlsvReader.getArrayInfo("BLOCKVARIABLE", attribs, arraySize, vectorSize, dataType, dataSize) == false) {
-      //no 
-//      cerr << "ERROR READING BLOCKVARIABLE AT " << __FILE__ << " " << __LINE__ << endl;
-      return false;
-   }
-
-   // Make a routine error checks:
-   if( vectorSize != 64 ) {
-      cerr << "ERROR, BAD AVGS VECTOR SIZE AT " << __FILE__ << " " << __LINE__ << endl;
-      return false;
-   }
-   unordered_map<uint64_t, pair<uint64_t, uint32_t>>::const_iterator it = cellsWithBlocksLocations.find( cellId );
-   if( it == cellsWithBlocksLocations.end() ) {
-      cerr << "COULDNT FIND CELL ID " << cellId << " AT " << __FILE__ << " " << __LINE__ << endl;
-      return false;
-   }
-   //Get offset and number of blocks:
-   pair<uint64_t, uint32_t> offsetAndBlocks = it->second;
-   const uint64_t blockOffset = get<0>(offsetAndBlocks);
-   const uint32_t N_blocks = get<1>(offsetAndBlocks);
-
-   if( N_blocks != blockIds.size() ) {
-      cerr << "ERROR, BAD AVGS ARRAY SIZE AT " << __FILE__ << " " << __LINE__ << endl;
-      cerr << "AVGS SIZE: " << N_blocks << endl;
-      cerr << "BLOCKIDS SIZE: " << blockIds.size() << endl;
-      return false;
-   }
-
-   char* buffer = new char[N_blocks * vectorSize * dataSize];
-   if (vlsvReader.readArray("BLOCKVARIABLE", attribs, blockOffset, N_blocks, buffer) == false) {
-      cerr << "ERROR could not read block variable at " << __FILE__ << " " << __LINE__ << endl;
-      delete[] buffer;
-      return false;
-   }
-   // Input avgs values:
-   array<double, 64> avgs_temp;
-   if( dataSize == 4 ) {
-      float * buffer_float = reinterpret_cast<float*>( buffer );
-      for( uint b = 0; b < blockIds.size(); ++b ) {
-         const uint32_t & blockId = blockIds[b];
-         for( uint i = 0; i < vectorSize; ++i ) {
-            avgs_temp[i] = buffer_float[vectorSize * b + i];
-         }
-         avgs.insert(make_pair(blockId, avgs_temp));
-      }
-   } else if( dataSize == 8 ) {
-      double * buffer_double = reinterpret_cast<double*>( buffer );
-      for( uint b = 0; b < blockIds.size(); ++b ) {
-         const uint32_t & blockId = blockIds[b];
-         for( uint i = 0; i < vectorSize; ++i ) {
-            avgs_temp[i] = buffer_double[vectorSize * b + i];
-         }
-         avgs.insert(make_pair(blockId, avgs_temp));
-      }
-   } else {
-      cerr << "ERROR, BAD AVGS DATASIZE AT " << __FILE__ << " " << __LINE__ << endl;
-      delete[] buffer;
-      return false;
-   }
-   delete[] buffer;
-   return true;
-}
-
 template <class T>
 bool getCellsWithBlocksLocations( T & vlsvReader, 
                                   unordered_map<uint64_t, pair<uint64_t, uint32_t>> & cellsWithBlocksLocations ) {
    if(cellsWithBlocksLocations.empty() == false) {
       cellsWithBlocksLocations.clear();
    }
-   const string meshName = attributes["--meshname"];
+   const string meshName = attributes.at("--meshname");
    vlsv::datatype::type cwb_dataType;
    uint64_t cwb_arraySize, cwb_vectorSize, cwb_dataSize;
    list<pair<string, string> > attribs;
@@ -904,12 +782,205 @@ bool getCellsWithBlocksLocations( T & vlsvReader,
    return true;
 }
 
+/*! Distribution function data of a group of spatial cells read from one file. The blocks
+ * of the c:th cell of the group are blockStart[c]...blockStart[c+1]-1, sorted by block ID,
+ * and the values of block b are avgs[b*64]...avgs[b*64+63].
+ */
+struct BlockData {
+   vector<uint64_t> blockStart;
+   vector<uint32_t> blockIds;
+   vector<double> avgs;
+};
+
+/*! Returns the name of the distribution function variable in the file, "proton" in
+ * multi-population files and "avgs" in older ones, or an empty string if neither exists.
+ */
+template <class T>
+string getDistributionName(T& vlsvReader) {
+   datatype::type dataType;
+   uint64_t arraySize, vectorSize, dataSize;
+   const char* names[2] = {"proton","avgs"};
+   for (int n=0; n<2; ++n) {
+      list<pair<string, string> > attribs;
+      attribs.push_back(make_pair("name", names[n]));
+      attribs.push_back(make_pair("mesh", attributes.at("--meshname")));
+      if (vlsvReader.getArrayInfo("BLOCKVARIABLE", attribs, arraySize, vectorSize, dataType, dataSize) == true) return names[n];
+   }
+   return "";
+}
+
+/*! Reads the block IDs and distribution function values of the cells cellIds[begin]...cellIds[end-1].
+ * The cells are sorted by their location in the file and cells stored back to back are
+ * read with a single call, so a group of cells written by the same process costs one read
+ * per array instead of one per cell.
+ * \param vlsvReader Some vlsv reader with a file open
+ * \param name Name of the distribution function variable, see getDistributionName
+ * \param cellsWithBlocksLocations Block offset and number of blocks of each cell in the file
+ * \param cellIds Spatial cell IDs
+ * \param begin Index of the first cell to read
+ * \param end Index one past the last cell to read
+ * \param data Return argument for the block data
+ * \return If true, the data was read successfully
+ */
+template <class T>
+bool readBlockData(T& vlsvReader,
+                   const string& name,
+                   const unordered_map<uint64_t, pair<uint64_t, uint32_t>>& cellsWithBlocksLocations,
+                   const vector<uint64_t>& cellIds,
+                   const size_t begin,
+                   const size_t end,
+                   BlockData& data) {
+   const size_t nCells = end - begin;
+   const uint velocityCellsPerBlock = 64;
+
+   // Locate the cells in the file
+   vector<pair<uint64_t, uint32_t> > locations(nCells);
+   data.blockStart.resize(nCells+1);
+   data.blockStart[0] = 0;
+   for (size_t c=0; c<nCells; ++c) {
+      unordered_map<uint64_t, pair<uint64_t, uint32_t>>::const_iterator it = cellsWithBlocksLocations.find( cellIds[begin+c] );
+      if( it == cellsWithBlocksLocations.end() ) {
+         cerr << "COULDNT FIND CELL ID " << cellIds[begin+c] << " AT " << __FILE__ << " " << __LINE__ << endl;
+         return false;
+      }
+      locations[c] = it->second;
+      data.blockStart[c+1] = data.blockStart[c] + it->second.second;
+   }
+   const uint64_t nBlocks = data.blockStart[nCells];
+
+   list<pair<string, string> > idAttribs;
+   idAttribs.push_back(make_pair("mesh", attributes.at("--meshname")));
+   list<pair<string, string> > avgsAttribs;
+   avgsAttribs.push_back(make_pair("name", name));
+   avgsAttribs.push_back(make_pair("mesh", attributes.at("--meshname")));
+
+   uint64_t idArraySize, idVectorSize, idDataSize;
+   datatype::type idDataType;
+   if (vlsvReader.getArrayInfo("BLOCKIDS", idAttribs, idArraySize, idVectorSize, idDataType, idDataSize) == false) {
+      cerr << "ERROR, COULD NOT FIND BLOCKIDS AT " << __FILE__ << " " << __LINE__ << endl;
+      return false;
+   }
+   if( idDataType != vlsv::datatype::type::UINT ) {
+      cerr << "ERROR, bad datatype at " << __FILE__ << " " << __LINE__ << endl;
+      return false;
+   }
+   uint64_t avgsArraySize, avgsVectorSize, avgsDataSize;
+   datatype::type avgsDataType;
+   if (vlsvReader.getArrayInfo("BLOCKVARIABLE", avgsAttribs, avgsArraySize, avgsVectorSize, avgsDataType, avgsDataSize) == false) {
+      cerr << "ERROR READING BLOCKVARIABLE AT " << __FILE__ << " " << __LINE__ << endl;
+      return false;
+   }
+   if( avgsVectorSize != velocityCellsPerBlock ) {
+      cerr << "ERROR, BAD AVGS VECTOR SIZE AT " << __FILE__ << " " << __LINE__ << endl;
+      return false;
+   }
+   if( avgsDataSize != sizeof(float) && avgsDataSize != sizeof(double) ) {
+      cerr << "ERROR, BAD AVGS DATASIZE AT " << __FILE__ << " " << __LINE__ << endl;
+      return false;
+   }
+
+   // Cells in file order
+   vector<size_t> order(nCells);
+   for (size_t c=0; c<nCells; ++c) order[c] = c;
+   sort(order.begin(),order.end(),[&locations](const size_t& a,const size_t& b) {return locations[a].first < locations[b].first;});
+
+   vector<uint32_t> fileIds(nBlocks);
+   vector<double> fileAvgs(nBlocks*velocityCellsPerBlock);
+   vector<char> idBuffer;
+   vector<char> avgsBuffer;
+
+   size_t r = 0;
+   while (r < nCells) {
+      // Extend the run as long as the next cell starts where the previous one ended
+      const uint64_t runOffset = locations[order[r]].first;
+      uint64_t runBlocks = locations[order[r]].second;
+      size_t rEnd = r+1;
+      while (rEnd < nCells && locations[order[rEnd]].first == runOffset + runBlocks) {
+         runBlocks += locations[order[rEnd]].second;
+         ++rEnd;
+      }
+
+      if (runBlocks > 0) {
+         idBuffer.resize(runBlocks*idVectorSize*idDataSize);
+         avgsBuffer.resize(runBlocks*avgsVectorSize*avgsDataSize);
+         if( vlsvReader.readArray( "BLOCKIDS", idAttribs, runOffset, runBlocks, &(idBuffer[0]) ) == false ) {
+            cerr << "ERROR, FAILED TO READ BLOCKIDS AT " << __FILE__ << " " << __LINE__ << endl;
+            return false;
+         }
+         if (vlsvReader.readArray("BLOCKVARIABLE", avgsAttribs, runOffset, runBlocks, &(avgsBuffer[0])) == false) {
+            cerr << "ERROR could not read block variable at " << __FILE__ << " " << __LINE__ << endl;
+            return false;
+         }
+
+         // Scatter the run to the cells' positions in the group
+         uint64_t b = 0;
+         for (size_t k=r; k<rEnd; ++k) {
+            const size_t c = order[k];
+            for (uint32_t i=0; i<locations[c].second; ++i, ++b) {
+               const uint64_t target = data.blockStart[c] + i;
+               fileIds[target] = (uint32_t)convUInt(&(idBuffer[0]) + b*idDataSize, idDataType, idDataSize);
+               if (avgsDataSize == sizeof(float)) {
+                  const float* values = reinterpret_cast<const float*>(&(avgsBuffer[0])) + b*velocityCellsPerBlock;
+                  for (uint v=0; v<velocityCellsPerBlock; ++v) fileAvgs[target*velocityCellsPerBlock+v] = values[v];
+               } else {
+                  const double* values = reinterpret_cast<const double*>(&(avgsBuffer[0])) + b*velocityCellsPerBlock;
+                  for (uint v=0; v<velocityCellsPerBlock; ++v) fileAvgs[target*velocityCellsPerBlock+v] = values[v];
+               }
+            }
+         }
+      }
+      r = rEnd;
+   }
+
+   // Sort the blocks of each cell by block ID
+   data.blockIds.resize(nBlocks);
+   data.avgs.resize(nBlocks*velocityCellsPerBlock);
+   #pragma omp parallel for schedule(dynamic,64)
+   for (int64_t c=0; c<(int64_t)nCells; ++c) {
+      const uint64_t first = data.blockStart[c];
+      vector<uint64_t> blockOrder(data.blockStart[c+1] - first);
+      for (size_t i=0; i<blockOrder.size(); ++i) blockOrder[i] = first + i;
+      sort(blockOrder.begin(),blockOrder.end(),[&fileIds](const uint64_t& a,const uint64_t& b) {return fileIds[a] < fileIds[b];});
+      for (size_t i=0; i<blockOrder.size(); ++i) {
+         data.blockIds[first+i] = fileIds[blockOrder[i]];
+         for (uint v=0; v<velocityCellsPerBlock; ++v) {
+            data.avgs[(first+i)*velocityCellsPerBlock+v] = fileAvgs[blockOrder[i]*velocityCellsPerBlock+v];
+         }
+      }
+   }
+   return true;
+}
+
+/*! Accumulates the differences between the values of a velocity block in two files. Values below
+ * threshold are clamped to it, and a velocity cell is relevant if either value exceeds it.
+ */
+inline void compareBlockAvgs(const double* avgs1,
+                             const double* avgs2,
+                             const double threshold,
+                             uint64_t& numOfRelevantCells,
+                             double& totalAbsDiff,
+                             double& totalAbsLog10Diff,
+                             double& maxDiff) {
+   for( uint i = 0; i < 64; ++i ) {
+      const double val1=avgs1[i]>threshold?avgs1[i]:threshold;
+      const double val2=avgs2[i]>threshold?avgs2[i]:threshold;
+      if(avgs1[i]>threshold || avgs2[i]>threshold)
+         numOfRelevantCells++;
+
+      const double diff = abs(val1 - val2);
+      totalAbsDiff += diff;
+      totalAbsLog10Diff += abs(log10(val1) - log10(val2));
+      maxDiff = max(maxDiff, diff);
+   }
+}
+
 template <class T, class U>
 bool compareAvgs( const string fileName1,
                   const string fileName2,
                   const bool verboseOutput,
                   vector<uint64_t> & cellIds1,
-                  vector<uint64_t> & cellIds2
+                  vector<uint64_t> & cellIds2,
+                  ostream& output
                 ) {
    if( cellIds1.empty() == true || cellIds2.empty() == true ) {
       cerr << "ERROR, CELL IDS EMPTY IN COMPARE AVGS" << endl;
@@ -947,191 +1018,94 @@ bool compareAvgs( const string fileName1,
       return false;
    }
 
-   // Create a few variables for the cell id loop:
-   vector< double > avgsDiffs;
-   double totalAbsAvgs = 0;
-   double totalAbsDiff = 0;
-   double totalAbsLog10Diff = 0;
-   double threshold=1e-16;
-   uint64_t numOfRelevantCells = 0;
-   uint64_t numOfIdenticalBlocks = 0;
-   uint64_t numOfNonIdenticalBlocks = 0;
+   const string name1 = getDistributionName(vlsvReader1);
+   const string name2 = getDistributionName(vlsvReader2);
+   if (name1.empty() == true || name2.empty() == true) {
+      cerr << "ERROR, FAILED TO READ AVGS AT " << __FILE__ << " " << __LINE__ << endl;
+      return false;
+   }
+
    if( cellIds1[0] == 0 || cellIds2[0] == 0 ) {
-      // User input 0 as the cell id -- compare all cell ids
+      // User input 0 as the cell id -- compare all cell ids, in the order they are stored in the first file
       cellIds1.clear();
-      cellIds2.clear();
       for( unordered_map<uint64_t, pair<uint64_t, uint32_t>>::const_iterator it = cellsWithBlocksLocations1.begin(); it != cellsWithBlocksLocations1.end(); ++it ) {
          cellIds1.push_back(it->first);
-         cellIds2.push_back(it->first);
       }
+      sort(cellIds1.begin(),cellIds1.end(),[&cellsWithBlocksLocations1](const uint64_t& a,const uint64_t& b) {
+         return cellsWithBlocksLocations1.at(a).first < cellsWithBlocksLocations1.at(b).first;
+      });
+      cellIds2 = cellIds1;
    }
 
    if( cellIds1.size() != cellIds2.size() ) {
       cerr << "ERROR, BAD CELL ID SIZES AT " << __FILE__ << " " << __LINE__ << endl;
       return false;
    }
-   // Go through cell ids:
-   for( uint cellIndex = 0; cellIndex < cellIds2.size(); cellIndex++ ) {
-      const uint64_t & cellId1 = cellIds1[cellIndex];
-      const uint64_t & cellId2 = cellIds2[cellIndex];
-      // Get the avgs in a hash map (The velocity block id is the key and avgs is the value):
-      const uint velocityCellsPerBlock = 64;
-      unordered_map<uint32_t, array<double, velocityCellsPerBlock> > avgs1;
-      unordered_map<uint32_t, array<double, velocityCellsPerBlock> > avgs2;
-      // Store the avgs in avgs1 and 2:
-      if( readAvgs( vlsvReader1, "proton", cellsWithBlocksLocations1, cellId1, avgs1 ) == false ) {
-         if( readAvgs( vlsvReader1, "avgs", cellsWithBlocksLocations1, cellId1, avgs1 ) == false ) {
-            cerr << "ERROR, FAILED TO READ AVGS AT " << __FILE__ << " " << __LINE__ << endl;
-            return false;
-         }
-      }
-      
-      if( readAvgs( vlsvReader2, "proton", cellsWithBlocksLocations2, cellId2, avgs2 ) == false ) {
-         if( readAvgs( vlsvReader2, "avgs", cellsWithBlocksLocations2, cellId2, avgs2 ) == false ) {
-            cerr << "ERROR, FAILED TO READ AVGS AT " << __FILE__ << " " << __LINE__ << endl;
-            return false;
-         }
-      }
-   
-      //Compare the avgs values:
-      // First make a check on how many of the block ids are identical:
-      const size_t sizeOfAvgs1 = avgs1.size();
-      const size_t sizeOfAvgs2 = avgs2.size();
-      // Vector of block ids that are the same
-      vector<uint32_t> blockIds1;
-      vector<uint32_t> blockIds2;
-      blockIds1.reserve(sizeOfAvgs1);
-      blockIds2.reserve(sizeOfAvgs2);
-      // Input block ids:
-      for( unordered_map<uint32_t, array<double, velocityCellsPerBlock> >::const_iterator it = avgs1.begin(); it != avgs1.end(); ++it ) {
-         blockIds1.push_back(it->first);
-      }
-      for( unordered_map<uint32_t, array<double, velocityCellsPerBlock> >::const_iterator it = avgs2.begin(); it != avgs2.end(); ++it ) {
-         blockIds2.push_back(it->first);
-      }
-      // Compare block ids:
-      // Sort
-      sort( blockIds1.begin(), blockIds1.end() );
-      sort( blockIds2.begin(), blockIds2.end() );
-      // Create iterators
-      vector<uint32_t>::const_iterator it1 = blockIds1.begin();
-      vector<uint32_t>::const_iterator it2 = blockIds2.begin();
-      // Separate block ids into two categories -- the ones that blockids1 and blockids2 share and ones that only one of them shares
-      vector<uint32_t> identicalBlockIds;
-      vector<uint32_t> nonIdenticalBlockIds;
-   
-      while( true ) {
-         if( it1 == blockIds1.end() || it2 == blockIds2.end() ) {
-            // Reach end of block ids
-            break;
-         }
-         if( *it1 == *it2 ) {
-            // Identical block id
-            identicalBlockIds.push_back(*it1);
-            it1++; it2++;
-         } else if( *it1 < *it2 ) {
-            // Non identical block id
-            // The block ids are sorted so to get identical block ids one must increment the lower value
-            nonIdenticalBlockIds.push_back(*it1);
-            it1++;
-         } else if( *it2 < *it1 ) {
-            // Non identical block id
-            // The block ids are sorted so to get identical block ids one must increment the lower value
-            nonIdenticalBlockIds.push_back(*it2);
-            it2++;
-         }
-      }
-      // Get the rest of the non identical block ids (If there are any)
-      // Note: This is only needed if for example it1 hit the end of the iteration and it2 still isn't at the end
-      for( ; it1 != blockIds1.end(); ++it1 ) {
-         nonIdenticalBlockIds.push_back(*it1);
-      }
-      for( ; it2 != blockIds2.end(); ++it2 ) {
-         nonIdenticalBlockIds.push_back(*it2);
-      }
-      // Compare block ids:
-      const uint64_t totalNumberOfBlocks = identicalBlockIds.size() + nonIdenticalBlockIds.size();
-      const double percentageOfIdenticalBlocks = (double)(totalNumberOfBlocks) / (double)(identicalBlockIds.size());
-      // Compare the avgs values of the identical blocks:
-      avgsDiffs.reserve(avgsDiffs.size() + identicalBlockIds.size() * velocityCellsPerBlock);
-      for( vector<uint32_t>::const_iterator it = identicalBlockIds.begin(); it != identicalBlockIds.end(); ++it ) {
-         // Get the block id
-         const uint32_t blockId = *it;
-         // Get avgs values:
-         const array<double, velocityCellsPerBlock> & avgsValues1 = avgs1.at(blockId);
-         const array<double, velocityCellsPerBlock> & avgsValues2 = avgs2.at(blockId);
-         // Get the diff:
-         for( uint i = 0; i < velocityCellsPerBlock; ++i ) {
-            double val1=avgsValues1[i]>threshold?avgsValues1[i]:threshold;
-            double val2=avgsValues2[i]>threshold?avgsValues2[i]:threshold;
-            if(avgsValues1[i]>threshold || avgsValues2[i]>threshold)
-               numOfRelevantCells++;
-            
-            avgsDiffs.push_back( abs(val1 - val2) );
-            totalAbsAvgs += (abs(val1) + abs(val2));
-            totalAbsDiff +=  abs(val1 - val2);
-            totalAbsLog10Diff += abs(log10(val1) - log10(val2));
-            
-         }
-      }
-      // Compare the avgs values of nonidentical blocks:
-      array<double, velocityCellsPerBlock> zeroAvgs;
-      for( uint i = 0; i < velocityCellsPerBlock; ++i ) {
-         zeroAvgs[i] = 0;
-      }
-      for( vector<uint32_t>::const_iterator it = nonIdenticalBlockIds.begin(); it != nonIdenticalBlockIds.end(); ++it ) {
-         // Get the block id
-         const uint32_t blockId = *it;
-         // Get avgs values: 
 
-         const array<double, velocityCellsPerBlock> * avgsValues1;
-         const array<double, velocityCellsPerBlock> * avgsValues2;
+   // Create a few variables for the cell id loop:
+   const double threshold=1e-16;
+   double totalAbsDiff = 0;
+   double totalAbsLog10Diff = 0;
+   double maxDiff = 0;
+   uint64_t numOfRelevantCells = 0;
+   uint64_t numOfIdenticalBlocks = 0;
+   uint64_t numOfNonIdenticalBlocks = 0;
+   array<double, 64> zeroAvgs;
+   zeroAvgs.fill(0.0);
+
+   // Go through the cells in groups of about blockReadChunk blocks:
+   BlockData data1;
+   BlockData data2;
+   size_t begin = 0;
+   while (begin < cellIds1.size()) {
+      size_t end = begin;
+      uint64_t groupBlocks = 0;
+      while (end < cellIds1.size() && (end == begin || groupBlocks < blockReadChunk)) {
+         unordered_map<uint64_t, pair<uint64_t, uint32_t>>::const_iterator it = cellsWithBlocksLocations1.find(cellIds1[end]);
+         if (it != cellsWithBlocksLocations1.end()) groupBlocks += it->second.second;
+         ++end;
+      }
 
-         unordered_map<uint32_t, array<double, velocityCellsPerBlock> >::const_iterator it2 = avgs1.find( blockId );
-         if( it2 == avgs1.end() ) {
-            avgsValues1 = &zeroAvgs;
-         } else {
-            avgsValues1 = &(it2->second);
-         }
+      if (readBlockData(vlsvReader1, name1, cellsWithBlocksLocations1, cellIds1, begin, end, data1) == false
+          || readBlockData(vlsvReader2, name2, cellsWithBlocksLocations2, cellIds2, begin, end, data2) == false) {
+         cerr << "ERROR, FAILED TO READ AVGS AT " << __FILE__ << " " << __LINE__ << endl;
+         return false;
+      }
 
-         it2 = avgs2.find( blockId );
-         if( it2 == avgs2.end() ) {
-            avgsValues2 = &zeroAvgs;
-         } else {
-            avgsValues2 = &(it2->second);
-         }
-         // Get the diff:
-         for( uint i = 0; i < velocityCellsPerBlock; ++i ) {
-            double val1=avgsValues1->operator[](i)>threshold?avgsValues1->operator[](i):threshold;
-            double val2=avgsValues2->operator[](i)>threshold?avgsValues2->operator[](i):threshold;
-            if( avgsValues1->operator[](i)>threshold || avgsValues2->operator[](i)>threshold)
-               numOfRelevantCells++;
-            
-            avgsDiffs.push_back( abs(val1 - val2) );
-            totalAbsAvgs += (abs(val1) + abs(val2));
-            totalAbsDiff +=  abs(val1 - val2);
-            totalAbsLog10Diff += abs(log10(val1) - log10(val2));
+      // Compare the blocks of each cell. Blocks are sorted by ID, so the blocks that exist
+      // in both files are found with a merge, and blocks that exist in only one file are
+      // compared against zero.
+      #pragma omp parallel for schedule(dynamic,16) reduction(+:totalAbsDiff,totalAbsLog10Diff,numOfRelevantCells,numOfIdenticalBlocks,numOfNonIdenticalBlocks) reduction(max:maxDiff)
+      for (int64_t c=0; c<(int64_t)(end-begin); ++c) {
+         uint64_t b1 = data1.blockStart[c];
+         uint64_t b2 = data2.blockStart[c];
+         const uint64_t end1 = data1.blockStart[c+1];
+         const uint64_t end2 = data2.blockStart[c+1];
+         while (b1 < end1 || b2 < end2) {
+            const double* avgs1 = &(zeroAvgs[0]);
+            const double* avgs2 = &(zeroAvgs[0]);
+            if (b2 == end2 || (b1 < end1 && data1.blockIds[b1] < data2.blockIds[b2])) {
+               avgs1 = &(data1.avgs[b1*64]);
+               ++b1;
+               ++numOfNonIdenticalBlocks;
+            } else if (b1 == end1 || data2.blockIds[b2] < data1.blockIds[b1]) {
+               avgs2 = &(data2.avgs[b2*64]);
+               ++b2;
+               ++numOfNonIdenticalBlocks;
+            } else {
+               avgs1 = &(data1.avgs[b1*64]);
+               avgs2 = &(data2.avgs[b2*64]);
+               ++b1;
+               ++b2;
+               ++numOfIdenticalBlocks;
+            }
+            compareBlockAvgs(avgs1, avgs2, threshold, numOfRelevantCells, totalAbsDiff, totalAbsLog10Diff, maxDiff);
          }
       }
-      numOfIdenticalBlocks += identicalBlockIds.size();
-      numOfNonIdenticalBlocks += nonIdenticalBlockIds.size();
-   }
-   // Get the max and min diff, and the sum of the diff
-   double maxDiff = 0;
-   double minDiff = numeric_limits<Real>::max();
-   double sumDiff = 0;
-   for( vector<double>::const_iterator it = avgsDiffs.begin(); it != avgsDiffs.end(); ++it ) {
-      sumDiff += *it;
-      if( maxDiff < *it ) {
-         maxDiff = *it;
-      }
-      if( minDiff > *it ) {
-         minDiff = *it;
-      }
+      begin = end;
    }
-   
-   const double relativeSumDiff = sumDiff / totalAbsAvgs;
-   cout << "File names: " << fileName1 << " & " << fileName2 << endl <<
+
+   output << "File names: " << fileName1 << " & " << fileName2 << endl <<
       "NonIdenticalBlocks:      " << numOfNonIdenticalBlocks << endl <<
       "IdenticalBlocks:         " << numOfIdenticalBlocks <<  endl <<
       "Absolute_Error:          " << totalAbsDiff  << endl <<
@@ -1150,6 +1124,7 @@ bool compareAvgs( const string fileName1,
  * \param varToExtract Pointer to the char array containing the name of the variable to extract
  * \param compToExtract Unsigned int designating the component to extract (0 for scalars)
  * \param verboseOutput Boolean parameter telling whether the output will be verbose or compact
+ * \param result Return argument for the results in non-verbose mode
  * \sa convertSILO singleStatistics outputStats pDistance outputDistance printNonVerboseData
  */
 bool process2Files(const string fileName1,
@@ -1157,10 +1132,11 @@ bool process2Files(const string fileName1,
                    const char * varToExtract,
                    const uint compToExtract,
                    const bool verboseOutput,
+                   PairResult& result,
                    const uint compToExtract2 = 0
                   ) {
-   map<uint, Real> orderedData1;
-   map<uint, Real> orderedData2;
+   CellData data1;
+   CellData data2;
    Real absolute, relative, mini, maxi, size, avg, stdev;
 
    // If the user wants to check avgs, call the avgs check function and return it. Otherwise move on to compare variables:
@@ -1172,19 +1148,21 @@ bool process2Files(const string fileName1,
       cellIds1.push_back(compToExtract);
       cellIds2.push_back(compToExtract2);
       // Compare files:
-      if( compareAvgs<vlsvinterface::Reader, vlsvinterface::Reader>(fileName1, fileName2, verboseOutput, cellIds1, cellIds2) == false ) { return false; }
+      stringstream output;
+      const bool success = compareAvgs<vlsvinterface::Reader, vlsvinterface::Reader>(fileName1, fileName2, verboseOutput, cellIds1, cellIds2, output);
+      if (verboseOutput == true) cout << output.str();
+      else result.text = output.str();
+      if (success == false) return false;
    } else {
-      unordered_map<size_t,size_t> cellOrder;
-   
       bool success = true;
-      success = convertSILO<vlsvinterface::Reader>(fileName1, varToExtract, compToExtract, &orderedData1, cellOrder, true);
+      success = convertSILO<vlsvinterface::Reader>(fileName1, varToExtract, compToExtract, data1);
 
       if( success == false ) {
          cerr << "ERROR Data import error with " << fileName1 << endl;
          return 1;
       }
 
-      success = convertSILO<vlsvinterface::Reader>(fileName2, varToExtract, compToExtract, &orderedData2, cellOrder, false);
+      success = convertSILO<vlsvinterface::Reader>(fileName2, varToExtract, compToExtract, data2);
 
       if( success == false ) {
          cerr << "ERROR Data import error with " << fileName2 << endl;
@@ -1192,16 +1170,19 @@ bool process2Files(const string fileName1,
       }   
 
       // Basic consistency check
-      if(orderedData1.size() != orderedData2.size()) {
+      if(data1.size() != data2.size()) {
          cerr << "ERROR Datasets have different size." << endl;
          return 1;
       }
+      vector<int64_t> match;
+      matchCells(data1, data2, match);
 
       // Open VLSV file where the diffence in the chosen variable is written
       const string prefix = fileName1.substr(0,fileName1.find_last_of('.'));
       const string suffix = fileName1.substr(fileName1.find_last_of('.'),fileName1.size());
       string outputFileName = prefix + ".diff." + varToExtract + suffix;
       const string varName = varToExtract;
+      const string meshName = attributes.at("--meshname");
       vlsv::Writer outputFile;
       if (attributes.find("--diff") != attributes.end()) {
          if (outputFileName[0] == '.' && outputFileName[1] == '/') {
@@ -1217,41 +1198,62 @@ bool process2Files(const string fileName1,
          }
 
          // Clone mesh from input file to diff file
-         map<string,string>::const_iterator it = attributes.find("--meshname");
-         if (cloneMesh(fileName1,outputFile,it->second) == false) return false;
+         if (cloneMesh(fileName1,outputFile,meshName) == false) return false;
       }
 
-      singleStatistics(&orderedData1, &size, &mini, &maxi, &avg, &stdev); //CONTINUE
-      outputStats(&size, &mini, &maxi, &avg, &stdev, verboseOutput, false);
+      singleStatistics(data1, &size, &mini, &maxi, &avg, &stdev);
+      outputStats(&size, &mini, &maxi, &avg, &stdev, verboseOutput, result);
 
-      singleStatistics(&orderedData2, &size, &mini, &maxi, &avg, &stdev);
-      outputStats(&size, &mini, &maxi, &avg, &stdev, verboseOutput, false);
+      singleStatistics(data2, &size, &mini, &maxi, &avg, &stdev);
+      outputStats(&size, &mini, &maxi, &avg, &stdev, verboseOutput, result);
 
-      pDistance(orderedData1, orderedData2, 0, &absolute, &relative, false, cellOrder,outputFile,attributes["--meshname"],"d0_"+varName);
-      outputDistance(0, &absolute, &relative, false, verboseOutput, false);
-      pDistance(orderedData1, orderedData2, 0, &absolute, &relative, true, cellOrder,outputFile,attributes["--meshname"],"d0_sft_"+varName);
-      outputDistance(0, &absolute, &relative, true, verboseOutput, false);
+      pDistance(data1, data2, match, 0, &absolute, &relative, false, outputFile, meshName, "d0_"+varName);
+      outputDistance(0, &absolute, &relative, false, verboseOutput, result);
+      pDistance(data1, data2, match, 0, &absolute, &relative, true, outputFile, meshName, "d0_sft_"+varName);
+      outputDistance(0, &absolute, &relative, true, verboseOutput, result);
 
-      pDistance(orderedData1, orderedData2, 1, &absolute, &relative, false, cellOrder,outputFile,attributes["--meshname"],"d1_"+varName);
-      outputDistance(1, &absolute, &relative, false, verboseOutput, false);
-      pDistance(orderedData1, orderedData2, 1, &absolute, &relative, true, cellOrder,outputFile,attributes["--meshname"],"d1_sft_"+varName);
-      outputDistance(1, &absolute, &relative, true, verboseOutput, false);
+      pDistance(data1, data2, match, 1, &absolute, &relative, false, outputFile, meshName, "d1_"+varName);
+      outputDistance(1, &absolute, &relative, false, verboseOutput, result);
+      pDistance(data1, data2, match, 1, &absolute, &relative, true, outputFile, meshName, "d1_sft_"+varName);
+      outputDistance(1, &absolute, &relative, true, verboseOutput, result);
 
-      pDistance(orderedData1, orderedData2, 2, &absolute, &relative, false, cellOrder,outputFile,attributes["--meshname"],"d2_"+varName);
-      outputDistance(2, &absolute, &relative, false, verboseOutput, false);
-      pDistance(orderedData1, orderedData2, 2, &absolute, &relative, true, cellOrder,outputFile,attributes["--meshname"],"d2_sft_"+varName);
-      outputDistance(2, &absolute, &relative, true, verboseOutput, false);
+      pDistance(data1, data2, match, 2, &absolute, &relative, false, outputFile, meshName, "d2_"+varName);
+      outputDistance(2, &absolute, &relative, false, verboseOutput, result);
+      pDistance(data1, data2, match, 2, &absolute, &relative, true, outputFile, meshName, "d2_sft_"+varName);
+      outputDistance(2, &absolute, &relative, true, verboseOutput, result);
 
       outputFile.close();
    }
    
-   if(verboseOutput == false)
-   {
-      printNonVerboseData();
+   return 0;
+}
+
+/*! Compares the given pairs of files with non-verbose output. The pairs are processed
+ * concurrently by the OpenMP threads, each with its own readers, and the results are
+ * printed in the order of the pairs once all of them are done. Difference files are
+ * written through MPI-IO, so with --diff the pairs are processed one at a time.
+ * \param filePairs Pairs of files to compare, the first file of each pair is the reference
+ * \param varToExtract Pointer to the char array containing the name of the variable to extract
+ * \param compToExtract Unsigned int designating the component to extract (0 for scalars)
+ * \param compToExtract2 Component (cell ID) in the second file when comparing distribution functions
+ * \sa process2Files printNonVerboseData
+ */
+void processFilePairs(const vector<pair<string,string> >& filePairs,
+                      const char * varToExtract,
+                      const uint compToExtract,
+                      const uint compToExtract2) {
+   vector<PairResult> results(filePairs.size());
+   const bool concurrent = (attributes.find("--diff") == attributes.end());
+
+   #pragma omp parallel for schedule(dynamic,1) if(concurrent)
+   for (int64_t p=0; p<(int64_t)filePairs.size(); ++p) {
+      process2Files(filePairs[p].first, filePairs[p].second, varToExtract, compToExtract, false, results[p], compToExtract2);
+   }
+
+   for (size_t p=0; p<filePairs.size(); ++p) {
+      printNonVerboseData(p+1, results[p]);
       cout << endl;
    }
-   
-   return 0;
 }
 
 /*! Creates the list of grid*.vlsv files present in the folder passed
@@ -1456,9 +1458,9 @@ int main(int argn,char* args[]) {
    if (dir1 == NULL && dir2 == NULL) {
       cout << "INFO Reading in two files." << endl;
       
-      // Process two files with verbose output (last argument true)
-      process2Files(fileName1, fileName2, varToExtract, compToExtract, true, compToExtract2);
-      //CONTINUE
+      // Process two files with verbose output (verboseOutput true)
+      PairResult result;
+      process2Files(fileName1, fileName2, varToExtract, compToExtract, true, result, compToExtract2);
       
       closedir(dir1);
       closedir(dir2);
@@ -1469,13 +1471,14 @@ int main(int argn,char* args[]) {
       cout << "#INFO Reading in one file and one directory." << endl;
       set<string> fileList;
       set<string>::iterator it;
+      vector<pair<string,string> > filePairs;
 
       if(dir1 == NULL){
          //file in 1, directory in 2
          processDirectory(dir2, &fileList);
          for(it = fileList.begin(); it != fileList.end();++it){
-            // Process two files with non-verbose output (last argument false), give full path to the file processor
-            process2Files(fileName1,fileName2 + "/" + *it, varToExtract, compToExtract, false, compToExtract2);
+            // Give full path to the file processor
+            filePairs.push_back(make_pair(fileName1,fileName2 + "/" + *it));
          }
       }
 
@@ -1483,11 +1486,14 @@ int main(int argn,char* args[]) {
          //directory in 1, file in 2
          processDirectory(dir1, &fileList);
          for(it = fileList.begin(); it != fileList.end();++it){
-            // Process two files with non-verbose output (last argument false), give full path to the file processor
-            process2Files(fileName1+"/"+*it,fileName2, varToExtract, compToExtract, false, compToExtract2);
+            // Give full path to the file processor
+            filePairs.push_back(make_pair(fileName1+"/"+*it,fileName2));
          }
       }
 
+      // Process the pairs with non-verbose output
+      processFilePairs(filePairs, varToExtract, compToExtract, compToExtract2);
+
       closedir(dir1);
       closedir(dir2);
       return 1;
@@ -1509,15 +1515,18 @@ int main(int argn,char* args[]) {
          return 1;
       }
       
+      vector<pair<string,string> > filePairs;
       set<string>::iterator it1, it2;
       for(it1 = fileList1.begin(), it2 = fileList2.begin();
-          it1 != fileList2.end(), it2 != fileList2.end();
+          it1 != fileList1.end() && it2 != fileList2.end();
           it1++, it2++)
       {
-      // Process two files with non-verbose output (last argument false), give full path to the file processor
-      process2Files(fileName1 + "/" + *it1,
-                    fileName2 + "/" + *it2, varToExtract, compToExtract, false, compToExtract2);
+         // Give full path to the file processor
+         filePairs.push_back(make_pair(fileName1 + "/" + *it1, fileName2 + "/" + *it2));
       }
+
+      // Process the pairs with non-verbose output
+      processFilePairs(filePairs, varToExtract, compToExtract, compToExtract2);
       
       closedir(dir1);
       closedir(dir2);
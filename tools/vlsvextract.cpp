@@ -1111,6 +1111,8 @@ uint64_t searchForBestCellId( const CellStructure & cellStruct,
    return bestCellId;
 }
 
+uint64_t getCellIdAtCoords( const CellStructure & cellStruct, const array<Real, 3> coordinates );
+
 //Searches for the closest cell id to the given coordinates from a list of cell ids and returns it
 //Input:
 //[0] CellStructure cellStruct -- a struct that holds info on cell structure
@@ -1130,7 +1132,15 @@ uint64_t searchForBestCellId( const CellStructure & cellStruct,
       cerr << "ERROR, PASSED AN EMPTY CELL ID LIST AT " << __FILE__ << " " << __LINE__ << endl;
       exit(1);
    }
+   return getCellIdAtCoords( cellStruct, coordinates );
+}
 
+//Returns the cell id containing the given coordinates, or numerical limit if the coordinates are out of bounds
+//Input:
+//[0] CellStructure cellStruct -- a struct that holds info on cell structure
+//[1] coordinates, -- Some coordinates x, y, z 
+uint64_t getCellIdAtCoords( const CellStructure & cellStruct,
+                            const array<Real, 3> coordinates ) {
    //Get the cell id corresponding to the given coordinates:
    int cellCoordinates[3];
    for( unsigned int i = 0; i < 3; ++i ) {
@@ -1427,6 +1437,18 @@ uint64_t getCellIdFromCoords( const CellStructure & cellStruct,
    return cellId;
 }
 
+//Same as above, but whether the cell has a velocity distribution is looked up from the index
+//sidecar opened in vlsvReader, so the list of cells with blocks is not read from the file
+uint64_t getCellIdFromCoords( const CellStructure & cellStruct, 
+                              const vlsvinterface::Reader & vlsvReader,
+                              const array<Real, 3> coords) {
+   const uint64_t cellId = getCellIdAtCoords( cellStruct, coords );
+   if( cellId == numeric_limits<uint64_t>::max() || vlsvReader.hasBlocks( "SpatialGrid", cellId ) == false ) {
+      return numeric_limits<uint64_t>::max();
+   }
+   return cellId;
+}
+
 //Prints out the usage message
 void printUsageMessage() {
    cout << endl;
@@ -1478,6 +1500,7 @@ bool retrieveOptions( const int argn, char *args[], UserOptions & mainOptions )
          ("point1", po::value< vector<Real> >()->multitoken(), "Set the starting point x y z of a line")
          ("point2", po::value< vector<Real> >()->multitoken(), "Set the ending point x y z of a line")
          ("pointamount", po::value<unsigned int>(), "Number of points along a line (OPTIONAL)")
+         ("index", "Read block metadata from the index file <file>.idx, which is written if it is missing or outdated (OPTIONAL)")
          ("outputdirectory", po::value< vector<string> >(), "The directory where the file is saved (default current folder) (OPTIONAL)");
          
       //For mapping input
@@ -1522,6 +1545,9 @@ bool retrieveOptions( const int argn, char *args[], UserOptions & mainOptions )
         //Let the program know we want to get the cell id from coordinates
         getCellIdFromLine = true;
       }
+      if( vm.count("index") ) {
+         mainOptions.useIndex = true;
+      }
       //Check for rotation
       if( vm.count("rotate") ) {
          //Rotate the vectors (used in convertVelocityBlocks2 as an argument)
@@ -1753,6 +1779,11 @@ void extractDistribution( const string & fileName, const UserOptions & mainOptio
    CellStructure cellStruct;
    setSpatialCellVariables( vlsvReader, cellStruct );
 
+   //Map the index file if requested. Without an index the block metadata is read from the file.
+   if( mainOptions.useIndex ) {
+      vlsvReader.openIndex( fileName, true );
+   }
+
    //Declare a vector for holding multiple cell ids (Note: Used only if we want to calculate the cell id along a line)
    vector<uint64_t> cellIdList;
 
@@ -1763,11 +1794,13 @@ void extractDistribution( const string & fileName, const UserOptions & mainOptio
 
       //Get the cell id list of cell ids with velocity distribution
       unordered_set<uint64_t> cellIdList_velocity;
-      createCellIdList( vlsvReader, cellIdList_velocity );
+      if( vlsvReader.indexOpen() == false ) createCellIdList( vlsvReader, cellIdList_velocity );
 
       //Get the cell id from coordinates
       //Note: By the way, this is not the same as bool getCellIdFromCoordinates (should change the name)
-      const uint64_t cellID = getCellIdFromCoords( cellStruct, cellIdList_velocity, mainOptions.coordinates );
+      const uint64_t cellID = vlsvReader.indexOpen() ?
+         getCellIdFromCoords( cellStruct, vlsvReader, mainOptions.coordinates ) :
+         getCellIdFromCoords( cellStruct, cellIdList_velocity, mainOptions.coordinates );
 
       if( cellID == numeric_limits<uint64_t>::max() ) {
          //Could not find a cell id
@@ -1783,7 +1816,7 @@ void extractDistribution( const string & fileName, const UserOptions & mainOptio
    } else if( mainOptions.getCellIdFromLine ) {
       //Get the cell id list of cell ids with velocity distribution
       unordered_set<uint64_t> cellIdList_velocity;
-      createCellIdList( vlsvReader, cellIdList_velocity );
+      if( vlsvReader.indexOpen() == false ) createCellIdList( vlsvReader, cellIdList_velocity );
 
       //Now there are multiple cell ids so do the same treatment for the cell ids as with getCellIdFromCoordinates
       //but now for multiple cell ids
@@ -1803,7 +1836,9 @@ void extractDistribution( const string & fileName, const UserOptions & mainOptio
          //declare coordinates array
          const array<Real, 3> & coords = *it;
          //Get the cell id from coordinates
-         const uint64_t cellID = getCellIdFromCoords( cellStruct, cellIdList_velocity, coords );
+         const uint64_t cellID = vlsvReader.indexOpen() ?
+            getCellIdFromCoords( cellStruct, vlsvReader, coords ) :
+            getCellIdFromCoords( cellStruct, cellIdList_velocity, coords );
          if( cellID != numeric_limits<uint64_t>::max() ) {
             //A valid cell id:
             //Store the cell id in the list of cell ids but only if it is not already there:
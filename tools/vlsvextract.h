@@ -75,6 +75,7 @@ public:
    bool getCellIdFromCoordinates;
    bool rotateVectors;
    bool plasmaFrame;
+   bool useIndex;
    uint64_t cellId;
    std::vector<uint64_t> cellIdList;
    uint32_t numberOfCoordinatesInALine;
@@ -89,6 +90,7 @@ public:
       getCellIdFromCoordinates = false;
       rotateVectors = false;
       plasmaFrame =false;
+      useIndex = false;
       cellId = std::numeric_limits<uint64_t>::max();
       numberOfCoordinatesInALine = 0;
    }
@@ -20,6 +20,16 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <set>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "vlsvreaderinterface.h"
 
 using namespace std;
@@ -68,13 +78,208 @@ namespace vlsvinterface {
       }
    }
 
+   static const uint64_t indexVersion = 2;
+
    Reader::Reader() : vlsv::Reader() {
       cellIdsSet = false;
       cellsWithBlocksSet = false;
+      indexData = NULL;
+      indexSize = 0;
+      indexCellIds = NULL;
+      indexBlockOffsets = NULL;
+      indexBlockCounts = NULL;
+      indexCells = 0;
    }
    
    Reader::~Reader() {
-   
+      closeIndex();
+   }
+
+   /** Returns the name of the index sidecar of the given VLSV file.*/
+   string Reader::indexFileName(const string& fileName) {
+      return fileName + ".idx";
+   }
+
+   /** Memory-map the index sidecar of the given VLSV file. The index is only used if it was
+    * written for the current version of the VLSV file, i.e., the size and modification time
+    * (including nanoseconds) of the file match the ones stored in the index.
+    * @param fileName Name of the VLSV file, which should be open in this reader.
+    * @param build If true, a missing or outdated index is built from the VLSV file and
+    * written next to it.
+    * @return If true, an index is open.*/
+   bool Reader::openIndex(const string& fileName,const bool& build) {
+      closeIndex();
+      struct stat sourceStat;
+      if (stat(fileName.c_str(),&sourceStat) != 0) return false;
+      const string indexName = indexFileName(fileName);
+
+      for (int attempt=0; attempt<2; ++attempt) {
+         const int fd = ::open(indexName.c_str(),O_RDONLY);
+         if (fd >= 0) {
+            struct stat indexStat;
+            if (fstat(fd,&indexStat) == 0 && (size_t)indexStat.st_size >= sizeof(IndexHeader)) {
+               void* ptr = mmap(NULL,indexStat.st_size,PROT_READ,MAP_SHARED,fd,0);
+               if (ptr != MAP_FAILED) {
+                  const IndexHeader* header = reinterpret_cast<const IndexHeader*>(ptr);
+                  if (strncmp(header->magic,"VLSVIDX",8) == 0
+                      && header->version == indexVersion
+                      && header->sourceSize == (uint64_t)sourceStat.st_size
+                      && header->sourceMtime == (int64_t)sourceStat.st_mtim.tv_sec
+                      && header->sourceMtimeNsec == (int64_t)sourceStat.st_mtim.tv_nsec
+                      && (size_t)indexStat.st_size >= sizeof(IndexHeader) + header->nEntries*sizeof(IndexEntry)) {
+                     indexData = reinterpret_cast<const char*>(ptr);
+                     indexSize = indexStat.st_size;
+                     ::close(fd);
+                     return true;
+                  }
+                  munmap(ptr,indexStat.st_size);
+               }
+            }
+            ::close(fd);
+         }
+
+         // Index is missing or outdated
+         if (build == false || attempt > 0) return false;
+         if (writeIndex(fileName,indexName) == false) {
+            cerr << "WARNING could not write index '" << indexName << "', reading block metadata from the VLSV file" << endl;
+            return false;
+         }
+      }
+      return false;
+   }
+
+   void Reader::closeIndex() {
+      if (indexData != NULL) munmap(const_cast<char*>(indexData),indexSize);
+      indexData = NULL;
+      indexSize = 0;
+      // A population selected from the index pointed into the unmapped data
+      if (indexCellIds != NULL) cellsWithBlocksSet = false;
+      indexCellIds = NULL;
+      indexBlockOffsets = NULL;
+      indexBlockCounts = NULL;
+      indexCells = 0;
+   }
+
+   /** Build the index of the open VLSV file and write it to indexName. The index is first
+    * written to a temporary file that is renamed, so that other processes never map a
+    * partially written index. The population selected with setCellsWithBlocks is kept.*/
+   bool Reader::writeIndex(const string& fileName,const string& indexName) {
+      struct stat sourceStat;
+      if (stat(fileName.c_str(),&sourceStat) != 0) return false;
+
+      list<string> meshNames;
+      if (getMeshNames(meshNames) == false) return false;
+      set<string> popNames;
+      getUniqueAttributeValues("BLOCKIDS","name",popNames);
+      if (popNames.empty() == true) popNames.insert("");
+
+      vector<IndexEntry> entries;
+      vector<vector<uint64_t> > arrays;
+
+      // readCellsWithBlocks below overwrites the block locations of the selected population
+      unordered_map<uint64_t, pair<uint64_t, uint32_t> > selectedLocations;
+      selectedLocations.swap(cellsWithBlocksLocations);
+      const bool selectedSet = cellsWithBlocksSet;
+
+      for (list<string>::const_iterator mesh=meshNames.begin(); mesh!=meshNames.end(); ++mesh) {
+         for (set<string>::const_iterator pop=popNames.begin(); pop!=popNames.end(); ++pop) {
+            if (mesh->size() >= sizeof(IndexEntry::meshName) || pop->size() >= sizeof(IndexEntry::popName)) continue;
+
+            // Skip meshes without velocity blocks quietly
+            list<pair<string, string> > attribs;
+            attribs.push_back(make_pair("mesh", *mesh));
+            if (pop->size() > 0) attribs.push_back(make_pair("name", *pop));
+            vlsv::datatype::type dataType;
+            uint64_t arraySize, vectorSize, dataSize;
+            if (getArrayInfo("CELLSWITHBLOCKS", attribs, arraySize, vectorSize, dataType, dataSize) == false) continue;
+            if (readCellsWithBlocks(*mesh,*pop) == false) continue;
+
+            vector<pair<uint64_t,pair<uint64_t,uint32_t> > > cells(cellsWithBlocksLocations.begin(),cellsWithBlocksLocations.end());
+            sort(cells.begin(),cells.end());
+            const uint64_t nCells = cells.size();
+            vector<uint64_t> data(3*nCells);
+            for (uint64_t c=0; c<nCells; ++c) {
+               data[c]          = cells[c].first;
+               data[nCells+c]   = cells[c].second.first;
+               data[2*nCells+c] = cells[c].second.second;
+            }
+
+            IndexEntry entry;
+            memset(&entry,0,sizeof(IndexEntry));
+            strncpy(entry.meshName,mesh->c_str(),sizeof(entry.meshName)-1);
+            strncpy(entry.popName,pop->c_str(),sizeof(entry.popName)-1);
+            entry.nCells = nCells;
+            entries.push_back(entry);
+            arrays.push_back(data);
+         }
+      }
+      cellsWithBlocksLocations.swap(selectedLocations);
+      cellsWithBlocksSet = selectedSet;
+
+      IndexHeader header;
+      memset(&header,0,sizeof(IndexHeader));
+      strncpy(header.magic,"VLSVIDX",sizeof(header.magic));
+      header.version = indexVersion;
+      header.sourceSize = sourceStat.st_size;
+      header.sourceMtime = sourceStat.st_mtim.tv_sec;
+      header.sourceMtimeNsec = sourceStat.st_mtim.tv_nsec;
+      header.nEntries = entries.size();
+
+      uint64_t offset = sizeof(IndexHeader) + entries.size()*sizeof(IndexEntry);
+      for (size_t e=0; e<entries.size(); ++e) {
+         entries[e].dataOffset = offset;
+         offset += arrays[e].size()*sizeof(uint64_t);
+      }
+
+      stringstream tmpName;
+      tmpName << indexName << ".tmp." << getpid();
+      ofstream out(tmpName.str().c_str(),ios::binary);
+      if (out.good() == false) return false;
+      out.write(reinterpret_cast<const char*>(&header),sizeof(IndexHeader));
+      if (entries.size() > 0) out.write(reinterpret_cast<const char*>(&(entries[0])),entries.size()*sizeof(IndexEntry));
+      for (size_t e=0; e<arrays.size(); ++e) {
+         if (arrays[e].size() > 0) out.write(reinterpret_cast<const char*>(&(arrays[e][0])),arrays[e].size()*sizeof(uint64_t));
+      }
+      out.close();
+      if (out.fail() == true || rename(tmpName.str().c_str(),indexName.c_str()) != 0) {
+         remove(tmpName.str().c_str());
+         return false;
+      }
+      return true;
+   }
+
+   /** Returns true if the given cell has velocity blocks of any population on the given mesh
+    * according to the open index. Always false if no index is open.*/
+   bool Reader::hasBlocks(const string& meshName,const uint64_t& cellId) const {
+      if (indexData == NULL) return false;
+      const IndexHeader* header = reinterpret_cast<const IndexHeader*>(indexData);
+      const IndexEntry* entries = reinterpret_cast<const IndexEntry*>(indexData + sizeof(IndexHeader));
+      for (uint64_t e=0; e<header->nEntries; ++e) {
+         if (meshName != entries[e].meshName) continue;
+         const uint64_t* cellIds = reinterpret_cast<const uint64_t*>(indexData + entries[e].dataOffset);
+         const uint64_t* it = lower_bound(cellIds,cellIds+entries[e].nCells,cellId);
+         if (it != cellIds+entries[e].nCells && *it == cellId) return true;
+      }
+      return false;
+   }
+
+   /** Look up the block offset and number of blocks of the given cell of the population
+    * set with setCellsWithBlocks.
+    * @return If false, the cell has no blocks.*/
+   bool Reader::findCellWithBlocks(const uint64_t& cellId,uint64_t& blockOffset,uint32_t& N_blocks) const {
+      if (indexCellIds != NULL) {
+         const uint64_t* it = lower_bound(indexCellIds,indexCellIds+indexCells,cellId);
+         if (it == indexCellIds+indexCells || *it != cellId) return false;
+         const uint64_t i = it - indexCellIds;
+         blockOffset = indexBlockOffsets[i];
+         N_blocks = indexBlockCounts[i];
+         return true;
+      }
+      unordered_map<uint64_t, pair<uint64_t, uint32_t>>::const_iterator it = cellsWithBlocksLocations.find( cellId );
+      if( it == cellsWithBlocksLocations.end() ) return false;
+      blockOffset = get<0>(it->second);
+      N_blocks = get<1>(it->second);
+      return true;
    }
    
    bool Reader::getMeshNames( list<string> & meshNames ) {
@@ -204,6 +409,28 @@ namespace vlsvinterface {
    }
 
    bool Reader::setCellsWithBlocks(const std::string& meshName,const std::string& popName) {
+      clearCellsWithBlocks();
+
+      // Use the index if it has this population
+      if (indexData != NULL) {
+         const IndexHeader* header = reinterpret_cast<const IndexHeader*>(indexData);
+         const IndexEntry* entries = reinterpret_cast<const IndexEntry*>(indexData + sizeof(IndexHeader));
+         for (uint64_t e=0; e<header->nEntries; ++e) {
+            if (meshName != entries[e].meshName || popName != entries[e].popName) continue;
+            indexCells = entries[e].nCells;
+            indexCellIds = reinterpret_cast<const uint64_t*>(indexData + entries[e].dataOffset);
+            indexBlockOffsets = indexCellIds + indexCells;
+            indexBlockCounts = indexBlockOffsets + indexCells;
+            cellsWithBlocksSet = true;
+            return true;
+         }
+      }
+      return readCellsWithBlocks(meshName,popName);
+   }
+
+   /** Read the locations of the velocity blocks of the given population from the
+    * CELLSWITHBLOCKS and BLOCKSPERCELL arrays into cellsWithBlocksLocations.*/
+   bool Reader::readCellsWithBlocks(const std::string& meshName,const std::string& popName) {
       if(cellsWithBlocksLocations.empty() == false) {
          cellsWithBlocksLocations.clear();
       }
@@ -290,16 +517,13 @@ namespace vlsvinterface {
          cerr << "ERROR, setCellsWithBlocks() NOT CALLED AT (CALL setCellsWithBlocks()) BEFORE CALLING getBlockIds " << __FILE__ << " " << __LINE__ << endl;
          return false;
       }
-      //Check if the cell id can be found:
-      unordered_map<uint64_t, pair<uint64_t, uint32_t>>::const_iterator it = cellsWithBlocksLocations.find( cellId );
-      if( it == cellsWithBlocksLocations.end() ) {
+      //Check if the cell id can be found, and get offset and number of blocks:
+      uint64_t blockOffset;
+      uint32_t N_blocks;
+      if( findCellWithBlocks( cellId, blockOffset, N_blocks ) == false ) {
          cerr << "COULDNT FIND CELL ID " << cellId << " AT " << __FILE__ << " " << __LINE__ << endl;
          return false;
       }
-      //Get offset and number of blocks:
-      pair<uint64_t, uint32_t> offsetAndBlocks = it->second;
-      const uint64_t blockOffset = get<0>(offsetAndBlocks);
-      const uint32_t N_blocks = get<1>(offsetAndBlocks);
    
       // Get some required info from VLSV file:
       list<pair<string, string> > attribs;
@@ -342,9 +566,10 @@ namespace vlsvinterface {
          return false;
       }
    
-      //Check if the cell id can be found:
-      unordered_map<uint64_t, pair<uint64_t, uint32_t>>::const_iterator it = cellsWithBlocksLocations.find( cellId );
-      if( it == cellsWithBlocksLocations.end() ) {
+      //Check if the cell id can be found, and get offset and number of blocks:
+      uint64_t offset;
+      uint32_t amountToReadIn;
+      if( findCellWithBlocks( cellId, offset, amountToReadIn ) == false ) {
          cerr << "COULDNT FIND CELL ID " << cellId << " AT " << __FILE__ << " " << __LINE__ << endl;
          return false;
       }
@@ -361,10 +586,6 @@ namespace vlsvinterface {
          return false;
       }
    
-      //Get offset and number of blocks
-      const uint64_t offset = get<0>(it->second);
-      const uint32_t amountToReadIn = get<1>(it->second);
-   
       if( allocateMemory == true ) {
          buffer = new char[amountToReadIn * vectorSize * dataSize];
       }
@@ -36,15 +36,55 @@
 extern float checkVersion( const std::string & fname );
 
 namespace vlsvinterface {
+   /** Header of the index sidecar file written next to a VLSV file, see Reader::openIndex.
+    * The header is followed by nEntries IndexEntry structs, one per (mesh,population) pair
+    * with velocity blocks, and by the arrays of each entry at IndexEntry::dataOffset:
+    * nCells sorted cell IDs, the block offsets of the cells and their block counts, all
+    * as uint64_t.*/
+   struct IndexHeader {
+      char magic[8];           /**< "VLSVIDX", used to recognize the file.*/
+      uint64_t version;        /**< Version of the index file format.*/
+      uint64_t sourceSize;     /**< Size of the indexed VLSV file in bytes.*/
+      int64_t sourceMtime;     /**< Modification time of the indexed VLSV file, seconds.*/
+      int64_t sourceMtimeNsec; /**< Nanoseconds part of the modification time.*/
+      uint64_t nEntries;       /**< Number of IndexEntry structs following the header.*/
+   };
+
+   struct IndexEntry {
+      char meshName[64];       /**< Name of the spatial mesh.*/
+      char popName[64];        /**< Name of the particle population, empty in old-style files.*/
+      uint64_t nCells;         /**< Number of cells with blocks.*/
+      uint64_t dataOffset;     /**< Byte offset of the cell ID array from the beginning of the index.*/
+   };
+
    class Reader : public vlsv::Reader {
    private:
       std::unordered_map<uint64_t, uint64_t> cellIdLocations;
       std::unordered_map<uint64_t, std::pair<uint64_t, uint32_t> > cellsWithBlocksLocations;
       bool cellIdsSet;
       bool cellsWithBlocksSet;
+
+      // Memory-mapped index sidecar. If an index is open and contains the population given
+      // to setCellsWithBlocks, block locations are looked up from the mapped arrays instead
+      // of cellsWithBlocksLocations, so only the pages touched by the lookups are read.
+      const char* indexData;
+      size_t indexSize;
+      const uint64_t* indexCellIds;
+      const uint64_t* indexBlockOffsets;
+      const uint64_t* indexBlockCounts;
+      uint64_t indexCells;
+
+      bool findCellWithBlocks(const uint64_t& cellId,uint64_t& blockOffset,uint32_t& N_blocks) const;
+      bool readCellsWithBlocks(const std::string& meshName,const std::string& popName);
+      bool writeIndex(const std::string& fileName,const std::string& indexName);
    public:
       Reader();
       virtual ~Reader();
+      static std::string indexFileName(const std::string& fileName);
+      bool openIndex(const std::string& fileName,const bool& build);
+      void closeIndex();
+      bool indexOpen() const {return indexData != NULL;}
+      bool hasBlocks(const std::string& meshName,const uint64_t& cellId) const;
       bool getMeshNames( std::list<std::string> & meshNames ); //Function for getting mesh names
       bool getMeshNames( std::set<std::string> & meshNames );
       bool getVariableNames( const std::string&, std::list<std::string> & meshNames );
@@ -63,28 +103,32 @@ namespace vlsvinterface {
       inline void clearCellsWithBlocks() {
          cellsWithBlocksLocations.clear();
          cellsWithBlocksSet = false;
+         indexCellIds = NULL;
+         indexCells = 0;
       }
       bool getVelocityBlockVariables( const std::string & variableName, const uint64_t & cellId, char*& buffer, bool allocateMemory = true );
 
       inline uint64_t getBlockOffset( const uint64_t & cellId ) {
          //Check if the cell id can be found:
-         std::unordered_map<uint64_t, std::pair<uint64_t,uint32_t> >::const_iterator it = cellsWithBlocksLocations.find( cellId );
-         if( it == cellsWithBlocksLocations.end() ) {
+         uint64_t blockOffset;
+         uint32_t N_blocks;
+         if( findCellWithBlocks( cellId, blockOffset, N_blocks ) == false ) {
             std::cerr << "COULDNT FIND CELL ID " << cellId << " AT " << __FILE__ << " " << __LINE__ << std::endl;
             exit(1);
          }
          //Get offset:
-         return std::get<0>(it->second);
+         return blockOffset;
       }
       inline uint32_t getNumberOfBlocks( const uint64_t & cellId ) {
          //Check if the cell id can be found:
-         std::unordered_map<uint64_t, std::pair<uint64_t,uint32_t> >::const_iterator it = cellsWithBlocksLocations.find( cellId );
-         if( it == cellsWithBlocksLocations.end() ) {
+         uint64_t blockOffset;
+         uint32_t N_blocks;
+         if( findCellWithBlocks( cellId, blockOffset, N_blocks ) == false ) {
             std::cerr << "COULDNT FIND CELL ID " << cellId << " AT " << __FILE__ << " " << __LINE__ << std::endl;
             exit(1);
          }
          //Get number of blocks:
-         return std::get<1>(it->second);
+         return N_blocks;
       }
    };
 
@@ -27,6 +27,9 @@
 
 #include "common.h"
 #include "unistd.h"
+#ifdef USE_BLOCK_POOL
+   #include "block_pool.h"
+#endif
 
 #ifdef DEBUG_VBC
    #include <sstream>
@@ -36,6 +39,14 @@ namespace vmesh {
 
    static const double BLOCK_ALLOCATION_FACTOR = 1.1;
 
+   #ifdef USE_BLOCK_POOL
+      typedef std::vector<Realf,pool_allocator<Realf,WID3> > BlockDataVector;
+      typedef std::vector<Real,pool_allocator<Real,BlockParams::N_VELOCITY_BLOCK_PARAMS> > BlockParametersVector;
+   #else
+      typedef std::vector<Realf,aligned_allocator<Realf,WID3> > BlockDataVector;
+      typedef std::vector<Real,aligned_allocator<Real,BlockParams::N_VELOCITY_BLOCK_PARAMS> > BlockParametersVector;
+   #endif
+
    template<typename LID>
    class VelocityBlockContainer {
     public:
@@ -55,6 +66,7 @@ namespace vmesh {
       const Real* getParameters() const;
       Real* getParameters(const LID& blockLID);      
       const Real* getParameters(const LID& blockLID) const;
+      void permute(const std::vector<LID>& order);
       void pop();
       LID push_back();
       LID push_back(const uint32_t& N_blocks);
@@ -74,11 +86,11 @@ namespace vmesh {
       void exitInvalidLocalID(const LID& localID,const std::string& funcName) const;
       void resize();
       
-      std::vector<Realf,aligned_allocator<Realf,WID3> > block_data;
+      BlockDataVector block_data;
       Realf null_block_data[WID3];
       LID currentCapacity;
       LID numberOfBlocks;
-      std::vector<Real,aligned_allocator<Real,BlockParams::N_VELOCITY_BLOCK_PARAMS> > parameters;
+      BlockParametersVector parameters;
    };
    
    template<typename LID> inline
@@ -101,8 +113,8 @@ namespace vmesh {
     * reserved for velocity blocks.*/
    template<typename LID> inline
    void VelocityBlockContainer<LID>::clear() {
-      std::vector<Realf,aligned_allocator<Realf,WID3> > dummy_data;
-      std::vector<Real,aligned_allocator<Real,BlockParams::N_VELOCITY_BLOCK_PARAMS> > dummy_parameters;
+      BlockDataVector dummy_data;
+      BlockParametersVector dummy_parameters;
       
       block_data.swap(dummy_data);
       parameters.swap(dummy_parameters);
@@ -220,6 +232,35 @@ namespace vmesh {
       return parameters.data() + blockLID*BlockParams::N_VELOCITY_BLOCK_PARAMS;
    }
    
+   /** Reorder the blocks so that block b is the block that was at order[b] before.
+    * The capacity is unchanged.
+    * @param order Old local IDs of the blocks in their new order, a permutation of 0...size()-1.*/
+   template<typename LID> inline
+   void VelocityBlockContainer<LID>::permute(const std::vector<LID>& order) {
+      #ifdef DEBUG_VBC
+         if (order.size() != numberOfBlocks) {
+            std::stringstream ss;
+            ss << "VBC ERROR: permutation of " << order.size() << " blocks given for " << numberOfBlocks << " blocks" << std::endl;
+            std::cerr << ss.str();
+            sleep(1);
+            exit(1);
+         }
+      #endif
+
+      BlockDataVector new_data(currentCapacity*WID3);
+      BlockParametersVector new_parameters(currentCapacity*BlockParams::N_VELOCITY_BLOCK_PARAMS);
+      for (LID b=0; b<numberOfBlocks; ++b) {
+         const Realf* source = block_data.data() + order[b]*WID3;
+         for (unsigned int i=0; i<WID3; ++i) new_data[b*WID3+i] = source[i];
+         const Real* sourceParameters = parameters.data() + order[b]*BlockParams::N_VELOCITY_BLOCK_PARAMS;
+         for (int i=0; i<BlockParams::N_VELOCITY_BLOCK_PARAMS; ++i) {
+            new_parameters[b*BlockParams::N_VELOCITY_BLOCK_PARAMS+i] = sourceParameters[i];
+         }
+      }
+      block_data.swap(new_data);
+      parameters.swap(new_parameters);
+   }
+
    template<typename LID> inline
    void VelocityBlockContainer<LID>::pop() {
       if (numberOfBlocks == 0) return;
@@ -269,12 +310,12 @@ namespace vmesh {
    bool VelocityBlockContainer<LID>::recapacitate(const LID& newCapacity) {
       if (newCapacity < numberOfBlocks) return false;
       {
-         std::vector<Realf,aligned_allocator<Realf,WID3> > dummy_data(newCapacity*WID3);
+         BlockDataVector dummy_data(newCapacity*WID3);
          for (size_t i=0; i<numberOfBlocks*WID3; ++i) dummy_data[i] = block_data[i];
          dummy_data.swap(block_data);
       }
       {
-         std::vector<Real,aligned_allocator<Real,BlockParams::N_VELOCITY_BLOCK_PARAMS> > dummy_parameters(newCapacity*BlockParams::N_VELOCITY_BLOCK_PARAMS);
+         BlockParametersVector dummy_parameters(newCapacity*BlockParams::N_VELOCITY_BLOCK_PARAMS);
          for (size_t i=0; i<numberOfBlocks*BlockParams::N_VELOCITY_BLOCK_PARAMS; ++i) dummy_parameters[i] = parameters[i];
          dummy_parameters.swap(parameters);
       }
@@ -38,6 +38,12 @@
 #include "definitions.h"
 #include "mpiconversion.h"
 #include "logger.h"
+#include "memoryallocation.h"
+#include "block_pool.h"
+#include "telemetry.h"
+#include "task_trace.h"
+#include "cell_order.h"
+#include "control_channel.h"
 #include "parameters.h"
 #include "readparameters.h"
 #include "spatial_cell.hpp"
@@ -91,91 +97,105 @@ void addTimedBarrier(string name){
    phiprof::stop(bt);
 }
 
-bool computeNewTimeStep(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
-			FsGrid< fsgrids::technical, 2>& technicalGrid, Real &newDt, bool &isChanged) {
-   
-   phiprof::start("compute-timestep");
-   //compute maximum time-step, this cannot be done at the first
-   //step as the solvers compute the limits for each cell
-
-   isChanged=false;
+/*! Memory used by a field solver grid on this process, including the ghost layers.*/
+template<typename T, int stencil> uint64_t fsgridMemory(FsGrid<T,stencil>& grid) {
+   const int* localSize = &grid.getLocalSize()[0];
+   uint64_t cells = 1;
+   for (int i=0; i<3; ++i) cells *= localSize[i] + 2*stencil;
+   return cells * sizeof(T);
+}
 
+/*! Compute the maximum time steps allowed on this process by the ordinary space (0), velocity space (1)
+ * and field (2) propagators. The ordinary space limit of each cell is obtained from the cached velocity
+ * extents of its populations, and the per-cell limits MAXRDT are updated on the way.
+ * \param dtMaxLocal Array of three time step limits, set by this function.
+ */
+void computeLocalTimeStepLimits(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+                                FsGrid< fsgrids::technical, 2>& technicalGrid, Real* dtMaxLocal) {
+   phiprof::start("compute-timestep-limits");
    const vector<CellID>& cells = getLocalCells();
-   /* Arrays for storing local (per process) and global max dt
-      0th position stores ordinary space propagation dt
-      1st position stores velocity space propagation dt
-      2nd position stores field propagation dt
-   */
-   Real dtMaxLocal[3];
-   Real dtMaxGlobal[3];
-   
-   dtMaxLocal[0]=numeric_limits<Real>::max();
-   dtMaxLocal[1]=numeric_limits<Real>::max();
-   dtMaxLocal[2]=numeric_limits<Real>::max();
-
-   for (vector<CellID>::const_iterator cell_id=cells.begin(); cell_id!=cells.end(); ++cell_id) {
-      SpatialCell* cell = mpiGrid[*cell_id];
+   const uint nPops = getObjectWrapper().particleSpecies.size();
+   const Real EPS = numeric_limits<Real>::min()*1000;
+   Real dtMaxR = numeric_limits<Real>::max();
+   Real dtMaxV = numeric_limits<Real>::max();
+   Real dtMaxFs = numeric_limits<Real>::max();
+
+   #pragma omp parallel for schedule(dynamic,16) reduction(min:dtMaxR,dtMaxV)
+   for (size_t c=0; c<cells.size(); ++c) {
+      SpatialCell* cell = mpiGrid[cells[c]];
       const Real dx = cell->parameters[CellParams::DX];
       const Real dy = cell->parameters[CellParams::DY];
       const Real dz = cell->parameters[CellParams::DZ];
-      
-      for (uint popID=0; popID<getObjectWrapper().particleSpecies.size(); ++popID) {
-         vmesh::VelocityBlockContainer<vmesh::LocalID>& blockContainer = cell->get_velocity_blocks(popID);
-         const Real* blockParams = blockContainer.getParameters();
-         const Real EPS = numeric_limits<Real>::min()*1000;
-         for (vmesh::LocalID blockLID=0; blockLID<blockContainer.size(); ++blockLID) {
-            for (unsigned int i=0; i<WID;i+=WID-1) {
-                const Real Vx 
-                  = blockParams[blockLID*BlockParams::N_VELOCITY_BLOCK_PARAMS+BlockParams::VXCRD] 
-                  + (i+HALF)*blockParams[blockLID*BlockParams::N_VELOCITY_BLOCK_PARAMS+BlockParams::DVX]
-                  + EPS;
-                const Real Vy 
-                  = blockParams[blockLID*BlockParams::N_VELOCITY_BLOCK_PARAMS+BlockParams::VYCRD] 
-                  + (i+HALF)*blockParams[blockLID*BlockParams::N_VELOCITY_BLOCK_PARAMS+BlockParams::DVY]
-                  + EPS;
-                const Real Vz 
-                  = blockParams[blockLID*BlockParams::N_VELOCITY_BLOCK_PARAMS+BlockParams::VZCRD]
-                  + (i+HALF)*blockParams[blockLID*BlockParams::N_VELOCITY_BLOCK_PARAMS+BlockParams::DVZ]
-                  + EPS;
-
-                const Real dt_max_cell = min(dx/fabs(Vx),min(dy/fabs(Vy),dz/fabs(Vz)));
-                cell->parameters[CellParams::MAXRDT] = min(dt_max_cell,cell->parameters[CellParams::MAXRDT]);
-                cell->set_max_r_dt(popID,min(dt_max_cell,cell->get_max_r_dt(popID)));
-             }
-         }
+
+      for (uint popID=0; popID<nPops; ++popID) {
+         if (cell->get_number_of_velocity_blocks(popID) == 0) continue;
+         const Real* extent = cell->get_velocity_extent(popID);
+         const Real dt_max_cell = min(dx/max(extent[0],EPS),min(dy/max(extent[1],EPS),dz/max(extent[2],EPS)));
+         cell->parameters[CellParams::MAXRDT] = min(dt_max_cell,cell->parameters[CellParams::MAXRDT]);
+         cell->set_max_r_dt(popID,min(dt_max_cell,cell->get_max_r_dt(popID)));
       }
-      
-      
+
       if ( cell->sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY ||
            (cell->sysBoundaryLayer == 1 && cell->sysBoundaryFlag != sysboundarytype::NOT_SYSBOUNDARY )) {
          //spatial fluxes computed also for boundary cells
-         dtMaxLocal[0]=min(dtMaxLocal[0], cell->parameters[CellParams::MAXRDT]);
+         dtMaxR = min(dtMaxR, cell->parameters[CellParams::MAXRDT]);
       }
 
       if (cell->sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY && cell->parameters[CellParams::MAXVDT] != 0) {
          //Acceleration only done on non sysboundary cells
-         dtMaxLocal[1]=min(dtMaxLocal[1], cell->parameters[CellParams::MAXVDT]);
+         dtMaxV = min(dtMaxV, cell->parameters[CellParams::MAXVDT]);
       }
    }
-   
+
    //compute max dt for fieldsolver
    const std::array<int, 3> gridDims(technicalGrid.getLocalSize());
+   #pragma omp parallel for collapse(2) reduction(min:dtMaxFs)
    for (int k=0; k<gridDims[2]; k++) {
-     for (int j=0; j<gridDims[1]; j++) {
-       for (int i=0; i<gridDims[0]; i++) {
-	 fsgrids::technical* cell = technicalGrid.get(i,j,k);
-	 if ( cell->sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY ||
-	      (cell->sysBoundaryLayer == 1 && cell->sysBoundaryFlag != sysboundarytype::NOT_SYSBOUNDARY )) {
-	   dtMaxLocal[2]=min(dtMaxLocal[2], cell->maxFsDt);
-	 }
-       }
-     }
+      for (int j=0; j<gridDims[1]; j++) {
+         for (int i=0; i<gridDims[0]; i++) {
+            const fsgrids::technical* cell = technicalGrid.get(i,j,k);
+            if ( cell->sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY ||
+                 (cell->sysBoundaryLayer == 1 && cell->sysBoundaryFlag != sysboundarytype::NOT_SYSBOUNDARY )) {
+               dtMaxFs = min(dtMaxFs, cell->maxFsDt);
+            }
+         }
+      }
    }
 
+   dtMaxLocal[0] = dtMaxR;
+   dtMaxLocal[1] = dtMaxV;
+   dtMaxLocal[2] = dtMaxFs;
+   phiprof::stop("compute-timestep-limits");
+}
+
+/*! Values reduced once per time step in the main loop with a single MPI_MIN allreduce.
+ * Flags and decisions made on one process are stored negated, so that the minimum
+ * yields their maximum over processes.
+ */
+enum ControlValue {
+   CONTROL_DT_R,          /*!< Ordinary space time step limit.*/
+   CONTROL_DT_V,          /*!< Velocity space time step limit.*/
+   CONTROL_DT_FS,         /*!< Field solver time step limit.*/
+   CONTROL_BAILOUT,       /*!< Negated globalflags::bailingOut.*/
+   CONTROL_WRITE_RESTART, /*!< Negated restart decision of MASTER_RANK (1: wall time interval, 2: requested).*/
+   CONTROL_BALANCE_LOAD,  /*!< Negated extra load balance request of MASTER_RANK.*/
+   CONTROL_COMMANDS,      /*!< Negated flag of MASTER_RANK having external commands to broadcast.*/
+   N_CONTROL_VALUES
+};
+
+/*! Decide on a new time step and the number of field solver subcycles from the global
+ * time step limits of the three propagators, see computeLocalTimeStepLimits.
+ * \param dtLimits Global (minimum over processes) time step limits.
+ * \param newDt New time step, set if isChanged is true.
+ * \param isChanged Set to true if a new time step was computed.
+ */
+bool computeNewTimeStep(const Real* dtLimits, Real &newDt, bool &isChanged) {
+   phiprof::start("compute-timestep");
+   isChanged=false;
+
+   Real dtMaxGlobal[3];
+   for (int i=0; i<3; ++i) dtMaxGlobal[i] = dtLimits[i];
 
-   
-   MPI_Allreduce(&(dtMaxLocal[0]), &(dtMaxGlobal[0]), 3, MPI_Type<Real>(), MPI_MIN, MPI_COMM_WORLD);
-   
    //If any of the solvers are disabled there should be no limits in timespace from it
    if (P::propagateVlasovTranslation == false)
       dtMaxGlobal[0]=numeric_limits<Real>::max();
@@ -257,6 +277,19 @@ bool computeNewTimeStep(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpi
    return true;
 }
 
+/*! Compute a new time step, including the global reduction of the local time step limits.
+ * Collective operation on MPI_COMM_WORLD.
+ */
+bool computeNewTimeStep(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+			FsGrid< fsgrids::technical, 2>& technicalGrid, Real &newDt, bool &isChanged) {
+   Real dtMaxLocal[3];
+   Real dtMaxGlobal[3];
+   computeLocalTimeStepLimits(mpiGrid, technicalGrid, dtMaxLocal);
+   MPI_Allreduce(&(dtMaxLocal[0]), &(dtMaxGlobal[0]), 3, MPI_Type<Real>(), MPI_MIN, MPI_COMM_WORLD);
+   telemetry::countCollective();
+   return computeNewTimeStep(dtMaxGlobal, newDt, isChanged);
+}
+
 ObjectWrapper& getObjectWrapper() {
    return objectWrapper;
 }
@@ -275,6 +308,7 @@ void recalculateLocalCellsCache() {
         dummy.swap(Parameters::localCells);
      }
    Parameters::localCells = mpiGrid.get_cells();
+   cellorder::sortCells(mpiGrid,Parameters::localCells);
 }
 
 int main(int argn,char* args[]) {
@@ -284,6 +318,8 @@ int main(int argn,char* args[]) {
    typedef Parameters P;
    Real newDt;
    bool dtIsChanged;
+   bool dtLimitsReduced = false;  // true if dtLimitsGlobal were reduced in the control allreduce on this step
+   Real dtLimitsGlobal[3];
    
 // Init MPI:
    int required=MPI_THREAD_FUNNELED;
@@ -339,6 +375,9 @@ int main(int argn,char* args[]) {
    getObjectWrapper().getParameters();
    project->getParameters();
    sysBoundaries.getParameters();
+   #ifdef USE_BLOCK_POOL
+   blockpool::setHugeTLB(P::memoryBlockPoolHugeTLB);
+   #endif
    phiprof::stop("Read parameters");
 
    // Init parallel logger:
@@ -430,6 +469,11 @@ int main(int argn,char* args[]) {
       = momentsDt2Grid.physicalGlobalStart = dPerBGrid.physicalGlobalStart = dMomentsGrid.physicalGlobalStart
       = BgBGrid.physicalGlobalStart = volGrid.physicalGlobalStart = technicalGrid.physicalGlobalStart
       = {P::xmin, P::ymin, P::zmin};
+   set_subsystem_memory(memorysubsystem::FSGRID,
+      fsgridMemory(perBGrid) + fsgridMemory(perBDt2Grid) + fsgridMemory(EGrid) + fsgridMemory(EDt2Grid)
+      + fsgridMemory(EHallGrid) + fsgridMemory(EGradPeGrid) + fsgridMemory(momentsGrid) + fsgridMemory(momentsDt2Grid)
+      + fsgridMemory(dPerBGrid) + fsgridMemory(dMomentsGrid) + fsgridMemory(BgBGrid) + fsgridMemory(volGrid)
+      + fsgridMemory(technicalGrid));
    phiprof::stop("Init fieldsolver grids");
    
    // Initialize grid.  After initializeGrid local cells have dist
@@ -612,6 +656,25 @@ int main(int argn,char* args[]) {
    
    addTimedBarrier("barrier-end-initialization");
    
+   // Telemetry is opened only now so that records cover time stepping and not initialization
+   if (telemetry::open(MPI_COMM_WORLD,MASTER_RANK,P::telemetryFileName,P::telemetryInterval,P::isRestart) == false) {
+      if(myRank == MASTER_RANK) cerr << "(MAIN) ERROR: failed to open telemetry file!" << endl;
+      exit(1);
+   }
+
+   if (myRank == MASTER_RANK && P::populationTasks) {
+      tasktrace::open("task_trace.json",P::populationTaskTrace);
+   }
+
+   // External commands arrive on the control socket if one is given, otherwise command files are polled for
+   if (myRank == MASTER_RANK && P::controlSocket.size() > 0) {
+      if (controlchannel::open(P::controlSocket)) {
+         logFile << "(MAIN): Receiving external commands on " << P::controlSocket << endl << writeVerbose;
+      } else {
+         logFile << "(MAIN): Failed to open control socket " << P::controlSocket << ", polling for command files instead" << endl << writeVerbose;
+      }
+   }
+
    phiprof::start("Simulation");
    double startTime=  MPI_Wtime();
    double beforeTime = MPI_Wtime();
@@ -625,10 +688,11 @@ int main(int argn,char* args[]) {
       addTimedBarrier("barrier-loop-start");
       
       phiprof::start("IO");
+      telemetry::start(telemetry::IO);
 
       phiprof::start("checkExternalCommands");
       if(myRank ==  MASTER_RANK) {
-         // check whether STOP or KILL or SAVE has been passed, should be done by MASTER_RANK only as it can reset P::bailout_write_restart
+         // check whether STOP, KILL, SAVE or another command has been passed, should be done by MASTER_RANK only as it can reset P::bailout_write_restart
          checkExternalCommands();
       }
       phiprof::stop("checkExternalCommands");
@@ -658,6 +722,8 @@ int main(int argn,char* args[]) {
          beforeStep=P::tstep;
          //report_grid_memory_consumption(mpiGrid);
          report_process_memory_consumption();
+         update_grid_memory_accounting(mpiGrid);
+         report_subsystem_memory_consumption();
       }
       logFile << writeVerbose;
       phiprof::stop("logfile-io");
@@ -701,20 +767,23 @@ int main(int argn,char* args[]) {
          }
       }
 
-      // Reduce globalflags::bailingOut from all processes
-      phiprof::start("Bailout-allreduce");
-      MPI_Allreduce(&(globalflags::bailingOut), &(doBailout), 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-      phiprof::stop("Bailout-allreduce");
+      // Check the memory budget, may request a restart write and/or load balance below
+      if (P::memoryNodeBudget > 0.0 && P::tstep % P::memoryCheckInterval == 0) {
+         phiprof::start("check-memory-budget");
+         check_memory_budget(mpiGrid);
+         phiprof::stop("check-memory-budget");
+      }
 
-      // Write restart data if needed
-      // Combined with checking of additional load balancing to have only one collective call.
+      // Decide whether a restart is written and an extra load balance is done. The wall time
+      // condition and the externally requested actions are only known on MASTER_RANK.
       phiprof::start("compute-is-restart-written-and-extra-LB");
+      doNow[0] = 0;
+      doNow[1] = 0;
       if (myRank == MASTER_RANK) {
          if (  (P::saveRestartWalltimeInterval >= 0.0
             && (P::saveRestartWalltimeInterval*wallTimeRestartCounter <=  MPI_Wtime()-initialWtime
                || P::tstep == P::tstep_max
                || P::t >= P::t_max))
-            || (doBailout > 0 && P::bailout_write_restart)
             || globalflags::writeRestart
          ) {
             doNow[0] = 1;
@@ -723,22 +792,50 @@ int main(int argn,char* args[]) {
                globalflags::writeRestart = false; // This flag is only used by MASTER_RANK here and it needs to be reset after a restart write has been issued.
             }
          }
-         else {
-            doNow[0] = 0;
-         }
          if (globalflags::balanceLoad == true) {
             doNow[1] = 1;
             globalflags::balanceLoad = false;
          }
       }
-      MPI_Bcast( &doNow, 2 , MPI_INT , MASTER_RANK ,MPI_COMM_WORLD);
-      writeRestartNow = doNow[0];
-      doNow[0] = 0;
-      if (doNow[1] == 1) {
+      phiprof::stop("compute-is-restart-written-and-extra-LB");
+
+      // All per-step control values (bailout flag, restart and load balance decisions and, if the
+      // time step is checked later in this step, the local time step limits) are combined in one
+      // reduction. Load balancing does not change the global minimum of the time step limits, but
+      // spatial refinement does, so they are left out on steps where the mesh is adapted.
+      phiprof::start("Control-allreduce");
+      const bool adaptMeshNow = P::amrAdaptInterval > 0 && P::tstep % P::amrAdaptInterval == 0 && P::tstep > P::tstep_min;
+      dtLimitsReduced = P::dynamicTimestep && P::tstep > P::tstep_min && !adaptMeshNow;
+      Real localControl[N_CONTROL_VALUES];
+      Real globalControl[N_CONTROL_VALUES];
+      if (dtLimitsReduced) {
+         computeLocalTimeStepLimits(mpiGrid, technicalGrid, &(localControl[CONTROL_DT_R]));
+      } else {
+         for (int i=0; i<3; ++i) localControl[CONTROL_DT_R+i] = numeric_limits<Real>::max();
+      }
+      localControl[CONTROL_BAILOUT] = -globalflags::bailingOut;
+      localControl[CONTROL_WRITE_RESTART] = -doNow[0];
+      localControl[CONTROL_BALANCE_LOAD] = -doNow[1];
+      localControl[CONTROL_COMMANDS] = (myRank == MASTER_RANK && externalCommandsPending()) ? -1 : 0;
+      MPI_Allreduce(localControl, globalControl, N_CONTROL_VALUES, MPI_Type<Real>(), MPI_MIN, MPI_COMM_WORLD);
+      telemetry::countCollective();
+      phiprof::stop("Control-allreduce");
+
+      for (int i=0; i<3; ++i) dtLimitsGlobal[i] = globalControl[CONTROL_DT_R+i];
+      doBailout = (globalControl[CONTROL_BAILOUT] < 0.0) ? 1 : 0;
+      writeRestartNow = (int)(-globalControl[CONTROL_WRITE_RESTART]);
+      if (writeRestartNow == 0 && doBailout > 0 && P::bailout_write_restart) {
+         writeRestartNow = 1;
+      }
+      if (globalControl[CONTROL_BALANCE_LOAD] < 0.0) {
          P::prepareForRebalance = true;
-         doNow[1] = 0;
       }
-      phiprof::stop("compute-is-restart-written-and-extra-LB");
+      if (globalControl[CONTROL_COMMANDS] < 0.0) {
+         phiprof::start("broadcast-external-commands");
+         broadcastExternalCommands();
+         telemetry::countCollective();
+         phiprof::stop("broadcast-external-commands");
+      }
 
       if (writeRestartNow >= 1){
          phiprof::start("write-restart");
@@ -769,6 +866,7 @@ int main(int argn,char* args[]) {
          phiprof::stop("write-restart");
       }
       
+      telemetry::stop(telemetry::IO);
       phiprof::stop("IO");
       addTimedBarrier("barrier-end-io");
       
@@ -780,6 +878,20 @@ int main(int argn,char* args[]) {
          break;
       }
       
+      //Adapt spatial refinement if needed, this also rebalances the load
+      if (P::amrAdaptInterval > 0 && P::tstep % P::amrAdaptInterval == 0 && P::tstep > P::tstep_min) {
+         logFile << "(AMR): Adapting spatial refinement, tstep = " << P::tstep << " t = " << P::t << endl << writeVerbose;
+         adaptRefinement(mpiGrid, sysBoundaries);
+         phiprof::start("Shrink_to_fit");
+         shrink_to_fit_grid_data(mpiGrid);
+         phiprof::stop("Shrink_to_fit");
+         // Cells created by refinement/coarsening get their fields from the field solver grid
+         phiprof::start("getFieldsFromFsGrid");
+         getFieldsFromFsGrid(volGrid, BgBGrid, EGradPeGrid, technicalGrid, mpiGrid, getLocalCells());
+         phiprof::stop("getFieldsFromFsGrid");
+         logFile << "(AMR): ... done!"  << endl << writeVerbose;
+      }
+      
       //Re-loadbalance if needed
       //TODO - add LB measure and do LB if it exceeds threshold
       #warning Re-loadbalance has been disabled temporarily for amr debugging
@@ -813,7 +925,11 @@ int main(int argn,char* args[]) {
       //simulation loop
       // FIXME what if dt changes at a restart??
       if(P::dynamicTimestep  && P::tstep > P::tstep_min) {
-         computeNewTimeStep(mpiGrid, technicalGrid, newDt, dtIsChanged);
+         if (dtLimitsReduced) {
+            computeNewTimeStep(dtLimitsGlobal, newDt, dtIsChanged);
+         } else {
+            computeNewTimeStep(mpiGrid, technicalGrid, newDt, dtIsChanged);
+         }
          addTimedBarrier("barrier-check-dt");
          if(dtIsChanged) {
             phiprof::start("update-dt");
@@ -850,6 +966,11 @@ int main(int argn,char* args[]) {
       
       phiprof::start("Propagate");
       //Propagate the state of simulation forward in time by dt:
+      if (isSysBoundaryCondDynamic) {
+         phiprof::start("Update system boundary states");
+         sysBoundaries.updateSysBoundaryStates(mpiGrid, P::t+0.5*P::dt);
+         phiprof::stop("Update system boundary states");
+      }
       if (P::propagateVlasovTranslation || P::propagateVlasovAcceleration ) {
          phiprof::start("Update system boundaries (Vlasov pre-translation)");
          sysBoundaries.applySysBoundaryVlasovConditions(mpiGrid, P::t+0.5*P::dt); 
@@ -858,6 +979,7 @@ int main(int argn,char* args[]) {
       }
       
       phiprof::start("Spatial-space");
+      telemetry::start(telemetry::SPATIAL_SPACE);
       
       if( P::propagateVlasovTranslation) {
          calculateSpatialTranslation(mpiGrid,P::dt);
@@ -865,6 +987,7 @@ int main(int argn,char* args[]) {
          calculateSpatialTranslation(mpiGrid,0.0);
       }
       
+      telemetry::stop(telemetry::SPATIAL_SPACE);
       phiprof::stop("Spatial-space",computedCells,"Cells");
       
       phiprof::start("Compute interp moments");
@@ -893,6 +1016,7 @@ int main(int argn,char* args[]) {
       // moments for t + dt are computed (field uses t and t+0.5dt)
       if (P::propagateField) {
          phiprof::start("Propagate Fields");
+         telemetry::start(telemetry::PROPAGATE_FIELDS);
 
          phiprof::start("fsgrid-coupling-in");
          // Copy moments over into the fsgrid.
@@ -926,11 +1050,13 @@ int main(int argn,char* args[]) {
          technicalGrid.updateGhostCells();
          getFieldsFromFsGrid(volGrid, BgBGrid, EGradPeGrid, technicalGrid, mpiGrid, cells);
          phiprof::stop("getFieldsFromFsGrid");
+         telemetry::stop(telemetry::PROPAGATE_FIELDS);
          phiprof::stop("Propagate Fields",cells.size(),"SpatialCells");
          addTimedBarrier("barrier-after-field-solver");
       }
       
       phiprof::start("Velocity-space");
+      telemetry::start(telemetry::VELOCITY_SPACE);
       if ( P::propagateVlasovAcceleration ) {
          calculateAcceleration(mpiGrid,P::dt);
          addTimedBarrier("barrier-after-ad just-blocks");
@@ -939,6 +1065,7 @@ int main(int argn,char* args[]) {
          calculateAcceleration(mpiGrid, 0.0);
       }
 
+      telemetry::stop(telemetry::VELOCITY_SPACE);
       phiprof::stop("Velocity-space",computedCells,"Cells");
       addTimedBarrier("barrier-after-acceleration");
 
@@ -970,6 +1097,10 @@ int main(int argn,char* args[]) {
          s << "The timestep dt=" << P::dt << " went below bailout.bailout_min_dt (" << to_string(P::bailout_min_dt) << ")." << endl;
          bailout(true, s.str(), __FILE__, __LINE__);
       }
+
+      telemetry::endStep(P::tstep,P::t,P::dt,computedCells/WID3,cells.size());
+      tasktrace::endStep();
+
       //Move forward in time
       P::meshRepartitioned = false;
       ++P::tstep;
@@ -1013,6 +1144,8 @@ int main(int argn,char* args[]) {
    if (myRank == MASTER_RANK) logFile << "(MAIN): Exiting." << endl << writeVerbose;
    logFile.close();
    if (P::diagnosticInterval != 0) diagnostic.close();
+   telemetry::close();
+   controlchannel::close();
    
    perBGrid.finalize();
    perBDt2Grid.finalize();
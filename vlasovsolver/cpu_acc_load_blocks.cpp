@@ -25,6 +25,16 @@
 #include "vec.h"
 #include "cpu_acc_load_blocks.hpp"
 
+/*! Index in the block data of the cell that is loaded into position cell = k*WID2 + j*WID + i
+ * of the column when the column is along dimension 0 or 1, i.e. the transposition used for
+ * the block widths that have no generated gather code below.
+ */
+static constexpr uint transposedCellIndex(const int dimension, const uint cell) {
+   return dimension == 0 ?
+      (cell % WID) * WID2 + ((cell / WID) % WID) * WID + cell / WID2 :
+      (cell % WID) + ((cell / WID) % WID) * WID2 + (cell / WID2) * WID;
+}
+
 void loadColumnBlockData(
    const vmesh::VelocityMesh<vmesh::GlobalID,vmesh::LocalID>& vmesh,
    vmesh::VelocityBlockContainer<vmesh::LocalID>& blockContainer,
@@ -42,6 +52,7 @@ void loadColumnBlockData(
       }
    }
 
+#if VELOCITY_BLOCK_WIDTH == 4
    /*[[[cog
 import cog
 
@@ -243,6 +254,29 @@ for dimension in range(0, 2):
       }
    }
 //[[[end]]]
+#else
+   if (dimension == 0 || dimension == 1) {
+      for (vmesh::LocalID block_k=0; block_k<n_blocks; ++block_k) {
+         Realf* __restrict__ data = blockContainer.getData(vmesh.getLocalID(blocks[block_k]));
+         for (uint k=0; k<WID; ++k) {
+            for (uint planeVector = 0; planeVector < VEC_PER_PLANE; planeVector++) {
+               Realf gathered[VECL] __attribute__((aligned(64)));
+               const uint cell = k * WID2 + planeVector * VECL;
+               if (dimension == 0) {
+                  for (uint vi = 0; vi < VECL; vi++) gathered[vi] = data[transposedCellIndex(0, cell + vi)];
+               } else {
+                  for (uint vi = 0; vi < VECL; vi++) gathered[vi] = data[transposedCellIndex(1, cell + vi)];
+               }
+               values[i_pcolumnv_b(planeVector, k, block_k, n_blocks)].load_a(gathered);
+            }
+         }
+         //zero old output data
+         for (uint i=0; i<WID3; ++i) {
+            data[i]=0;
+         }
+      }
+   }
+#endif
 
    if (dimension == 2) {
       // copy block data for all blocks. Dimension 2 is easy, here
@@ -116,7 +116,7 @@ void inline swapBlockIndices(velocity_block_indices_t &blockIndices, const uint
 bool map_1d(SpatialCell* spatial_cell,
             const uint popID,     
             Realv intersection, Realv intersection_di, Realv intersection_dj,Realv intersection_dk,
-            const uint dimension) {
+            const uint dimension, const bool updateContentLists) {
    no_subnormals();
 
    Realv dv,v_min;
@@ -131,6 +131,16 @@ bool map_1d(SpatialCell* spatial_cell,
    //nothing to do if no blocks
    if(vmesh.size() == 0 )
       return true;
+
+   /*If this is the last mapping of the acceleration, the content lists
+     are filled while the target blocks are still in cache, see below*/
+   const Real velocityBlockMinValue = spatial_cell->getVelocityBlockMinValue(popID);
+   std::vector<vmesh::GlobalID>& blocksWithContent = spatial_cell->get_population(popID).velocity_block_with_content_list;
+   std::vector<vmesh::GlobalID>& blocksWithNoContent = spatial_cell->get_population(popID).velocity_block_with_no_content_list;
+   if (updateContentLists) {
+      blocksWithContent.clear();
+      blocksWithNoContent.clear();
+   }
    
 
    // Velocity grid refinement level, has no effect but is 
@@ -396,24 +406,15 @@ bool map_1d(SpatialCell* spatial_cell,
          */
          for (uint j = 0; j < WID; j += VECL/WID){ 
             // create vectors with the i and j indices in the vector position on the plane.
-            #if VECL == 4       
-            const Veci i_indices = Veci(0, 1, 2, 3);
-            const Veci j_indices = Veci(j, j, j, j);
-            #elif VECL == 8
-            const Veci i_indices = Veci(0, 1, 2, 3,
-                                        0, 1, 2, 3);
-            const Veci j_indices = Veci(j, j, j, j,
-                                        j + 1, j + 1, j + 1, j + 1);
-            #elif VECL == 16
-            const Veci i_indices = Veci(0, 1, 2, 3,
-                                        0, 1, 2, 3,
-                                        0, 1, 2, 3,
-                                        0, 1, 2, 3);
-            const Veci j_indices = Veci(j, j, j, j,
-                                        j + 1, j + 1, j + 1, j + 1,
-                                        j + 2, j + 2, j + 2, j + 2,
-                                        j + 3, j + 3, j + 3, j + 3);
-            #endif
+            // A vector covers VECL/WID rows of the plane: lane l is at i = l % WID, j = j + l / WID.
+            int i_lanes[VECL], j_lanes[VECL];
+            for (int lane = 0; lane < VECL; ++lane) {
+               i_lanes[lane] = lane % WID;
+               j_lanes[lane] = j + lane / WID;
+            }
+            Veci i_indices, j_indices;
+            i_indices.load(i_lanes);
+            j_indices.load(j_lanes);
 
             const Veci  target_cell_index_common =
                i_indices * cell_indices_to_id[0] +
@@ -563,9 +564,28 @@ bool map_1d(SpatialCell* spatial_cell,
          } //for loop over j index
          valuesColumnOffset += (n_cblocks + 2) * (WID3/VECL) ;// there are WID3/VECL elements of type Vec per block    
       } //for loop over columns
-      
+
+      /*The target blocks of this set are final and no later set touches
+        them, so classify them now instead of rescanning all blocks in
+        update_velocity_block_content_lists*/
+      if (updateContentLists) {
+         for (uint blockK = 0; blockK < MAX_BLOCKS_PER_DIM; blockK++){
+            if(isTargetBlock[blockK])  {
+               const vmesh::GlobalID targetBlock =
+                  setFirstBlockIndices[0] * block_indices_to_id[0] +
+                  setFirstBlockIndices[1] * block_indices_to_id[1] +
+                  blockK                  * block_indices_to_id[2];
+               if (velocity_block_has_content(blockIndexToBlockData[blockK],velocityBlockMinValue)) {
+                  blocksWithContent.push_back(targetBlock);
+               } else {
+                  blocksWithNoContent.push_back(targetBlock);
+               }
+            }
+         }
+      }
    }
    delete [] blocks;
+   if (updateContentLists) spatial_cell->set_velocity_block_content_lists_valid(popID);
    return true;
 }
 
@@ -31,6 +31,6 @@ using namespace spatial_cell;
 
 bool map_1d(SpatialCell* spatial_cell, const uint popID,     
             Realv intersection, Realv intersection_di, Realv intersection_dj,Realv intersection_dk,
-            const uint dimension) ;
+            const uint dimension, const bool updateContentLists) ;
 
 #endif
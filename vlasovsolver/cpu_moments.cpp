@@ -24,6 +24,7 @@
 #include "cpu_moments.h"
 #include "../vlasovmover.h"
 #include "../object_wrapper.h"
+#include "../cell_affinity.h"
 #include "../fieldsolver/fs_common.h" // divideIfNonZero()
 
 using namespace std;
@@ -158,8 +159,7 @@ void calculateMoments_R_maxdt(
     creal HALF = 0.5;
 
     for (uint popID=0; popID<getObjectWrapper().particleSpecies.size(); ++popID) {
-       #pragma omp parallel for
-       for (size_t c=0; c<cells.size(); ++c) {
+       cellaffinity::forEachCell(mpiGrid, cells, cellaffinity::STATIC, [&](const size_t c) {
           SpatialCell* cell = mpiGrid[cells[c]];
           
           // Clear old moments to zero value
@@ -183,7 +183,7 @@ void calculateMoments_R_maxdt(
           cell->set_max_r_dt(popID,numeric_limits<Real>::max());
 
           vmesh::VelocityBlockContainer<vmesh::LocalID>& blockContainer = cell->get_velocity_blocks(popID);
-          if (blockContainer.size() == 0) continue;
+          if (blockContainer.size() == 0) return;
           const Realf* data       = blockContainer.getData();
           const Real* blockParams = blockContainer.getParameters();
           const Real mass = getObjectWrapper().particleSpecies[popID].mass;
@@ -249,7 +249,7 @@ void calculateMoments_R_maxdt(
           cell->parameters[CellParams::VY_R] += array[2]*mass;
           cell->parameters[CellParams::VZ_R] += array[3]*mass;
           cell->parameters[CellParams::RHOQ_R  ] += array[0]*charge;
-       } // for-loop over spatial cells
+       }); // for-loop over spatial cells
     } // for-loop over particle species
     
     #pragma omp parallel for
@@ -267,12 +267,11 @@ void calculateMoments_R_maxdt(
    }
 
    for (uint popID=0; popID<getObjectWrapper().particleSpecies.size(); ++popID) {
-      #pragma omp parallel for
-      for (size_t c=0; c<cells.size(); ++c) {
+      cellaffinity::forEachCell(mpiGrid, cells, cellaffinity::STATIC, [&](const size_t c) {
          SpatialCell* cell = mpiGrid[cells[c]];
        
          vmesh::VelocityBlockContainer<vmesh::LocalID>& blockContainer = cell->get_velocity_blocks(popID);
-         if (blockContainer.size() == 0) continue;
+         if (blockContainer.size() == 0) return;
          const Realf* data       = blockContainer.getData();
          const Real* blockParams = blockContainer.getParameters();
          const Real mass = getObjectWrapper().particleSpecies[popID].mass;
@@ -300,7 +299,7 @@ void calculateMoments_R_maxdt(
          cell->parameters[CellParams::P_11_R] += pop.P_R[0];
          cell->parameters[CellParams::P_22_R] += pop.P_R[1];
          cell->parameters[CellParams::P_33_R] += pop.P_R[2];
-      } // for-loop over spatial cells
+      }); // for-loop over spatial cells
    } // for-loop over particle species
 
    phiprof::stop("compute-moments-n-maxdt");
@@ -323,8 +322,7 @@ void calculateMoments_V(
    
    // Loop over all particle species
    for (uint popID=0; popID<getObjectWrapper().particleSpecies.size(); ++popID) {
-      #pragma omp parallel for
-      for (size_t c=0; c<cells.size(); ++c) {
+      cellaffinity::forEachCell(mpiGrid, cells, cellaffinity::STATIC, [&](const size_t c) {
          SpatialCell* cell = mpiGrid[cells[c]];
          
          // Clear old moments to zero value
@@ -340,7 +338,7 @@ void calculateMoments_V(
          }
 
          vmesh::VelocityBlockContainer<vmesh::LocalID>& blockContainer = cell->get_velocity_blocks(popID);
-         if (blockContainer.size() == 0) continue;
+         if (blockContainer.size() == 0) return;
          const Realf* data       = blockContainer.getData();
          const Real* blockParams = blockContainer.getParameters();
          const Real mass = getObjectWrapper().particleSpecies[popID].mass;
@@ -369,7 +367,7 @@ void calculateMoments_V(
          cell->parameters[CellParams::VY_V] += array[2]*mass;
          cell->parameters[CellParams::VZ_V] += array[3]*mass;
          cell->parameters[CellParams::RHOQ_V  ] += array[0]*charge;
-      } // for-loop over spatial cells
+      }); // for-loop over spatial cells
    } // for-loop over particle species
    
    #pragma omp parallel for
@@ -387,12 +385,11 @@ void calculateMoments_V(
    }
 
    for (uint popID=0; popID<getObjectWrapper().particleSpecies.size(); ++popID) {
-      #pragma omp parallel for
-      for (size_t c=0; c<cells.size(); ++c) {
+      cellaffinity::forEachCell(mpiGrid, cells, cellaffinity::STATIC, [&](const size_t c) {
          SpatialCell* cell = mpiGrid[cells[c]];
 
          vmesh::VelocityBlockContainer<vmesh::LocalID>& blockContainer = cell->get_velocity_blocks(popID);
-         if (blockContainer.size() == 0) continue;
+         if (blockContainer.size() == 0) return;
          const Realf* data       = blockContainer.getData();
          const Real* blockParams = blockContainer.getParameters();
          const Real mass = getObjectWrapper().particleSpecies[popID].mass;
@@ -422,7 +419,7 @@ void calculateMoments_V(
          cell->parameters[CellParams::P_22_V] += pop.P_V[1];
          cell->parameters[CellParams::P_33_V] += pop.P_V[2];
          
-      } // for-loop over spatial cells
+      }); // for-loop over spatial cells
    } // for-loop over particle species
 
    phiprof::stop("Compute _V moments");
@@ -33,7 +33,7 @@ void compute_spatial_source_neighbors(const dccrg::Dccrg<SpatialCell,dccrg::Cart
 void compute_spatial_target_neighbors(const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
                                       const CellID& cellID,const uint dimension,SpatialCell **neighbors);
 void copy_trans_block_data(SpatialCell** source_neighbors,const vmesh::GlobalID blockGID,
-                           Vec* values,const unsigned char* const cellid_transpose,const uint popID);
+                           Vec* values,const BlockCellIndex* const cellid_transpose,const uint popID);
 CellID get_spatial_neighbor(const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
                             const CellID& cellID,const bool include_first_boundary_layer,
                             const int spatial_di,const int spatial_dj,const int spatial_dk);
@@ -42,7 +42,7 @@ SpatialCell* get_spatial_neighbor_pointer(const dccrg::Dccrg<SpatialCell,dccrg::
                                           const int spatial_di,const int spatial_dj,const int spatial_dk);
 void store_trans_block_data(SpatialCell** target_neighbors,const vmesh::GlobalID blockGID,
                             Vec* __restrict__ target_values,
-                            const unsigned char* const cellid_transpose,const uint popID);
+                            const BlockCellIndex* const cellid_transpose,const uint popID);
 
 bool do_translate_cell(spatial_cell::SpatialCell* SC);
 bool trans_map_1d(const dccrg::Dccrg<spatial_cell::SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
@@ -71,7 +71,7 @@ void compute_spatial_target_neighbors(const dccrg::Dccrg<SpatialCell,
 void copy_trans_block_data(SpatialCell** source_neighbors,
                            const vmesh::GlobalID blockGID,
                            Vec* values,
-                           const unsigned char* const cellid_transpose,
+                           const BlockCellIndex* const cellid_transpose,
                            const uint popID);
 
 #endif
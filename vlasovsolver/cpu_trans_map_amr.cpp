@@ -82,7 +82,7 @@ int getNeighborhood(const uint dimension, const uint stencil) {
  * @param [out] sourceCells pointer to an array of pointers to SpatialCell objects for the source cells
  */
 void computeSpatialSourceCellsForPencil(const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
-                                        setOfPencils& pencils,
+                                        const setOfPencils& pencils,
                                         const uint iPencil,
                                         const uint dimension,
                                         SpatialCell **sourceCells){
@@ -196,7 +196,7 @@ void computeSpatialSourceCellsForPencil(const dccrg::Dccrg<SpatialCell,dccrg::Ca
  *
  */
 void computeSpatialTargetCellsForPencils(const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
-                                         setOfPencils& pencils,
+                                         const setOfPencils& pencils,
                                          const uint dimension,
                                          SpatialCell **targetCells){
 
@@ -329,12 +329,12 @@ CellID selectNeighbor(const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>
  * @param [in] dimension Spatial dimension
  * @param [in] path Integer value that determines which neighbor is added to the pencil when a higher refinement level is met
  * @param [in] endIds Prescribed end conditions for the pencil. If any of these cell ids is about to be added to the pencil,
- *             the builder terminates.
+ *             the builder terminates. Has to be sorted.
  */
-setOfPencils buildPencilsWithNeighbors( const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry> &grid, 
-					setOfPencils &pencils, const CellID seedId,
-					vector<CellID> ids, const uint dimension, 
-					vector<uint> path, const vector<CellID> &endIds) {
+void buildPencilsWithNeighbors( const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry> &grid, 
+                                setOfPencils &pencils, const CellID seedId,
+                                vector<CellID> ids, const uint dimension, 
+                                vector<uint> path, const vector<CellID> &endIds) {
 
    const bool debug = false;
    CellID nextNeighbor;
@@ -468,7 +468,7 @@ setOfPencils buildPencilsWithNeighbors( const dccrg::Dccrg<SpatialCell,dccrg::Ca
             std::cout << " Next neighbor is " << nextNeighbor << "." << std::endl;
          }
 
-         if ( std::any_of(endIds.begin(), endIds.end(), [nextNeighbor](uint i){return i == nextNeighbor;}) ||
+         if ( std::binary_search(endIds.begin(), endIds.end(), nextNeighbor) ||
               !do_translate_cell(grid[nextNeighbor])) {
             
             nextNeighbor = INVALID_CELLID;
@@ -492,9 +492,6 @@ setOfPencils buildPencilsWithNeighbors( const dccrg::Dccrg<SpatialCell,dccrg::Ca
    y = coordinates[iy];
 
    pencils.addPencil(ids,x,y,periodic,path);
-   
-   return pencils;
-  
 }
 
 /* Propagate a given velocity block in all spatial cells of a pencil by a time step dt using a PPM reconstruction.
@@ -700,7 +697,7 @@ void copy_trans_block_data_amr(
     const vmesh::GlobalID blockGID,
     int lengthOfPencil,
     Vec* values,
-    const unsigned char* const cellid_transpose,
+    const BlockCellIndex* const cellid_transpose,
     const uint popID) { 
 
    // Allocate data pointer for all blocks in pencil. Pad on both ends by VLASOV_STENCIL_WIDTH
@@ -862,16 +859,15 @@ bool checkPencils(const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpi
                   const std::vector<CellID> &cells, const setOfPencils& pencils) {
 
    bool correct = true;
+   const std::unordered_set<CellID> idsInPencils(pencils.ids.begin(), pencils.ids.end());
 
    for (auto id : cells) {
 
       if (mpiGrid[id]->sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY )  {
       
-         int myCount = std::count(pencils.ids.begin(), pencils.ids.end(), id);
-         
-         if( myCount == 0) {
+         if( idsInPencils.count(id) == 0) {
             
-            std::cerr << "ERROR: Cell ID " << id << " Appears in pencils " << myCount << " times!"<< std::endl;            
+            std::cerr << "ERROR: Cell ID " << id << " Appears in pencils 0 times!"<< std::endl;            
             correct = false;
          }
 
@@ -923,6 +919,82 @@ void printPencilsFunc(const setOfPencils& pencils, const uint dimension, const i
    MPI_Barrier(MPI_COMM_WORLD);
 }
 
+/* Pencils of each dimension, reused until the mesh is repartitioned.*/
+static setOfPencils cachedPencils[3];
+static bool cachedPencilsValid[3] = {false,false,false};
+static uint cachedPencilsStep[3];
+static size_t cachedPencilsNCells[3];
+
+/* Build the pencils covering the local propagated cells in the given dimension. Pencils are
+ * constructed in parallel, one set per seed, and concatenated in seed order so that the
+ * result is identical to a serial build.
+ *
+ * @param [in] mpiGrid DCCRG grid object
+ * @param [in] localPropagatedCells List of local cells that get propagated
+ * @param [in] dimension Spatial dimension
+ * @param [out] pencils Pencil data struct, must be empty on entry
+ */
+static void buildPencils(const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+                         const vector<CellID>& localPropagatedCells,
+                         const uint dimension,
+                         setOfPencils& pencils) {
+
+   vector<CellID> seedIds;
+   getSeedIds(mpiGrid, localPropagatedCells, dimension, seedIds);
+
+   // Builders stop at any seed, sorted for binary search
+   vector<CellID> endIds(seedIds);
+   std::sort(endIds.begin(), endIds.end());
+
+   vector<setOfPencils> pencilsOfSeed(seedIds.size());
+   #pragma omp parallel for schedule(dynamic,1)
+   for (size_t i = 0; i < seedIds.size(); ++i) {
+      // Empty vectors for internal use of buildPencilsWithNeighbors
+      vector<CellID> ids;
+      vector<uint> path;
+      buildPencilsWithNeighbors(mpiGrid, pencilsOfSeed[i], seedIds[i], ids, dimension, path, endIds);
+   }
+
+   for (size_t i = 0; i < seedIds.size(); ++i) {
+      pencils.append(pencilsOfSeed[i]);
+   }
+
+   // Check refinement of two ghost cells on each end of each pencil
+   check_ghost_cells(mpiGrid,pencils,dimension);
+
+   if(!checkPencils(mpiGrid, localPropagatedCells, pencils)) {
+      abort();
+   }
+}
+
+/* Return the pencils of the given dimension. They only change when the mesh is
+ * repartitioned (load balance or refinement), so they are rebuilt on the first call
+ * of a time step with a repartitioned mesh and reused otherwise.
+ *
+ * @param [in] mpiGrid DCCRG grid object
+ * @param [in] localPropagatedCells List of local cells that get propagated
+ * @param [in] dimension Spatial dimension
+ */
+static const setOfPencils& getPencils(const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+                                      const vector<CellID>& localPropagatedCells,
+                                      const uint dimension) {
+
+   if (cachedPencilsValid[dimension] == false
+       || (P::meshRepartitioned && cachedPencilsStep[dimension] != P::tstep)
+       || cachedPencilsNCells[dimension] != localPropagatedCells.size()) {
+
+      phiprof::start("Build pencils");
+      cachedPencils[dimension] = setOfPencils();
+      buildPencils(mpiGrid, localPropagatedCells, dimension, cachedPencils[dimension]);
+      cachedPencilsValid[dimension] = true;
+      cachedPencilsStep[dimension] = P::tstep;
+      cachedPencilsNCells[dimension] = localPropagatedCells.size();
+      phiprof::stop("Build pencils",cachedPencils[dimension].N,"Pencils");
+   }
+
+   return cachedPencils[dimension];
+}
+
 /* Map velocity blocks in all local cells forward by one time step in one spatial dimension.
  * This function uses 1-cell wide pencils to update cells in-place to avoid allocating large
  * temporary buffers.
@@ -949,7 +1021,7 @@ bool trans_map_1d_amr(const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>&
    const bool printPencils = false;
    Realv dvz,vz_min;  
    uint cell_indices_to_id[3]; /*< used when computing id of target cell in block*/
-   unsigned char  cellid_transpose[WID3]; /*< defines the transpose for the solver internal (transposed) id: i + j*WID + k*WID2 to actual one*/
+   BlockCellIndex cellid_transpose[WID3]; /*< defines the transpose for the solver internal (transposed) id: i + j*WID + k*WID2 to actual one*/
    const uint blocks_per_dim = 1;
    // return if there's no cells to propagate
    if(localPropagatedCells.size() == 0) {
@@ -1016,39 +1088,33 @@ bool trans_map_1d_amr(const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>&
    }
    // ****************************************************************************
 
-   // compute pencils => set of pencils (shared datastructure)
-   
-   vector<CellID> seedIds;
-   getSeedIds(mpiGrid, localPropagatedCells, dimension, seedIds);
-   
-   // Empty vectors for internal use of buildPencilsWithNeighbors. Could be default values but
-   // default vectors are complicated. Should overload buildPencilsWithNeighbors like suggested here
-   // https://stackoverflow.com/questions/3147274/c-default-argument-for-vectorint
-   vector<CellID> ids;
-   vector<uint> path;
-
-   // Output vectors for ready pencils
-   setOfPencils pencils;
-   vector<setOfPencils> pencilSets;
-
-   for (const auto seedId : seedIds) {
-      // Construct pencils from the seedIds into a set of pencils.
-      pencils = buildPencilsWithNeighbors(mpiGrid, pencils, seedId, ids, dimension, path, seedIds);
-   }   
-   
-   // Check refinement of two ghost cells on each end of each pencil
-   check_ghost_cells(mpiGrid,pencils,dimension);
+   // compute pencils => set of pencils (shared datastructure, cached between calls)
+   const setOfPencils& pencils = getPencils(mpiGrid, localPropagatedCells, dimension);
    // ****************************************************************************   
 
    if(printPencils) printPencilsFunc(pencils,dimension,myRank);
 
-   if(!checkPencils(mpiGrid, localPropagatedCells, pencils)) {
-      abort();
-   }
-   
    // Add the final set of pencils to the pencilSets - vector.
    // Only one set is created for now but we retain support for multiple sets
-   pencilSets.push_back(pencils);
+   vector<const setOfPencils*> pencilSets;
+   pencilSets.push_back(&pencils);
+
+   // Source and target cells of the pencils are the same for all velocity blocks.
+   // Source cells of pencil i start at idsStart[i] + 2 * VLASOV_STENCIL_WIDTH * i,
+   // target cells of pencil i at idsStart[i] + 2 * i.
+   vector< vector<SpatialCell*> > sourceCellsOfSets(pencilSets.size());
+   vector< vector<SpatialCell*> > targetCellsOfSets(pencilSets.size());
+   for (size_t iSet = 0; iSet < pencilSets.size(); ++iSet) {
+      const setOfPencils& pencilSet = *pencilSets[iSet];
+      sourceCellsOfSets[iSet].resize(pencilSet.sumOfLengths + 2 * VLASOV_STENCIL_WIDTH * pencilSet.N);
+      targetCellsOfSets[iSet].resize(pencilSet.sumOfLengths + 2 * pencilSet.N);
+      #pragma omp parallel for
+      for (uint pencili = 0; pencili < pencilSet.N; ++pencili) {
+         computeSpatialSourceCellsForPencil(mpiGrid, pencilSet, pencili, dimension,
+                                            sourceCellsOfSets[iSet].data() + pencilSet.idsStart[pencili] + 2 * VLASOV_STENCIL_WIDTH * pencili);
+      }
+      computeSpatialTargetCellsForPencils(mpiGrid, pencilSet, dimension, targetCellsOfSets[iSet].data());
+   }
    
    const uint8_t VMESH_REFLEVEL = 0;
    
@@ -1095,17 +1161,16 @@ bool trans_map_1d_amr(const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>&
          
          // Loop over sets of pencils
          // This loop only has one iteration for now
-         for ( auto pencils: pencilSets ) {
+         for ( size_t iSet = 0; iSet < pencilSets.size(); ++iSet ) {
+            const setOfPencils& pencils = *pencilSets[iSet];
 
             phiprof::start(t1);
             
             std::vector<Realf> targetBlockData((pencils.sumOfLengths + 2 * pencils.N) * WID3);
             
-            // Compute spatial neighbors for target cells.
+            // Spatial neighbors for target cells.
             // For targets we need the local cells, plus a padding of 1 cell at both ends
-            std::vector<SpatialCell*> targetCells(pencils.sumOfLengths + pencils.N * 2 );
-            
-            computeSpatialTargetCellsForPencils(mpiGrid, pencils, dimension, targetCells.data());           
+            const std::vector<SpatialCell*>& targetCells = targetCellsOfSets[iSet];
 
             // Loop over pencils
             uint totalTargetLength = 0;
@@ -1115,15 +1180,14 @@ bool trans_map_1d_amr(const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>&
                uint targetLength = L + 2;
                uint sourceLength = L + 2 * VLASOV_STENCIL_WIDTH;
                
-               // Compute spatial neighbors for the source cells of the pencil. In
+               // Spatial neighbors for the source cells of the pencil. In
                // source cells we have a wider stencil and take into account boundaries.
-               std::vector<SpatialCell*> sourceCells(sourceLength);
-
-               computeSpatialSourceCellsForPencil(mpiGrid, pencils, pencili, dimension, sourceCells.data());
+               SpatialCell** sourceCells = sourceCellsOfSets[iSet].data()
+                  + pencils.idsStart[pencili] + 2 * VLASOV_STENCIL_WIDTH * pencili;
                
                // dz is the cell size in the direction of the pencil
                std::vector<Vec, aligned_allocator<Vec,64>> dz(sourceLength);
-               for(uint i = 0; i < sourceCells.size(); ++i) {
+               for(uint i = 0; i < sourceLength; ++i) {
                   switch (dimension) {
                   case(0):
                      dz[i] = sourceCells[i]->SpatialCell::parameters[CellParams::DX];
@@ -1142,7 +1206,7 @@ bool trans_map_1d_amr(const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>&
                std::vector<Vec, aligned_allocator<Vec,64>> sourceVecData(sourceLength * WID3 / VECL);
 
                // load data(=> sourcedata) / (proper xy reconstruction in future)
-               copy_trans_block_data_amr(sourceCells.data(), blockGID, L, sourceVecData.data(),
+               copy_trans_block_data_amr(sourceCells, blockGID, L, sourceVecData.data(),
                                          cellid_transpose, popID);
 
                // Dz and sourceVecData are both padded by VLASOV_STENCIL_WIDTH
@@ -33,7 +33,8 @@ struct setOfPencils {
    uint N; // Number of pencils in the set
    uint sumOfLengths;
    std::vector< uint > lengthOfPencils; // Lengths of pencils
-   std::vector< CellID > ids; // List of cells
+   std::vector< uint > idsStart; // Offset of the first cell of each pencil in ids
+   std::vector< CellID > ids; // List of cells of all pencils, stored one pencil after another
    std::vector< Realv > x,y; // x,y - position
    std::vector< bool > periodic;
    std::vector< std::vector<uint> > path; // Path taken through refinement levels
@@ -44,9 +45,10 @@ struct setOfPencils {
       sumOfLengths = 0;
    }
 
-   void addPencil(std::vector<CellID> idsIn, Real xIn, Real yIn, bool periodicIn, std::vector<uint> pathIn) {
+   void addPencil(const std::vector<CellID>& idsIn, Real xIn, Real yIn, bool periodicIn, const std::vector<uint>& pathIn) {
 
       N++;
+      idsStart.push_back(sumOfLengths);
       sumOfLengths += idsIn.size();
       lengthOfPencils.push_back(idsIn.size());
       ids.insert(ids.end(),idsIn.begin(),idsIn.end());
@@ -56,6 +58,22 @@ struct setOfPencils {
       path.push_back(pathIn);
    }
 
+   // Append all pencils of another set after the pencils of this set.
+   void append(const setOfPencils& other) {
+
+      for (uint i = 0; i < other.N; ++i) {
+         idsStart.push_back(sumOfLengths + other.idsStart[i]);
+      }
+      N += other.N;
+      sumOfLengths += other.sumOfLengths;
+      lengthOfPencils.insert(lengthOfPencils.end(),other.lengthOfPencils.begin(),other.lengthOfPencils.end());
+      ids.insert(ids.end(),other.ids.begin(),other.ids.end());
+      x.insert(x.end(),other.x.begin(),other.x.end());
+      y.insert(y.end(),other.y.begin(),other.y.end());
+      periodic.insert(periodic.end(),other.periodic.begin(),other.periodic.end());
+      path.insert(path.end(),other.path.begin(),other.path.end());
+   }
+
    void removePencil(const uint pencilId) {
 
       x.erase(x.begin() + pencilId);
@@ -63,14 +81,16 @@ struct setOfPencils {
       periodic.erase(periodic.begin() + pencilId);
       path.erase(path.begin() + pencilId);
 
-      CellID ibeg = 0;
-      for (uint i = 0; i < pencilId; ++i) {
-         ibeg += lengthOfPencils[i];
+      const uint ibeg = idsStart[pencilId];
+      const uint length = lengthOfPencils[pencilId];
+      ids.erase(ids.begin() + ibeg, ids.begin() + ibeg + length);
+      for (uint i = pencilId + 1; i < N; ++i) {
+         idsStart[i] -= length;
       }
-      ids.erase(ids.begin() + ibeg, ids.begin() + ibeg + lengthOfPencils[pencilId]);
+      idsStart.erase(idsStart.begin() + pencilId);
 
       N--;
-      sumOfLengths -= lengthOfPencils[pencilId];
+      sumOfLengths -= length;
       lengthOfPencils.erase(lengthOfPencils.begin() + pencilId);
          
    }
@@ -79,19 +99,12 @@ struct setOfPencils {
 
       std::vector<CellID> idsOut;
       
-      if (pencilId > N) {
+      if (pencilId >= N) {
          return idsOut;
       }
 
-      CellID ibeg = 0;
-      for (uint i = 0; i < pencilId; i++) {
-         ibeg += lengthOfPencils[i];
-      }
-      CellID iend = ibeg + lengthOfPencils[pencilId];
-    
-      for (uint i = ibeg; i < iend; i++) {
-         idsOut.push_back(ids[i]);
-      }
+      const uint ibeg = idsStart[pencilId];
+      idsOut.assign(ids.begin() + ibeg, ids.begin() + ibeg + lengthOfPencils[pencilId]);
 
       return idsOut;
    }
@@ -185,14 +198,14 @@ void copy_trans_block_data_amr(
     const vmesh::GlobalID blockGID,
     int lengthOfPencil,
     Vec* values,
-    const unsigned char* const cellid_transpose,
+    const BlockCellIndex* const cellid_transpose,
     const uint popID);
 
 
-setOfPencils buildPencilsWithNeighbors( const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry> &grid, 
-					setOfPencils &pencils, CellID startingId,
-					std::vector<CellID> ids, uint dimension, 
-					std::vector<uint> path);
+void buildPencilsWithNeighbors( const dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry> &grid, 
+                                setOfPencils &pencils, const CellID seedId,
+                                std::vector<CellID> ids, const uint dimension, 
+                                std::vector<uint> path, const std::vector<CellID> &endIds);
 
 bool trans_map_1d_amr(const dccrg::Dccrg<spatial_cell::SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
                   const std::vector<CellID>& localPropagatedCells,
@@ -30,8 +30,10 @@
 
 By setting suitable compile-time defines oen can set the length,
 accuracy and implementation of the vector. The vector length has to be
-a multiple of WID, which is 4 in Vlasiator. It also cannot be larger
-than WID*WID or 16. Thus 4, 8 or 16 are now supported. Currently
+a multiple of WID, the velocity block width (4 by default, set with
+VELOCITY_BLOCK_WIDTH). It also cannot be larger than WID*WID. Thus with
+WID=4 vector lengths of 4, 8 or 16 are supported, and with WID=8 lengths
+of 8 or 16. Currently
 implemented vector backends are:
 
 VEC4D_AGNER
@@ -65,8 +67,8 @@ typedef double Realv;
 #define to_realv(v) to_double(v)
 #define VECL 4
 #define VPREC 8
-#define VEC_PER_PLANE 4 //vectors per plane in block
-#define VEC_PER_BLOCK 16
+#define VEC_PER_PLANE (WID2/VECL) //vectors per plane in block
+#define VEC_PER_BLOCK (WID3/VECL)
 #endif
 
 #ifdef VEC8D_AGNER
@@ -79,8 +81,8 @@ typedef double Realv;
 #define to_realv(v) to_double(v)
 #define VECL 8
 #define VPREC 8
-#define VEC_PER_PLANE 2 //vectors per plane in block
-#define VEC_PER_BLOCK 8
+#define VEC_PER_PLANE (WID2/VECL) //vectors per plane in block
+#define VEC_PER_BLOCK (WID3/VECL)
 #endif
 
 #ifdef VEC4F_AGNER
@@ -93,8 +95,8 @@ typedef float Realv;
 #define to_realv(v) to_float(v)
 #define VECL 4
 #define VPREC 4
-#define VEC_PER_PLANE 4 //vectors per plane in block
-#define VEC_PER_BLOCK 16
+#define VEC_PER_PLANE (WID2/VECL) //vectors per plane in block
+#define VEC_PER_BLOCK (WID3/VECL)
 #endif
 
 #ifdef VEC8F_AGNER
@@ -107,8 +109,8 @@ typedef float Realv;
 #define to_realv(v) to_float(v)
 #define VECL 8
 #define VPREC 4
-#define VEC_PER_PLANE 2 //vectors per plane in block
-#define VEC_PER_BLOCK 8
+#define VEC_PER_PLANE (WID2/VECL) //vectors per plane in block
+#define VEC_PER_BLOCK (WID3/VECL)
 #endif
 
 
@@ -122,8 +124,8 @@ typedef float Realv;
 #define to_realv(v) to_float(v)
 #define VECL 16
 #define VPREC 4
-#define VEC_PER_PLANE 1 //vectors per plane in block
-#define VEC_PER_BLOCK 4
+#define VEC_PER_PLANE (WID2/VECL) //vectors per plane in block
+#define VEC_PER_BLOCK (WID3/VECL)
 #endif
 
 
@@ -138,8 +140,8 @@ typedef double Realv;
 #define to_realv(v) to_double(v)
 #define VECL 4
 #define VPREC 8
-#define VEC_PER_PLANE 4 //vectors per plane in block
-#define VEC_PER_BLOCK 16
+#define VEC_PER_PLANE (WID2/VECL) //vectors per plane in block
+#define VEC_PER_BLOCK (WID3/VECL)
 #endif
 
 #ifdef VEC4F_FALLBACK
@@ -152,8 +154,8 @@ typedef float Realv;
 #define to_realv(v) to_float(v)
 #define VECL 4
 #define VPREC 4
-#define VEC_PER_PLANE 4 //vectors per plane in block
-#define VEC_PER_BLOCK 16
+#define VEC_PER_PLANE (WID2/VECL) //vectors per plane in block
+#define VEC_PER_BLOCK (WID3/VECL)
 #endif
 
 #ifdef VEC8D_FALLBACK
@@ -166,8 +168,8 @@ typedef double Realv;
 #define to_realv(v) to_double(v)
 #define VECL 8
 #define VPREC 8
-#define VEC_PER_PLANE 2 //vectors per plane in block
-#define VEC_PER_BLOCK 8
+#define VEC_PER_PLANE (WID2/VECL) //vectors per plane in block
+#define VEC_PER_BLOCK (WID3/VECL)
 #endif
 
 
@@ -181,8 +183,8 @@ typedef float Realv;
 #define to_realv(v) to_float(v)
 #define VECL 8
 #define VPREC 4
-#define VEC_PER_PLANE 2 //vectors per plane in block
-#define VEC_PER_BLOCK 8
+#define VEC_PER_PLANE (WID2/VECL) //vectors per plane in block
+#define VEC_PER_BLOCK (WID3/VECL)
 #endif
 
 
@@ -196,6 +198,13 @@ const Vec one_twelfth(1.0/12.0);
 const Vec seven_twelfth(7.0/12.0);
 const Vec one_third(1.0/3.0);
 
+#ifndef VELOCITY_BLOCK_WIDTH
+#define VELOCITY_BLOCK_WIDTH 4
+#endif
+#if (VECL % VELOCITY_BLOCK_WIDTH != 0) || (VECL > VELOCITY_BLOCK_WIDTH * VELOCITY_BLOCK_WIDTH)
+#error "The vector length has to be a multiple of the velocity block width and at most its square"
+#endif
+
 
 
 
@@ -20,6 +20,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 #include <vector>
@@ -35,9 +36,13 @@
 #include "../spatial_cell.hpp"
 #include "../vlasovmover.h"
 #include "../grid.h"
+#include "../logger.h"
 #include "../definitions.h"
 #include "../object_wrapper.h"
 #include "../mpiconversion.h"
+#include "../telemetry.h"
+#include "../cell_affinity.h"
+#include "../task_trace.h"
 
 #include "cpu_moments.h"
 #include "cpu_acc_semilag.hpp"
@@ -47,6 +52,8 @@
 using namespace std;
 using namespace spatial_cell;
 
+extern Logger logFile;
+
 creal ZERO    = 0.0;
 creal HALF    = 0.5;
 creal FOURTH  = 1.0/4.0;
@@ -55,6 +62,101 @@ creal ONE     = 1.0;
 creal TWO     = 2.0;
 creal EPSILON = 1.0e-25;
 
+/*!
+  Writes the error of the packed stencil data of the given send cells to the logfile: the
+  largest and RMS relative error of the values at or above the sparse threshold, and the
+  relative mass error of the packed copies. Collective operation on MPI_COMM_WORLD.
+*/
+static void reportPackingError(
+        dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+        const vector<CellID>& sendCells,
+        const int neighborhood,
+        const uint popID) {
+   Real maxError = 0.0;
+   Real sums[4] = {0.0,0.0,0.0,0.0}; // squared relative errors, values, mass, packed mass
+   #pragma omp parallel
+   {
+      Real threadMaxError = 0.0;
+      Real threadSquaredError = 0.0;
+      uint64_t threadValues = 0;
+      Real threadMass = 0.0;
+      Real threadPackedMass = 0.0;
+      #pragma omp for schedule(dynamic,1)
+      for (size_t c=0; c<sendCells.size(); ++c) {
+         mpiGrid[sendCells[c]]->get_packed_block_data_error(popID,threadMaxError,threadSquaredError,
+                                                            threadValues,threadMass,threadPackedMass);
+      }
+      #pragma omp critical
+      {
+         maxError = max(maxError,threadMaxError);
+         sums[0] += threadSquaredError;
+         sums[1] += threadValues;
+         sums[2] += threadMass;
+         sums[3] += threadPackedMass;
+      }
+   }
+
+   Real globalMaxError;
+   Real globalSums[4];
+   MPI_Reduce(&maxError,&globalMaxError,1,MPI_Type<Real>(),MPI_MAX,MASTER_RANK,MPI_COMM_WORLD);
+   MPI_Reduce(sums,globalSums,4,MPI_Type<Real>(),MPI_SUM,MASTER_RANK,MPI_COMM_WORLD);
+   telemetry::countCollective();
+
+   int myRank;
+   MPI_Comm_rank(MPI_COMM_WORLD,&myRank);
+   if (myRank != MASTER_RANK) return;
+   const Real rmsError = (globalSums[1] > 0.0) ? sqrt(globalSums[0]/globalSums[1]) : 0.0;
+   const Real massError = (globalSums[2] > 0.0) ? (globalSums[3]-globalSums[2])/globalSums[2] : 0.0;
+   logFile << "(PACKED): " << getObjectWrapper().particleSpecies[popID].name << " neighborhood " << neighborhood;
+   logFile << " max relative error " << globalMaxError << " RMS relative error " << rmsError;
+   logFile << " over " << (uint64_t)globalSums[1] << " values, relative mass error " << massError << endl << writeVerbose;
+}
+
+/*!
+  Updates the distribution function of the remote cells in the translation stencil of
+  the given neighborhood. With vlasovsolver.packedStencilTransfer the block data is
+  packed to 16 bits per value on the sending side and unpacked after the transfer, the
+  remote copies are only read as stencil sources so their reduced precision does not
+  accumulate. On diagnostic steps (io.diagnostic_write_interval) the packing error of
+  the sent data is written to the logfile.
+*/
+static void updateRemoteStencilData(
+        dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+        const int neighborhood,
+        const uint popID) {
+   if (!P::packedStencilTransfer) {
+      SpatialCell::set_mpi_transfer_type(Transfer::VEL_BLOCK_DATA);
+      telemetry::start(telemetry::MPI_WAIT);
+      mpiGrid.update_copies_of_remote_neighbors(neighborhood);
+      telemetry::stop(telemetry::MPI_WAIT);
+      return;
+   }
+
+   const vector<CellID>& sendCells = mpiGrid.get_local_cells_on_process_boundary(neighborhood);
+   #pragma omp parallel for schedule(dynamic,1)
+   for (size_t c=0; c<sendCells.size(); ++c) {
+      mpiGrid[sendCells[c]]->pack_block_data(popID);
+   }
+
+   if (P::diagnosticInterval != 0 && P::tstep % P::diagnosticInterval == 0) {
+      reportPackingError(mpiGrid,sendCells,neighborhood,popID);
+   }
+
+   SpatialCell::set_mpi_transfer_type(Transfer::VEL_BLOCK_DATA_PACKED);
+   telemetry::start(telemetry::MPI_WAIT);
+   mpiGrid.update_copies_of_remote_neighbors(neighborhood);
+   telemetry::stop(telemetry::MPI_WAIT);
+
+   const vector<CellID>& receiveCells = mpiGrid.get_remote_cells_on_process_boundary(neighborhood);
+   #pragma omp parallel for schedule(dynamic,1)
+   for (size_t c=0; c<receiveCells.size(); ++c) {
+      mpiGrid[receiveCells[c]]->unpack_block_data(popID);
+   }
+   for (size_t c=0; c<sendCells.size(); ++c) {
+      mpiGrid[sendCells[c]]->release_packed_block_data(popID);
+   }
+}
+
 /** Propagates the distribution function in spatial space. 
     
     Based on SLICE-3D algorithm: Zerroukat, M., and T. Allen. "A
@@ -84,8 +186,7 @@ void calculateSpatialTranslation(
    if(P::zcells_ini > 1){
       trans_timer=phiprof::initializeTimer("transfer-stencil-data-z","MPI");
       phiprof::start(trans_timer);
-      SpatialCell::set_mpi_transfer_type(Transfer::VEL_BLOCK_DATA);
-      mpiGrid.update_copies_of_remote_neighbors(VLASOV_SOLVER_Z_NEIGHBORHOOD_ID);
+      updateRemoteStencilData(mpiGrid,VLASOV_SOLVER_Z_NEIGHBORHOOD_ID,popID);
       phiprof::stop(trans_timer);
 
       phiprof::start("compute-mapping-z");
@@ -114,10 +215,9 @@ void calculateSpatialTranslation(
       
       trans_timer=phiprof::initializeTimer("transfer-stencil-data-x","MPI");
       phiprof::start(trans_timer);
-      SpatialCell::set_mpi_transfer_type(Transfer::VEL_BLOCK_DATA);
 
       mpiGrid.set_send_single_cells(false);
-      mpiGrid.update_copies_of_remote_neighbors(VLASOV_SOLVER_X_NEIGHBORHOOD_ID);
+      updateRemoteStencilData(mpiGrid,VLASOV_SOLVER_X_NEIGHBORHOOD_ID,popID);
       phiprof::stop(trans_timer);
       
       phiprof::start("compute-mapping-x");
@@ -146,10 +246,9 @@ void calculateSpatialTranslation(
       
       trans_timer=phiprof::initializeTimer("transfer-stencil-data-y","MPI");
       phiprof::start(trans_timer);
-      SpatialCell::set_mpi_transfer_type(Transfer::VEL_BLOCK_DATA);
-      
+
       mpiGrid.set_send_single_cells(false);
-      mpiGrid.update_copies_of_remote_neighbors(VLASOV_SOLVER_Y_NEIGHBORHOOD_ID);
+      updateRemoteStencilData(mpiGrid,VLASOV_SOLVER_Y_NEIGHBORHOOD_ID,popID);
       phiprof::stop(trans_timer);
       
       phiprof::start("compute-mapping-y");
@@ -271,6 +370,53 @@ momentCalculation:
   --------------------------------------------------
 */
 
+/** Accelerate one cell over one subcycle step of population popID.
+ * @param mpiGrid Parallel grid library.
+ * @param cellID Cell to accelerate.
+ * @param popID Population.
+ * @param step Subcycle step.
+ * @param dt Time step.*/
+static void accelerateCell(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+                           const CellID cellID,const uint popID,const uint step,const Real& dt) {
+   const Real maxVdt = mpiGrid[cellID]->get_max_v_dt(popID);
+   
+   //compute subcycle dt. The length is maxVdt on all steps
+   //except the last one. This is to keep the neighboring
+   //spatial cells in sync, so that two neighboring cells with
+   //different number of subcycles have similar timesteps,
+   //except that one takes an additional short step. This keeps
+   //spatial block neighbors as much in sync as possible for
+   //adjust blocks.
+   Real subcycleDt;
+   if( (step + 1) * maxVdt > dt) {
+      subcycleDt = max(dt - step * maxVdt, 0.0);
+   } else{
+      subcycleDt = maxVdt;
+   }
+
+   //generate pseudo-random order which is always the same irrespective of parallelization, restarts, etc.
+   char rngStateBuffer[256];
+   random_data rngDataBuffer;
+
+   // set seed, initialise generator and get value. The order is the same
+   // for all cells, but varies with timestep.
+   memset(&(rngDataBuffer), 0, sizeof(rngDataBuffer));
+   #ifdef _AIX
+      initstate_r(P::tstep, &(rngStateBuffer[0]), 256, NULL, &(rngDataBuffer));
+      int64_t rndInt;
+      random_r(&rndInt, &rngDataBuffer);
+   #else
+      initstate_r(P::tstep, &(rngStateBuffer[0]), 256, &(rngDataBuffer));
+      int32_t rndInt;
+      random_r(&rngDataBuffer, &rndInt);
+   #endif
+      
+   uint map_order=rndInt%3;
+   phiprof::start("cell-semilag-acc");
+   cpu_accelerate_cell(mpiGrid[cellID],popID,map_order,subcycleDt);
+   phiprof::stop("cell-semilag-acc");
+}
+
 /** Accelerate the given population to new time t+dt.
  * This function is AMR safe.
  * @param popID Particle population ID.
@@ -292,47 +438,9 @@ void calculateAcceleration(const uint popID,const uint globalMaxSubcycles,const
    calculateMoments_V(mpiGrid, propagatedCells, false);
 
    // Semi-Lagrangian acceleration for those cells which are subcycled
-   #pragma omp parallel for schedule(dynamic,1)
-   for (size_t c=0; c<propagatedCells.size(); ++c) {
-      const CellID cellID = propagatedCells[c];
-      const Real maxVdt = mpiGrid[cellID]->get_max_v_dt(popID);
-      
-      //compute subcycle dt. The length is maxVdt on all steps
-      //except the last one. This is to keep the neighboring
-      //spatial cells in sync, so that two neighboring cells with
-      //different number of subcycles have similar timesteps,
-      //except that one takes an additional short step. This keeps
-      //spatial block neighbors as much in sync as possible for
-      //adjust blocks.
-      Real subcycleDt;
-      if( (step + 1) * maxVdt > dt) {
-         subcycleDt = max(dt - step * maxVdt, 0.0);
-      } else{
-         subcycleDt = maxVdt;
-      }
-
-      //generate pseudo-random order which is always the same irrespective of parallelization, restarts, etc.
-      char rngStateBuffer[256];
-      random_data rngDataBuffer;
-
-      // set seed, initialise generator and get value. The order is the same
-      // for all cells, but varies with timestep.
-      memset(&(rngDataBuffer), 0, sizeof(rngDataBuffer));
-      #ifdef _AIX
-         initstate_r(P::tstep, &(rngStateBuffer[0]), 256, NULL, &(rngDataBuffer));
-         int64_t rndInt;
-         random_r(&rndInt, &rngDataBuffer);
-      #else
-         initstate_r(P::tstep, &(rngStateBuffer[0]), 256, &(rngDataBuffer));
-         int32_t rndInt;
-         random_r(&rngDataBuffer, &rndInt);
-      #endif
-         
-      uint map_order=rndInt%3;
-      phiprof::start("cell-semilag-acc");
-      cpu_accelerate_cell(mpiGrid[cellID],popID,map_order,subcycleDt);
-      phiprof::stop("cell-semilag-acc");
-   }
+   cellaffinity::forEachCell(mpiGrid, propagatedCells, cellaffinity::DYNAMIC, [&](const size_t c) {
+      accelerateCell(mpiGrid,propagatedCells[c],popID,step,dt);
+   });
 
    //global adjust after each subcycle to keep number of blocks managable. Even the ones not
    //accelerating anyore participate. It is important to keep
@@ -345,6 +453,78 @@ void calculateAcceleration(const uint popID,const uint globalMaxSubcycles,const
    if(step < (globalMaxSubcycles - 1)) adjustVelocityBlocks(mpiGrid, propagatedCells, false, popID);
 }
 
+/** Accelerate all particle populations over their subcycles in lockstep
+ * (vlasovsolver.populationTasks). On each subcycle step the cells of all populations
+ * that are still subcycling form one work queue, and the block adjustments of the
+ * populations are pipelined so that the MPI transfers of one population overlap with
+ * the adjustment of another.
+ * @param mpiGrid Parallel grid library.
+ * @param globalMaxSubcycles Global maximum number of subcycles of each population.
+ * @param propagatedCells Cells in which each population is accelerated, pruned in place.
+ * @param dt Time step.*/
+static void accelerateAllPopulations(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>& mpiGrid,
+                                     const vector<int>& globalMaxSubcycles,
+                                     vector<vector<CellID> >& propagatedCells,
+                                     const Real& dt) {
+   const vector<CellID>& cells = getLocalCells();
+   const uint nPops = globalMaxSubcycles.size();
+   int maxSteps = 1;
+   for (uint popID=0; popID<nPops; ++popID) maxSteps = max(maxSteps,globalMaxSubcycles[popID]);
+
+   for (uint step=0; step<(uint)maxSteps; ++step) {
+      vector<CellID> momentCells;
+      vector<pair<CellID,uint> > tasks;
+      for (uint popID=0; popID<nPops; ++popID) {
+         if (step >= (uint)globalMaxSubcycles[popID]) continue;
+         if (step > 0) {
+            // prune list of cells to propagate to only contained those which are now subcycled
+            vector<CellID> temp;
+            for (const auto& cell: propagatedCells[popID]) {
+               if (step < getAccelerationSubcycles(mpiGrid[cell], dt, popID) ) {
+                  temp.push_back(cell);
+               }
+            }
+            propagatedCells[popID].swap(temp);
+         }
+         momentCells.insert(momentCells.end(),propagatedCells[popID].begin(),propagatedCells[popID].end());
+         for (const auto& cell: propagatedCells[popID]) tasks.push_back(make_pair(cell,popID));
+      }
+      sort(momentCells.begin(),momentCells.end());
+      momentCells.erase(unique(momentCells.begin(),momentCells.end()),momentCells.end());
+
+      // Moments of all populations are computed once for the step, so every population
+      // is accelerated with the moments at the start of the step
+      calculateMoments_V(mpiGrid, momentCells, false);
+
+      // Heaviest tasks first, so that the dynamic schedule ends with small ones
+      sort(tasks.begin(),tasks.end(),[&](const pair<CellID,uint>& a,const pair<CellID,uint>& b) {
+         return mpiGrid[a.first]->get_number_of_velocity_blocks(a.second)
+              > mpiGrid[b.first]->get_number_of_velocity_blocks(b.second);
+      });
+      #pragma omp parallel for schedule(dynamic,1)
+      for (size_t t=0; t<tasks.size(); ++t) {
+         const double t0 = tasktrace::start();
+         accelerateCell(mpiGrid,tasks[t].first,tasks[t].second,step,dt);
+         tasktrace::record("accelerate",tasks[t].second,t0);
+      }
+
+      // Intermediate steps adjust only the accelerated cells, the last step of a population
+      // (or step 0 if it is not subcycled at all) does the final adjust of all cells
+      vector<uint> pops;
+      vector<vector<CellID> > cellsToAdjust;
+      vector<bool> doPrepareToReceiveBlocks;
+      for (uint popID=0; popID<nPops; ++popID) {
+         const uint steps = max(globalMaxSubcycles[popID],1);
+         if (step >= steps) continue;
+         const bool last = (step == steps-1);
+         pops.push_back(popID);
+         cellsToAdjust.push_back(last ? cells : propagatedCells[popID]);
+         doPrepareToReceiveBlocks.push_back(last);
+      }
+      adjustVelocityBlocksOverlapped(mpiGrid,pops,cellsToAdjust,doPrepareToReceiveBlocks);
+   }
+}
+
 /** Accelerate all particle populations to new time t+dt. 
  * This function is AMR safe.
  * @param mpiGrid Parallel grid library.
@@ -370,64 +550,73 @@ void calculateAcceleration(dccrg::Dccrg<SpatialCell,dccrg::Cartesian_Geometry>&
       goto momentCalculation;
    }
    phiprof::start("semilag-acc");
-    
-   // Accelerate all particle species
-    for (uint popID=0; popID<getObjectWrapper().particleSpecies.size(); ++popID) {
-       int maxSubcycles=0;
-       int globalMaxSubcycles;
-
-       // Set active population
-       SpatialCell::setCommunicatedSpecies(popID);
-       
-       // Iterate through all local cells and collect cells to propagate.
-       // Ghost cells (spatial cells at the boundary of the simulation 
-       // volume) do not need to be propagated:
-       vector<CellID> propagatedCells;
-       for (size_t c=0; c<cells.size(); ++c) {
-          SpatialCell* SC = mpiGrid[cells[c]];
-          const vmesh::VelocityMesh<vmesh::GlobalID,vmesh::LocalID>& vmesh = SC->get_velocity_mesh(popID);
-          // disregard boundary cells, in preparation for acceleration 
-          if (SC->sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY ) {
-             if(vmesh.size() != 0){
-                //do not propagate spatial cells with no blocks
-                propagatedCells.push_back(cells[c]);
-             }
-             //prepare for acceleration, updates max dt for each cell, it
-             //needs to be set to somthing sensible for _all_ cells, even if
-             //they are not propagated
-             prepareAccelerateCell(SC, popID);
-             //update max subcycles for all cells in this process
-             maxSubcycles = max((int)getAccelerationSubcycles(SC, dt, popID), maxSubcycles);
-             spatial_cell::Population& pop = SC->get_population(popID);
-             pop.ACCSUBCYCLES = getAccelerationSubcycles(SC, dt, popID);
-          }
-       }
+   {
+      const uint nPops = getObjectWrapper().particleSpecies.size();
+      vector<int> maxSubcycles(nPops,0);
+      vector<int> globalMaxSubcycles(nPops);
+      vector<vector<CellID> > propagatedCells(nPops);
+
+      // Iterate through all local cells and collect cells to propagate for all
+      // species first, so that the subcycle counts of all species can be 
+      // reduced in a single collective. Ghost cells (spatial cells at the 
+      // boundary of the simulation volume) do not need to be propagated:
+      for (uint popID=0; popID<nPops; ++popID) {
+         for (size_t c=0; c<cells.size(); ++c) {
+            SpatialCell* SC = mpiGrid[cells[c]];
+            const vmesh::VelocityMesh<vmesh::GlobalID,vmesh::LocalID>& vmesh = SC->get_velocity_mesh(popID);
+            // disregard boundary cells, in preparation for acceleration 
+            if (SC->sysBoundaryFlag == sysboundarytype::NOT_SYSBOUNDARY ) {
+               if(vmesh.size() != 0){
+                  //do not propagate spatial cells with no blocks
+                  propagatedCells[popID].push_back(cells[c]);
+               }
+               //prepare for acceleration, updates max dt for each cell, it
+               //needs to be set to somthing sensible for _all_ cells, even if
+               //they are not propagated
+               prepareAccelerateCell(SC, popID);
+               //update max subcycles for all cells in this process
+               spatial_cell::Population& pop = SC->get_population(popID);
+               pop.ACCSUBCYCLES = getAccelerationSubcycles(SC, dt, popID);
+               maxSubcycles[popID] = max((int)pop.ACCSUBCYCLES, maxSubcycles[popID]);
+            }
+         }
+      }
 
-       // Compute global maximum for number of subcycles
-       MPI_Allreduce(&maxSubcycles, &globalMaxSubcycles, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
-       
-       // substep global max times
-       for(uint step=0; step<(uint)globalMaxSubcycles; ++step) {
-          if(step > 0) {
-             // prune list of cells to propagate to only contained those which are now subcycled
-             vector<CellID> temp;
-             for (const auto& cell: propagatedCells) {
-                if (step < getAccelerationSubcycles(mpiGrid[cell], dt, popID) ) {
-                   temp.push_back(cell);
-                }
-             }
-             
-             propagatedCells.swap(temp);
-          }
-          // Accelerate population over one subcycle step
-          calculateAcceleration(popID,(uint)globalMaxSubcycles,step,mpiGrid,propagatedCells,dt);
-       } // for-loop over acceleration substeps
-       
-       // final adjust for all cells, also fixing remote cells.
-       adjustVelocityBlocks(mpiGrid, cells, true, popID);
-    } // for-loop over particle species
-
-    phiprof::stop("semilag-acc");
+      // Compute global maximum for number of subcycles of each species
+      MPI_Allreduce(maxSubcycles.data(), globalMaxSubcycles.data(), nPops, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+      telemetry::countCollective();
+
+      if (P::populationTasks) {
+         accelerateAllPopulations(mpiGrid,globalMaxSubcycles,propagatedCells,dt);
+      } else {
+         // Accelerate all particle species
+         for (uint popID=0; popID<nPops; ++popID) {
+            // Set active population
+            SpatialCell::setCommunicatedSpecies(popID);
+
+            // substep global max times
+            for(uint step=0; step<(uint)globalMaxSubcycles[popID]; ++step) {
+               if(step > 0) {
+                  // prune list of cells to propagate to only contained those which are now subcycled
+                  vector<CellID> temp;
+                  for (const auto& cell: propagatedCells[popID]) {
+                     if (step < getAccelerationSubcycles(mpiGrid[cell], dt, popID) ) {
+                        temp.push_back(cell);
+                     }
+                  }
+
+                  propagatedCells[popID].swap(temp);
+               }
+               // Accelerate population over one subcycle step
+               calculateAcceleration(popID,(uint)globalMaxSubcycles[popID],step,mpiGrid,propagatedCells[popID],dt);
+            } // for-loop over acceleration substeps
+
+            // final adjust for all cells, also fixing remote cells.
+            adjustVelocityBlocks(mpiGrid, cells, true, popID);
+         } // for-loop over particle species
+      }
+   }
+   phiprof::stop("semilag-acc");
 
    // Recalculate "_V" velocity moments
 momentCalculation: